@@ -0,0 +1,204 @@
+/*
+* Vulkan async compute
+*
+* Per-frame compute command buffers on a separate compute queue, synchronized with the frame's graphics submission
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanAsyncCompute.h"
+#include "VulkanDevice.h"
+
+namespace vks
+{
+	namespace
+	{
+		VkSemaphore createSemaphore(VkDevice device, bool timeline)
+		{
+			VkSemaphoreTypeCreateInfoKHR semaphoreTypeCI{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR,
+				.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+				.initialValue = 0
+			};
+			VkSemaphoreCreateInfo semaphoreCI{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+				.pNext = timeline ? &semaphoreTypeCI : nullptr
+			};
+			VkSemaphore semaphore;
+			VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCI, nullptr, &semaphore));
+			return semaphore;
+		}
+	}
+
+	/**
+	* Create the command buffers and synchronization objects
+	*
+	* @param device Device with a logical device, compute work is submitted to the first queue of the compute queue family
+	* @param frameCount Number of frames in flight
+	* @param timelineSemaphores True if VK_KHR_timeline_semaphore and its feature have been enabled for the device
+	* @param separateQueue If false, compute work is submitted to the graphics queue instead, e.g. to compare against async compute
+	*/
+	void AsyncCompute::prepare(VulkanDevice* device, uint32_t frameCount, bool timelineSemaphores, bool separateQueue)
+	{
+		this->device = device;
+		VkDevice logicalDevice = device->logicalDevice;
+		queueFamilyIndex = separateQueue ? device->queueFamilyIndices.compute : device->queueFamilyIndices.graphics;
+		vkGetDeviceQueue(logicalDevice, queueFamilyIndex, 0, &queue);
+		ownershipTransfer = queueFamilyIndex != device->queueFamilyIndices.graphics;
+		// Without a dedicated compute family, the first queue of the graphics family is the graphics queue itself
+		this->separateQueue = ownershipTransfer;
+
+		if (timelineSemaphores)
+		{
+			vkWaitSemaphoresKHR = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(vkGetDeviceProcAddr(logicalDevice, "vkWaitSemaphoresKHR"));
+			timelineSemaphores = vkWaitSemaphoresKHR != nullptr;
+		}
+		this->timelineSemaphores = timelineSemaphores;
+		if (timelineSemaphores)
+		{
+			computeTimeline = createSemaphore(logicalDevice, true);
+			graphicsTimeline = createSemaphore(logicalDevice, true);
+			frameValues.assign(frameCount, 0);
+		}
+		else
+		{
+			for (uint32_t i = 0; i < frameCount; i++)
+			{
+				computeSemaphores.push_back(createSemaphore(logicalDevice, false));
+				graphicsSemaphores.push_back(createSemaphore(logicalDevice, false));
+				VkFenceCreateInfo fenceCI = vks::initializers::fenceCreateInfo(VK_FENCE_CREATE_SIGNALED_BIT);
+				VkFence fence;
+				VK_CHECK_RESULT(vkCreateFence(logicalDevice, &fenceCI, nullptr, &fence));
+				fences.push_back(fence);
+			}
+		}
+
+		commandPool = device->createCommandPool(queueFamilyIndex);
+		for (uint32_t i = 0; i < frameCount; i++)
+		{
+			commandBuffers.push_back(device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandPool));
+		}
+	}
+
+	void AsyncCompute::destroy()
+	{
+		if (!device)
+		{
+			return;
+		}
+		VkDevice logicalDevice = device->logicalDevice;
+		VK_CHECK_RESULT(vkQueueWaitIdle(queue));
+		vkDestroyCommandPool(logicalDevice, commandPool, nullptr);
+		commandBuffers.clear();
+		if (computeTimeline)
+		{
+			vkDestroySemaphore(logicalDevice, computeTimeline, nullptr);
+			vkDestroySemaphore(logicalDevice, graphicsTimeline, nullptr);
+		}
+		for (size_t i = 0; i < fences.size(); i++)
+		{
+			vkDestroySemaphore(logicalDevice, computeSemaphores[i], nullptr);
+			vkDestroySemaphore(logicalDevice, graphicsSemaphores[i], nullptr);
+			vkDestroyFence(logicalDevice, fences[i], nullptr);
+		}
+		computeSemaphores.clear();
+		graphicsSemaphores.clear();
+		fences.clear();
+		device = nullptr;
+	}
+
+	VkCommandBuffer AsyncCompute::beginFrame(uint32_t frameIndex)
+	{
+		if (timelineSemaphores)
+		{
+			VkSemaphoreWaitInfoKHR waitInfo{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR,
+				.semaphoreCount = 1,
+				.pSemaphores = &computeTimeline,
+				.pValues = &frameValues[frameIndex]
+			};
+			VK_CHECK_RESULT(vkWaitSemaphoresKHR(device->logicalDevice, &waitInfo, UINT64_MAX));
+		}
+		else
+		{
+			VK_CHECK_RESULT(vkWaitForFences(device->logicalDevice, 1, &fences[frameIndex], VK_TRUE, UINT64_MAX));
+			VK_CHECK_RESULT(vkResetFences(device->logicalDevice, 1, &fences[frameIndex]));
+		}
+		VkCommandBufferBeginInfo beginInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+		};
+		VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffers[frameIndex], &beginInfo));
+		return commandBuffers[frameIndex];
+	}
+
+	void AsyncCompute::submit(uint32_t frameIndex, VkPipelineStageFlags graphicsWaitStage, bool waitForGraphics)
+	{
+		VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffers[frameIndex]));
+		const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		VkSubmitInfo submitInfo{
+			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			.pWaitDstStageMask = &waitStage,
+			.commandBufferCount = 1,
+			.pCommandBuffers = &commandBuffers[frameIndex],
+			.signalSemaphoreCount = 1
+		};
+		if (timelineSemaphores)
+		{
+			frameValues[frameIndex] = ++computeValue;
+			const bool waitsForGraphics = waitForGraphics && (graphicsValue > 0);
+			VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo{
+				.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+				.waitSemaphoreValueCount = waitsForGraphics ? 1u : 0u,
+				.pWaitSemaphoreValues = &graphicsValue,
+				.signalSemaphoreValueCount = 1,
+				.pSignalSemaphoreValues = &computeValue
+			};
+			submitInfo.pNext = &timelineSubmitInfo;
+			submitInfo.waitSemaphoreCount = waitsForGraphics ? 1 : 0;
+			submitInfo.pWaitSemaphores = &graphicsTimeline;
+			submitInfo.pSignalSemaphores = &computeTimeline;
+			graphicsWaitCount += waitsForGraphics ? 1 : 0;
+			VK_CHECK_RESULT(device->queueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
+		}
+		else
+		{
+			submitInfo.waitSemaphoreCount = pendingGraphicsSemaphore ? 1 : 0;
+			submitInfo.pWaitSemaphores = &pendingGraphicsSemaphore;
+			submitInfo.pSignalSemaphores = &computeSemaphores[frameIndex];
+			graphicsWaitCount += pendingGraphicsSemaphore ? 1 : 0;
+			VK_CHECK_RESULT(device->queueSubmit(queue, 1, &submitInfo, fences[frameIndex]));
+			pendingGraphicsSemaphore = VK_NULL_HANDLE;
+		}
+		submissionCount++;
+		graphicsWaitPending = true;
+		pendingFrameIndex = frameIndex;
+		pendingWaitStage = graphicsWaitStage;
+	}
+
+	bool AsyncCompute::graphicsSync(GraphicsSync& sync)
+	{
+		if (!graphicsWaitPending)
+		{
+			return false;
+		}
+		graphicsWaitPending = false;
+		sync.waitStage = pendingWaitStage;
+		if (timelineSemaphores)
+		{
+			sync.waitSemaphore = computeTimeline;
+			sync.waitValue = frameValues[pendingFrameIndex];
+			sync.signalSemaphore = graphicsTimeline;
+			sync.signalValue = ++graphicsValue;
+		}
+		else
+		{
+			sync.waitSemaphore = computeSemaphores[pendingFrameIndex];
+			sync.signalSemaphore = graphicsSemaphores[pendingFrameIndex];
+			pendingGraphicsSemaphore = sync.signalSemaphore;
+		}
+		return true;
+	}
+}
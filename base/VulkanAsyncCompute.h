@@ -0,0 +1,94 @@
+/*
+* Vulkan async compute
+*
+* Per-frame compute command buffers on a separate compute queue, synchronized with the frame's graphics submission
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	struct VulkanDevice;
+
+	/**
+	* @brief Records and submits compute work for each frame in flight to the compute queue
+	* submit() signals a semaphore that the graphics submission of the same frame waits for at the given stages, and the graphics submission signals a semaphore that the next compute submission can wait for. Compute work can so overlap with the rendering and post-processing of the previous frame, while the frame consuming its results still waits for it
+	* Synchronization uses timeline semaphores if VK_KHR_timeline_semaphore has been enabled, binary semaphores and fences otherwise. With binary semaphores every compute submission waits for the previous graphics submission, as a signalled binary semaphore must be waited for before it can be signalled again
+	* If queueFamilyIndex differs from the graphics queue family, resources shared with graphics need queue family ownership transfers (or VK_SHARING_MODE_CONCURRENT)
+	* @note The graphics submission must go through VulkanExampleBase::submitFrame() (or use graphicsSync()) in every frame that submitted compute work
+	*/
+	class AsyncCompute
+	{
+	public:
+		/** @brief Synchronization of a graphics submission with the compute work of its frame */
+		struct GraphicsSync
+		{
+			VkSemaphore waitSemaphore{ VK_NULL_HANDLE };
+			uint64_t waitValue{ 0 };
+			VkPipelineStageFlags waitStage{ 0 };
+			VkSemaphore signalSemaphore{ VK_NULL_HANDLE };
+			uint64_t signalValue{ 0 };
+		};
+
+		void prepare(VulkanDevice* device, uint32_t frameCount, bool timelineSemaphores, bool separateQueue = true);
+		/** @brief Waits for all compute work and releases all resources */
+		void destroy();
+
+		/** @brief Waits until the compute work previously submitted for the frame index has finished and begins its command buffer */
+		VkCommandBuffer beginFrame(uint32_t frameIndex);
+		/**
+		* @brief Ends and submits the command buffer of the frame index
+		* @param graphicsWaitStage Stages of the frame's graphics submission that consume the compute results
+		* @param waitForGraphics If true, compute waits for the previous graphics submission, e.g. if it overwrites resources that frame still reads. Always the case without timeline semaphores
+		*/
+		void submit(uint32_t frameIndex, VkPipelineStageFlags graphicsWaitStage, bool waitForGraphics = true);
+		/** @brief Returns the semaphores for the graphics submission of the current frame and resets them, false if no compute work has been submitted since the last graphics submission */
+		bool graphicsSync(GraphicsSync& sync);
+
+		VkQueue queue{ VK_NULL_HANDLE };
+		uint32_t queueFamilyIndex{ 0 };
+		/** @brief True if compute and graphics queue families differ, so shared resources need ownership transfers */
+		bool ownershipTransfer{ false };
+		/** @brief True if compute work is submitted to another queue than graphics */
+		bool separateQueue{ false };
+		bool timelineSemaphores{ false };
+
+		/** @brief Number of compute submissions and of submissions that waited for graphics since prepare */
+		uint64_t submissionCount{ 0 };
+		uint64_t graphicsWaitCount{ 0 };
+
+	private:
+		VulkanDevice* device{ nullptr };
+		PFN_vkWaitSemaphoresKHR vkWaitSemaphoresKHR{ nullptr };
+		VkCommandPool commandPool{ VK_NULL_HANDLE };
+		std::vector<VkCommandBuffer> commandBuffers;
+
+		// Timeline semaphores, signalled with increasing values by compute and graphics submissions
+		VkSemaphore computeTimeline{ VK_NULL_HANDLE };
+		VkSemaphore graphicsTimeline{ VK_NULL_HANDLE };
+		uint64_t computeValue{ 0 };
+		uint64_t graphicsValue{ 0 };
+		// Compute timeline value of each frame's last submission, the command buffer can be reused once it has been reached
+		std::vector<uint64_t> frameValues;
+
+		// Binary semaphores and fences per frame if timeline semaphores aren't available
+		std::vector<VkSemaphore> computeSemaphores;
+		std::vector<VkSemaphore> graphicsSemaphores;
+		std::vector<VkFence> fences;
+		// Signalled by the last graphics submission and not yet waited for by compute
+		VkSemaphore pendingGraphicsSemaphore{ VK_NULL_HANDLE };
+
+		// Compute submission of the current frame that the next graphics submission has to wait for
+		bool graphicsWaitPending{ false };
+		uint32_t pendingFrameIndex{ 0 };
+		VkPipelineStageFlags pendingWaitStage{ 0 };
+	};
+}
@@ -18,10 +18,21 @@ namespace vks
 	* @param size (Optional) Size of the memory range to map. Pass VK_WHOLE_SIZE to map the complete buffer range.
 	* @param offset (Optional) Byte offset from beginning
 	* 
+	* @note Sub-allocated buffers point into their block's persistent mapping, so no mapping call is made
+	*
 	* @return VkResult of the buffer mapping call
 	*/
 	VkResult Buffer::map(VkDeviceSize size, VkDeviceSize offset)
 	{
+		if (memoryAllocator)
+		{
+			if (!allocation.mapped)
+			{
+				return VK_ERROR_MEMORY_MAP_FAILED;
+			}
+			mapped = static_cast<uint8_t*>(allocation.mapped) + offset;
+			return VK_SUCCESS;
+		}
 		return vkMapMemory(device, memory, offset, size, 0, &mapped);
 	}
 
@@ -34,7 +45,10 @@ namespace vks
 	{
 		if (mapped)
 		{
-			vkUnmapMemory(device, memory);
+			if (!memoryAllocator)
+			{
+				vkUnmapMemory(device, memory);
+			}
 			mapped = nullptr;
 		}
 	}
@@ -48,7 +62,7 @@ namespace vks
 	*/
 	VkResult Buffer::bind(VkDeviceSize offset)
 	{
-		return vkBindBufferMemory(device, buffer, memory, offset);
+		return vkBindBufferMemory(device, buffer, memory, allocation.offset + offset);
 	}
 
 	/**
@@ -90,6 +104,10 @@ namespace vks
 	*/
 	VkResult Buffer::flush(VkDeviceSize size, VkDeviceSize offset)
 	{
+		if (memoryAllocator)
+		{
+			return memoryAllocator->flush(allocation, size, offset);
+		}
 		VkMappedMemoryRange mappedRange{
 			.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
 			.memory = memory,
@@ -111,6 +129,10 @@ namespace vks
 	*/
 	VkResult Buffer::invalidate(VkDeviceSize size, VkDeviceSize offset)
 	{
+		if (memoryAllocator)
+		{
+			return memoryAllocator->invalidate(allocation, size, offset);
+		}
 		VkMappedMemoryRange mappedRange{
 			.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
 			.memory = memory,
@@ -130,8 +152,19 @@ namespace vks
 			vkDestroyBuffer(device, buffer, nullptr);
 			buffer = VK_NULL_HANDLE;
 		}
+		if (memoryAllocator)
+		{
+			memoryAllocator->free(allocation);
+			memoryAllocator = nullptr;
+			memory = VK_NULL_HANDLE;
+			mapped = nullptr;
+		}
 		if (memory)
 		{
+			if (memoryTracker)
+			{
+				memoryTracker->untrack(memory);
+			}
 			vkFreeMemory(device, memory, nullptr);
 			memory = VK_NULL_HANDLE;
 		}
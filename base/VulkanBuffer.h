@@ -14,6 +14,8 @@
 
 #include "vulkan/vulkan.h"
 #include "VulkanTools.h"
+#include "VulkanMemoryAllocator.h"
+#include "VulkanMemoryTracker.h"
 
 namespace vks
 {	
@@ -35,6 +37,11 @@ namespace vks
 		/** @brief Memory property flags to be filled by external source at buffer creation (to query at some later point) */
 		VkMemoryPropertyFlags memoryPropertyFlags;
 		uint64_t deviceAddress;
+		/** @brief Tracker the buffer's memory is accounted in (if any), for buffers with their own device memory */
+		MemoryTracker* memoryTracker = nullptr;
+		/** @brief Allocator the buffer's memory has been sub-allocated from (if any), set by the VulkanDevice at buffer creation. memory is then shared with other resources and starts at allocation.offset */
+		MemoryAllocator* memoryAllocator = nullptr;
+		MemoryAllocation allocation;
 		VkResult map(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 		void unmap();
 		VkResult bind(VkDeviceSize offset = 0);
@@ -0,0 +1,67 @@
+/*
+* Vulkan command buffer reuse
+*
+* Tracks which per-frame command buffers are still valid, so unchanged frames resubmit them instead of recording them again
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanCommandBufferReuse.h"
+
+namespace vks
+{
+	/**
+	* @param frameCount Number of frames in flight
+	* @param enabled If false, every frame is recorded, e.g. to compare CPU times
+	*/
+	void CommandBufferReuse::prepare(uint32_t frameCount, bool enabled)
+	{
+		this->enabled = enabled;
+		recordings.assign(frameCount, {});
+	}
+
+	bool CommandBufferReuse::reusable(uint32_t frameIndex, uint32_t imageIndex, uint64_t key)
+	{
+		Recording& recording = recordings[frameIndex];
+		if (enabled && recording.valid && (recording.imageIndex == imageIndex) && (recording.key == key) && (recording.generation == generation))
+		{
+			reuseCount++;
+			if (recordCount > 0)
+			{
+				savedTime += recordTime / static_cast<double>(recordCount);
+			}
+			return true;
+		}
+		recording = { true, imageIndex, key, generation };
+		return false;
+	}
+
+	void CommandBufferReuse::recorded(double timeMs)
+	{
+		recordCount++;
+		recordTime += timeMs;
+	}
+
+	void CommandBufferReuse::invalidate()
+	{
+		generation++;
+	}
+
+	float CommandBufferReuse::reuseRate() const
+	{
+		const uint64_t frames = recordCount + reuseCount;
+		return (frames > 0) ? 100.0f * static_cast<float>(reuseCount) / static_cast<float>(frames) : 0.0f;
+	}
+
+	void CommandBufferReuse::writeJson(std::ostream& os) const
+	{
+		os << "{\"enabled\": " << (enabled ? "true" : "false");
+		os << ", \"recorded\": " << recordCount;
+		os << ", \"reused\": " << reuseCount;
+		os << ", \"meanRecordTime\": " << ((recordCount > 0) ? recordTime / static_cast<double>(recordCount) : 0.0);
+		os << ", \"savedTime\": " << savedTime;
+		os << "}";
+	}
+}
@@ -0,0 +1,57 @@
+/*
+* Vulkan command buffer reuse
+*
+* Tracks which per-frame command buffers are still valid, so unchanged frames resubmit them instead of recording them again
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace vks
+{
+	/**
+	* @brief Decides per frame whether the command buffer of a frame slot can be submitted as previously recorded
+	* A recording is identified by the swap chain image it renders to, a caller defined key (e.g. a signature of the UI draw commands) and a generation that invalidate() advances. Frames with a matching recording skip recording, and the mean time of past recordings is counted as saved CPU time
+	* @note Only valid for command buffers that are recorded without VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT and whose per-frame data lives in buffers that are updated in place (e.g. uniform buffers)
+	*/
+	class CommandBufferReuse
+	{
+	public:
+		void prepare(uint32_t frameCount, bool enabled);
+
+		/** @brief Returns true if the command buffer of the frame index was recorded for the image index and key since the last invalidate(), otherwise the caller has to record it and report the time with recorded() */
+		bool reusable(uint32_t frameIndex, uint32_t imageIndex, uint64_t key);
+		void recorded(double timeMs);
+		/** @brief Invalidates the recordings of all frame slots, e.g. after a resize or an option change */
+		void invalidate();
+
+		bool enabled{ true };
+		uint64_t recordCount{ 0 };
+		uint64_t reuseCount{ 0 };
+		/** @brief Total time spent recording, and the estimated time saved by reuse in ms */
+		double recordTime{ 0.0 };
+		double savedTime{ 0.0 };
+
+		/** @brief Percentage of frames that reused their command buffer */
+		float reuseRate() const;
+		void writeJson(std::ostream& os) const;
+
+	private:
+		struct Recording
+		{
+			bool valid{ false };
+			uint32_t imageIndex{ 0 };
+			uint64_t key{ 0 };
+			uint64_t generation{ 0 };
+		};
+		std::vector<Recording> recordings;
+		uint64_t generation{ 0 };
+	};
+}
@@ -0,0 +1,308 @@
+/*
+* Vulkan growable descriptor allocator
+*
+* Allocates descriptor sets from a list of pools that grows when a pool runs out of memory, and updates sets through cached descriptor update templates
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanDescriptorAllocator.h"
+#include "VulkanDevice.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace vks
+{
+	/**
+	* Set up the allocator, pools are created on first use
+	*
+	* @param device Device to allocate the pools from
+	* @param poolRatios Descriptor types and their count per set
+	* @param setsPerPool Number of sets in the first pool
+	*/
+	void DescriptorAllocator::prepare(VulkanDevice* device, const std::vector<PoolSizeRatio>& poolRatios, uint32_t setsPerPool)
+	{
+		this->device = device;
+		this->setsPerPool = setsPerPool;
+		this->poolRatios = poolRatios;
+		if (this->poolRatios.empty())
+		{
+			this->poolRatios = {
+				{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f },
+				{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+				{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+				{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
+				{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f },
+				{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1.0f },
+				{ VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1.0f },
+				{ VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1.0f },
+			};
+			// Pools may only contain acceleration structures if the extension has been enabled
+			if (device->extensionEnabled(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME))
+			{
+				this->poolRatios.push_back({ VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, 1.0f });
+			}
+		}
+		if (device->extensionEnabled(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+		{
+			VkDevice logicalDevice = device->logicalDevice;
+			vkCreateDescriptorUpdateTemplateKHR = reinterpret_cast<PFN_vkCreateDescriptorUpdateTemplateKHR>(vkGetDeviceProcAddr(logicalDevice, "vkCreateDescriptorUpdateTemplateKHR"));
+			vkDestroyDescriptorUpdateTemplateKHR = reinterpret_cast<PFN_vkDestroyDescriptorUpdateTemplateKHR>(vkGetDeviceProcAddr(logicalDevice, "vkDestroyDescriptorUpdateTemplateKHR"));
+			vkUpdateDescriptorSetWithTemplateKHR = reinterpret_cast<PFN_vkUpdateDescriptorSetWithTemplateKHR>(vkGetDeviceProcAddr(logicalDevice, "vkUpdateDescriptorSetWithTemplateKHR"));
+		}
+	}
+
+	void DescriptorAllocator::destroy()
+	{
+		if (!device)
+		{
+			return;
+		}
+		VkDevice logicalDevice = device->logicalDevice;
+		for (VkDescriptorPool pool : readyPools)
+		{
+			vkDestroyDescriptorPool(logicalDevice, pool, nullptr);
+		}
+		for (VkDescriptorPool pool : fullPools)
+		{
+			vkDestroyDescriptorPool(logicalDevice, pool, nullptr);
+		}
+		readyPools.clear();
+		fullPools.clear();
+		for (auto& [key, updateTemplate] : updateTemplates)
+		{
+			vkDestroyDescriptorUpdateTemplateKHR(logicalDevice, updateTemplate, nullptr);
+		}
+		updateTemplates.clear();
+		allocatedSets = 0;
+		device = nullptr;
+	}
+
+	/**
+	* Allocate a descriptor set
+	*
+	* @param layout Layout of the set
+	* @param descriptorSet Pointer to the handle of the allocated set
+	* @param pNext (Optional) Extension structure of the allocation, e.g. variable descriptor counts
+	*
+	* @return VK_SUCCESS if the set has been allocated
+	*/
+	VkResult DescriptorAllocator::allocate(VkDescriptorSetLayout layout, VkDescriptorSet* descriptorSet, const void* pNext)
+	{
+		return allocate(layout, {}, descriptorSet, pNext);
+	}
+
+	/**
+	* Allocate a descriptor set, retrying with a pool that fits the layout if the current pool is exhausted
+	*
+	* @param layout Layout of the set
+	* @param bindings Bindings the layout has been created with
+	* @param descriptorSet Pointer to the handle of the allocated set
+	* @param pNext (Optional) Extension structure of the allocation, e.g. variable descriptor counts
+	*
+	* @return VK_SUCCESS if the set has been allocated
+	*/
+	VkResult DescriptorAllocator::allocate(VkDescriptorSetLayout layout, const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSet* descriptorSet, const void* pNext)
+	{
+		assert(device);
+		VkDescriptorPool pool = getPool();
+		VkDescriptorSetAllocateInfo allocInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.pNext = pNext,
+			.descriptorPool = pool,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &layout
+		};
+		VkResult result = vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, descriptorSet);
+		if ((result == VK_ERROR_OUT_OF_POOL_MEMORY) || (result == VK_ERROR_FRAGMENTED_POOL))
+		{
+			// Retire the exhausted pool and retry with a new one, other ready pools may be just as exhausted
+			fullPools.push_back(pool);
+			readyPools.pop_back();
+			allocInfo.descriptorPool = addPool(bindings);
+			result = vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, descriptorSet);
+		}
+		if (result == VK_SUCCESS)
+		{
+			allocatedSets++;
+		}
+		return result;
+	}
+
+	void DescriptorAllocator::reset()
+	{
+		readyPools.insert(readyPools.end(), fullPools.begin(), fullPools.end());
+		fullPools.clear();
+		for (VkDescriptorPool pool : readyPools)
+		{
+			VK_CHECK_RESULT(vkResetDescriptorPool(device->logicalDevice, pool, 0));
+		}
+		allocatedSets = 0;
+	}
+
+	void DescriptorAllocator::update(VkDescriptorSet descriptorSet, VkDescriptorSetLayout layout, const std::vector<VkDescriptorSetLayoutBinding>& bindings, const std::vector<DescriptorInfo>& descriptors)
+	{
+		if (vkUpdateDescriptorSetWithTemplateKHR)
+		{
+			std::pair<VkDescriptorSetLayout, std::vector<uint32_t>> key{ layout, {} };
+			for (const VkDescriptorSetLayoutBinding& binding : bindings)
+			{
+				key.second.insert(key.second.end(), { binding.binding, static_cast<uint32_t>(binding.descriptorType), binding.descriptorCount });
+			}
+			VkDescriptorUpdateTemplateKHR& updateTemplate = updateTemplates[key];
+			if (!updateTemplate)
+			{
+				// Descriptors are tightly packed DescriptorInfo entries, one after another for all bindings
+				std::vector<VkDescriptorUpdateTemplateEntryKHR> entries;
+				size_t offset = 0;
+				for (const VkDescriptorSetLayoutBinding& binding : bindings)
+				{
+					entries.push_back({
+						.dstBinding = binding.binding,
+						.dstArrayElement = 0,
+						.descriptorCount = binding.descriptorCount,
+						.descriptorType = binding.descriptorType,
+						.offset = offset,
+						.stride = sizeof(DescriptorInfo)
+					});
+					offset += binding.descriptorCount * sizeof(DescriptorInfo);
+				}
+				VkDescriptorUpdateTemplateCreateInfoKHR templateCI{
+					.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR,
+					.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size()),
+					.pDescriptorUpdateEntries = entries.data(),
+					.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR,
+					.descriptorSetLayout = layout
+				};
+				VK_CHECK_RESULT(vkCreateDescriptorUpdateTemplateKHR(device->logicalDevice, &templateCI, nullptr, &updateTemplate));
+			}
+			vkUpdateDescriptorSetWithTemplateKHR(device->logicalDevice, descriptorSet, updateTemplate, descriptors.data());
+			templateUpdates++;
+			return;
+		}
+
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets;
+		writeDescriptorSets.reserve(bindings.size());
+		const DescriptorInfo* descriptor = descriptors.data();
+		for (const VkDescriptorSetLayoutBinding& binding : bindings)
+		{
+			VkWriteDescriptorSet writeDescriptorSet{
+				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				.dstSet = descriptorSet,
+				.dstBinding = binding.binding,
+				.descriptorCount = 1,
+				.descriptorType = binding.descriptorType,
+			};
+			// Image and buffer infos are read with the stride of their own type, which may be smaller than DescriptorInfo, so arrays are written one element at a time
+			for (uint32_t i = 0; i < binding.descriptorCount; i++, descriptor++)
+			{
+				writeDescriptorSet.dstArrayElement = i;
+				switch (binding.descriptorType)
+				{
+				case VK_DESCRIPTOR_TYPE_SAMPLER:
+				case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+				case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+				case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+				case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+					writeDescriptorSet.pImageInfo = &descriptor->image;
+					break;
+				case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+				case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+					writeDescriptorSet.pTexelBufferView = &descriptor->texelBufferView;
+					break;
+				default:
+					writeDescriptorSet.pBufferInfo = &descriptor->buffer;
+					break;
+				}
+				writeDescriptorSets.push_back(writeDescriptorSet);
+			}
+		}
+		vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+
+	void DescriptorAllocator::forget(VkDescriptorSetLayout layout)
+	{
+		for (auto it = updateTemplates.begin(); it != updateTemplates.end();)
+		{
+			if (it->first.first == layout)
+			{
+				vkDestroyDescriptorUpdateTemplateKHR(device->logicalDevice, it->second, nullptr);
+				it = updateTemplates.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	uint32_t DescriptorAllocator::poolCount() const
+	{
+		return static_cast<uint32_t>(readyPools.size() + fullPools.size());
+	}
+
+	VkDescriptorPool DescriptorAllocator::getPool()
+	{
+		if (readyPools.empty())
+		{
+			return addPool({});
+		}
+		return readyPools.back();
+	}
+
+	VkDescriptorPool DescriptorAllocator::addPool(const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+	{
+		readyPools.push_back(createPool(setsPerPool, bindings));
+		setsPerPool = std::min(setsPerPool * 2, maxSetsPerPool);
+		return readyPools.back();
+	}
+
+	/**
+	* Create a pool with descriptor counts from the ratios
+	*
+	* @param setCount Number of sets in the pool
+	* @param bindings Bindings of a layout, the count of each type is raised to at least what one set of the layout requires, types missing from the ratios are added
+	*/
+	VkDescriptorPool DescriptorAllocator::createPool(uint32_t setCount, const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+	{
+		std::vector<VkDescriptorPoolSize> poolSizes;
+		for (const PoolSizeRatio& poolRatio : poolRatios)
+		{
+			poolSizes.push_back({ .type = poolRatio.type, .descriptorCount = std::max(1u, static_cast<uint32_t>(poolRatio.ratio * setCount)) });
+		}
+		std::map<VkDescriptorType, uint32_t> layoutCounts;
+		for (const VkDescriptorSetLayoutBinding& binding : bindings)
+		{
+			layoutCounts[binding.descriptorType] += binding.descriptorCount;
+		}
+		for (const auto& [type, count] : layoutCounts)
+		{
+			// Inline uniform blocks also need the block count chained to the pool, which the ratios don't cover
+			if (type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK)
+			{
+				continue;
+			}
+			auto poolSize = std::find_if(poolSizes.begin(), poolSizes.end(), [type](const VkDescriptorPoolSize& size) { return size.type == type; });
+			if (poolSize == poolSizes.end())
+			{
+				poolSizes.push_back({ .type = type, .descriptorCount = count });
+			}
+			else
+			{
+				poolSize->descriptorCount = std::max(poolSize->descriptorCount, count);
+			}
+		}
+		VkDescriptorPoolCreateInfo descriptorPoolCI{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			.maxSets = setCount,
+			.poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+			.pPoolSizes = poolSizes.data()
+		};
+		VkDescriptorPool pool;
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolCI, nullptr, &pool));
+		return pool;
+	}
+}
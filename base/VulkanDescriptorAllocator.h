@@ -0,0 +1,108 @@
+/*
+* Vulkan growable descriptor allocator
+*
+* Allocates descriptor sets from a list of pools that grows when a pool runs out of memory, and updates sets through cached descriptor update templates
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	struct VulkanDevice;
+
+	/** @brief Descriptor info for a single descriptor in a set update, matches the layout expected by update templates */
+	struct DescriptorInfo
+	{
+		union
+		{
+			VkDescriptorImageInfo image;
+			VkDescriptorBufferInfo buffer;
+			VkBufferView texelBufferView;
+		};
+
+		DescriptorInfo(const VkDescriptorImageInfo& image) : image(image) {}
+		DescriptorInfo(const VkDescriptorBufferInfo& buffer) : buffer(buffer) {}
+		DescriptorInfo(VkBufferView texelBufferView) : texelBufferView(texelBufferView) {}
+	};
+
+	/**
+	* @brief Allocates descriptor sets without having to size a descriptor pool up front
+	* Pools are created with descriptor counts proportional to their number of sets. If an allocation fails because a pool is exhausted, a new pool with twice as many sets is added and the allocation is retried
+	* If the layout's bindings are passed, the new pool also fits the layout's descriptors, so layouts with types missing from the ratios or with more descriptors than a pool holds can be allocated
+	* reset() returns all sets at once and keeps the pools, so an allocator per frame in flight can be used for sets that are rebuilt every frame
+	*/
+	class DescriptorAllocator
+	{
+	public:
+		/** @brief Number of descriptors of a type per set in a pool */
+		struct PoolSizeRatio
+		{
+			VkDescriptorType type;
+			float ratio;
+		};
+
+		/** @brief Upper limit for the number of sets per pool when growing */
+		static constexpr uint32_t maxSetsPerPool = 4096;
+
+		/**
+		* @param poolRatios Descriptor types and their count per set, defaults to the types used by the examples
+		* @param setsPerPool Number of sets in the first pool
+		*/
+		void prepare(VulkanDevice* device, const std::vector<PoolSizeRatio>& poolRatios = {}, uint32_t setsPerPool = 32);
+		/** @brief Destroys all pools (freeing all sets) and update templates */
+		void destroy();
+
+		/**
+		* @brief Allocates a set from the current pool, growing the pool list if required
+		* @return VK_SUCCESS, or the error of the retry with a new pool (e.g. VK_ERROR_OUT_OF_POOL_MEMORY if the layout doesn't fit a pool sized from the ratios)
+		*/
+		VkResult allocate(VkDescriptorSetLayout layout, VkDescriptorSet* descriptorSet, const void* pNext = nullptr);
+		/** @brief Allocates a set, a pool added for the retry holds at least the descriptors of the layout's bindings */
+		VkResult allocate(VkDescriptorSetLayout layout, const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSet* descriptorSet, const void* pNext = nullptr);
+		/** @brief Returns all sets allocated from the allocator, the sets must no longer be in use by the device */
+		void reset();
+
+		/**
+		* @brief Writes all descriptors of a set
+		* Uses a descriptor update template created once per layout if VK_KHR_descriptor_update_template is enabled, falls back to vkUpdateDescriptorSets otherwise
+		* Templates are cached per layout handle and list of bindings. A destroyed layout's handle may be reused by a new layout, so call forget() before destroying a layout that has been passed to update() while the allocator stays in use
+		* @param bindings Bindings of the layout the set was allocated with that are written, may be a subset of the layout's bindings
+		* @param descriptors One entry per descriptor, in the order of bindings and array elements
+		*/
+		void update(VkDescriptorSet descriptorSet, VkDescriptorSetLayout layout, const std::vector<VkDescriptorSetLayoutBinding>& bindings, const std::vector<DescriptorInfo>& descriptors);
+		/** @brief Destroys the update templates created for a layout, must be called before the layout is destroyed if the allocator is kept */
+		void forget(VkDescriptorSetLayout layout);
+
+		/** @brief Number of pools, allocated sets and template based updates since prepare (or the last reset for sets) */
+		uint32_t poolCount() const;
+		uint32_t allocatedSets{ 0 };
+		uint64_t templateUpdates{ 0 };
+
+	private:
+		VulkanDevice* device{ nullptr };
+		std::vector<PoolSizeRatio> poolRatios;
+		uint32_t setsPerPool{ 0 };
+		// Pools with free space and pools that failed an allocation, both are moved back to readyPools by reset()
+		std::vector<VkDescriptorPool> readyPools;
+		std::vector<VkDescriptorPool> fullPools;
+		// Keyed by layout and the binding, type and count of each written binding
+		std::map<std::pair<VkDescriptorSetLayout, std::vector<uint32_t>>, VkDescriptorUpdateTemplateKHR> updateTemplates;
+		PFN_vkCreateDescriptorUpdateTemplateKHR vkCreateDescriptorUpdateTemplateKHR{ nullptr };
+		PFN_vkDestroyDescriptorUpdateTemplateKHR vkDestroyDescriptorUpdateTemplateKHR{ nullptr };
+		PFN_vkUpdateDescriptorSetWithTemplateKHR vkUpdateDescriptorSetWithTemplateKHR{ nullptr };
+
+		VkDescriptorPool getPool();
+		VkDescriptorPool addPool(const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+		VkDescriptorPool createPool(uint32_t setCount, const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+	};
+}
@@ -34,6 +34,7 @@ VulkanDevice::VulkanDevice(VkPhysicalDevice physicalDevice) {
   vkGetPhysicalDeviceFeatures(physicalDevice, &features);
   // Memory properties are used regularly for creating all kinds of buffers
   vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+  memoryTracker.init(physicalDevice, memoryProperties);
   // Queue family properties, used for setting up requested queues upon device
   // creation
   uint32_t queueFamilyCount;
@@ -66,6 +67,9 @@ VulkanDevice::VulkanDevice(VkPhysicalDevice physicalDevice) {
  * @note Frees the logical device
  */
 VulkanDevice::~VulkanDevice() {
+  uploadManager.destroy();
+  immediateContext.destroy();
+  memoryAllocator.destroy();
   if (commandPool) {
     vkDestroyCommandPool(logicalDevice, commandPool, nullptr);
   }
@@ -297,6 +301,8 @@ VkResult VulkanDevice::createLogicalDevice(
   }
 
   this->enabledFeatures = enabledFeatures;
+  this->enabledExtensions.assign(deviceExtensions.begin(),
+                                 deviceExtensions.end());
 
   VkResult result = vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr,
                                    &logicalDevice);
@@ -307,9 +313,115 @@ VkResult VulkanDevice::createLogicalDevice(
   // Create a default command pool for graphics command buffers
   commandPool = createCommandPool(queueFamilyIndices.graphics);
 
+  memoryAllocator.init(logicalDevice, properties, memoryProperties,
+                       &memoryTracker);
+  immediateContext.prepare(this);
+
   return result;
 }
 
+/**
+ * Allocate device memory and account it in the memory tracker
+ *
+ * @param allocateInfo Memory allocation info passed to vkAllocateMemory
+ * @param memory Pointer to the memory handle acquired by the function
+ * @param tag Subsystem the allocation is accounted to
+ *
+ * @return VkResult of the allocation
+ */
+VkResult VulkanDevice::allocateMemory(const VkMemoryAllocateInfo* allocateInfo,
+                                      VkDeviceMemory* memory,
+                                      MemoryTag tag) {
+  VkResult result =
+      vkAllocateMemory(logicalDevice, allocateInfo, nullptr, memory);
+  if (result == VK_SUCCESS) {
+    memoryTracker.track(*memory, allocateInfo->allocationSize,
+                        allocateInfo->memoryTypeIndex, tag);
+  }
+  return result;
+}
+
+/**
+ * Free device memory and remove it from the memory tracker
+ *
+ * @param memory Memory handle to free (may be VK_NULL_HANDLE)
+ */
+void VulkanDevice::freeMemory(VkDeviceMemory memory) {
+  if (memory == VK_NULL_HANDLE) {
+    return;
+  }
+  memoryTracker.untrack(memory);
+  vkFreeMemory(logicalDevice, memory, nullptr);
+}
+
+/**
+ * Sub-allocate memory for a buffer and bind it
+ *
+ * @param buffer Buffer to allocate memory for
+ * @param memoryPropertyFlags Memory properties for the buffer
+ * @param tag Subsystem the allocation is accounted to
+ * @param allocation Receives the allocated range, host visible memory is
+ * persistently mapped at allocation->mapped
+ * @param deviceAddress True if the buffer uses shader device addresses
+ *
+ * @return VkResult of the allocation or binding
+ */
+VkResult VulkanDevice::allocateBufferMemory(
+    VkBuffer buffer,
+    VkMemoryPropertyFlags memoryPropertyFlags,
+    MemoryTag tag,
+    MemoryAllocation* allocation,
+    bool deviceAddress) {
+  VkMemoryRequirements memReqs;
+  vkGetBufferMemoryRequirements(logicalDevice, buffer, &memReqs);
+  VkResult result = memoryAllocator.allocate(
+      memReqs, getMemoryType(memReqs.memoryTypeBits, memoryPropertyFlags), true,
+      deviceAddress, tag, *allocation);
+  if (result != VK_SUCCESS) {
+    return result;
+  }
+  return vkBindBufferMemory(logicalDevice, buffer, allocation->memory,
+                            allocation->offset);
+}
+
+/**
+ * Sub-allocate memory for an image and bind it
+ *
+ * @param image Image to allocate memory for
+ * @param memoryPropertyFlags Memory properties for the image
+ * @param tag Subsystem the allocation is accounted to
+ * @param allocation Receives the allocated range
+ * @param linear True if the image uses linear tiling
+ *
+ * @return VkResult of the allocation or binding
+ */
+VkResult VulkanDevice::allocateImageMemory(
+    VkImage image,
+    VkMemoryPropertyFlags memoryPropertyFlags,
+    MemoryTag tag,
+    MemoryAllocation* allocation,
+    bool linear) {
+  VkMemoryRequirements memReqs;
+  vkGetImageMemoryRequirements(logicalDevice, image, &memReqs);
+  VkResult result = memoryAllocator.allocate(
+      memReqs, getMemoryType(memReqs.memoryTypeBits, memoryPropertyFlags),
+      linear, false, tag, *allocation);
+  if (result != VK_SUCCESS) {
+    return result;
+  }
+  return vkBindImageMemory(logicalDevice, image, allocation->memory,
+                           allocation->offset);
+}
+
+/**
+ * Return memory sub-allocated with allocateBufferMemory or allocateImageMemory
+ *
+ * @param allocation Allocation to free (ignored if not valid), reset afterwards
+ */
+void VulkanDevice::freeAllocation(MemoryAllocation& allocation) {
+  memoryAllocator.free(allocation);
+}
+
 /**
  * Create a buffer on the device
  *
@@ -355,7 +467,9 @@ VkResult VulkanDevice::createBuffer(VkBufferUsageFlags usageFlags,
     allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
     memAlloc.pNext = &allocFlagsInfo;
   }
-  VK_CHECK_RESULT(vkAllocateMemory(logicalDevice, &memAlloc, nullptr, memory));
+  VK_CHECK_RESULT(allocateMemory(
+      &memAlloc, memory,
+      MemoryTracker::tagForBufferUsage(usageFlags, memoryPropertyFlags)));
 
   // If a pointer to the buffer data has been passed, map the buffer and copy
   // over the data
@@ -409,24 +523,18 @@ VkResult VulkanDevice::createBuffer(VkBufferUsageFlags usageFlags,
   VK_CHECK_RESULT(vkCreateBuffer(logicalDevice, &bufferCreateInfo, nullptr,
                                  &buffer->buffer));
 
-  // Create the memory backing up the buffer handle
+  // Sub-allocate the memory backing up the buffer handle and attach it to the
+  // buffer object. If the buffer has VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+  // set, the memory is taken from blocks allocated with the device address flag
   VkMemoryRequirements memReqs;
-  VkMemoryAllocateInfo memAlloc = vks::initializers::memoryAllocateInfo();
   vkGetBufferMemoryRequirements(logicalDevice, buffer->buffer, &memReqs);
-  memAlloc.allocationSize = memReqs.size;
-  // Find a memory type index that fits the properties of the buffer
-  memAlloc.memoryTypeIndex =
-      getMemoryType(memReqs.memoryTypeBits, memoryPropertyFlags);
-  // If the buffer has VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT set we also
-  // need to enable the appropriate flag during allocation
-  VkMemoryAllocateFlagsInfoKHR allocFlagsInfo{};
-  if (usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
-    allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
-    allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
-    memAlloc.pNext = &allocFlagsInfo;
-  }
-  VK_CHECK_RESULT(
-      vkAllocateMemory(logicalDevice, &memAlloc, nullptr, &buffer->memory));
+  VK_CHECK_RESULT(allocateBufferMemory(
+      buffer->buffer, memoryPropertyFlags,
+      MemoryTracker::tagForBufferUsage(usageFlags, memoryPropertyFlags),
+      &buffer->allocation,
+      (usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0));
+  buffer->memory = buffer->allocation.memory;
+  buffer->memoryAllocator = &memoryAllocator;
 
   buffer->alignment = memReqs.alignment;
   buffer->size = size;
@@ -447,8 +555,7 @@ VkResult VulkanDevice::createBuffer(VkBufferUsageFlags usageFlags,
   // Initialize a default descriptor that covers the whole buffer size
   buffer->setupDescriptor();
 
-  // Attach the memory to the buffer object
-  return buffer->bind();
+  return VK_SUCCESS;
 }
 
 /**
@@ -522,11 +629,22 @@ VkCommandPool VulkanDevice::createCommandPool(
 VkCommandBuffer VulkanDevice::createCommandBuffer(VkCommandBufferLevel level,
                                                   VkCommandPool pool,
                                                   bool begin) {
-  VkCommandBufferAllocateInfo cmdBufAllocateInfo =
-      vks::initializers::commandBufferAllocateInfo(pool, level, 1);
-  VkCommandBuffer cmdBuffer;
-  VK_CHECK_RESULT(
-      vkAllocateCommandBuffers(logicalDevice, &cmdBufAllocateInfo, &cmdBuffer));
+  VkCommandBuffer cmdBuffer{VK_NULL_HANDLE};
+  if (pool == commandPool && level == VK_COMMAND_BUFFER_LEVEL_PRIMARY) {
+    // The default pool allows resetting individual command buffers, so a
+    // recycled one is reset implicitly when recording starts
+    std::lock_guard<std::mutex> lock(recycledCommandBuffersMutex);
+    if (!recycledCommandBuffers.empty()) {
+      cmdBuffer = recycledCommandBuffers.back();
+      recycledCommandBuffers.pop_back();
+    }
+  }
+  if (cmdBuffer == VK_NULL_HANDLE) {
+    VkCommandBufferAllocateInfo cmdBufAllocateInfo =
+        vks::initializers::commandBufferAllocateInfo(pool, level, 1);
+    VK_CHECK_RESULT(vkAllocateCommandBuffers(logicalDevice,
+                                             &cmdBufAllocateInfo, &cmdBuffer));
+  }
   // If requested, also start recording for the new command buffer
   if (begin) {
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -548,7 +666,7 @@ VkCommandBuffer VulkanDevice::createCommandBuffer(VkCommandBufferLevel level,
  * @param queue Queue to submit the command buffer to
  * @param pool Command pool on which the command buffer has been created
  * @param free (Optional) Free the command buffer once it has been submitted
- * (Defaults to true)
+ * (Defaults to true), command buffers of the default pool are recycled instead
  *
  * @note The queue that the command buffer is submitted to must be from the same
  * family index as the pool it was allocated from
@@ -563,23 +681,29 @@ void VulkanDevice::flushCommandBuffer(VkCommandBuffer commandBuffer,
   }
 
   VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
+  // Recorded uploads may be read by the command buffer, so they must be
+  // submitted before it
+  uploadManager.flush();
 
   VkSubmitInfo submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
                           .commandBufferCount = 1,
                           .pCommandBuffers = &commandBuffer};
-  // Create fence to ensure that the command buffer has finished executing
-  VkFenceCreateInfo fenceInfo =
-      vks::initializers::fenceCreateInfo(VK_FLAGS_NONE);
-  VkFence fence;
-  VK_CHECK_RESULT(vkCreateFence(logicalDevice, &fenceInfo, nullptr, &fence));
+  // Fence to ensure that the command buffer has finished executing, taken
+  // from the immediate context's pool instead of being created for every flush
+  VkFence fence = immediateContext.acquireFence();
   // Submit to the queue
-  VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, fence));
+  VK_CHECK_RESULT(queueSubmit(queue, 1, &submitInfo, fence));
   // Wait for the fence to signal that command buffer has finished executing
   VK_CHECK_RESULT(vkWaitForFences(logicalDevice, 1, &fence, VK_TRUE,
                                   DEFAULT_FENCE_TIMEOUT));
-  vkDestroyFence(logicalDevice, fence, nullptr);
+  immediateContext.releaseFence(fence);
   if (free) {
-    vkFreeCommandBuffers(logicalDevice, pool, 1, &commandBuffer);
+    if (pool == commandPool) {
+      std::lock_guard<std::mutex> lock(recycledCommandBuffersMutex);
+      recycledCommandBuffers.push_back(commandBuffer);
+    } else {
+      vkFreeCommandBuffers(logicalDevice, pool, 1, &commandBuffer);
+    }
   }
 }
 
@@ -589,6 +713,43 @@ void VulkanDevice::flushCommandBuffer(VkCommandBuffer commandBuffer,
   return flushCommandBuffer(commandBuffer, queue, commandPool, free);
 }
 
+/**
+ * Get the lock that serializes access to a queue
+ *
+ * @param queue Queue to get the lock for
+ *
+ * @note Submission, presentation and waiting for idle on a queue require
+ * external synchronization, so anything that does these from more than one
+ * thread must hold this lock
+ * @return Mutex that lives as long as the device
+ */
+std::mutex& VulkanDevice::queueMutex(VkQueue queue) {
+  std::lock_guard<std::mutex> lock(queueMutexesMutex);
+  std::unique_ptr<std::mutex>& mutex = queueMutexes[queue];
+  if (!mutex) {
+    mutex = std::make_unique<std::mutex>();
+  }
+  return *mutex;
+}
+
+/**
+ * Submit to a queue while holding its lock
+ *
+ * @param queue Queue to submit to
+ * @param submitCount Number of submissions
+ * @param submits Submissions
+ * @param fence (Optional) Fence signaled once all submissions have finished
+ *
+ * @return VkResult of the submission
+ */
+VkResult VulkanDevice::queueSubmit(VkQueue queue,
+                                   uint32_t submitCount,
+                                   const VkSubmitInfo* submits,
+                                   VkFence fence) {
+  std::lock_guard<std::mutex> lock(queueMutex(queue));
+  return vkQueueSubmit(queue, submitCount, submits, fence);
+}
+
 /**
  * Check if an extension is supported by the (physical device)
  *
@@ -602,6 +763,18 @@ bool VulkanDevice::extensionSupported(std::string extension) {
                     extension) != supportedExtensions.end());
 }
 
+/**
+ * Check if an extension has been enabled for the logical device
+ *
+ * @param extension Name of the extension to check
+ *
+ * @return True if the extension was passed to vkCreateDevice
+ */
+bool VulkanDevice::extensionEnabled(std::string extension) {
+  return (std::find(enabledExtensions.begin(), enabledExtensions.end(),
+                    extension) != enabledExtensions.end());
+}
+
 /**
  * Select the best-fit depth format for this device from a list of possible
  * depth (and stencil) formats
@@ -11,11 +11,18 @@
 #pragma once
 
 #include "VulkanBuffer.h"
+#include "VulkanImmediateContext.h"
+#include "VulkanMemoryAllocator.h"
+#include "VulkanMemoryTracker.h"
+#include "VulkanUploadManager.h"
 #include "VulkanTools.h"
 #include "vulkan/vulkan.h"
 #include <algorithm>
 #include <assert.h>
 #include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace vks
 {
@@ -37,8 +44,24 @@ struct VulkanDevice
 	std::vector<VkQueueFamilyProperties> queueFamilyProperties{};
 	/** @brief List of extensions supported by the device */
 	std::vector<std::string> supportedExtensions{};
+	/** @brief List of extensions enabled for the logical device */
+	std::vector<std::string> enabledExtensions{};
+	/** @brief Accounts device memory allocated through allocateMemory per heap, memory type and subsystem */
+	MemoryTracker memoryTracker;
+	/** @brief Sub-allocates memory for buffers and images created by the base helpers from larger device memory blocks */
+	MemoryAllocator memoryAllocator;
+	/** @brief Streams buffer and image data to the device through a staging ring on the transfer queue */
+	UploadManager uploadManager;
+	/** @brief Recycled command buffers and fences for one-shot submissions */
+	ImmediateContext immediateContext;
 	/** @brief Default command pool for the graphics queue family index */
 	VkCommandPool commandPool{ VK_NULL_HANDLE };;
+	/** @brief Primary command buffers of the default pool released by flushCommandBuffer, handed out again by createCommandBuffer */
+	std::vector<VkCommandBuffer> recycledCommandBuffers;
+	std::mutex recycledCommandBuffersMutex;
+	/** @brief Per-queue locks for submission and presentation, queues are shared by the frame submission, uploads and one-shot command buffers that may run on loader threads */
+	std::unordered_map<VkQueue, std::unique_ptr<std::mutex>> queueMutexes;
+	std::mutex queueMutexesMutex;
 	/** @brief Contains queue family indices */
 	struct
 	{
@@ -55,6 +78,11 @@ struct VulkanDevice
 	uint32_t        getMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties, VkBool32 *memTypeFound = nullptr) const;
 	uint32_t        getQueueFamilyIndex(VkQueueFlags queueFlags) const;
 	VkResult        createLogicalDevice(VkPhysicalDeviceFeatures enabledFeatures, std::vector<const char *> enabledExtensions, void *pNextChain, bool useSwapChain = true, VkQueueFlags requestedQueueTypes = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+	VkResult        allocateMemory(const VkMemoryAllocateInfo *allocateInfo, VkDeviceMemory *memory, MemoryTag tag = MemoryTag::Other);
+	void            freeMemory(VkDeviceMemory memory);
+	VkResult        allocateBufferMemory(VkBuffer buffer, VkMemoryPropertyFlags memoryPropertyFlags, MemoryTag tag, MemoryAllocation *allocation, bool deviceAddress = false);
+	VkResult        allocateImageMemory(VkImage image, VkMemoryPropertyFlags memoryPropertyFlags, MemoryTag tag, MemoryAllocation *allocation, bool linear = false);
+	void            freeAllocation(MemoryAllocation &allocation);
 	VkResult        createBuffer(VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory, void *data = nullptr);
 	VkResult        createBuffer(VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags, vks::Buffer *buffer, VkDeviceSize size, void *data = nullptr);
 	void            copyBuffer(vks::Buffer *src, vks::Buffer *dst, VkQueue queue, VkBufferCopy *copyRegion = nullptr);
@@ -63,7 +91,10 @@ struct VulkanDevice
 	VkCommandBuffer createCommandBuffer(VkCommandBufferLevel level, bool begin = false);
 	void            flushCommandBuffer(VkCommandBuffer commandBuffer, VkQueue queue, VkCommandPool pool, bool free = true);
 	void            flushCommandBuffer(VkCommandBuffer commandBuffer, VkQueue queue, bool free = true);
+	std::mutex&     queueMutex(VkQueue queue);
+	VkResult        queueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *submits, VkFence fence);
 	bool            extensionSupported(std::string extension);
+	bool            extensionEnabled(std::string extension);
 	VkFormat        getSupportedDepthFormat(bool checkSamplingSupport);
 };
 }        // namespace vks
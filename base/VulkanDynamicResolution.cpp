@@ -0,0 +1,183 @@
+/*
+* Vulkan dynamic resolution
+*
+* Scales the resolution an example renders its scene at, so the GPU time of a frame approaches a target frame time
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanDynamicResolution.h"
+#include "VulkanDevice.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vks
+{
+	/**
+	* Create the timestamp queries
+	*
+	* @param device Device whose graphics queue the timed commands are submitted to
+	* @param frameCount Number of frames in flight
+	* @param targetFrameTime GPU frame time in ms the scale is adjusted for, zero disables scaling
+	*/
+	void DynamicResolution::prepare(VulkanDevice* device, uint32_t frameCount, float targetFrameTime)
+	{
+		this->device = device;
+		this->targetFrameTime = targetFrameTime;
+		const uint32_t validBits = device->queueFamilyProperties[device->queueFamilyIndices.graphics].timestampValidBits;
+		if ((targetFrameTime <= 0.0f) || (validBits == 0))
+		{
+			return;
+		}
+		timestampMask = (validBits >= 64) ? UINT64_MAX : ((1ull << validBits) - 1);
+		timestampPeriod = device->properties.limits.timestampPeriod;
+		VkQueryPoolCreateInfo queryPoolCI{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+		queryPoolCI.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCI.queryCount = frameCount * 2;
+		VK_CHECK_RESULT(vkCreateQueryPool(device->logicalDevice, &queryPoolCI, nullptr, &queryPool));
+		pending.assign(frameCount, false);
+		history.fill(scale);
+		enabled = true;
+	}
+
+	void DynamicResolution::destroy()
+	{
+		if (queryPool)
+		{
+			vkDestroyQueryPool(device->logicalDevice, queryPool, nullptr);
+			queryPool = VK_NULL_HANDLE;
+		}
+		enabled = false;
+	}
+
+	void DynamicResolution::beginFrame(uint32_t frameIndex)
+	{
+		if (!enabled || !pending[frameIndex])
+		{
+			return;
+		}
+		pending[frameIndex] = false;
+		std::array<uint64_t, 2> timestamps{};
+		if (vkGetQueryPoolResults(device->logicalDevice, queryPool, frameIndex * 2, 2, sizeof(timestamps), timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+		{
+			return;
+		}
+		const double time = static_cast<double>((timestamps[1] - timestamps[0]) & timestampMask) * timestampPeriod / 1000000.0;
+		gpuTime = (scaleCount == 0) ? time : gpuTime * 0.9 + time * 0.1;
+		if (gpuTime > 0.0)
+		{
+			const float idealScale = scale * static_cast<float>(std::sqrt(targetFrameTime / gpuTime));
+			if (std::abs(idealScale - scale) > 0.02f)
+			{
+				scale = std::clamp(scale + std::clamp(idealScale - scale, -maxStep, maxStep), minScale, maxScale);
+			}
+		}
+		history[historyOffset] = scale;
+		historyOffset = (historyOffset + 1) % historySize;
+		lowestScale = (scaleCount == 0) ? scale : std::min(lowestScale, scale);
+		highestScale = (scaleCount == 0) ? scale : std::max(highestScale, scale);
+		scaleCount++;
+		scaleSum += scale;
+		if (recordScales)
+		{
+			scales.push_back(scale);
+		}
+	}
+
+	void DynamicResolution::beginTiming(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+	{
+		if (!enabled)
+		{
+			return;
+		}
+		vkCmdResetQueryPool(commandBuffer, queryPool, frameIndex * 2, 2);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, frameIndex * 2);
+	}
+
+	void DynamicResolution::endTiming(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+	{
+		if (!enabled)
+		{
+			return;
+		}
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, frameIndex * 2 + 1);
+		pending[frameIndex] = true;
+	}
+
+	VkExtent2D DynamicResolution::scaledExtent(uint32_t width, uint32_t height) const
+	{
+		return {
+			std::max(1u, static_cast<uint32_t>(std::lround(width * scale))),
+			std::max(1u, static_cast<uint32_t>(std::lround(height * scale)))
+		};
+	}
+
+	VkFilter DynamicResolution::upscaleFilter(VkFormat format) const
+	{
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(device->physicalDevice, format, &formatProperties);
+		return (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+	}
+
+	void DynamicResolution::upscale(VkCommandBuffer commandBuffer, VkImage src, VkImageLayout srcLayout, VkExtent2D srcExtent, VkImage dst, VkImageLayout dstLayout, VkExtent2D dstExtent, VkFilter filter) const
+	{
+		const VkImageSubresourceRange subresourceRange{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		// The source has just been rendered, the destination may still be read by the previous frame
+		std::array<VkImageMemoryBarrier, 2> barriers{};
+		barriers[0] = vks::initializers::imageMemoryBarrier();
+		barriers[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		barriers[0].oldLayout = srcLayout;
+		barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barriers[0].image = src;
+		barriers[0].subresourceRange = subresourceRange;
+		barriers[1] = vks::initializers::imageMemoryBarrier();
+		barriers[1].srcAccessMask = 0;
+		barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barriers[1].image = dst;
+		barriers[1].subresourceRange = subresourceRange;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+		VkImageBlit blit{};
+		blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		blit.srcOffsets[1] = { static_cast<int32_t>(srcExtent.width), static_cast<int32_t>(srcExtent.height), 1 };
+		blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		blit.dstOffsets[1] = { static_cast<int32_t>(dstExtent.width), static_cast<int32_t>(dstExtent.height), 1 };
+		vkCmdBlitImage(commandBuffer, src, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, filter);
+
+		barriers[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		barriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barriers[0].newLayout = srcLayout;
+		barriers[1].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		barriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barriers[1].newLayout = dstLayout;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+	}
+
+	void DynamicResolution::writeJson(std::ostream& os, bool frameScales) const
+	{
+		const double mean = (scaleCount == 0) ? 1.0 : scaleSum / static_cast<double>(scaleCount);
+		os << "{\"enabled\": " << (enabled ? "true" : "false");
+		os << ", \"targetFrameTime\": " << targetFrameTime;
+		os << ", \"meanScale\": " << mean;
+		os << ", \"minScale\": " << lowestScale;
+		os << ", \"maxScale\": " << highestScale;
+		if (frameScales && recordScales)
+		{
+			os << ", \"scales\": [";
+			for (size_t i = 0; i < scales.size(); i++)
+			{
+				os << (i > 0 ? ", " : "") << scales[i];
+			}
+			os << "]";
+		}
+		os << "}";
+	}
+}
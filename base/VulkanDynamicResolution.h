@@ -0,0 +1,88 @@
+/*
+* Vulkan dynamic resolution
+*
+* Scales the resolution an example renders its scene at, so the GPU time of a frame approaches a target frame time
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <array>
+#include <ostream>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	struct VulkanDevice;
+
+	/**
+	* @brief Controls the render scale of an example from measured GPU time
+	* Examples render their scene into a target allocated at full resolution, but only into scaledExtent() of it, and upscale() that region to a full resolution image before post-processing and UI
+	* The GPU time between beginTiming() and endTiming() is read back once the frame's fence has been signalled. As the cost of fill rate bound work grows with the number of pixels, the scale moves towards scale * sqrt(target / time) in small steps, with a dead band to avoid oscillating between two resolutions
+	* @note Disabled (scale fixed at 1) if no target has been set or the graphics queue doesn't support timestamps
+	*/
+	class DynamicResolution
+	{
+	public:
+		/** @brief Number of scales kept for the overlay plot */
+		static constexpr uint32_t historySize = 120;
+
+		/** @brief targetFrameTime is in ms, zero disables scaling */
+		void prepare(VulkanDevice* device, uint32_t frameCount, float targetFrameTime);
+		void destroy();
+
+		/** @brief Reads back the GPU time last measured with this frame slot and adjusts the scale, must only be called once that frame's fence has been signalled */
+		void beginFrame(uint32_t frameIndex);
+		/** @brief Encloses the commands whose GPU time is measured, both must be recorded outside of a render pass */
+		void beginTiming(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+		void endTiming(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+		/** @brief Extent to render the scene at for a full resolution of width x height */
+		VkExtent2D scaledExtent(uint32_t width, uint32_t height) const;
+		/** @brief Linear filtering if the format supports it for blits, nearest otherwise */
+		VkFilter upscaleFilter(VkFormat format) const;
+		/**
+		* @brief Blits the srcExtent region of a rendered color image to the whole dstExtent of another image
+		* @param srcLayout Layout src has been rendered to (e.g. a render pass' final layout), it is transitioned back to it after the blit
+		* @param dstLayout Layout dst is left in, its previous contents are discarded
+		*/
+		void upscale(VkCommandBuffer commandBuffer, VkImage src, VkImageLayout srcLayout, VkExtent2D srcExtent, VkImage dst, VkImageLayout dstLayout, VkExtent2D dstExtent, VkFilter filter) const;
+
+		bool enabled{ false };
+		float targetFrameTime{ 0.0f };
+		float minScale{ 0.5f };
+		float maxScale{ 1.0f };
+		/** @brief Max. change of the scale per frame */
+		float maxStep{ 0.05f };
+		float scale{ 1.0f };
+		/** @brief Moving average of the measured GPU time in ms */
+		double gpuTime{ 0.0 };
+
+		/** @brief Most recent scales in a ring starting at historyOffset */
+		std::array<float, historySize> history{};
+		uint32_t historyOffset{ 0 };
+		/** @brief Number, sum and range of the scales of all measured frames */
+		uint64_t scaleCount{ 0 };
+		double scaleSum{ 0.0 };
+		float lowestScale{ 1.0f };
+		float highestScale{ 1.0f };
+		/** @brief If set, the scale of every measured frame is kept in scales, e.g. for benchmark output. Off by default as it grows with every frame */
+		bool recordScales{ false };
+		std::vector<float> scales;
+
+		void writeJson(std::ostream& os, bool frameScales) const;
+
+	private:
+		VulkanDevice* device{ nullptr };
+		VkQueryPool queryPool{ VK_NULL_HANDLE };
+		uint64_t timestampMask{ 0 };
+		double timestampPeriod{ 1.0 };
+		// Frame slots with timestamps written and not yet read back
+		std::vector<bool> pending;
+	};
+}
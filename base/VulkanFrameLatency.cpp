@@ -0,0 +1,133 @@
+/*
+* Vulkan frame latency measurement
+*
+* Measures the time from the start of a frame (when it picks up the latest input) until it has been presented, or until its fence signalled if present wait is not available
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanFrameLatency.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vks
+{
+	/**
+	* Prepare latency measurement
+	*
+	* @param device Logical device used for vkWaitForPresentKHR
+	* @param frameCount Number of frames in flight
+	* @param presentWait True if VK_KHR_present_id and VK_KHR_present_wait have been enabled for the device
+	*/
+	void FrameLatency::prepare(VkDevice device, uint32_t frameCount, bool presentWait)
+	{
+		this->device = device;
+		inputTimes.assign(frameCount, Clock::time_point());
+		inFlight.assign(frameCount, false);
+		if (presentWait)
+		{
+			vkWaitForPresentKHR = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(device, "vkWaitForPresentKHR"));
+		}
+		this->presentWait = presentWait && vkWaitForPresentKHR;
+	}
+
+	void FrameLatency::beginFrame(uint32_t frameIndex, Clock::time_point inputTime)
+	{
+		inputTimes[frameIndex] = inputTime;
+		inFlight[frameIndex] = true;
+	}
+
+	void FrameLatency::frameCompleted(uint32_t frameIndex)
+	{
+		if (!presentWait && inFlight[frameIndex])
+		{
+			addSample(inputTimes[frameIndex]);
+		}
+		inFlight[frameIndex] = false;
+	}
+
+	const void* FrameLatency::present(uint32_t frameIndex)
+	{
+		if (!presentWait || !inFlight[frameIndex])
+		{
+			return nullptr;
+		}
+		presentIdValue = nextPresentId++;
+		pendingPresents.push_back({ presentIdValue, inputTimes[frameIndex] });
+		presentIdInfo = {
+			.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+			.swapchainCount = 1,
+			.pPresentIds = &presentIdValue
+		};
+		return &presentIdInfo;
+	}
+
+	void FrameLatency::poll(VkSwapchainKHR swapchain)
+	{
+		// Presents complete in order, so polling stops at the first one that is still pending
+		while (!pendingPresents.empty())
+		{
+			const VkResult result = vkWaitForPresentKHR(device, swapchain, pendingPresents.front().id, 0);
+			if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR)
+			{
+				addSample(pendingPresents.front().inputTime);
+			}
+			else if (result == VK_TIMEOUT)
+			{
+				break;
+			}
+			// Presents that can no longer complete (e.g. an out of date swapchain) are dropped without a sample
+			pendingPresents.pop_front();
+		}
+	}
+
+	void FrameLatency::reset()
+	{
+		pendingPresents.clear();
+		std::fill(inFlight.begin(), inFlight.end(), false);
+	}
+
+	void FrameLatency::addSample(Clock::time_point inputTime)
+	{
+		const double latency = std::chrono::duration<double, std::milli>(Clock::now() - inputTime).count();
+		recentLatency = (sampleCount == 0) ? latency : recentLatency * 0.9 + latency * 0.1;
+		maxLatency = (sampleCount == 0) ? latency : std::max(maxLatency, latency);
+		sampleCount++;
+		sampleSum += latency;
+		if (recordSamples)
+		{
+			samples.push_back(latency);
+		}
+	}
+
+	/** @brief Returns the given percentile (0..100) of the recorded latencies */
+	double FrameLatency::percentile(double p) const
+	{
+		if (samples.empty())
+		{
+			return 0.0;
+		}
+		std::vector<double> sorted(samples);
+		std::sort(sorted.begin(), sorted.end());
+		size_t index = static_cast<size_t>(std::ceil((p / 100.0) * sorted.size()));
+		return sorted[std::clamp<size_t>(index, 1, sorted.size()) - 1];
+	}
+
+	void FrameLatency::writeJson(std::ostream& os, uint32_t framesInFlight) const
+	{
+		const double mean = (sampleCount == 0) ? 0.0 : sampleSum / static_cast<double>(sampleCount);
+		os << "{\"framesInFlight\": " << framesInFlight;
+		os << ", \"source\": \"" << (presentWait ? "presentWait" : "fence") << "\"";
+		os << ", \"frames\": " << sampleCount;
+		os << ", \"mean\": " << mean;
+		// Median and percentiles need the individual samples
+		if (recordSamples)
+		{
+			os << ", \"median\": " << percentile(50.0) << ", \"p99\": " << percentile(99.0);
+		}
+		os << ", \"max\": " << maxLatency << "}";
+	}
+}
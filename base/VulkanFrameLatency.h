@@ -0,0 +1,78 @@
+/*
+* Vulkan frame latency measurement
+*
+* Measures the time from the start of a frame (when it picks up the latest input) until it has been presented, or until its fence signalled if present wait is not available
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <ostream>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	/**
+	* @brief Input to present latency of the frames in flight
+	* With VK_KHR_present_id and VK_KHR_present_wait every present gets an id, and a frame's latency is taken once vkWaitForPresentKHR reports that id as presented. Pending ids are polled without blocking, as the swapchain must not be accessed from another thread while presenting
+	* Without these extensions the latency ends when the CPU sees the frame's fence signalled, which leaves out the time the image waits for presentation
+	*/
+	class FrameLatency
+	{
+	public:
+		using Clock = std::chrono::high_resolution_clock;
+
+		/** @brief presentWait must only be true if both extensions and their features have been enabled */
+		void prepare(VkDevice device, uint32_t frameCount, bool presentWait);
+
+		/** @brief Records the input time of the frame rendered with the given frame index */
+		void beginFrame(uint32_t frameIndex, Clock::time_point inputTime);
+		/** @brief Called once the fence of the frame index has been waited for, ends the latency of its previous frame without present wait */
+		void frameCompleted(uint32_t frameIndex);
+		/** @brief Returns a VkPresentIdKHR to chain into VkPresentInfoKHR for the frame index, or nullptr without present wait */
+		const void* present(uint32_t frameIndex);
+		/** @brief Ends the latency of all frames that have been presented so far, without blocking */
+		void poll(VkSwapchainKHR swapchain);
+		/** @brief Drops pending presents and frames, e.g. after the swapchain has been recreated */
+		void reset();
+
+		bool presentWait{ false };
+		/** @brief Moving average of the latency in ms for display */
+		double recentLatency{ 0.0 };
+		/** @brief Number, sum and maximum of the latencies of all measured frames in ms */
+		uint64_t sampleCount{ 0 };
+		double sampleSum{ 0.0 };
+		double maxLatency{ 0.0 };
+		/** @brief If set, the latency of every measured frame is kept in samples for the median and percentiles of benchmark output. Off by default as it grows with every frame */
+		bool recordSamples{ false };
+		std::vector<double> samples;
+
+		double percentile(double p) const;
+		void writeJson(std::ostream& os, uint32_t framesInFlight) const;
+
+	private:
+		struct PendingPresent
+		{
+			uint64_t id;
+			Clock::time_point inputTime;
+		};
+
+		VkDevice device{ VK_NULL_HANDLE };
+		PFN_vkWaitForPresentKHR vkWaitForPresentKHR{ nullptr };
+		std::vector<Clock::time_point> inputTimes;
+		std::vector<bool> inFlight;
+		std::deque<PendingPresent> pendingPresents;
+		uint64_t nextPresentId{ 1 };
+		uint64_t presentIdValue{ 0 };
+		VkPresentIdKHR presentIdInfo{};
+
+		void addSample(Clock::time_point inputTime);
+	};
+}
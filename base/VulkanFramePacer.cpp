@@ -0,0 +1,181 @@
+/*
+* Vulkan frame pacing
+*
+* Caps the frame rate with a hybrid sleep and spin wait, and measures the intervals between presents
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanFramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+namespace vks
+{
+	namespace
+	{
+		double standardDeviation(const double* values, size_t count)
+		{
+			if (count < 2)
+			{
+				return 0.0;
+			}
+			const double mean = std::accumulate(values, values + count, 0.0) / static_cast<double>(count);
+			double sumSquares = 0.0;
+			for (size_t i = 0; i < count; i++)
+			{
+				sumSquares += (values[i] - mean) * (values[i] - mean);
+			}
+			return std::sqrt(sumSquares / static_cast<double>(count));
+		}
+	}
+
+	void FramePacer::prepare(float maxFrameRate)
+	{
+		this->maxFrameRate = maxFrameRate;
+		enabled = maxFrameRate > 0.0f;
+		if (enabled)
+		{
+			targetInterval = 1000.0 / maxFrameRate;
+		}
+	}
+
+	void FramePacer::wait()
+	{
+		if (!enabled)
+		{
+			return;
+		}
+		using Milliseconds = std::chrono::duration<double, std::milli>;
+		const Clock::duration interval = std::chrono::duration_cast<Clock::duration>(Milliseconds(targetInterval));
+		Clock::time_point now = Clock::now();
+		if (now > nextFrame + interval)
+		{
+			// First frame, or too far behind to catch up
+			if (nextFrame != Clock::time_point())
+			{
+				missedFrames++;
+			}
+			nextFrame = now + interval;
+			return;
+		}
+		if (now > nextFrame)
+		{
+			missedFrames++;
+		}
+		const Clock::time_point sleepEnd = nextFrame - std::chrono::duration_cast<Clock::duration>(Milliseconds(spinThreshold));
+		if (now < sleepEnd)
+		{
+			std::this_thread::sleep_until(sleepEnd);
+			const Clock::time_point woken = Clock::now();
+			sleepTime += Milliseconds(woken - now).count();
+			sleepOvershoot = std::max(sleepOvershoot * 0.99, Milliseconds(woken - sleepEnd).count());
+			spinThreshold = std::min(sleepOvershoot * 1.5 + 0.1, targetInterval);
+			now = woken;
+		}
+		while (now < nextFrame)
+		{
+			std::this_thread::yield();
+			const Clock::time_point spun = Clock::now();
+			spinTime += Milliseconds(spun - now).count();
+			now = spun;
+		}
+		// Frames stay on the schedule, so the time a frame started late is taken off the next wait
+		nextFrame += interval;
+	}
+
+	void FramePacer::presented()
+	{
+		const Clock::time_point now = Clock::now();
+		if (lastPresent != Clock::time_point())
+		{
+			const double interval = std::chrono::duration<double, std::milli>(now - lastPresent).count();
+			intervalCount++;
+			intervalSum += interval;
+			intervalSumSquares += interval * interval;
+			maxInterval = std::max(maxInterval, interval);
+			histogram[std::min(static_cast<size_t>(interval * 10.0), histogram.size() - 1)]++;
+			if (recordIntervals)
+			{
+				presentIntervals.push_back(interval);
+			}
+			recentIntervals[recentCount % recentSize] = interval;
+			recentCount++;
+		}
+		lastPresent = now;
+	}
+
+	void FramePacer::resume()
+	{
+		nextFrame = Clock::time_point();
+		lastPresent = Clock::time_point();
+	}
+
+	double FramePacer::meanInterval() const
+	{
+		return (intervalCount == 0) ? 0.0 : intervalSum / static_cast<double>(intervalCount);
+	}
+
+	double FramePacer::jitter() const
+	{
+		if (intervalCount < 2)
+		{
+			return 0.0;
+		}
+		const double mean = meanInterval();
+		return std::sqrt(std::max(intervalSumSquares / static_cast<double>(intervalCount) - mean * mean, 0.0));
+	}
+
+	double FramePacer::recentJitter() const
+	{
+		return standardDeviation(recentIntervals.data(), std::min(recentCount, recentSize));
+	}
+
+	double FramePacer::percentileInterval(double fraction) const
+	{
+		if (intervalCount == 0)
+		{
+			return 0.0;
+		}
+		const uint64_t target = static_cast<uint64_t>(std::ceil(static_cast<double>(intervalCount) * fraction));
+		uint64_t intervals = 0;
+		size_t bucket = 0;
+		while (bucket < histogram.size() - 1)
+		{
+			intervals += histogram[bucket];
+			if (intervals >= target)
+			{
+				break;
+			}
+			bucket++;
+		}
+		return std::min((bucket + 1) / 10.0, maxInterval);
+	}
+
+	void FramePacer::writeJson(std::ostream& os, bool intervals) const
+	{
+		os << "{\"frameLimit\": " << maxFrameRate;
+		os << ", \"meanPresentInterval\": " << meanInterval();
+		os << ", \"jitter\": " << jitter();
+		os << ", \"p99PresentInterval\": " << percentileInterval(0.99);
+		os << ", \"maxPresentInterval\": " << maxInterval;
+		os << ", \"missedFrames\": " << missedFrames;
+		os << ", \"sleepTime\": " << sleepTime;
+		os << ", \"spinTime\": " << spinTime;
+		if (intervals && recordIntervals)
+		{
+			os << ", \"presentIntervals\": [";
+			for (size_t i = 0; i < presentIntervals.size(); i++)
+			{
+				os << (i > 0 ? ", " : "") << presentIntervals[i];
+			}
+			os << "]";
+		}
+		os << "}";
+	}
+}
@@ -0,0 +1,83 @@
+/*
+* Vulkan frame pacing
+*
+* Caps the frame rate with a hybrid sleep and spin wait, and measures the intervals between presents
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace vks
+{
+	/**
+	* @brief Frame rate limiter and present interval statistics
+	* wait() sleeps until shortly before the next frame is due and spins for the rest, as sleeping alone wakes up too late by a varying amount. How early it stops sleeping adapts to the overshoot of recent sleeps
+	* Frames are due on a fixed schedule instead of a fixed time after the previous frame, so a late frame is followed by a shorter wait and intervals stay even. If a frame is more than one interval late, the schedule restarts from it instead of catching up with a burst of frames
+	* Jitter is the standard deviation of the intervals between presents. These intervals are the frame pacing statistics the example base prints on exit and writes to benchmark results
+	*/
+	class FramePacer
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/** @brief Number of present intervals the recent jitter is calculated from */
+		static constexpr uint32_t recentSize = 120;
+
+		/** @brief maxFrameRate in frames per second, zero disables limiting */
+		void prepare(float maxFrameRate);
+
+		/** @brief Blocks until the next frame is due */
+		void wait();
+		/** @brief Records the time of a present */
+		void presented();
+		/** @brief Restarts the schedule and interval measurement, e.g. after rendering was suspended */
+		void resume();
+
+		bool enabled{ false };
+		float maxFrameRate{ 0.0f };
+		/** @brief Target interval, and how long before a frame is due sleeping ends, in ms */
+		double targetInterval{ 0.0 };
+		double spinThreshold{ 1.0 };
+
+		/** @brief Total time spent sleeping and spinning in ms, and frames that started after they were due */
+		double sleepTime{ 0.0 };
+		double spinTime{ 0.0 };
+		uint64_t missedFrames{ 0 };
+
+		/** @brief Number, sum, sum of squares and maximum of the intervals between all presents in ms */
+		uint64_t intervalCount{ 0 };
+		double intervalSum{ 0.0 };
+		double intervalSumSquares{ 0.0 };
+		double maxInterval{ 0.0 };
+		/** @brief Intervals between presents in 0.1 ms buckets, the last one collects all longer intervals */
+		std::array<uint32_t, 1000> histogram{};
+		/** @brief If set, every present interval is kept in presentIntervals, e.g. for benchmark output. Off by default as it grows with every frame */
+		bool recordIntervals{ false };
+		std::vector<double> presentIntervals;
+
+		/** @brief Mean and standard deviation of all present intervals, and of the last recentSize for display */
+		double meanInterval() const;
+		double jitter() const;
+		double recentJitter() const;
+		/** @brief Upper bound of the histogram bucket that contains the given fraction of intervals, e.g. 0.99 for the 99th percentile */
+		double percentileInterval(double fraction) const;
+		void writeJson(std::ostream& os, bool intervals) const;
+
+	private:
+		Clock::time_point nextFrame;
+		Clock::time_point lastPresent;
+		// Largest recent sleep overshoot in ms, decays so a single outlier doesn't keep the spin threshold high
+		double sleepOvershoot{ 0.0 };
+		std::array<double, recentSize> recentIntervals{};
+		uint32_t recentCount{ 0 };
+	};
+}
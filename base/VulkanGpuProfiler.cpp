@@ -0,0 +1,259 @@
+/*
+* Vulkan GPU timestamp profiler
+*
+* Measures GPU execution time of frames and command buffer ranges with timestamp queries and adds them to the CPU profiler's timeline
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanGpuProfiler.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "VulkanTools.h"
+#include "profiler.hpp"
+
+namespace vks
+{
+	void GpuProfiler::prepare(VkInstance instance, vks::VulkanDevice* device, VkQueue queue, uint32_t queueFamilyIndex, uint32_t frameCount, bool calibratedTimestamps)
+	{
+		this->device = device;
+		this->queue = queue;
+		const uint32_t validBits = device->queueFamilyProperties[queueFamilyIndex].timestampValidBits;
+		if (validBits == 0)
+		{
+			return;
+		}
+		timestampMask = (validBits >= 64) ? UINT64_MAX : ((1ull << validBits) - 1);
+		timestampPeriod = device->properties.limits.timestampPeriod;
+
+		// One additional query is used for calibrating without VK_EXT_calibrated_timestamps
+		VkQueryPoolCreateInfo queryPoolCI{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+		queryPoolCI.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCI.queryCount = frameCount * zonesPerFrame * 2 + 1;
+		VK_CHECK_RESULT(vkCreateQueryPool(device->logicalDevice, &queryPoolCI, nullptr, &queryPool));
+
+		commandPool = device->createCommandPool(queueFamilyIndex);
+		frames.resize(frameCount);
+		for (Frame& frame : frames)
+		{
+			frame.zones.reserve(zonesPerFrame);
+			frame.beginCommandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandPool);
+			frame.endCommandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandPool);
+		}
+
+		if (calibratedTimestamps)
+		{
+			// The host clock needs to be the one std::chrono::steady_clock (and with that the CPU profiler) is based on
+#if defined(_WIN32)
+			const VkTimeDomainEXT requiredTimeDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+#elif defined(__linux__) || defined(__ANDROID__)
+			const VkTimeDomainEXT requiredTimeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+#else
+			const VkTimeDomainEXT requiredTimeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+#endif
+			auto getTimeDomains = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT"));
+			uint32_t timeDomainCount{ 0 };
+			std::vector<VkTimeDomainEXT> timeDomains;
+			if (getTimeDomains && (getTimeDomains(device->physicalDevice, &timeDomainCount, nullptr) == VK_SUCCESS))
+			{
+				timeDomains.resize(timeDomainCount);
+				getTimeDomains(device->physicalDevice, &timeDomainCount, timeDomains.data());
+			}
+			const bool deviceDomain = std::find(timeDomains.begin(), timeDomains.end(), VK_TIME_DOMAIN_DEVICE_EXT) != timeDomains.end();
+			const bool hostDomain = std::find(timeDomains.begin(), timeDomains.end(), requiredTimeDomain) != timeDomains.end();
+			if (deviceDomain && hostDomain && (requiredTimeDomain != VK_TIME_DOMAIN_DEVICE_EXT))
+			{
+				hostTimeDomain = requiredTimeDomain;
+				getCalibratedTimestamps = reinterpret_cast<PFN_vkGetCalibratedTimestampsEXT>(vkGetDeviceProcAddr(device->logicalDevice, "vkGetCalibratedTimestampsEXT"));
+			}
+		}
+	}
+
+	void GpuProfiler::destroy()
+	{
+		if (queryPool != VK_NULL_HANDLE)
+		{
+			vkDestroyQueryPool(device->logicalDevice, queryPool, nullptr);
+			queryPool = VK_NULL_HANDLE;
+		}
+		if (commandPool != VK_NULL_HANDLE)
+		{
+			vkDestroyCommandPool(device->logicalDevice, commandPool, nullptr);
+			commandPool = VK_NULL_HANDLE;
+		}
+		frames.clear();
+	}
+
+	bool GpuProfiler::supported() const
+	{
+		return queryPool != VK_NULL_HANDLE;
+	}
+
+	void GpuProfiler::calibrate()
+	{
+		if (!supported())
+		{
+			return;
+		}
+		if (getCalibratedTimestamps)
+		{
+			VkCalibratedTimestampInfoEXT timestampInfos[2]{};
+			timestampInfos[0].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+			timestampInfos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+			timestampInfos[1].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+			timestampInfos[1].timeDomain = hostTimeDomain;
+			uint64_t timestamps[2]{};
+			uint64_t maxDeviation{ 0 };
+			VK_CHECK_RESULT(getCalibratedTimestamps(device->logicalDevice, 2, timestampInfos, timestamps, &maxDeviation));
+			gpuReference = timestamps[0] & timestampMask;
+#if defined(_WIN32)
+			// Performance counter ticks need to be converted to nanoseconds
+			LARGE_INTEGER frequency;
+			QueryPerformanceFrequency(&frequency);
+			cpuReference = static_cast<int64_t>(static_cast<double>(timestamps[1]) * 1.0e9 / static_cast<double>(frequency.QuadPart));
+#else
+			cpuReference = static_cast<int64_t>(timestamps[1]);
+#endif
+			return;
+		}
+		// Without calibrated timestamps, assume that a timestamp written by a single submission was taken halfway between submitting and the fence being signalled
+		const uint32_t query = static_cast<uint32_t>(frames.size()) * zonesPerFrame * 2;
+		VkCommandBuffer commandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandPool, true);
+		vkCmdResetQueryPool(commandBuffer, queryPool, query, 1);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, query);
+		const int64_t submitTime = Profiler::now();
+		device->flushCommandBuffer(commandBuffer, queue, commandPool);
+		const int64_t completionTime = Profiler::now();
+		uint64_t timestamp{ 0 };
+		VK_CHECK_RESULT(vkGetQueryPoolResults(device->logicalDevice, queryPool, query, 1, sizeof(uint64_t), &timestamp, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+		gpuReference = timestamp & timestampMask;
+		cpuReference = submitTime + (completionTime - submitTime) / 2;
+	}
+
+	uint32_t GpuProfiler::firstQuery(uint32_t frameIndex) const
+	{
+		return frameIndex * zonesPerFrame * 2;
+	}
+
+	int64_t GpuProfiler::toProfilerTime(uint64_t timestamp) const
+	{
+		const int64_t ticks = static_cast<int64_t>((timestamp & timestampMask) - gpuReference);
+		return cpuReference + static_cast<int64_t>(static_cast<double>(ticks) * timestampPeriod);
+	}
+
+	void GpuProfiler::collect(uint32_t frameIndex)
+	{
+		Frame& frame = frames[frameIndex];
+		if (frame.submitted && (frame.queryCount > 0))
+		{
+			// Each result is followed by its availability, so zones whose queries are available are kept if others aren't (VK_NOT_READY)
+			std::vector<uint64_t> results(frame.queryCount * 2);
+			// The frame's fence has already been waited on, so results that aren't available belong to zones that were never executed
+			VkResult result = vkGetQueryPoolResults(device->logicalDevice, queryPool, firstQuery(frameIndex), frame.queryCount, results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+			if ((result == VK_SUCCESS) || (result == VK_NOT_READY))
+			{
+				for (const Zone& zone : frame.zones)
+				{
+					if ((zone.endQuery < frame.queryCount) && (results[zone.beginQuery * 2 + 1] != 0) && (results[zone.endQuery * 2 + 1] != 0))
+					{
+						Profiler::get().addGpuZone(zone.name, toProfilerTime(results[zone.beginQuery * 2]), toProfilerTime(results[zone.endQuery * 2]), frame.frameNumber);
+					}
+				}
+			}
+		}
+		frame.zones.clear();
+		frame.queryCount = 0;
+		frame.active = false;
+		frame.submitted = false;
+	}
+
+	void GpuProfiler::beginFrame(uint32_t frameIndex, uint64_t frameNumber)
+	{
+		if (!supported())
+		{
+			return;
+		}
+		collect(frameIndex);
+		if (!Profiler::get().capturing())
+		{
+			return;
+		}
+		Frame& frame = frames[frameIndex];
+		frame.active = true;
+		frame.frameNumber = frameNumber;
+		// The first zone always covers the whole frame, its queries are written by the command buffers from recordFrameCommandBuffers
+		frame.zones.push_back({ "frame", 0, 1 });
+		frame.queryCount = 2;
+	}
+
+	void GpuProfiler::recordFrameCommandBuffers(uint32_t frameIndex, VkCommandBuffer& beginCommandBuffer, VkCommandBuffer& endCommandBuffer)
+	{
+		Frame& frame = frames[frameIndex];
+		VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		// Queries of all zones of this frame are reset ahead of the frame's command buffers
+		VK_CHECK_RESULT(vkBeginCommandBuffer(frame.beginCommandBuffer, &beginInfo));
+		vkCmdResetQueryPool(frame.beginCommandBuffer, queryPool, firstQuery(frameIndex), zonesPerFrame * 2);
+		vkCmdWriteTimestamp(frame.beginCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, firstQuery(frameIndex));
+		VK_CHECK_RESULT(vkEndCommandBuffer(frame.beginCommandBuffer));
+		VK_CHECK_RESULT(vkBeginCommandBuffer(frame.endCommandBuffer, &beginInfo));
+		vkCmdWriteTimestamp(frame.endCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, firstQuery(frameIndex) + 1);
+		VK_CHECK_RESULT(vkEndCommandBuffer(frame.endCommandBuffer));
+		beginCommandBuffer = frame.beginCommandBuffer;
+		endCommandBuffer = frame.endCommandBuffer;
+		frame.submitted = true;
+	}
+
+	void GpuProfiler::collectAll()
+	{
+		for (uint32_t i = 0; i < static_cast<uint32_t>(frames.size()); i++)
+		{
+			collect(i);
+		}
+	}
+
+	bool GpuProfiler::active(uint32_t frameIndex) const
+	{
+		return supported() && frames[frameIndex].active;
+	}
+
+	uint32_t GpuProfiler::beginZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, const char* name)
+	{
+		if (!active(frameIndex))
+		{
+			return UINT32_MAX;
+		}
+		Frame& frame = frames[frameIndex];
+		if (frame.queryCount + 2 > zonesPerFrame * 2)
+		{
+			return UINT32_MAX;
+		}
+		const uint32_t beginQuery = frame.queryCount++;
+		// The end query is assigned in endZone, so nested zones get consecutive queries
+		frame.zones.push_back({ name, beginQuery, UINT32_MAX });
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, firstQuery(frameIndex) + beginQuery);
+		return static_cast<uint32_t>(frame.zones.size()) - 1;
+	}
+
+	void GpuProfiler::endZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t zone)
+	{
+		if (!active(frameIndex) || (zone >= frames[frameIndex].zones.size()))
+		{
+			return;
+		}
+		Frame& frame = frames[frameIndex];
+		if (frame.queryCount >= zonesPerFrame * 2)
+		{
+			return;
+		}
+		frame.zones[zone].endQuery = frame.queryCount++;
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, firstQuery(frameIndex) + frame.zones[zone].endQuery);
+	}
+}
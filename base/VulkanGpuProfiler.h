@@ -0,0 +1,86 @@
+/*
+* Vulkan GPU timestamp profiler
+*
+* Measures GPU execution time of frames and command buffer ranges with timestamp queries and adds them to the CPU profiler's timeline
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanDevice.h"
+
+namespace vks
+{
+	/**
+	* @brief Writes timestamp queries for GPU zones and converts their results to the clock used by vks::Profiler
+	* @note GPU and CPU clocks are correlated with VK_EXT_calibrated_timestamps if it has been enabled, otherwise with a single timestamp submission
+	*/
+	class GpuProfiler
+	{
+	public:
+		/** @brief Max. number of zones (including the frame zone) per frame */
+		static const uint32_t zonesPerFrame = 32;
+
+		void prepare(VkInstance instance, vks::VulkanDevice* device, VkQueue queue, uint32_t queueFamilyIndex, uint32_t frameCount, bool calibratedTimestamps);
+		void destroy();
+		/** @brief False if the queue doesn't support timestamps */
+		bool supported() const;
+		/** @brief Re-correlates the GPU and CPU clocks, e.g. at the start of a capture */
+		void calibrate();
+
+		/** @brief Reads back the zones last written for the given frame slot, one full round of frames in flight later, and starts new ones. Must only be called once that frame's fence has been signalled */
+		void beginFrame(uint32_t frameIndex, uint64_t frameNumber);
+		/** @brief Records the zone spanning the whole frame, the returned command buffers need to be submitted before and after the frame's command buffers */
+		void recordFrameCommandBuffers(uint32_t frameIndex, VkCommandBuffer& beginCommandBuffer, VkCommandBuffer& endCommandBuffer);
+		/** @brief Reads back all pending zones, requires the queue to be idle */
+		void collectAll();
+		/** @brief True if zones are recorded for the given frame slot */
+		bool active(uint32_t frameIndex) const;
+
+		/** @brief Starts a zone in a command buffer of the current frame, name must be a string literal. Returns UINT32_MAX if no zone is recorded
+		* @note Not thread safe, zones need to be added from the thread that records the frame's primary command buffer */
+		uint32_t beginZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, const char* name);
+		void endZone(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t zone);
+
+	private:
+		struct Zone
+		{
+			const char* name;
+			uint32_t beginQuery;
+			uint32_t endQuery;
+		};
+		struct Frame
+		{
+			std::vector<Zone> zones;
+			uint32_t queryCount{ 0 };
+			uint64_t frameNumber{ 0 };
+			bool active{ false };
+			bool submitted{ false };
+			VkCommandBuffer beginCommandBuffer{ VK_NULL_HANDLE };
+			VkCommandBuffer endCommandBuffer{ VK_NULL_HANDLE };
+		};
+
+		vks::VulkanDevice* device{ nullptr };
+		VkQueue queue{ VK_NULL_HANDLE };
+		VkQueryPool queryPool{ VK_NULL_HANDLE };
+		VkCommandPool commandPool{ VK_NULL_HANDLE };
+		std::vector<Frame> frames;
+		uint64_t timestampMask{ 0 };
+		double timestampPeriod{ 1.0 };
+		PFN_vkGetCalibratedTimestampsEXT getCalibratedTimestamps{ nullptr };
+		VkTimeDomainEXT hostTimeDomain{ VK_TIME_DOMAIN_DEVICE_EXT };
+		// GPU timestamp and profiler time (in ns) of the same point in time
+		uint64_t gpuReference{ 0 };
+		int64_t cpuReference{ 0 };
+
+		uint32_t firstQuery(uint32_t frameIndex) const;
+		int64_t toProfilerTime(uint64_t timestamp) const;
+		void collect(uint32_t frameIndex);
+	};
+}
@@ -0,0 +1,228 @@
+/*
+* Vulkan immediate context for one-shot command buffer submissions
+*
+* Recycles command buffers and fences per thread instead of allocating and destroying them for every one-off operation, and can batch several operations into a single submission
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanImmediateContext.h"
+#include "VulkanDevice.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace vks
+{
+	void ImmediateContext::prepare(VulkanDevice* device)
+	{
+		this->device = device;
+	}
+
+	void ImmediateContext::destroy()
+	{
+		if (!device)
+		{
+			return;
+		}
+		VkDevice logicalDevice = device->logicalDevice;
+		for (auto& [id, state] : threadStates)
+		{
+			// Deferred command buffers that were never flushed are freed with their pools
+			for (Batch& batch : state->inFlight)
+			{
+				VK_CHECK_RESULT(vkWaitForFences(logicalDevice, 1, &batch.fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT));
+				vkDestroyFence(logicalDevice, batch.fence, nullptr);
+			}
+			for (auto& [queueFamilyIndex, commandPool] : state->commandPools)
+			{
+				vkDestroyCommandPool(logicalDevice, commandPool, nullptr);
+			}
+		}
+		threadStates.clear();
+		for (VkFence fence : freeFences)
+		{
+			vkDestroyFence(logicalDevice, fence, nullptr);
+		}
+		freeFences.clear();
+		device = nullptr;
+	}
+
+	ImmediateContext::ThreadState& ImmediateContext::threadState()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::unique_ptr<ThreadState>& state = threadStates[std::this_thread::get_id()];
+		if (!state)
+		{
+			state = std::make_unique<ThreadState>();
+		}
+		return *state;
+	}
+
+	VkCommandBuffer ImmediateContext::begin(uint32_t queueFamilyIndex)
+	{
+		assert(device);
+		ThreadState& state = threadState();
+		poll();
+
+		VkCommandBuffer commandBuffer;
+		std::vector<VkCommandBuffer>& freeCommandBuffers = state.freeCommandBuffers[queueFamilyIndex];
+		if (!freeCommandBuffers.empty())
+		{
+			// Pools are created with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, so beginning a recycled command buffer resets it
+			commandBuffer = freeCommandBuffers.back();
+			freeCommandBuffers.pop_back();
+		}
+		else
+		{
+			VkCommandPool& commandPool = state.commandPools[queueFamilyIndex];
+			if (!commandPool)
+			{
+				commandPool = device->createCommandPool(queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+			}
+			commandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandPool);
+			state.queueFamilies[commandBuffer] = queueFamilyIndex;
+		}
+		VkCommandBufferBeginInfo beginInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+		};
+		VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+		return commandBuffer;
+	}
+
+	void ImmediateContext::submit(VkCommandBuffer commandBuffer, VkQueue queue)
+	{
+		ThreadState& state = threadState();
+		Batch batch{ .queue = queue, .queueFamilyIndex = state.queueFamilies[commandBuffer], .commandBuffers = { commandBuffer } };
+		submitBatch(state, batch);
+		VK_CHECK_RESULT(vkWaitForFences(device->logicalDevice, 1, &batch.fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT));
+		retire(state, batch);
+	}
+
+	void ImmediateContext::submitDeferred(VkCommandBuffer commandBuffer, VkQueue queue, std::function<void()> onComplete)
+	{
+		ThreadState& state = threadState();
+		auto batch = std::find_if(state.pending.begin(), state.pending.end(), [queue](const Batch& pending) { return pending.queue == queue; });
+		if (batch == state.pending.end())
+		{
+			state.pending.push_back({ .queue = queue, .queueFamilyIndex = state.queueFamilies[commandBuffer] });
+			batch = state.pending.end() - 1;
+		}
+		batch->commandBuffers.push_back(commandBuffer);
+		if (onComplete)
+		{
+			batch->callbacks.push_back(std::move(onComplete));
+		}
+	}
+
+	void ImmediateContext::flush()
+	{
+		ThreadState& state = threadState();
+		for (Batch& batch : state.pending)
+		{
+			submitBatch(state, batch);
+			state.inFlight.push_back(std::move(batch));
+		}
+		state.pending.clear();
+	}
+
+	void ImmediateContext::poll()
+	{
+		ThreadState& state = threadState();
+		// Completion callbacks may submit and flush further work, which adds to inFlight while it's being iterated
+		std::vector<Batch> batches = std::move(state.inFlight);
+		state.inFlight.clear();
+		// Batches on different queues may complete out of order
+		for (Batch& batch : batches)
+		{
+			if (vkGetFenceStatus(device->logicalDevice, batch.fence) == VK_SUCCESS)
+			{
+				retire(state, batch);
+			}
+			else
+			{
+				state.inFlight.push_back(std::move(batch));
+			}
+		}
+	}
+
+	void ImmediateContext::wait()
+	{
+		flush();
+		ThreadState& state = threadState();
+		// Work submitted by completion callbacks is waited for as well
+		while (!state.inFlight.empty())
+		{
+			std::vector<Batch> batches = std::move(state.inFlight);
+			state.inFlight.clear();
+			for (Batch& batch : batches)
+			{
+				VK_CHECK_RESULT(vkWaitForFences(device->logicalDevice, 1, &batch.fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT));
+				retire(state, batch);
+			}
+			flush();
+		}
+	}
+
+	VkFence ImmediateContext::acquireFence()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!freeFences.empty())
+		{
+			VkFence fence = freeFences.back();
+			freeFences.pop_back();
+			return fence;
+		}
+		VkFenceCreateInfo fenceCI = vks::initializers::fenceCreateInfo(VK_FLAGS_NONE);
+		VkFence fence;
+		VK_CHECK_RESULT(vkCreateFence(device->logicalDevice, &fenceCI, nullptr, &fence));
+		return fence;
+	}
+
+	/**
+	* Return a fence to the pool
+	*
+	* @param fence Fence that has been signalled or was never submitted
+	*/
+	void ImmediateContext::releaseFence(VkFence fence)
+	{
+		VK_CHECK_RESULT(vkResetFences(device->logicalDevice, 1, &fence));
+		std::lock_guard<std::mutex> lock(mutex);
+		freeFences.push_back(fence);
+	}
+
+	void ImmediateContext::submitBatch(ThreadState& state, Batch& batch)
+	{
+		// Recorded uploads may be read by the batch, so they must be submitted before it
+		device->uploadManager.flush();
+		for (VkCommandBuffer commandBuffer : batch.commandBuffers)
+		{
+			VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
+		}
+		batch.fence = acquireFence();
+		VkSubmitInfo submitInfo{
+			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			.commandBufferCount = static_cast<uint32_t>(batch.commandBuffers.size()),
+			.pCommandBuffers = batch.commandBuffers.data()
+		};
+		// The queue is shared with the frame submission, which may run on another thread
+		VK_CHECK_RESULT(device->queueSubmit(batch.queue, 1, &submitInfo, batch.fence));
+		std::lock_guard<std::mutex> lock(mutex);
+		submissionCount++;
+		commandBufferCount += batch.commandBuffers.size();
+	}
+
+	void ImmediateContext::retire(ThreadState& state, Batch& batch)
+	{
+		for (auto& callback : batch.callbacks)
+		{
+			callback();
+		}
+		std::vector<VkCommandBuffer>& freeCommandBuffers = state.freeCommandBuffers[batch.queueFamilyIndex];
+		freeCommandBuffers.insert(freeCommandBuffers.end(), batch.commandBuffers.begin(), batch.commandBuffers.end());
+		releaseFence(batch.fence);
+	}
+}
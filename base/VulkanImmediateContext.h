@@ -0,0 +1,93 @@
+/*
+* Vulkan immediate context for one-shot command buffer submissions
+*
+* Recycles command buffers and fences per thread instead of allocating and destroying them for every one-off operation, and can batch several operations into a single submission
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	struct VulkanDevice;
+
+	/**
+	* @brief Pooled command buffers and fences for one-shot operations (layout transitions, copies, acceleration structure builds, etc.)
+	* Each thread records from its own command pools, so command buffers can be requested from loader threads without locking
+	* Completed command buffers and fences are recycled the next time the owning thread requests a command buffer
+	* @note Command buffers must be submitted and flushed from the thread that requested them, submissions hold the device's queue lock so that thread doesn't have to be the one that submits the frames
+	*/
+	class ImmediateContext
+	{
+	public:
+		void prepare(VulkanDevice* device);
+		/** @brief Waits for all submissions and releases all resources, must only be called when no other thread uses the context */
+		void destroy();
+
+		/** @brief Returns a primary command buffer in the recording state, allocated from the calling thread's pool for the given queue family */
+		VkCommandBuffer begin(uint32_t queueFamilyIndex);
+		/** @brief Submits a command buffer returned by begin() and waits for it to complete */
+		void submit(VkCommandBuffer commandBuffer, VkQueue queue);
+		/**
+		* @brief Adds a command buffer returned by begin() to the calling thread's batch for the queue, without submitting it
+		* @param onComplete Called from the thread that polls or waits once the batch has finished executing on the device
+		*/
+		void submitDeferred(VkCommandBuffer commandBuffer, VkQueue queue, std::function<void()> onComplete = nullptr);
+		/** @brief Submits the calling thread's batches, all deferred command buffers for a queue go into a single vkQueueSubmit */
+		void flush();
+		/** @brief Runs completion callbacks of finished batches of the calling thread and recycles their command buffers and fences */
+		void poll();
+		/** @brief Flushes and waits for all batches of the calling thread */
+		void wait();
+
+		/** @brief Fences that are reset and ready to be used, for callers that manage their own command buffers */
+		VkFence acquireFence();
+		void releaseFence(VkFence fence);
+
+		/** @brief Number of submissions and command buffers submitted through the context since prepare */
+		uint64_t submissionCount{ 0 };
+		uint64_t commandBufferCount{ 0 };
+
+	private:
+		// Command buffers of a single queue submission that may still be executing
+		struct Batch
+		{
+			VkQueue queue{ VK_NULL_HANDLE };
+			uint32_t queueFamilyIndex{ 0 };
+			std::vector<VkCommandBuffer> commandBuffers;
+			std::vector<std::function<void()>> callbacks;
+			VkFence fence{ VK_NULL_HANDLE };
+		};
+		struct ThreadState
+		{
+			// Command pool and recycled command buffers per queue family
+			std::unordered_map<uint32_t, VkCommandPool> commandPools;
+			std::unordered_map<uint32_t, std::vector<VkCommandBuffer>> freeCommandBuffers;
+			std::unordered_map<VkCommandBuffer, uint32_t> queueFamilies;
+			// Deferred command buffers that have not been submitted yet
+			std::vector<Batch> pending;
+			std::vector<Batch> inFlight;
+		};
+
+		VulkanDevice* device{ nullptr };
+		std::mutex mutex;
+		std::unordered_map<std::thread::id, std::unique_ptr<ThreadState>> threadStates;
+		std::vector<VkFence> freeFences;
+
+		ThreadState& threadState();
+		void submitBatch(ThreadState& state, Batch& batch);
+		void retire(ThreadState& state, Batch& batch);
+	};
+}
@@ -0,0 +1,353 @@
+/*
+* Vulkan device memory sub-allocator
+*
+* Hands out ranges of large device memory blocks using buddy free lists per memory type, so resources don't need a vkAllocateMemory call each
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanMemoryAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace vks
+{
+	namespace
+	{
+		VkDeviceSize nextPowerOfTwo(VkDeviceSize value)
+		{
+			VkDeviceSize result = 1;
+			while (result < value)
+			{
+				result <<= 1;
+			}
+			return result;
+		}
+
+		uint32_t log2(VkDeviceSize value)
+		{
+			uint32_t result = 0;
+			while (value > 1)
+			{
+				value >>= 1;
+				result++;
+			}
+			return result;
+		}
+	}
+
+	void MemoryAllocator::init(VkDevice device, const VkPhysicalDeviceProperties& properties, const VkPhysicalDeviceMemoryProperties& memoryProperties, MemoryTracker* tracker)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->device = device;
+		this->memoryProperties = memoryProperties;
+		this->tracker = tracker;
+		nonCoherentAtomSize = std::max<VkDeviceSize>(properties.limits.nonCoherentAtomSize, 1);
+		assert(nonCoherentAtomSize <= minAllocationSize);
+		// Four pools per memory type: linear and optimal resources, each with and without device address support
+		pools.resize(memoryProperties.memoryTypeCount * 4);
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+		{
+			const VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex].size;
+			VkDeviceSize blockSize = preferredBlockSize;
+			if (heapSize <= 1024ull * 1024 * 1024)
+			{
+				blockSize = std::max(nextPowerOfTwo(heapSize / 8 + 1) / 2, minAllocationSize);
+			}
+			for (uint32_t j = 0; j < 4; j++)
+			{
+				Pool& pool = pools[i * 4 + j];
+				pool.memoryTypeIndex = i;
+				pool.blockSize = blockSize;
+				pool.levelCount = log2(blockSize / minAllocationSize) + 1;
+			}
+		}
+	}
+
+	void MemoryAllocator::destroy()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& pool : pools)
+		{
+			for (auto& block : pool.blocks)
+			{
+				assert(block.allocationCount == 0);
+				if (block.memory != VK_NULL_HANDLE)
+				{
+					freeDeviceMemory(block.memory, block.mapped);
+				}
+			}
+			pool.blocks.clear();
+		}
+		statistics = {};
+	}
+
+	uint32_t MemoryAllocator::poolIndex(uint32_t memoryTypeIndex, bool linear, bool deviceAddress) const
+	{
+		return memoryTypeIndex * 4 + (linear ? 0 : 2) + (deviceAddress ? 1 : 0);
+	}
+
+	VkResult MemoryAllocator::allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, bool deviceAddress, VkDeviceMemory& memory, void*& mapped)
+	{
+		VkMemoryAllocateInfo memoryAllocateInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+		memoryAllocateInfo.allocationSize = size;
+		memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+		VkMemoryAllocateFlagsInfoKHR allocateFlagsInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR };
+		if (deviceAddress)
+		{
+			allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+			memoryAllocateInfo.pNext = &allocateFlagsInfo;
+		}
+		VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &memory);
+		if (result != VK_SUCCESS)
+		{
+			return result;
+		}
+		mapped = nullptr;
+		if (memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+		{
+			result = vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+			if (result != VK_SUCCESS)
+			{
+				vkFreeMemory(device, memory, nullptr);
+				memory = VK_NULL_HANDLE;
+				return result;
+			}
+		}
+		statistics.reserved += size;
+		return VK_SUCCESS;
+	}
+
+	void MemoryAllocator::freeDeviceMemory(VkDeviceMemory memory, void* mapped)
+	{
+		if (mapped)
+		{
+			vkUnmapMemory(device, memory);
+		}
+		vkFreeMemory(device, memory, nullptr);
+	}
+
+	/**
+	* Take a range of the given buddy level from a block, splitting larger free ranges as required
+	*
+	* @return False if the block has no free range large enough
+	*/
+	bool MemoryAllocator::allocateFromBlock(Pool& pool, Block& block, uint32_t level, VkDeviceSize& offset)
+	{
+		int32_t freeLevel = static_cast<int32_t>(level);
+		while ((freeLevel >= 0) && block.freeLists[freeLevel].empty())
+		{
+			freeLevel--;
+		}
+		if (freeLevel < 0)
+		{
+			return false;
+		}
+		offset = *block.freeLists[freeLevel].begin();
+		block.freeLists[freeLevel].erase(block.freeLists[freeLevel].begin());
+		// Split down to the requested size, the upper halves become free ranges of the next level
+		for (uint32_t l = static_cast<uint32_t>(freeLevel); l < level; l++)
+		{
+			block.freeLists[l + 1].insert(offset + (pool.blockSize >> (l + 1)));
+		}
+		return true;
+	}
+
+	/**
+	* Allocate memory for a resource
+	*
+	* @param requirements Memory requirements of the resource
+	* @param memoryTypeIndex Memory type to allocate from
+	* @param linear True for buffers and linear tiling images, false for optimal tiling images
+	* @param deviceAddress True if the memory needs to support buffer device addresses
+	* @param tag Subsystem the allocation is accounted to in the memory tracker
+	* @param allocation Receives the allocated range
+	*
+	* @return VkResult of the device memory allocation (if a new block or dedicated allocation was required)
+	*/
+	VkResult MemoryAllocator::allocate(const VkMemoryRequirements& requirements, uint32_t memoryTypeIndex, bool linear, bool deviceAddress, MemoryTag tag, MemoryAllocation& allocation)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		assert(memoryTypeIndex < memoryProperties.memoryTypeCount);
+		Pool& pool = pools[poolIndex(memoryTypeIndex, linear, deviceAddress)];
+		allocation = {};
+		allocation.memoryTypeIndex = memoryTypeIndex;
+
+		// Large resources and lazily allocated (transient) attachments get their own device memory
+		const VkDeviceSize size = std::max({ nextPowerOfTwo(requirements.size), nextPowerOfTwo(requirements.alignment), minAllocationSize });
+		const bool lazy = (memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+		if ((size > pool.blockSize / 2) || lazy)
+		{
+			VkResult result = allocateDeviceMemory(requirements.size, memoryTypeIndex, deviceAddress, allocation.memory, allocation.mapped);
+			if (result != VK_SUCCESS)
+			{
+				return result;
+			}
+			statistics.dedicatedCount++;
+		}
+		else
+		{
+			const uint32_t level = log2(pool.blockSize / size);
+			uint32_t blockIndex = 0;
+			VkDeviceSize offset = 0;
+			bool found = false;
+			for (; blockIndex < pool.blocks.size(); blockIndex++)
+			{
+				Block& block = pool.blocks[blockIndex];
+				if ((block.memory != VK_NULL_HANDLE) && allocateFromBlock(pool, block, level, offset))
+				{
+					found = true;
+					break;
+				}
+			}
+			if (!found)
+			{
+				// Reuse the slot of a previously released block to keep block indices of live allocations stable
+				blockIndex = 0;
+				while ((blockIndex < pool.blocks.size()) && (pool.blocks[blockIndex].memory != VK_NULL_HANDLE))
+				{
+					blockIndex++;
+				}
+				if (blockIndex == pool.blocks.size())
+				{
+					pool.blocks.emplace_back();
+				}
+				Block& block = pool.blocks[blockIndex];
+				VkResult result = allocateDeviceMemory(pool.blockSize, memoryTypeIndex, deviceAddress, block.memory, block.mapped);
+				if (result != VK_SUCCESS)
+				{
+					return result;
+				}
+				block.freeLists.assign(pool.levelCount, {});
+				block.freeLists[0].insert(0);
+				statistics.blockCount++;
+				allocateFromBlock(pool, block, level, offset);
+			}
+			Block& block = pool.blocks[blockIndex];
+			block.allocationCount++;
+			allocation.memory = block.memory;
+			allocation.offset = offset;
+			allocation.mapped = block.mapped ? static_cast<uint8_t*>(block.mapped) + offset : nullptr;
+			allocation.pool = poolIndex(memoryTypeIndex, linear, deviceAddress);
+			allocation.block = blockIndex;
+			allocation.level = level;
+			statistics.padding += size - requirements.size;
+		}
+		allocation.size = requirements.size;
+		statistics.allocationCount++;
+		statistics.used += requirements.size;
+		if (tracker)
+		{
+			tracker->track(allocation.memory, allocation.size, memoryTypeIndex, tag, allocation.offset);
+		}
+		return VK_SUCCESS;
+	}
+
+	/**
+	* Return an allocation to its block (or free its dedicated memory), the allocation is reset afterwards
+	*/
+	void MemoryAllocator::free(MemoryAllocation& allocation)
+	{
+		if (!allocation.valid())
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		if (tracker)
+		{
+			tracker->untrack(allocation.memory, allocation.offset);
+		}
+		if (allocation.pool == UINT32_MAX)
+		{
+			freeDeviceMemory(allocation.memory, allocation.mapped);
+			statistics.reserved -= allocation.size;
+			statistics.dedicatedCount--;
+		}
+		else
+		{
+			Pool& pool = pools[allocation.pool];
+			Block& block = pool.blocks[allocation.block];
+			// Merge with free buddies as long as possible
+			VkDeviceSize offset = allocation.offset;
+			uint32_t level = allocation.level;
+			while (level > 0)
+			{
+				const VkDeviceSize buddy = offset ^ (pool.blockSize >> level);
+				auto it = block.freeLists[level].find(buddy);
+				if (it == block.freeLists[level].end())
+				{
+					break;
+				}
+				block.freeLists[level].erase(it);
+				offset = std::min(offset, buddy);
+				level--;
+			}
+			block.freeLists[level].insert(offset);
+			block.allocationCount--;
+			statistics.padding -= (pool.blockSize >> allocation.level) - allocation.size;
+			// Release empty blocks, but keep the last one of a pool to avoid allocating a new block for every short lived resource
+			if (block.allocationCount == 0)
+			{
+				const auto usedBlocks = std::count_if(pool.blocks.begin(), pool.blocks.end(), [](const Block& b) { return b.memory != VK_NULL_HANDLE; });
+				if (usedBlocks > 1)
+				{
+					freeDeviceMemory(block.memory, block.mapped);
+					block = {};
+					statistics.reserved -= pool.blockSize;
+					statistics.blockCount--;
+				}
+			}
+		}
+		statistics.allocationCount--;
+		statistics.used -= allocation.size;
+		allocation = {};
+	}
+
+	VkMappedMemoryRange MemoryAllocator::mappedRange(const MemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const
+	{
+		VkMappedMemoryRange range{ VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE };
+		range.memory = allocation.memory;
+		if (allocation.pool == UINT32_MAX)
+		{
+			// Dedicated allocations own the whole device memory, so the range can be passed on as is
+			range.offset = offset;
+			range.size = size;
+			return range;
+		}
+		// Ranges need to be aligned to nonCoherentAtomSize, buddy ranges are aligned to at least minAllocationSize so the aligned range stays within the allocation's range
+		const VkDeviceSize begin = allocation.offset + offset;
+		const VkDeviceSize allocationEnd = allocation.offset + allocation.size;
+		const VkDeviceSize end = (size == VK_WHOLE_SIZE) ? allocationEnd : std::min(allocationEnd, begin + size);
+		range.offset = begin - (begin % nonCoherentAtomSize);
+		range.size = ((end + nonCoherentAtomSize - 1) / nonCoherentAtomSize) * nonCoherentAtomSize - range.offset;
+		return range;
+	}
+
+	VkResult MemoryAllocator::flush(const MemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset)
+	{
+		const VkMappedMemoryRange range = mappedRange(allocation, size, offset);
+		return vkFlushMappedMemoryRanges(device, 1, &range);
+	}
+
+	VkResult MemoryAllocator::invalidate(const MemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset)
+	{
+		const VkMappedMemoryRange range = mappedRange(allocation, size, offset);
+		return vkInvalidateMappedMemoryRanges(device, 1, &range);
+	}
+
+	MemoryAllocator::Statistics MemoryAllocator::getStatistics()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return statistics;
+	}
+
+	void MemoryAllocator::writeJson(std::ostream& os)
+	{
+		const Statistics stats = getStatistics();
+		os << "{\"blocks\": " << stats.blockCount << ", \"dedicated\": " << stats.dedicatedCount << ", \"allocations\": " << stats.allocationCount;
+		os << ", \"reserved\": " << stats.reserved << ", \"used\": " << stats.used << ", \"padding\": " << stats.padding << "}";
+	}
+}
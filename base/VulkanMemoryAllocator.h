@@ -0,0 +1,122 @@
+/*
+* Vulkan device memory sub-allocator
+*
+* Hands out ranges of large device memory blocks using buddy free lists per memory type, so resources don't need a vkAllocateMemory call each
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanMemoryTracker.h"
+
+namespace vks
+{
+	/** @brief A range of device memory handed out by the MemoryAllocator */
+	struct MemoryAllocation
+	{
+		VkDeviceMemory memory{ VK_NULL_HANDLE };
+		/** @brief Offset of the allocation into memory, to be used when binding resources */
+		VkDeviceSize offset{ 0 };
+		/** @brief Size requested by the resource, the range reserved in the block is rounded up to the next power of two */
+		VkDeviceSize size{ 0 };
+		/** @brief Host address of the allocation if it's in host visible memory, blocks stay mapped for their whole lifetime */
+		void* mapped{ nullptr };
+		uint32_t memoryTypeIndex{ 0 };
+		// Pool, block and buddy level the allocation belongs to, pool is UINT32_MAX for dedicated allocations
+		uint32_t pool{ UINT32_MAX };
+		uint32_t block{ 0 };
+		uint32_t level{ 0 };
+
+		bool valid() const
+		{
+			return memory != VK_NULL_HANDLE;
+		}
+	};
+
+	/**
+	* @brief Sub-allocates buffers and images from device memory blocks
+	* Each memory type has separate pools for linear resources (buffers, linear images) and optimal tiling images, so neighbouring resources never violate bufferImageGranularity
+	* Blocks are managed as buddy systems: allocations are rounded up to a power of two, which also satisfies any alignment up to that size
+	* Resources larger than half a block get a dedicated allocation
+	*/
+	class MemoryAllocator
+	{
+	public:
+		/** @brief Smallest range handed out, matches the largest nonCoherentAtomSize allowed by the spec, so flushes never touch neighbouring allocations */
+		static constexpr VkDeviceSize minAllocationSize = 256;
+		/** @brief Block size for heaps larger than 1 GiB, smaller heaps use an eighth of their size */
+		static constexpr VkDeviceSize preferredBlockSize = 64ull * 1024 * 1024;
+
+		struct Statistics
+		{
+			uint32_t blockCount{ 0 };
+			uint32_t dedicatedCount{ 0 };
+			uint32_t allocationCount{ 0 };
+			/** @brief Device memory allocated for blocks and dedicated allocations */
+			VkDeviceSize reserved{ 0 };
+			/** @brief Memory actually requested by resources */
+			VkDeviceSize used{ 0 };
+			/** @brief Memory lost to rounding allocations up to a power of two */
+			VkDeviceSize padding{ 0 };
+		};
+
+		void init(VkDevice device, const VkPhysicalDeviceProperties& properties, const VkPhysicalDeviceMemoryProperties& memoryProperties, MemoryTracker* tracker);
+		/** @brief Frees all blocks, all allocations must have been freed before */
+		void destroy();
+
+		/**
+		* @brief Allocates memory for a resource with the given requirements
+		* @param linear True for buffers and linear tiling images
+		* @param deviceAddress True if the memory needs to be allocated with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT (for buffers with shader device addresses)
+		*/
+		VkResult allocate(const VkMemoryRequirements& requirements, uint32_t memoryTypeIndex, bool linear, bool deviceAddress, MemoryTag tag, MemoryAllocation& allocation);
+		void free(MemoryAllocation& allocation);
+
+		/** @brief Flushes a range relative to the start of the allocation, required for non-coherent memory */
+		VkResult flush(const MemoryAllocation& allocation, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+		VkResult invalidate(const MemoryAllocation& allocation, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+
+		Statistics getStatistics();
+		void writeJson(std::ostream& os);
+
+	private:
+		struct Block
+		{
+			VkDeviceMemory memory{ VK_NULL_HANDLE };
+			void* mapped{ nullptr };
+			// Free offsets for each buddy level, level 0 spans the whole block
+			std::vector<std::set<VkDeviceSize>> freeLists;
+			uint32_t allocationCount{ 0 };
+		};
+		struct Pool
+		{
+			uint32_t memoryTypeIndex;
+			VkDeviceSize blockSize;
+			uint32_t levelCount;
+			std::vector<Block> blocks;
+		};
+
+		std::mutex mutex;
+		VkDevice device{ VK_NULL_HANDLE };
+		VkPhysicalDeviceMemoryProperties memoryProperties{};
+		VkDeviceSize nonCoherentAtomSize{ 1 };
+		MemoryTracker* tracker{ nullptr };
+		std::vector<Pool> pools;
+		Statistics statistics;
+
+		uint32_t poolIndex(uint32_t memoryTypeIndex, bool linear, bool deviceAddress) const;
+		VkResult allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, bool deviceAddress, VkDeviceMemory& memory, void*& mapped);
+		void freeDeviceMemory(VkDeviceMemory memory, void* mapped);
+		bool allocateFromBlock(Pool& pool, Block& block, uint32_t level, VkDeviceSize& offset);
+		VkMappedMemoryRange mappedRange(const MemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+	};
+}
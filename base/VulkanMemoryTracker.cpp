@@ -0,0 +1,227 @@
+/*
+* Vulkan device memory tracker
+*
+* Accounts device memory allocations per memory heap, memory type and subsystem
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanMemoryTracker.h"
+
+#include <algorithm>
+
+namespace vks
+{
+	void MemoryTracker::init(VkPhysicalDevice physicalDevice, const VkPhysicalDeviceMemoryProperties& memoryProperties)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->physicalDevice = physicalDevice;
+		this->memoryProperties = memoryProperties;
+		heapUsage.resize(memoryProperties.memoryHeapCount);
+		typeUsage.resize(memoryProperties.memoryTypeCount);
+	}
+
+	void MemoryTracker::enableBudget(PFN_vkGetPhysicalDeviceMemoryProperties2KHR getMemoryProperties2)
+	{
+		this->getMemoryProperties2 = getMemoryProperties2;
+	}
+
+	bool MemoryTracker::budgetAvailable() const
+	{
+		return getMemoryProperties2 != nullptr;
+	}
+
+	void MemoryTracker::add(Usage& usage, VkDeviceSize size)
+	{
+		usage.live += size;
+		usage.peak = std::max(usage.peak, usage.live);
+		usage.allocations++;
+	}
+
+	void MemoryTracker::remove(Usage& usage, VkDeviceSize size)
+	{
+		usage.live -= size;
+		usage.allocations--;
+	}
+
+	/**
+	* Account a new device memory allocation
+	*
+	* @param memory Handle of the allocated device memory
+	* @param size Size of the allocation in bytes
+	* @param memoryTypeIndex Memory type the allocation was made from
+	* @param tag Subsystem the allocation is accounted to
+	* @param offset Offset of a sub-allocation into the device memory
+	*/
+	void MemoryTracker::track(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, MemoryTag tag, VkDeviceSize offset)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if ((memory == VK_NULL_HANDLE) || (memoryTypeIndex >= typeUsage.size()))
+		{
+			return;
+		}
+		allocations[{ memory, offset }] = { size, memoryTypeIndex, tag };
+		add(typeUsage[memoryTypeIndex], size);
+		add(heapUsage[memoryProperties.memoryTypes[memoryTypeIndex].heapIndex], size);
+		add(tagUsage[static_cast<size_t>(tag)], size);
+		add(totalUsage, size);
+	}
+
+	/**
+	* Remove a device memory allocation from the statistics, memory that is not tracked is ignored
+	*/
+	void MemoryTracker::untrack(VkDeviceMemory memory, VkDeviceSize offset)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = allocations.find({ memory, offset });
+		if (it == allocations.end())
+		{
+			return;
+		}
+		const Allocation& allocation = it->second;
+		remove(typeUsage[allocation.memoryTypeIndex], allocation.size);
+		remove(heapUsage[memoryProperties.memoryTypes[allocation.memoryTypeIndex].heapIndex], allocation.size);
+		remove(tagUsage[static_cast<size_t>(allocation.tag)], allocation.size);
+		remove(totalUsage, allocation.size);
+		allocations.erase(it);
+	}
+
+	const VkPhysicalDeviceMemoryProperties& MemoryTracker::getMemoryProperties() const
+	{
+		return memoryProperties;
+	}
+
+	MemoryTracker::Usage MemoryTracker::getHeapUsage(uint32_t heapIndex)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return heapUsage[heapIndex];
+	}
+
+	MemoryTracker::Usage MemoryTracker::getTypeUsage(uint32_t typeIndex)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return typeUsage[typeIndex];
+	}
+
+	MemoryTracker::Usage MemoryTracker::getTagUsage(MemoryTag tag)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return tagUsage[static_cast<size_t>(tag)];
+	}
+
+	MemoryTracker::Usage MemoryTracker::getTotalUsage()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return totalUsage;
+	}
+
+	/**
+	* Query the current per-heap budget and process usage
+	*
+	* @return Budget for each memory heap, empty if VK_EXT_memory_budget is not available
+	*/
+	std::vector<MemoryTracker::HeapBudget> MemoryTracker::getHeapBudgets() const
+	{
+		std::vector<HeapBudget> budgets;
+		if (!getMemoryProperties2)
+		{
+			return budgets;
+		}
+		VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT };
+		VkPhysicalDeviceMemoryProperties2 memoryProperties2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2 };
+		memoryProperties2.pNext = &budgetProperties;
+		getMemoryProperties2(physicalDevice, &memoryProperties2);
+		budgets.resize(memoryProperties2.memoryProperties.memoryHeapCount);
+		for (size_t i = 0; i < budgets.size(); i++)
+		{
+			budgets[i] = { budgetProperties.heapBudget[i], budgetProperties.heapUsage[i] };
+		}
+		return budgets;
+	}
+
+	void MemoryTracker::writeJson(std::ostream& os)
+	{
+		const std::vector<HeapBudget> budgets = getHeapBudgets();
+		std::lock_guard<std::mutex> lock(mutex);
+		auto writeUsage = [&os](const Usage& usage) {
+			os << "\"live\": " << usage.live << ", \"peak\": " << usage.peak << ", \"allocations\": " << usage.allocations;
+		};
+		os << "{\"total\": {";
+		writeUsage(totalUsage);
+		os << "},\n    \"heaps\": [";
+		for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+		{
+			const VkMemoryHeap& heap = memoryProperties.memoryHeaps[i];
+			os << (i > 0 ? ", " : "") << "{\"index\": " << i << ", \"size\": " << heap.size;
+			os << ", \"deviceLocal\": " << ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "true" : "false") << ", ";
+			writeUsage(heapUsage[i]);
+			if (i < budgets.size())
+			{
+				os << ", \"budget\": " << budgets[i].budget << ", \"processUsage\": " << budgets[i].usage;
+			}
+			os << "}";
+		}
+		os << "],\n    \"types\": [";
+		bool first = true;
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+		{
+			// Only list memory types that have actually been used
+			if (typeUsage[i].peak == 0)
+			{
+				continue;
+			}
+			os << (first ? "" : ", ") << "{\"index\": " << i << ", \"heap\": " << memoryProperties.memoryTypes[i].heapIndex;
+			os << ", \"propertyFlags\": " << memoryProperties.memoryTypes[i].propertyFlags << ", ";
+			writeUsage(typeUsage[i]);
+			os << "}";
+			first = false;
+		}
+		os << "],\n    \"tags\": {";
+		for (size_t i = 0; i < tagUsage.size(); i++)
+		{
+			os << (i > 0 ? ", " : "") << "\"" << tagName(static_cast<MemoryTag>(i)) << "\": {";
+			writeUsage(tagUsage[i]);
+			os << "}";
+		}
+		os << "}}";
+	}
+
+	const char* MemoryTracker::tagName(MemoryTag tag)
+	{
+		switch (tag)
+		{
+		case MemoryTag::Textures:
+			return "textures";
+		case MemoryTag::Geometry:
+			return "geometry";
+		case MemoryTag::Uniforms:
+			return "uniforms";
+		case MemoryTag::Attachments:
+			return "attachments";
+		case MemoryTag::Staging:
+			return "staging";
+		default:
+			return "other";
+		}
+	}
+
+	MemoryTag MemoryTracker::tagForBufferUsage(VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags)
+	{
+		if (usageFlags & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+		{
+			return MemoryTag::Uniforms;
+		}
+		if (usageFlags & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR))
+		{
+			return MemoryTag::Geometry;
+		}
+		// Host visible buffers that are only used as a copy source are staging buffers
+		if ((usageFlags == VK_BUFFER_USAGE_TRANSFER_SRC_BIT) && (memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+		{
+			return MemoryTag::Staging;
+		}
+		return MemoryTag::Other;
+	}
+}
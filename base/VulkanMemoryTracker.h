@@ -0,0 +1,98 @@
+/*
+* Vulkan device memory tracker
+*
+* Accounts device memory allocations per memory heap, memory type and subsystem
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	/** @brief Subsystems device memory allocations are accounted to */
+	enum class MemoryTag : uint32_t
+	{
+		Textures,
+		Geometry,
+		Uniforms,
+		Attachments,
+		Staging,
+		Other,
+		Count
+	};
+
+	/**
+	* @brief Keeps track of live and peak device memory usage
+	* @note Only sees allocations made through VulkanDevice::allocateMemory and the MemoryAllocator (or other functions calling track/untrack)
+	* Sub-allocations are accounted with their own size and told apart by their offset into the device memory block
+	*/
+	class MemoryTracker
+	{
+	public:
+		struct Usage
+		{
+			VkDeviceSize live{ 0 };
+			VkDeviceSize peak{ 0 };
+			uint32_t allocations{ 0 };
+		};
+		/** @brief Heap budget and usage of the whole process as reported by VK_EXT_memory_budget */
+		struct HeapBudget
+		{
+			VkDeviceSize budget{ 0 };
+			VkDeviceSize usage{ 0 };
+		};
+
+		void init(VkPhysicalDevice physicalDevice, const VkPhysicalDeviceMemoryProperties& memoryProperties);
+		/** @brief Enables heap budget queries, requires VK_EXT_memory_budget to be enabled on the device */
+		void enableBudget(PFN_vkGetPhysicalDeviceMemoryProperties2KHR getMemoryProperties2);
+		bool budgetAvailable() const;
+
+		void track(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, MemoryTag tag, VkDeviceSize offset = 0);
+		void untrack(VkDeviceMemory memory, VkDeviceSize offset = 0);
+
+		const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const;
+		Usage getHeapUsage(uint32_t heapIndex);
+		Usage getTypeUsage(uint32_t typeIndex);
+		Usage getTagUsage(MemoryTag tag);
+		Usage getTotalUsage();
+		std::vector<HeapBudget> getHeapBudgets() const;
+
+		/** @brief Writes the current statistics as a single JSON object (e.g. for benchmark results) */
+		void writeJson(std::ostream& os);
+
+		static const char* tagName(MemoryTag tag);
+		/** @brief Returns the tag for a buffer based on its usage flags */
+		static MemoryTag tagForBufferUsage(VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags);
+	private:
+		struct Allocation
+		{
+			VkDeviceSize size;
+			uint32_t memoryTypeIndex;
+			MemoryTag tag;
+		};
+		static void add(Usage& usage, VkDeviceSize size);
+		static void remove(Usage& usage, VkDeviceSize size);
+
+		std::mutex mutex;
+		VkPhysicalDevice physicalDevice{ VK_NULL_HANDLE };
+		VkPhysicalDeviceMemoryProperties memoryProperties{};
+		PFN_vkGetPhysicalDeviceMemoryProperties2KHR getMemoryProperties2{ nullptr };
+		std::map<std::pair<VkDeviceMemory, VkDeviceSize>, Allocation> allocations;
+		std::vector<Usage> heapUsage;
+		std::vector<Usage> typeUsage;
+		std::array<Usage, static_cast<size_t>(MemoryTag::Count)> tagUsage{};
+		Usage totalUsage{};
+	};
+}
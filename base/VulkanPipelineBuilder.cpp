@@ -0,0 +1,175 @@
+/*
+* Vulkan parallel pipeline builder
+*
+* Collects pipeline create infos and creates them on multiple threads, each with its own pipeline cache that is merged into the target cache afterwards
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanPipelineBuilder.h"
+#include "VulkanTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace vks
+{
+	namespace
+	{
+		template <typename T>
+		const T* copyState(const T* source, T& target)
+		{
+			if (!source)
+			{
+				return nullptr;
+			}
+			target = *source;
+			return &target;
+		}
+
+		template <typename T>
+		const T* copyArray(const T* source, uint32_t count, std::vector<T>& target)
+		{
+			if (!source || (count == 0))
+			{
+				return source;
+			}
+			target.assign(source, source + count);
+			return target.data();
+		}
+	}
+
+	void PipelineBuilder::add(const VkGraphicsPipelineCreateInfo& pipelineCI, VkPipeline* pipeline)
+	{
+		auto entry = std::make_unique<GraphicsPipeline>();
+		GraphicsPipeline& p = *entry;
+		p.createInfo = pipelineCI;
+		p.pipeline = pipeline;
+		p.createInfo.pStages = copyArray(pipelineCI.pStages, pipelineCI.stageCount, p.stages);
+		if (copyState(pipelineCI.pVertexInputState, p.vertexInputState))
+		{
+			p.vertexInputState.pVertexBindingDescriptions = copyArray(p.vertexInputState.pVertexBindingDescriptions, p.vertexInputState.vertexBindingDescriptionCount, p.vertexBindings);
+			p.vertexInputState.pVertexAttributeDescriptions = copyArray(p.vertexInputState.pVertexAttributeDescriptions, p.vertexInputState.vertexAttributeDescriptionCount, p.vertexAttributes);
+			p.createInfo.pVertexInputState = &p.vertexInputState;
+		}
+		p.createInfo.pInputAssemblyState = copyState(pipelineCI.pInputAssemblyState, p.inputAssemblyState);
+		p.createInfo.pTessellationState = copyState(pipelineCI.pTessellationState, p.tessellationState);
+		if (copyState(pipelineCI.pViewportState, p.viewportState))
+		{
+			p.viewportState.pViewports = copyArray(p.viewportState.pViewports, p.viewportState.viewportCount, p.viewports);
+			p.viewportState.pScissors = copyArray(p.viewportState.pScissors, p.viewportState.scissorCount, p.scissors);
+			p.createInfo.pViewportState = &p.viewportState;
+		}
+		p.createInfo.pRasterizationState = copyState(pipelineCI.pRasterizationState, p.rasterizationState);
+		p.createInfo.pMultisampleState = copyState(pipelineCI.pMultisampleState, p.multisampleState);
+		p.createInfo.pDepthStencilState = copyState(pipelineCI.pDepthStencilState, p.depthStencilState);
+		if (copyState(pipelineCI.pColorBlendState, p.colorBlendState))
+		{
+			p.colorBlendState.pAttachments = copyArray(p.colorBlendState.pAttachments, p.colorBlendState.attachmentCount, p.blendAttachments);
+			p.createInfo.pColorBlendState = &p.colorBlendState;
+		}
+		if (copyState(pipelineCI.pDynamicState, p.dynamicState))
+		{
+			p.dynamicState.pDynamicStates = copyArray(p.dynamicState.pDynamicStates, p.dynamicState.dynamicStateCount, p.dynamicStates);
+			p.createInfo.pDynamicState = &p.dynamicState;
+		}
+		graphicsPipelines.push_back(std::move(entry));
+	}
+
+	void PipelineBuilder::add(const VkComputePipelineCreateInfo& pipelineCI, VkPipeline* pipeline)
+	{
+		computePipelines.push_back({ pipelineCI, pipeline });
+	}
+
+	VkResult PipelineBuilder::create(VkDevice device, VkPipelineCache pipelineCache, size_t index)
+	{
+		if (index < graphicsPipelines.size())
+		{
+			GraphicsPipeline& p = *graphicsPipelines[index];
+			return vkCreateGraphicsPipelines(device, pipelineCache, 1, &p.createInfo, nullptr, p.pipeline);
+		}
+		ComputePipeline& p = computePipelines[index - graphicsPipelines.size()];
+		return vkCreateComputePipelines(device, pipelineCache, 1, &p.createInfo, nullptr, p.pipeline);
+	}
+
+	void PipelineBuilder::build(VkDevice device, VkPipelineCache pipelineCache, uint32_t maxThreads)
+	{
+		const size_t pipelineCount = graphicsPipelines.size() + computePipelines.size();
+		if (maxThreads == 0)
+		{
+			maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+		threadCount = static_cast<uint32_t>(std::min<size_t>(maxThreads, pipelineCount));
+
+		if (threadCount <= 1)
+		{
+			for (size_t i = 0; i < pipelineCount; i++)
+			{
+				VK_CHECK_RESULT(create(device, pipelineCache, i));
+			}
+		}
+		else
+		{
+			// Seed every thread's cache with the current data so pipelines already in the (disk) cache are still hits
+			std::vector<char> cacheData;
+			if (pipelineCache != VK_NULL_HANDLE)
+			{
+				size_t dataSize = 0;
+				VK_CHECK_RESULT(vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr));
+				cacheData.resize(dataSize);
+				VK_CHECK_RESULT(vkGetPipelineCacheData(device, pipelineCache, &dataSize, cacheData.data()));
+			}
+			VkPipelineCacheCreateInfo pipelineCacheCI{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+				.initialDataSize = cacheData.size(),
+				.pInitialData = cacheData.data()
+			};
+			std::vector<VkPipelineCache> threadCaches(threadCount);
+			for (VkPipelineCache& threadCache : threadCaches)
+			{
+				VK_CHECK_RESULT(vkCreatePipelineCache(device, &pipelineCacheCI, nullptr, &threadCache));
+			}
+
+			// Threads pick the next pipeline from a shared counter, so a few expensive pipelines don't stall a statically assigned share
+			std::atomic<size_t> nextPipeline{ 0 };
+			std::vector<VkResult> results(threadCount, VK_SUCCESS);
+			std::vector<std::thread> threads;
+			for (uint32_t t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back([&, t]() {
+					for (size_t i = nextPipeline++; i < pipelineCount; i = nextPipeline++)
+					{
+						VkResult result = create(device, threadCaches[t], i);
+						if (result != VK_SUCCESS)
+						{
+							results[t] = result;
+						}
+					}
+				});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+
+			if (pipelineCache != VK_NULL_HANDLE)
+			{
+				VK_CHECK_RESULT(vkMergePipelineCaches(device, pipelineCache, threadCount, threadCaches.data()));
+			}
+			for (VkPipelineCache threadCache : threadCaches)
+			{
+				vkDestroyPipelineCache(device, threadCache, nullptr);
+			}
+			for (VkResult result : results)
+			{
+				VK_CHECK_RESULT(result);
+			}
+		}
+
+		graphicsPipelines.clear();
+		computePipelines.clear();
+	}
+}
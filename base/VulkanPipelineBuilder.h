@@ -0,0 +1,74 @@
+/*
+* Vulkan parallel pipeline builder
+*
+* Collects pipeline create infos and creates them on multiple threads, each with its own pipeline cache that is merged into the target cache afterwards
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	/**
+	* @brief Creates a batch of pipelines across worker threads
+	* add() takes a snapshot of the create info, so the usual pattern of changing shader stages or fixed function state between pipelines works unchanged. Shader stages, vertex input, input assembly, tessellation, viewport, rasterization, multisample, depth stencil, color blend and dynamic state (including their arrays) are copied. Everything else the create info points to (pNext chains, specialization info, sample masks) must stay valid until build() returns
+	*/
+	class PipelineBuilder
+	{
+	public:
+		/** @brief Queues a pipeline, the handle is written to pipeline by build() */
+		void add(const VkGraphicsPipelineCreateInfo& pipelineCI, VkPipeline* pipeline);
+		void add(const VkComputePipelineCreateInfo& pipelineCI, VkPipeline* pipeline);
+
+		/**
+		* @brief Creates all queued pipelines and clears the queue
+		* @param pipelineCache Cache the pipelines are created with, the worker threads' caches are initialized from and merged into it
+		* @param maxThreads Upper limit for the number of worker threads, 0 uses one per hardware thread
+		*/
+		void build(VkDevice device, VkPipelineCache pipelineCache, uint32_t maxThreads = 0);
+
+		/** @brief Number of threads used by the last build */
+		uint32_t threadCount{ 0 };
+
+	private:
+		struct GraphicsPipeline
+		{
+			VkGraphicsPipelineCreateInfo createInfo;
+			std::vector<VkPipelineShaderStageCreateInfo> stages;
+			VkPipelineVertexInputStateCreateInfo vertexInputState;
+			std::vector<VkVertexInputBindingDescription> vertexBindings;
+			std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+			VkPipelineTessellationStateCreateInfo tessellationState;
+			VkPipelineViewportStateCreateInfo viewportState;
+			std::vector<VkViewport> viewports;
+			std::vector<VkRect2D> scissors;
+			VkPipelineRasterizationStateCreateInfo rasterizationState;
+			VkPipelineMultisampleStateCreateInfo multisampleState;
+			VkPipelineDepthStencilStateCreateInfo depthStencilState;
+			VkPipelineColorBlendStateCreateInfo colorBlendState;
+			std::vector<VkPipelineColorBlendAttachmentState> blendAttachments;
+			VkPipelineDynamicStateCreateInfo dynamicState;
+			std::vector<VkDynamicState> dynamicStates;
+			VkPipeline* pipeline;
+		};
+		struct ComputePipeline
+		{
+			VkComputePipelineCreateInfo createInfo;
+			VkPipeline* pipeline;
+		};
+		// Graphics pipelines are heap allocated as the copied create infos point into them
+		std::vector<std::unique_ptr<GraphicsPipeline>> graphicsPipelines;
+		std::vector<ComputePipeline> computePipelines;
+
+		VkResult create(VkDevice device, VkPipelineCache pipelineCache, size_t index);
+	};
+}
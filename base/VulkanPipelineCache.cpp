@@ -0,0 +1,150 @@
+/*
+* Vulkan pipeline cache persisted to disk
+*
+* Loads pipeline cache data written by a previous run on the same device and driver, and saves it again on shutdown
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanPipelineCache.h"
+#include "VulkanTools.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace vks
+{
+	/**
+	* Create the pipeline cache
+	*
+	* @param device Logical device to create the cache on
+	* @param properties Properties of the physical device, used to validate the stored data
+	* @param filename File the cache is loaded from and saved to, an empty filename creates a cache that is never saved
+	*/
+	VkPipelineCache PipelineCache::create(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& filename)
+	{
+		this->device = device;
+		this->properties = properties;
+		this->filename = filename;
+
+		std::vector<char> fileData;
+		if (!filename.empty())
+		{
+			std::ifstream is(filename, std::ios::binary | std::ios::ate);
+			if (is.is_open())
+			{
+				fileData.resize(static_cast<size_t>(is.tellg()));
+				is.seekg(0, std::ios::beg);
+				is.read(fileData.data(), fileData.size());
+				if (!is)
+				{
+					fileData.clear();
+				}
+			}
+		}
+
+		VkPipelineCacheCreateInfo pipelineCacheCI{ .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+		if (fileData.size() >= sizeof(FileHeader))
+		{
+			FileHeader header;
+			memcpy(&header, fileData.data(), sizeof(FileHeader));
+			const char* data = fileData.data() + sizeof(FileHeader);
+			if ((header.dataSize == fileData.size() - sizeof(FileHeader)) && matchesDevice(header, data))
+			{
+				pipelineCacheCI.initialDataSize = static_cast<size_t>(header.dataSize);
+				pipelineCacheCI.pInitialData = data;
+				coldCreationTime = header.coldCreationTime;
+			}
+		}
+		VkResult result = vkCreatePipelineCache(device, &pipelineCacheCI, nullptr, &handle);
+		if ((result != VK_SUCCESS) && (pipelineCacheCI.initialDataSize > 0))
+		{
+			// Drivers may still reject data that passed the header checks, start with an empty cache instead
+			pipelineCacheCI.initialDataSize = 0;
+			pipelineCacheCI.pInitialData = nullptr;
+			coldCreationTime = -1.0;
+			result = vkCreatePipelineCache(device, &pipelineCacheCI, nullptr, &handle);
+		}
+		VK_CHECK_RESULT(result);
+		warm = pipelineCacheCI.initialDataSize > 0;
+		loadedSize = pipelineCacheCI.initialDataSize;
+		return handle;
+	}
+
+	bool PipelineCache::save(double creationTime)
+	{
+		if ((handle == VK_NULL_HANDLE) || filename.empty())
+		{
+			return false;
+		}
+		size_t dataSize = 0;
+		VK_CHECK_RESULT(vkGetPipelineCacheData(device, handle, &dataSize, nullptr));
+		std::vector<char> data(dataSize);
+		VK_CHECK_RESULT(vkGetPipelineCacheData(device, handle, &dataSize, data.data()));
+
+		FileHeader header{};
+		header.magic = fileMagic;
+		header.version = fileVersion;
+		header.vendorID = properties.vendorID;
+		header.deviceID = properties.deviceID;
+		header.driverVersion = properties.driverVersion;
+		memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+		header.coldCreationTime = warm ? coldCreationTime : creationTime;
+		header.dataSize = dataSize;
+
+		const std::string tempFilename = filename + ".tmp";
+		{
+			std::ofstream os(tempFilename, std::ios::binary | std::ios::trunc);
+			if (!os.is_open())
+			{
+				return false;
+			}
+			os.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+			os.write(data.data(), dataSize);
+			if (!os)
+			{
+				return false;
+			}
+		}
+		// Replaces an existing file on all platforms
+		std::error_code error;
+		std::filesystem::rename(tempFilename, filename, error);
+		if (error)
+		{
+			std::filesystem::remove(tempFilename, error);
+			return false;
+		}
+		return true;
+	}
+
+	void PipelineCache::destroy()
+	{
+		if (handle != VK_NULL_HANDLE)
+		{
+			vkDestroyPipelineCache(device, handle, nullptr);
+			handle = VK_NULL_HANDLE;
+		}
+	}
+
+	bool PipelineCache::matchesDevice(const FileHeader& header, const char* data) const
+	{
+		if ((header.magic != fileMagic) || (header.version != fileVersion) || (header.vendorID != properties.vendorID) || (header.deviceID != properties.deviceID) ||
+			(header.driverVersion != properties.driverVersion) || (memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0))
+		{
+			return false;
+		}
+		// The driver's own header has to agree with ours, in case the data was modified
+		VkPipelineCacheHeaderVersionOne cacheHeader;
+		if (header.dataSize < sizeof(cacheHeader))
+		{
+			return false;
+		}
+		memcpy(&cacheHeader, data, sizeof(cacheHeader));
+		return (cacheHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) && (cacheHeader.vendorID == properties.vendorID) && (cacheHeader.deviceID == properties.deviceID) &&
+			(memcmp(cacheHeader.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0);
+	}
+}
@@ -0,0 +1,63 @@
+/*
+* Vulkan pipeline cache persisted to disk
+*
+* Loads pipeline cache data written by a previous run on the same device and driver, and saves it again on shutdown
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <string>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	/**
+	* @brief Pipeline cache that is loaded from and saved to a file
+	* The file starts with a header identifying the vendor, device, driver version and pipeline cache UUID the data was created with. Data written for anything else is discarded instead of being passed to the driver
+	*/
+	class PipelineCache
+	{
+	public:
+		/** @brief Creates the cache, initialized with the data stored in filename if it matches the device, empty otherwise */
+		VkPipelineCache create(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& filename);
+		/**
+		* @brief Writes the cache data to a temporary file that then replaces filename, so an interrupted write never leaves a truncated cache behind
+		* @param creationTime Pipeline creation time of this run in ms, stored as the cold creation time if the cache was created empty
+		*/
+		bool save(double creationTime);
+		void destroy();
+
+		VkPipelineCache handle{ VK_NULL_HANDLE };
+		/** @brief True if the cache was initialized with data from disk */
+		bool warm{ false };
+		size_t loadedSize{ 0 };
+		/** @brief Pipeline creation time in ms of the run that created the cache file from an empty cache, negative if unknown */
+		double coldCreationTime{ -1.0 };
+
+	private:
+		struct FileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint32_t driverVersion;
+			uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+			double coldCreationTime;
+			uint64_t dataSize;
+		};
+		static constexpr uint32_t fileMagic = 0x43504B56; // "VKPC"
+		static constexpr uint32_t fileVersion = 1;
+
+		VkDevice device{ VK_NULL_HANDLE };
+		VkPhysicalDeviceProperties properties{};
+		std::string filename;
+
+		bool matchesDevice(const FileHeader& header, const char* data) const;
+	};
+}
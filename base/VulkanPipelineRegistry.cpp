@@ -0,0 +1,335 @@
+/*
+* Vulkan pipeline registry
+*
+* Returns an existing pipeline for create infos that were already used, instead of creating the same pipeline again
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanPipelineRegistry.h"
+#include "VulkanTools.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace vks
+{
+	namespace
+	{
+		// Only used for types without padding, structures with pointers are written field by field
+		template <typename T>
+		void append(std::string& key, const T& value)
+		{
+			key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template <typename T>
+		void appendArray(std::string& key, const T* values, uint32_t count)
+		{
+			append(key, count);
+			if (values && (count > 0))
+			{
+				key.append(reinterpret_cast<const char*>(values), sizeof(T) * count);
+			}
+		}
+
+		// Marks the presence of an optional state, so a missing state doesn't match one with all fields zero
+		template <typename T>
+		bool appendPresence(std::string& key, const T* state)
+		{
+			append(key, static_cast<uint8_t>(state != nullptr));
+			return state != nullptr;
+		}
+	}
+
+	void PipelineRegistry::prepare(VkDevice device)
+	{
+		this->device = device;
+	}
+
+	void PipelineRegistry::destroy()
+	{
+		for (auto& [key, entry] : pipelines)
+		{
+			vkDestroyPipeline(device, entry.pipeline, nullptr);
+		}
+		for (const Entry& entry : uncachedPipelines)
+		{
+			vkDestroyPipeline(device, entry.pipeline, nullptr);
+		}
+		pipelines.clear();
+		uncachedPipelines.clear();
+		shaderHashes.clear();
+	}
+
+	template <typename Match>
+	void PipelineRegistry::evict(Match match)
+	{
+		for (auto it = pipelines.begin(); it != pipelines.end();)
+		{
+			if (match(it->second))
+			{
+				vkDestroyPipeline(device, it->second.pipeline, nullptr);
+				it = pipelines.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		std::erase_if(uncachedPipelines, [this, &match](const Entry& entry) {
+			if (match(entry))
+			{
+				vkDestroyPipeline(device, entry.pipeline, nullptr);
+				return true;
+			}
+			return false;
+		});
+	}
+
+	void PipelineRegistry::forget(VkPipelineLayout layout)
+	{
+		evict([layout](const Entry& entry) { return entry.layout == layout; });
+	}
+
+	void PipelineRegistry::forget(VkRenderPass renderPass)
+	{
+		evict([renderPass](const Entry& entry) { return entry.renderPass == renderPass; });
+	}
+
+	void PipelineRegistry::registerShader(VkShaderModule shaderModule, uint64_t hash)
+	{
+		shaderHashes[shaderModule] = hash;
+	}
+
+	uint64_t PipelineRegistry::hash(const void* data, size_t size, uint64_t seed)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash = seed;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	void PipelineRegistry::appendStage(std::string& key, const VkPipelineShaderStageCreateInfo& stage) const
+	{
+		append(key, stage.flags);
+		append(key, stage.stage);
+		auto shaderHash = shaderHashes.find(stage.module);
+		append(key, (shaderHash != shaderHashes.end()) ? shaderHash->second : reinterpret_cast<uint64_t>(stage.module));
+		const std::string entryPoint = stage.pName ? stage.pName : "";
+		append(key, static_cast<uint32_t>(entryPoint.size()));
+		key.append(entryPoint);
+		if (appendPresence(key, stage.pSpecializationInfo))
+		{
+			const VkSpecializationInfo& specializationInfo = *stage.pSpecializationInfo;
+			append(key, specializationInfo.mapEntryCount);
+			for (uint32_t i = 0; i < specializationInfo.mapEntryCount; i++)
+			{
+				const VkSpecializationMapEntry& mapEntry = specializationInfo.pMapEntries[i];
+				append(key, mapEntry.constantID);
+				append(key, mapEntry.offset);
+				append(key, static_cast<uint64_t>(mapEntry.size));
+			}
+			append(key, static_cast<uint64_t>(specializationInfo.dataSize));
+			key.append(static_cast<const char*>(specializationInfo.pData), specializationInfo.dataSize);
+		}
+	}
+
+	VkPipeline PipelineRegistry::getGraphicsPipeline(const VkGraphicsPipelineCreateInfo& pipelineCI, VkPipelineCache pipelineCache)
+	{
+		std::string key;
+		bool cacheable = true;
+		append(key, pipelineCI.sType);
+		append(key, pipelineCI.flags);
+
+		append(key, pipelineCI.stageCount);
+		for (uint32_t i = 0; i < pipelineCI.stageCount; i++)
+		{
+			cacheable &= (pipelineCI.pStages[i].pNext == nullptr);
+			appendStage(key, pipelineCI.pStages[i]);
+		}
+		if (appendPresence(key, pipelineCI.pVertexInputState))
+		{
+			const VkPipelineVertexInputStateCreateInfo& state = *pipelineCI.pVertexInputState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			appendArray(key, state.pVertexBindingDescriptions, state.vertexBindingDescriptionCount);
+			appendArray(key, state.pVertexAttributeDescriptions, state.vertexAttributeDescriptionCount);
+		}
+		if (appendPresence(key, pipelineCI.pInputAssemblyState))
+		{
+			const VkPipelineInputAssemblyStateCreateInfo& state = *pipelineCI.pInputAssemblyState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			append(key, state.topology);
+			append(key, state.primitiveRestartEnable);
+		}
+		if (appendPresence(key, pipelineCI.pTessellationState))
+		{
+			const VkPipelineTessellationStateCreateInfo& state = *pipelineCI.pTessellationState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			append(key, state.patchControlPoints);
+		}
+		if (appendPresence(key, pipelineCI.pViewportState))
+		{
+			const VkPipelineViewportStateCreateInfo& state = *pipelineCI.pViewportState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			appendArray(key, state.pViewports, state.viewportCount);
+			appendArray(key, state.pScissors, state.scissorCount);
+		}
+		if (appendPresence(key, pipelineCI.pRasterizationState))
+		{
+			const VkPipelineRasterizationStateCreateInfo& state = *pipelineCI.pRasterizationState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			append(key, state.depthClampEnable);
+			append(key, state.rasterizerDiscardEnable);
+			append(key, state.polygonMode);
+			append(key, state.cullMode);
+			append(key, state.frontFace);
+			append(key, state.depthBiasEnable);
+			append(key, state.depthBiasConstantFactor);
+			append(key, state.depthBiasClamp);
+			append(key, state.depthBiasSlopeFactor);
+			append(key, state.lineWidth);
+		}
+		if (appendPresence(key, pipelineCI.pMultisampleState))
+		{
+			const VkPipelineMultisampleStateCreateInfo& state = *pipelineCI.pMultisampleState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			append(key, state.rasterizationSamples);
+			append(key, state.sampleShadingEnable);
+			append(key, state.minSampleShading);
+			appendArray(key, state.pSampleMask, state.pSampleMask ? (static_cast<uint32_t>(state.rasterizationSamples) + 31) / 32 : 0);
+			append(key, state.alphaToCoverageEnable);
+			append(key, state.alphaToOneEnable);
+		}
+		if (appendPresence(key, pipelineCI.pDepthStencilState))
+		{
+			const VkPipelineDepthStencilStateCreateInfo& state = *pipelineCI.pDepthStencilState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			append(key, state.depthTestEnable);
+			append(key, state.depthWriteEnable);
+			append(key, state.depthCompareOp);
+			append(key, state.depthBoundsTestEnable);
+			append(key, state.stencilTestEnable);
+			append(key, state.front);
+			append(key, state.back);
+			append(key, state.minDepthBounds);
+			append(key, state.maxDepthBounds);
+		}
+		if (appendPresence(key, pipelineCI.pColorBlendState))
+		{
+			const VkPipelineColorBlendStateCreateInfo& state = *pipelineCI.pColorBlendState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			append(key, state.logicOpEnable);
+			append(key, state.logicOp);
+			appendArray(key, state.pAttachments, state.attachmentCount);
+			append(key, state.blendConstants);
+		}
+		if (appendPresence(key, pipelineCI.pDynamicState))
+		{
+			const VkPipelineDynamicStateCreateInfo& state = *pipelineCI.pDynamicState;
+			cacheable &= (state.pNext == nullptr);
+			append(key, state.flags);
+			appendArray(key, state.pDynamicStates, state.dynamicStateCount);
+		}
+		append(key, pipelineCI.layout);
+		append(key, pipelineCI.renderPass);
+		append(key, pipelineCI.subpass);
+		append(key, pipelineCI.basePipelineHandle);
+		append(key, pipelineCI.basePipelineIndex);
+
+		for (const VkBaseInStructure* next = static_cast<const VkBaseInStructure*>(pipelineCI.pNext); next; next = next->pNext)
+		{
+			append(key, next->sType);
+			if (next->sType == VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR)
+			{
+				const VkPipelineRenderingCreateInfoKHR* renderingCI = reinterpret_cast<const VkPipelineRenderingCreateInfoKHR*>(next);
+				append(key, renderingCI->viewMask);
+				appendArray(key, renderingCI->pColorAttachmentFormats, renderingCI->colorAttachmentCount);
+				append(key, renderingCI->depthAttachmentFormat);
+				append(key, renderingCI->stencilAttachmentFormat);
+			}
+			else
+			{
+				cacheable = false;
+			}
+		}
+
+		if (cacheable)
+		{
+			auto pipeline = pipelines.find(key);
+			if (pipeline != pipelines.end())
+			{
+				hits++;
+				return pipeline->second.pipeline;
+			}
+		}
+
+		const auto tStart = std::chrono::high_resolution_clock::now();
+		VkPipeline pipeline;
+		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
+		creationTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+		misses++;
+		const Entry entry{ pipeline, pipelineCI.layout, pipelineCI.renderPass };
+		if (cacheable)
+		{
+			pipelines[key] = entry;
+		}
+		else
+		{
+			uncachedPipelines.push_back(entry);
+		}
+		return pipeline;
+	}
+
+	VkPipeline PipelineRegistry::getComputePipeline(const VkComputePipelineCreateInfo& pipelineCI, VkPipelineCache pipelineCache)
+	{
+		std::string key;
+		append(key, pipelineCI.sType);
+		append(key, pipelineCI.flags);
+		appendStage(key, pipelineCI.stage);
+		append(key, pipelineCI.layout);
+		append(key, pipelineCI.basePipelineHandle);
+		append(key, pipelineCI.basePipelineIndex);
+		const bool cacheable = (pipelineCI.pNext == nullptr) && (pipelineCI.stage.pNext == nullptr);
+
+		if (cacheable)
+		{
+			auto pipeline = pipelines.find(key);
+			if (pipeline != pipelines.end())
+			{
+				hits++;
+				return pipeline->second.pipeline;
+			}
+		}
+
+		const auto tStart = std::chrono::high_resolution_clock::now();
+		VkPipeline pipeline;
+		VK_CHECK_RESULT(vkCreateComputePipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
+		creationTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+		misses++;
+		const Entry entry{ pipeline, pipelineCI.layout, VK_NULL_HANDLE };
+		if (cacheable)
+		{
+			pipelines[key] = entry;
+		}
+		else
+		{
+			uncachedPipelines.push_back(entry);
+		}
+		return pipeline;
+	}
+}
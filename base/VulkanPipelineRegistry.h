@@ -0,0 +1,74 @@
+/*
+* Vulkan pipeline registry
+*
+* Returns an existing pipeline for create infos that were already used, instead of creating the same pipeline again
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	/**
+	* @brief Deduplicates pipelines by their complete create info
+	* The key covers flags, shader stages (by shader hash, entry point and specialization constants), all fixed function state, dynamic states, layout, render pass and subpass, and the formats of VkPipelineRenderingCreateInfo for dynamic rendering
+	* Shaders are identified by the hash registered with registerShader(), other modules by their handle. Create infos with pNext structures that aren't part of the key are not deduplicated, but the resulting pipelines are still owned by the registry
+	* Pipelines are owned by the registry and must not be destroyed by the caller
+	* Layouts and render passes are part of the key by handle, and a destroyed object's handle may be reused by a new one. forget() must be called before destroying a layout or render pass that was used with the registry, unless the registry is destroyed first
+	*/
+	class PipelineRegistry
+	{
+	public:
+		void prepare(VkDevice device);
+		/** @brief Destroys all pipelines returned by the registry */
+		void destroy();
+
+		/** @brief Associates a shader module with a hash of its code (or source), so pipelines using different modules with the same code are deduplicated */
+		void registerShader(VkShaderModule shaderModule, uint64_t hash);
+
+		/** @brief Returns the pipeline for the create info, creating it on first use */
+		VkPipeline getGraphicsPipeline(const VkGraphicsPipelineCreateInfo& pipelineCI, VkPipelineCache pipelineCache);
+		VkPipeline getComputePipeline(const VkComputePipelineCreateInfo& pipelineCI, VkPipelineCache pipelineCache);
+
+		/** @brief Destroys all pipelines created with the layout or render pass, these must no longer be in use by the device */
+		void forget(VkPipelineLayout layout);
+		void forget(VkRenderPass renderPass);
+
+		/** @brief Number of lookups that returned an existing pipeline and that created a new one, and the time spent creating pipelines in ms */
+		uint64_t hits{ 0 };
+		uint64_t misses{ 0 };
+		double creationTime{ 0.0 };
+		size_t pipelineCount() const { return pipelines.size() + uncachedPipelines.size(); }
+
+		/** @brief FNV-1a hash of a block of memory */
+		static uint64_t hash(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull);
+
+	private:
+		// Layout and render pass are kept with each pipeline for forget()
+		struct Entry
+		{
+			VkPipeline pipeline;
+			VkPipelineLayout layout;
+			VkRenderPass renderPass;
+		};
+
+		VkDevice device{ VK_NULL_HANDLE };
+		// Keyed by the serialized create info
+		std::unordered_map<std::string, Entry> pipelines;
+		std::vector<Entry> uncachedPipelines;
+		std::unordered_map<VkShaderModule, uint64_t> shaderHashes;
+
+		void appendStage(std::string& key, const VkPipelineShaderStageCreateInfo& stage) const;
+		template <typename Match>
+		void evict(Match match);
+	};
+}
@@ -145,20 +145,9 @@ VulkanRaytracingSample::ScratchBuffer VulkanRaytracingSample::createScratchBuffe
 		.sharingMode = VK_SHARING_MODE_EXCLUSIVE
 	};
 	VK_CHECK_RESULT(vkCreateBuffer(vulkanDevice_->logicalDevice, &bufferCreateInfo, nullptr, &scratchBuffer.handle));
-	VkMemoryRequirements memoryRequirements{};
-	vkGetBufferMemoryRequirements(vulkanDevice_->logicalDevice, scratchBuffer.handle, &memoryRequirements);
-	VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{
-		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
-		.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR
-	};
-	VkMemoryAllocateInfo memoryAllocateInfo{
-		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-		.pNext = &memoryAllocateFlagsInfo,
-		.allocationSize = memoryRequirements.size,
-		.memoryTypeIndex = vulkanDevice_->getMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-	};
-	VK_CHECK_RESULT(vkAllocateMemory(vulkanDevice_->logicalDevice, &memoryAllocateInfo, nullptr, &scratchBuffer.memory));
-	VK_CHECK_RESULT(vkBindBufferMemory(vulkanDevice_->logicalDevice, scratchBuffer.handle, scratchBuffer.memory, 0));
+	// Acceleration structure and scratch buffers are accessed via device addresses
+	VK_CHECK_RESULT(vulkanDevice_->allocateBufferMemory(scratchBuffer.handle, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vks::MemoryTag::Geometry, &scratchBuffer.allocation, true));
+	scratchBuffer.memory = scratchBuffer.allocation.memory;
 	VkBufferDeviceAddressInfoKHR bufferDeviceAddresInfo{
 		.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
 		.buffer = scratchBuffer.handle
@@ -169,9 +158,7 @@ VulkanRaytracingSample::ScratchBuffer VulkanRaytracingSample::createScratchBuffe
 
 void VulkanRaytracingSample::deleteScratchBuffer(ScratchBuffer& scratchBuffer)
 {
-	if (scratchBuffer.memory != VK_NULL_HANDLE) {
-		vkFreeMemory(vulkanDevice_->logicalDevice, scratchBuffer.memory, nullptr);
-	}
+	vulkanDevice_->freeAllocation(scratchBuffer.allocation);
 	if (scratchBuffer.handle != VK_NULL_HANDLE) {
 		vkDestroyBuffer(vulkanDevice_->logicalDevice, scratchBuffer.handle, nullptr);
 	}
@@ -186,20 +173,9 @@ void VulkanRaytracingSample::createAccelerationStructure(AccelerationStructure&
 		.sharingMode = VK_SHARING_MODE_EXCLUSIVE
 	};
 	VK_CHECK_RESULT(vkCreateBuffer(vulkanDevice_->logicalDevice, &bufferCreateInfo, nullptr, &accelerationStructure.buffer));
-	VkMemoryRequirements memoryRequirements{};
-	vkGetBufferMemoryRequirements(vulkanDevice_->logicalDevice, accelerationStructure.buffer, &memoryRequirements);
-	VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{
-		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
-		.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR
-	};
-	VkMemoryAllocateInfo memoryAllocateInfo{
-		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-		.pNext = &memoryAllocateFlagsInfo,
-		.allocationSize = memoryRequirements.size,
-		.memoryTypeIndex = vulkanDevice_->getMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-	};
-	VK_CHECK_RESULT(vkAllocateMemory(vulkanDevice_->logicalDevice, &memoryAllocateInfo, nullptr, &accelerationStructure.memory));
-	VK_CHECK_RESULT(vkBindBufferMemory(vulkanDevice_->logicalDevice, accelerationStructure.buffer, accelerationStructure.memory, 0));
+	// Acceleration structure and scratch buffers are accessed via device addresses
+	VK_CHECK_RESULT(vulkanDevice_->allocateBufferMemory(accelerationStructure.buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vks::MemoryTag::Geometry, &accelerationStructure.allocation, true));
+	accelerationStructure.memory = accelerationStructure.allocation.memory;
 	VkAccelerationStructureCreateInfoKHR accelerationStructureCreate_info{
 		.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
 		.buffer = accelerationStructure.buffer,
@@ -216,7 +192,12 @@ void VulkanRaytracingSample::createAccelerationStructure(AccelerationStructure&
 
 void VulkanRaytracingSample::deleteAccelerationStructure(AccelerationStructure& accelerationStructure)
 {
-	vkFreeMemory(device_, accelerationStructure.memory, nullptr);
+	if (accelerationStructure.allocation.valid()) {
+		vulkanDevice_->freeAllocation(accelerationStructure.allocation);
+	} else {
+		// Buffer memory allocated by the sample
+		vulkanDevice_->freeMemory(accelerationStructure.memory);
+	}
 	vkDestroyBuffer(device_, accelerationStructure.buffer, nullptr);
 	vkDestroyAccelerationStructureKHR(device_, accelerationStructure.handle, nullptr);
 }
@@ -236,7 +217,7 @@ void VulkanRaytracingSample::createStorageImage(VkFormat format, VkExtent3D exte
 	if (storageImage.image != VK_NULL_HANDLE) {
 		vkDestroyImageView(device_, storageImage.view, nullptr);
 		vkDestroyImage(device_, storageImage.image, nullptr);
-		vkFreeMemory(device_, storageImage.memory, nullptr);
+		vulkanDevice_->freeAllocation(storageImage.allocation);
 		storageImage = {};
 	}
 
@@ -254,13 +235,8 @@ void VulkanRaytracingSample::createStorageImage(VkFormat format, VkExtent3D exte
 	};
 	VK_CHECK_RESULT(vkCreateImage(vulkanDevice_->logicalDevice, &image, nullptr, &storageImage.image));
 
-	VkMemoryRequirements memReqs;
-	vkGetImageMemoryRequirements(vulkanDevice_->logicalDevice, storageImage.image, &memReqs);
-	VkMemoryAllocateInfo memoryAllocateInfo = vks::initializers::memoryAllocateInfo();
-	memoryAllocateInfo.allocationSize = memReqs.size;
-	memoryAllocateInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(vulkanDevice_->logicalDevice, &memoryAllocateInfo, nullptr, &storageImage.memory));
-	VK_CHECK_RESULT(vkBindImageMemory(vulkanDevice_->logicalDevice, storageImage.image, storageImage.memory, 0));
+	VK_CHECK_RESULT(vulkanDevice_->allocateImageMemory(storageImage.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vks::MemoryTag::Attachments, &storageImage.allocation));
+	storageImage.memory = storageImage.allocation.memory;
 
 	VkImageViewCreateInfo colorImageView{
 		.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
@@ -277,19 +253,19 @@ void VulkanRaytracingSample::createStorageImage(VkFormat format, VkExtent3D exte
 	};
 	VK_CHECK_RESULT(vkCreateImageView(vulkanDevice_->logicalDevice, &colorImageView, nullptr, &storageImage.view));
 
-	VkCommandBuffer cmdBuffer = vulkanDevice_->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	VkCommandBuffer cmdBuffer = vulkanDevice_->immediateContext.begin(vulkanDevice_->queueFamilyIndices.graphics);
 	vks::tools::setImageLayout(cmdBuffer, storageImage.image,
 		VK_IMAGE_LAYOUT_UNDEFINED,
 		VK_IMAGE_LAYOUT_GENERAL,
 		{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 });
-	vulkanDevice_->flushCommandBuffer(cmdBuffer, queue_);
+	vulkanDevice_->immediateContext.submit(cmdBuffer, queue_);
 }
 
 void VulkanRaytracingSample::deleteStorageImage()
 {
 	vkDestroyImageView(vulkanDevice_->logicalDevice, storageImage.view, nullptr);
 	vkDestroyImage(vulkanDevice_->logicalDevice, storageImage.image, nullptr);
-	vkFreeMemory(vulkanDevice_->logicalDevice, storageImage.memory, nullptr);
+	vulkanDevice_->freeAllocation(storageImage.allocation);
 }
 
 void VulkanRaytracingSample::prepare()
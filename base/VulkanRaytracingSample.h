@@ -48,6 +48,7 @@ public:
 		uint64_t deviceAddress{ 0 };
 		VkBuffer handle{ VK_NULL_HANDLE };
 		VkDeviceMemory memory{ VK_NULL_HANDLE };
+		vks::MemoryAllocation allocation;
 	};
 
 	// Holds information for a ray tracing acceleration structure
@@ -55,12 +56,14 @@ public:
 		VkAccelerationStructureKHR handle{ VK_NULL_HANDLE };
 		uint64_t deviceAddress{ 0 };
 		VkDeviceMemory memory{ VK_NULL_HANDLE };
+		vks::MemoryAllocation allocation;
 		VkBuffer buffer{ VK_NULL_HANDLE };
 	};
 
 	// Holds information for a storage image that the ray tracing shaders output to
 	struct StorageImage {
 		VkDeviceMemory memory{ VK_NULL_HANDLE };
+		vks::MemoryAllocation allocation;
 		VkImage image{ VK_NULL_HANDLE };
 		VkImageView view{ VK_NULL_HANDLE };
 		VkFormat format;
@@ -0,0 +1,200 @@
+/*
+* Memory mapped SPIR-V shader archive
+*
+* Reads the archives written by shaders/packshaders.py, shader code is used directly from the mapped file without copying
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanShaderArchive.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#elif !defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vks
+{
+	ShaderArchive::~ShaderArchive()
+	{
+		close();
+	}
+
+	/**
+	* Map an archive into memory
+	*
+	* @param filename Archive written by packshaders.py
+	*
+	* @note Not supported on Android, where shaders are read from the apk's assets
+	*/
+	bool ShaderArchive::open(const std::string& filename)
+	{
+		close();
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		HANDLE mapping = nullptr;
+		if (GetFileSizeEx(file, &fileSize) && (fileSize.QuadPart > 0))
+		{
+			mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		}
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		fileHandle = file;
+		mappingHandle = mapping;
+		size = static_cast<size_t>(fileSize.QuadPart);
+#elif !defined(__ANDROID__)
+		int file = ::open(filename.c_str(), O_RDONLY);
+		if (file < 0)
+		{
+			return false;
+		}
+		struct stat fileStat;
+		if ((fstat(file, &fileStat) != 0) || (fileStat.st_size == 0))
+		{
+			::close(file);
+			return false;
+		}
+		void* mapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		// The mapping keeps the file alive
+		::close(file);
+		if (mapped == MAP_FAILED)
+		{
+			return false;
+		}
+		data = static_cast<const uint8_t*>(mapped);
+		size = static_cast<size_t>(fileStat.st_size);
+#endif
+		if (!data || !validate())
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void ShaderArchive::close()
+	{
+#if defined(_WIN32)
+		if (data)
+		{
+			UnmapViewOfFile(data);
+		}
+		if (mappingHandle)
+		{
+			CloseHandle(mappingHandle);
+			mappingHandle = nullptr;
+		}
+		if (fileHandle)
+		{
+			CloseHandle(fileHandle);
+			fileHandle = nullptr;
+		}
+#elif !defined(__ANDROID__)
+		if (data)
+		{
+			munmap(const_cast<uint8_t*>(data), size);
+		}
+#endif
+		data = nullptr;
+		size = 0;
+		fileEntries = nullptr;
+		blobs = nullptr;
+		blobCount = 0;
+		entries.clear();
+	}
+
+	bool ShaderArchive::find(std::string_view path, Shader& shader) const
+	{
+		auto entry = entries.find(path);
+		if (entry == entries.end())
+		{
+			return false;
+		}
+		const FileEntry& fileEntry = fileEntries[entry->second];
+		const FileBlob& blob = blobs[fileEntry.blobIndex];
+		shader.code = reinterpret_cast<const uint32_t*>(data + blob.offset);
+		shader.size = static_cast<size_t>(blob.size);
+		shader.hash = blob.hash;
+		shader.sourceSize = fileEntry.sourceSize;
+		shader.sourceTime = fileEntry.sourceTime;
+		return true;
+	}
+
+	// Only the file's metadata is read, which is much cheaper than reading and hashing its code
+	bool ShaderArchive::matchesSource(const Shader& shader, const std::string& sourceFile)
+	{
+#if defined(__ANDROID__)
+		return true;
+#else
+#if defined(_WIN32)
+		struct _stat64 fileStat;
+		if (_stat64(sourceFile.c_str(), &fileStat) != 0)
+#else
+		struct stat fileStat;
+		if (stat(sourceFile.c_str(), &fileStat) != 0)
+#endif
+		{
+			return true;
+		}
+		return (static_cast<uint64_t>(fileStat.st_size) == shader.sourceSize) && (static_cast<int64_t>(fileStat.st_mtime) == shader.sourceTime);
+#endif
+	}
+
+	// Checks all offsets against the file size once, so lookups don't have to
+	bool ShaderArchive::validate()
+	{
+		FileHeader header;
+		if (size < sizeof(FileHeader))
+		{
+			return false;
+		}
+		memcpy(&header, data, sizeof(FileHeader));
+		const uint64_t tablesSize = sizeof(FileHeader) + uint64_t(header.entryCount) * sizeof(FileEntry) + uint64_t(header.blobCount) * sizeof(FileBlob);
+		if ((memcmp(header.magic, "VKSP", 4) != 0) || (header.version != fileVersion) || (tablesSize > size) ||
+			(header.stringTableOffset > size) || (header.stringTableSize > size - header.stringTableOffset))
+		{
+			return false;
+		}
+		blobs = reinterpret_cast<const FileBlob*>(data + sizeof(FileHeader) + header.entryCount * sizeof(FileEntry));
+		for (uint32_t i = 0; i < header.blobCount; i++)
+		{
+			// vkCreateShaderModule reads the code as 32 bit words
+			if ((blobs[i].offset % 4 != 0) || (blobs[i].size % 4 != 0) || (blobs[i].offset > size) || (blobs[i].size > size - blobs[i].offset))
+			{
+				return false;
+			}
+		}
+		fileEntries = reinterpret_cast<const FileEntry*>(data + sizeof(FileHeader));
+		const char* stringTable = reinterpret_cast<const char*>(data + header.stringTableOffset);
+		for (uint32_t i = 0; i < header.entryCount; i++)
+		{
+			const FileEntry& entry = fileEntries[i];
+			if ((entry.blobIndex >= header.blobCount) || (uint64_t(entry.pathOffset) + entry.pathLength > header.stringTableSize))
+			{
+				return false;
+			}
+			entries[std::string_view(stringTable + entry.pathOffset, entry.pathLength)] = i;
+		}
+		blobCount = header.blobCount;
+		return true;
+	}
+}
@@ -0,0 +1,96 @@
+/*
+* Memory mapped SPIR-V shader archive
+*
+* Reads the archives written by shaders/packshaders.py, shader code is used directly from the mapped file without copying
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace vks
+{
+	/**
+	* @brief Read only view of a packed shader archive
+	* The archive holds the SPIR-V of a shading language folder, indexed by the path relative to that folder. Files with identical code share a single blob, identified by its content hash
+	*/
+	class ShaderArchive
+	{
+	public:
+		struct Shader
+		{
+			/** @brief SPIR-V code inside the mapped file, valid until the archive is closed */
+			const uint32_t* code;
+			size_t size;
+			uint64_t hash;
+			/** @brief Size and modification time (in seconds since the epoch) of the .spv file when it was packed */
+			uint64_t sourceSize;
+			int64_t sourceTime;
+		};
+
+		ShaderArchive() = default;
+		ShaderArchive(const ShaderArchive&) = delete;
+		ShaderArchive& operator=(const ShaderArchive&) = delete;
+		~ShaderArchive();
+
+		/** @brief Maps the archive, returns false if the file does not exist or is not a valid archive */
+		bool open(const std::string& filename);
+		void close();
+		bool isOpen() const { return data != nullptr; }
+
+		/** @brief Looks up a shader by its path relative to the shading language folder (e.g. "base/uioverlay.vert.spv") */
+		bool find(std::string_view path, Shader& shader) const;
+		/** @brief Returns false if the .spv file a shader was packed from has a different size or modification time now, i.e. the archive is out of date. A missing file counts as a match, so archives can be used without the loose files */
+		static bool matchesSource(const Shader& shader, const std::string& sourceFile);
+
+		/** @brief Number of paths and of unique blobs in the archive */
+		uint32_t shaderCount() const { return static_cast<uint32_t>(entries.size()); }
+		uint32_t blobCount{ 0 };
+
+	private:
+		struct FileHeader
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t entryCount;
+			uint32_t blobCount;
+			uint64_t stringTableOffset;
+			uint64_t stringTableSize;
+		};
+		struct FileEntry
+		{
+			uint32_t pathOffset;
+			uint32_t pathLength;
+			uint32_t blobIndex;
+			uint32_t sourceSize;
+			int64_t sourceTime;
+		};
+		struct FileBlob
+		{
+			uint64_t offset;
+			uint64_t size;
+			uint64_t hash;
+		};
+		static constexpr uint32_t fileVersion = 2;
+
+		const uint8_t* data{ nullptr };
+		size_t size{ 0 };
+#if defined(_WIN32)
+		void* fileHandle{ nullptr };
+		void* mappingHandle{ nullptr };
+#endif
+		const FileEntry* fileEntries{ nullptr };
+		const FileBlob* blobs{ nullptr };
+		// Paths point into the mapped string table, values are entry indices
+		std::unordered_map<std::string_view, uint32_t> entries;
+
+		bool validate();
+	};
+}
@@ -11,6 +11,7 @@
  */
 
 #include "VulkanSwapChain.h"
+#include "VulkanDevice.h"
 
 /** @brief Creates the platform specific surface abstraction of the native
  * platform window used for presentation */
@@ -378,8 +379,146 @@ void VulkanSwapChain::create(uint32_t& width,
   }
 }
 
+void VulkanSwapChain::createOffscreen(vks::VulkanDevice* vulkanDevice,
+                                      VkQueue queue,
+                                      uint32_t width,
+                                      uint32_t height,
+                                      uint32_t imageCount) {
+  assert(physicalDevice);
+  assert(device);
+
+  destroyOffscreen();
+  offscreen_ = true;
+  offscreenDevice = vulkanDevice;
+  offscreenQueue = queue;
+  nextOffscreenImage = 0;
+
+  // Use the formats preferred for swap chains, the images need to be color
+  // attachments and transfer sources for frame dumps
+  const VkFormatFeatureFlags requiredFeatures =
+      VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT |
+      VK_FORMAT_FEATURE_TRANSFER_SRC_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+  colorFormat_ = VK_FORMAT_UNDEFINED;
+  for (VkFormat format : {VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM}) {
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, format,
+                                        &formatProperties);
+    if ((formatProperties.optimalTilingFeatures & requiredFeatures) ==
+        requiredFeatures) {
+      colorFormat_ = format;
+      break;
+    }
+  }
+  if (colorFormat_ == VK_FORMAT_UNDEFINED) {
+    vks::tools::exitFatal("Could not find a format for offscreen images!", -1);
+  }
+  colorSpace_ = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+
+  imageCount_ = imageCount;
+  images_.resize(imageCount_);
+  imageViews_.resize(imageCount_);
+  offscreenMemory.resize(imageCount_);
+  offscreenReleaseSemaphores.resize(imageCount_);
+  offscreenReleased.assign(imageCount_, false);
+  for (uint32_t i = 0; i < imageCount_; i++) {
+    VkImageCreateInfo imageCI{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = colorFormat_,
+        .extent = {width, height, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                 VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                 VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+    VK_CHECK_RESULT(vkCreateImage(device, &imageCI, nullptr, &images_[i]));
+
+    VK_CHECK_RESULT(offscreenDevice->allocateImageMemory(
+        images_[i], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        vks::MemoryTag::Attachments, &offscreenMemory[i]));
+
+    VkImageViewCreateInfo colorAttachmentView{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .image = images_[i],
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = colorFormat_,
+        .components = {VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G,
+                       VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A},
+        .subresourceRange = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                             .baseMipLevel = 0,
+                             .levelCount = 1,
+                             .baseArrayLayer = 0,
+                             .layerCount = 1},
+    };
+    VK_CHECK_RESULT(vkCreateImageView(device, &colorAttachmentView, nullptr,
+                                      &imageViews_[i]));
+
+    VkSemaphoreCreateInfo semaphoreCI{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCI, nullptr,
+                                      &offscreenReleaseSemaphores[i]));
+  }
+}
+
+VkResult VulkanSwapChain::presentOffscreen(uint32_t imageIndex,
+                                           VkSemaphore waitSemaphore) {
+  const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+  VkSubmitInfo submitInfo{
+      .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+      .waitSemaphoreCount = (waitSemaphore != VK_NULL_HANDLE) ? 1u : 0u,
+      .pWaitSemaphores = &waitSemaphore,
+      .pWaitDstStageMask = &waitStage,
+      .signalSemaphoreCount = 1,
+      .pSignalSemaphores = &offscreenReleaseSemaphores[imageIndex],
+  };
+  offscreenReleased[imageIndex] = true;
+  return offscreenDevice->queueSubmit(offscreenQueue, 1, &submitInfo, VK_NULL_HANDLE);
+}
+
+void VulkanSwapChain::destroyOffscreen() {
+  if (!offscreen_) {
+    return;
+  }
+  for (uint32_t i = 0; i < imageCount_; i++) {
+    vkDestroyImageView(device, imageViews_[i], nullptr);
+    vkDestroyImage(device, images_[i], nullptr);
+    offscreenDevice->freeAllocation(offscreenMemory[i]);
+    vkDestroySemaphore(device, offscreenReleaseSemaphores[i], nullptr);
+  }
+  images_.clear();
+  imageViews_.clear();
+  offscreenMemory.clear();
+  offscreenReleaseSemaphores.clear();
+  offscreenReleased.clear();
+  imageCount_ = 0;
+  offscreen_ = false;
+}
+
 VkResult VulkanSwapChain::acquireNextImage(VkSemaphore presentCompleteSemaphore,
                                            uint32_t& imageIndex) {
+  if (offscreen_) {
+    // Images are handed out in order, the semaphore is signaled once the
+    // image's previous presentation has been waited for
+    imageIndex = nextOffscreenImage;
+    nextOffscreenImage = (nextOffscreenImage + 1) % imageCount_;
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo submitInfo{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = offscreenReleased[imageIndex] ? 1u : 0u,
+        .pWaitSemaphores = &offscreenReleaseSemaphores[imageIndex],
+        .pWaitDstStageMask = &waitStage,
+        .signalSemaphoreCount =
+            (presentCompleteSemaphore != VK_NULL_HANDLE) ? 1u : 0u,
+        .pSignalSemaphores = &presentCompleteSemaphore,
+    };
+    offscreenReleased[imageIndex] = false;
+    return offscreenDevice->queueSubmit(offscreenQueue, 1, &submitInfo, VK_NULL_HANDLE);
+  }
   // By setting timeout to UINT64_MAX we will always wait until the next image
   // has been acquired or an actual error is thrown With that we don't have to
   // handle VK_NOT_READY
@@ -388,6 +527,7 @@ VkResult VulkanSwapChain::acquireNextImage(VkSemaphore presentCompleteSemaphore,
                                &imageIndex);
 }
 void VulkanSwapChain::cleanup() {
+  destroyOffscreen();
   if (swapChain_ != VK_NULL_HANDLE) {
     for (auto i = 0; i < images_.size(); i++) {
       vkDestroyImageView(device, imageViews_[i], nullptr);
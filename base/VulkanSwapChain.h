@@ -19,6 +19,7 @@
 #include <vector>
 
 #include <vulkan/vulkan.h>
+#include "VulkanMemoryAllocator.h"
 #include "VulkanTools.h"
 
 #ifdef __ANDROID__
@@ -29,12 +30,26 @@
 #include <sys/utsname.h>
 #endif
 
+namespace vks {
+struct VulkanDevice;
+}
+
 class VulkanSwapChain {
  private:
   VkInstance instance{VK_NULL_HANDLE};
   VkDevice device{VK_NULL_HANDLE};
   VkPhysicalDevice physicalDevice{VK_NULL_HANDLE};
   VkSurfaceKHR surface{VK_NULL_HANDLE};
+  // Offscreen image pool (see createOffscreen)
+  VkQueue offscreenQueue{VK_NULL_HANDLE};
+  vks::VulkanDevice* offscreenDevice{nullptr};
+  std::vector<vks::MemoryAllocation> offscreenMemory{};
+  // Signaled by presentOffscreen, waited for by the next acquisition of the
+  // image
+  std::vector<VkSemaphore> offscreenReleaseSemaphores{};
+  std::vector<bool> offscreenReleased{};
+  uint32_t nextOffscreenImage{0};
+  void destroyOffscreen();
 
  public:
   VkFormat colorFormat_{};
@@ -44,6 +59,8 @@ class VulkanSwapChain {
   std::vector<VkImageView> imageViews_{};
   uint32_t queueNodeIndex_{UINT32_MAX};
   uint32_t imageCount_{0};
+  // True if the images are an offscreen pool instead of a swap chain
+  bool offscreen_{false};
 
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
   void initSurface(void* platformHandle, void* platformWindow);
@@ -87,6 +104,23 @@ class VulkanSwapChain {
               uint32_t& height,
               bool vsync = false,
               bool fullscreen = false);
+  /**
+   * Create a pool of images that are rendered to in place of swap chain
+   * images, so examples can run without a window or surface
+   *
+   * @param vulkanDevice Device the image memory is sub-allocated from, so it
+   * shows up in the memory statistics as attachments
+   * @param queue Queue the acquisition and presentation semaphores are
+   * signaled and waited for on
+   * @param width Width of the images
+   * @param height Height of the images
+   * @param imageCount Number of images in the pool
+   */
+  void createOffscreen(vks::VulkanDevice* vulkanDevice,
+                       VkQueue queue,
+                       uint32_t width,
+                       uint32_t height,
+                       uint32_t imageCount);
   /**
    * Acquires the next image in the swap chain
    *
@@ -102,6 +136,14 @@ class VulkanSwapChain {
    */
   VkResult acquireNextImage(VkSemaphore presentCompleteSemaphore,
                             uint32_t& imageIndex);
+  /**
+   * Replaces vkQueuePresentKHR for offscreen images, releases the image for
+   * its next acquisition once the wait semaphore has been signaled
+   *
+   * @param imageIndex Index of the image to present
+   * @param waitSemaphore Semaphore signaled by the rendering to the image
+   */
+  VkResult presentOffscreen(uint32_t imageIndex, VkSemaphore waitSemaphore);
   /* Free all Vulkan resources acquired by the swapchain */
   void cleanup();
 };
@@ -35,6 +35,8 @@ class Texture
 	VkImage               image;
 	VkImageLayout         imageLayout;
 	VkDeviceMemory        deviceMemory;
+	/** @brief Memory range sub-allocated by the texture loaders, deviceMemory is then the (shared) block the image is bound to */
+	MemoryAllocation      allocation;
 	VkImageView           view;
 	uint32_t              width, height;
 	uint32_t              mipLevels;
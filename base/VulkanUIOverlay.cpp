@@ -8,6 +8,7 @@
 */
 
 #include "VulkanUIOverlay.h"
+#include "VulkanPipelineRegistry.h"
 
 namespace vks 
 {
@@ -103,15 +104,7 @@ namespace vks
 			.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
 		};
 		VK_CHECK_RESULT(vkCreateImage(device->logicalDevice, &imageInfo, nullptr, &fontImage));
-		VkMemoryRequirements memReqs;
-		vkGetImageMemoryRequirements(device->logicalDevice, fontImage, &memReqs);
-		VkMemoryAllocateInfo memAllocInfo{
-			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-			.allocationSize = memReqs.size,
-			.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-		};
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &fontMemory));
-		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, fontImage, fontMemory, 0));
+		VK_CHECK_RESULT(device->allocateImageMemory(fontImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryTag::Textures, &fontAllocation));
 
 		// Image view
 		VkImageViewCreateInfo viewInfo{
@@ -123,41 +116,12 @@ namespace vks
 		};
 		VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewInfo, nullptr, &fontView));
 
-		// Staging buffers for font data upload
-		vks::Buffer stagingBuffer;
-		VK_CHECK_RESULT(device->createBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingBuffer, uploadSize));
-		stagingBuffer.map();
-		memcpy(stagingBuffer.mapped, fontData, uploadSize);
-
-		// Copy buffer data to font image
-		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-		// Prepare for transfer
-		vks::tools::setImageLayout(
-			copyCmd,
-			fontImage,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			VK_IMAGE_LAYOUT_UNDEFINED,
-			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			VK_PIPELINE_STAGE_HOST_BIT,
-			VK_PIPELINE_STAGE_TRANSFER_BIT);
-		// Copy
+		// Upload font data on the transfer queue
 		VkBufferImageCopy bufferCopyRegion{
 			.imageSubresource = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .layerCount = 1 },
 			.imageExtent = {.width = (uint32_t)texWidth, .height = (uint32_t)texHeight, .depth = 1 }
 		};
-		vkCmdCopyBufferToImage(copyCmd, stagingBuffer.buffer, fontImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferCopyRegion);
-		// Prepare for shader read
-		vks::tools::setImageLayout(
-			copyCmd,
-			fontImage,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-			VK_PIPELINE_STAGE_TRANSFER_BIT,
-			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-		device->flushCommandBuffer(copyCmd, queue, true);
-
-		stagingBuffer.destroy();
+		device->uploadManager.uploadImage(fontImage, fontData, uploadSize, { bufferCopyRegion }, viewInfo.subresourceRange, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
 
 		// Font texture Sampler
 		VkSamplerCreateInfo samplerInfo{
@@ -337,6 +301,29 @@ namespace vks
 		buffers[currentBuffer].indexBuffer.flush();
 	}
 
+	/** Hash of everything draw() records for the current draw data, vertex and index data is excluded as update() writes it to the buffers in place */
+	uint64_t UIOverlay::drawSignature(uint32_t currentBuffer) const
+	{
+		ImDrawData* imDrawData = ImGui::GetDrawData();
+		if ((!imDrawData) || (imDrawData->CmdListsCount == 0)) {
+			return 0;
+		}
+		const ImGuiIO& io = ImGui::GetIO();
+		const VkBuffer handles[2] = { buffers[currentBuffer].vertexBuffer.buffer, buffers[currentBuffer].indexBuffer.buffer };
+		uint64_t hash = PipelineRegistry::hash(handles, sizeof(handles));
+		hash = PipelineRegistry::hash(&io.DisplaySize, sizeof(io.DisplaySize), hash);
+		for (int32_t i = 0; i < imDrawData->CmdListsCount; i++) {
+			const ImDrawList* cmd_list = imDrawData->CmdLists[i];
+			hash = PipelineRegistry::hash(&cmd_list->VtxBuffer.Size, sizeof(cmd_list->VtxBuffer.Size), hash);
+			for (int32_t j = 0; j < cmd_list->CmdBuffer.Size; j++) {
+				const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[j];
+				hash = PipelineRegistry::hash(&pcmd->ClipRect, sizeof(pcmd->ClipRect), hash);
+				hash = PipelineRegistry::hash(&pcmd->ElemCount, sizeof(pcmd->ElemCount), hash);
+			}
+		}
+		return hash;
+	}
+
 	void UIOverlay::draw(const VkCommandBuffer commandBuffer, uint32_t currentBuffer)
 	{
 		ImDrawData* imDrawData = ImGui::GetDrawData();
@@ -402,7 +389,7 @@ namespace vks
 		}
 		vkDestroyImageView(device->logicalDevice, fontView, nullptr);
 		vkDestroyImage(device->logicalDevice, fontImage, nullptr);
-		vkFreeMemory(device->logicalDevice, fontMemory, nullptr);
+		device->freeAllocation(fontAllocation);
 		vkDestroySampler(device->logicalDevice, sampler, nullptr);
 		vkDestroyDescriptorSetLayout(device->logicalDevice, descriptorSetLayout, nullptr);
 		vkDestroyDescriptorPool(device->logicalDevice, descriptorPool, nullptr);
@@ -417,7 +404,9 @@ namespace vks
 
 	bool UIOverlay::checkBox(const char *caption, bool *value)
 	{
-		return ImGui::Checkbox(caption, value);
+		bool res = ImGui::Checkbox(caption, value);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	bool UIOverlay::checkBox(const char *caption, int32_t *value)
@@ -425,27 +414,36 @@ namespace vks
 		bool val = (*value == 1);
 		bool res = ImGui::Checkbox(caption, &val);
 		*value = val;
+		if (res) { updated = true; };
 		return res;
 	}
 
 	bool UIOverlay::radioButton(const char* caption, bool value)
 	{
-		return ImGui::RadioButton(caption, value);
+		bool res = ImGui::RadioButton(caption, value);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	bool UIOverlay::inputFloat(const char *caption, float *value, float step, uint32_t precision)
 	{
-		return ImGui::InputFloat(caption, value, step, step * 10.0f, precision);
+		bool res = ImGui::InputFloat(caption, value, step, step * 10.0f, precision);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	bool UIOverlay::sliderFloat(const char* caption, float* value, float min, float max)
 	{
-		return ImGui::SliderFloat(caption, value, min, max);
+		bool res = ImGui::SliderFloat(caption, value, min, max);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	bool UIOverlay::sliderInt(const char* caption, int32_t* value, int32_t min, int32_t max)
 	{
-		return ImGui::SliderInt(caption, value, min, max);
+		bool res = ImGui::SliderInt(caption, value, min, max);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	bool UIOverlay::comboBox(const char *caption, int32_t *itemindex, std::vector<std::string> items)
@@ -459,16 +457,22 @@ namespace vks
 			charitems.push_back(items[i].c_str());
 		}
 		uint32_t itemCount = static_cast<uint32_t>(charitems.size());
-		return ImGui::Combo(caption, itemindex, &charitems[0], itemCount, itemCount);
+		bool res = ImGui::Combo(caption, itemindex, &charitems[0], itemCount, itemCount);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	bool UIOverlay::button(const char *caption)
 	{
-		return ImGui::Button(caption);
+		bool res = ImGui::Button(caption);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	bool UIOverlay::colorPicker(const char* caption, float* color) {
-		return ImGui::ColorEdit4(caption, color, ImGuiColorEditFlags_NoInputs);
+		bool res = ImGui::ColorEdit4(caption, color, ImGuiColorEditFlags_NoInputs);
+		if (res) { updated = true; };
+		return res;
 	}
 
 	void UIOverlay::text(const char *formatstr, ...)
@@ -61,7 +61,7 @@ namespace vks
 		VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 		VkPipeline pipeline{ VK_NULL_HANDLE };
 
-		VkDeviceMemory fontMemory{ VK_NULL_HANDLE };
+		MemoryAllocation fontAllocation;
 		VkImage fontImage{ VK_NULL_HANDLE };
 		VkImageView fontView{ VK_NULL_HANDLE };
 		VkSampler sampler{ VK_NULL_HANDLE };
@@ -72,6 +72,8 @@ namespace vks
 		} pushConstBlock;
 
 		bool visible{ true };
+		/** @brief Set by the widgets below when they change a value, reset by the caller */
+		bool updated{ false };
 		float scale{ 1.0f };
 
 		UIOverlay();
@@ -82,6 +84,7 @@ namespace vks
 
 		void update(uint32_t currentBuffer);
 		void draw(const VkCommandBuffer commandBuffer, uint32_t currentBuffer);
+		uint64_t drawSignature(uint32_t currentBuffer) const;
 		void resize(uint32_t width, uint32_t height);
 
 		void freeResources();
@@ -0,0 +1,78 @@
+/*
+* Vulkan per-frame uniform ring
+*
+* Bump allocates uniform data from a persistently mapped buffer with one range per frame in flight, bound with dynamic offsets
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanUniformRing.h"
+#include "VulkanDevice.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vks
+{
+	/**
+	* Set up the ring, the buffer itself is created on first use
+	*
+	* @param device Device to create the buffer on
+	* @param frameCount Number of frames in flight, each gets its own range
+	* @param frameSize Size of a frame's range, rounded up to minUniformBufferOffsetAlignment
+	*/
+	void UniformRing::prepare(VulkanDevice* device, uint32_t frameCount, VkDeviceSize frameSize)
+	{
+		this->device = device;
+		this->frameCount = frameCount;
+		alignment = std::max<VkDeviceSize>(device->properties.limits.minUniformBufferOffsetAlignment, 1);
+		this->frameSize = (frameSize + alignment - 1) / alignment * alignment;
+		frameBegin = 0;
+		head = 0;
+	}
+
+	void UniformRing::createBuffer()
+	{
+		VK_CHECK_RESULT(device->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, frameSize * frameCount));
+		VK_CHECK_RESULT(buffer.map());
+	}
+
+	void UniformRing::destroy()
+	{
+		buffer.destroy();
+	}
+
+	void UniformRing::beginFrame(uint32_t frameIndex)
+	{
+		peakFrameUsage = std::max(peakFrameUsage, head - frameBegin);
+		frameBegin = frameSize * frameIndex;
+		head = frameBegin;
+	}
+
+	uint32_t UniformRing::push(const void* data, VkDeviceSize size)
+	{
+		if (!buffer.buffer)
+		{
+			createBuffer();
+		}
+		const VkDeviceSize offset = (head + alignment - 1) / alignment * alignment;
+		if (offset + size > frameBegin + frameSize)
+		{
+			vks::tools::exitFatal("Uniform data of a frame exceeds the uniform ring's frame size of " + std::to_string(frameSize) + " bytes", -1);
+		}
+		memcpy(static_cast<char*>(buffer.mapped) + offset, data, size);
+		head = offset + size;
+		return static_cast<uint32_t>(offset);
+	}
+
+	VkDescriptorBufferInfo UniformRing::descriptor(VkDeviceSize range)
+	{
+		if (!buffer.buffer)
+		{
+			createBuffer();
+		}
+		return { .buffer = buffer.buffer, .offset = 0, .range = range };
+	}
+}
@@ -0,0 +1,61 @@
+/*
+* Vulkan per-frame uniform ring
+*
+* Bump allocates uniform data from a persistently mapped buffer with one range per frame in flight, bound with dynamic offsets
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include "vulkan/vulkan.h"
+#include "VulkanBuffer.h"
+
+namespace vks
+{
+	struct VulkanDevice;
+
+	/**
+	* @brief Linear allocator for uniform data that only lives for a single frame
+	* The buffer is split into one range per frame in flight. beginFrame() rewinds the range of a frame once its fence has been waited for, push() copies data to the next aligned offset in that range and returns it as a dynamic offset
+	* Descriptors use VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC with descriptor(), so a single descriptor set serves every frame and every push
+	* The buffer is only created on the first call to push() or descriptor(), so examples that don't use the ring don't pay for it
+	*/
+	class UniformRing
+	{
+	public:
+		static constexpr VkDeviceSize defaultFrameSize = 1024 * 1024;
+
+		void prepare(VulkanDevice* device, uint32_t frameCount, VkDeviceSize frameSize = defaultFrameSize);
+		void destroy();
+
+		/** @brief Rewinds the range of the given frame, the device must be done with the frame's previous pushes */
+		void beginFrame(uint32_t frameIndex);
+		/** @brief Copies data into the current frame's range and returns its dynamic offset */
+		uint32_t push(const void* data, VkDeviceSize size);
+		template <typename T>
+		uint32_t push(const T& data)
+		{
+			return push(&data, sizeof(T));
+		}
+
+		/** @brief Buffer info for a dynamic uniform buffer descriptor reading range bytes at the dynamic offset */
+		VkDescriptorBufferInfo descriptor(VkDeviceSize range);
+
+		/** @brief Most bytes pushed in a single frame since prepare */
+		VkDeviceSize peakFrameUsage{ 0 };
+
+	private:
+		VulkanDevice* device{ nullptr };
+		uint32_t frameCount{ 0 };
+		Buffer buffer;
+		VkDeviceSize frameSize{ 0 };
+		VkDeviceSize alignment{ 0 };
+		VkDeviceSize frameBegin{ 0 };
+		VkDeviceSize head{ 0 };
+
+		void createBuffer();
+	};
+}
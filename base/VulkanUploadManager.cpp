@@ -0,0 +1,508 @@
+/*
+* Vulkan asynchronous upload manager
+*
+* Streams buffer and image data through a persistent staging ring on the transfer queue, so uploads overlap with rendering instead of waiting on a fence each
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include "VulkanUploadManager.h"
+#include "VulkanDevice.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace vks
+{
+	namespace
+	{
+		VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		VkSemaphore createTimelineSemaphore(VkDevice device)
+		{
+			VkSemaphoreTypeCreateInfoKHR semaphoreTypeCI{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR,
+				.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+				.initialValue = 0
+			};
+			VkSemaphoreCreateInfo semaphoreCI{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+				.pNext = &semaphoreTypeCI
+			};
+			VkSemaphore semaphore;
+			VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCI, nullptr, &semaphore));
+			return semaphore;
+		}
+	}
+
+	/**
+	* Create the staging ring, command pools and synchronization objects
+	*
+	* @param device Device with a logical device, uploads are submitted to the first queue of the transfer and graphics queue families
+	* @param timelineSemaphores True if VK_KHR_timeline_semaphore and its feature have been enabled for the device
+	* @param stagingSize Size of the staging ring
+	*/
+	void UploadManager::prepare(VulkanDevice* device, bool timelineSemaphores, VkDeviceSize stagingSize)
+	{
+		this->device = device;
+		this->stagingSize = stagingSize;
+		VkDevice logicalDevice = device->logicalDevice;
+		vkGetDeviceQueue(logicalDevice, device->queueFamilyIndices.transfer, 0, &transferQueue);
+		vkGetDeviceQueue(logicalDevice, device->queueFamilyIndices.graphics, 0, &graphicsQueue);
+		ownershipTransfer = device->queueFamilyIndices.transfer != device->queueFamilyIndices.graphics;
+
+		if (timelineSemaphores)
+		{
+			vkGetSemaphoreCounterValueKHR = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(vkGetDeviceProcAddr(logicalDevice, "vkGetSemaphoreCounterValueKHR"));
+			vkWaitSemaphoresKHR = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(vkGetDeviceProcAddr(logicalDevice, "vkWaitSemaphoresKHR"));
+			timelineSemaphores = vkGetSemaphoreCounterValueKHR && vkWaitSemaphoresKHR;
+		}
+		this->timelineSemaphores = timelineSemaphores;
+		if (timelineSemaphores)
+		{
+			transferTimeline = createTimelineSemaphore(logicalDevice);
+			if (ownershipTransfer)
+			{
+				acquireTimeline = createTimelineSemaphore(logicalDevice);
+			}
+		}
+
+		transferCommandPool = device->createCommandPool(device->queueFamilyIndices.transfer);
+		if (ownershipTransfer)
+		{
+			acquireCommandPool = device->createCommandPool(device->queueFamilyIndices.graphics);
+		}
+
+		// The staging ring stays mapped for the lifetime of the manager
+		VkBufferCreateInfo bufferCI{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			.size = stagingSize,
+			.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE
+		};
+		VK_CHECK_RESULT(vkCreateBuffer(logicalDevice, &bufferCI, nullptr, &stagingBuffer));
+		VK_CHECK_RESULT(device->allocateBufferMemory(stagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryTag::Staging, &stagingAllocation));
+	}
+
+	void UploadManager::destroy()
+	{
+		if (!device)
+		{
+			return;
+		}
+		waitIdle();
+		std::lock_guard<std::mutex> lock(mutex);
+		VkDevice logicalDevice = device->logicalDevice;
+		for (Submission& submission : freeSubmissions)
+		{
+			if (submission.fence)
+			{
+				vkDestroyFence(logicalDevice, submission.fence, nullptr);
+			}
+			if (submission.semaphore)
+			{
+				vkDestroySemaphore(logicalDevice, submission.semaphore, nullptr);
+			}
+		}
+		freeSubmissions.clear();
+		vkDestroyCommandPool(logicalDevice, transferCommandPool, nullptr);
+		if (acquireCommandPool)
+		{
+			vkDestroyCommandPool(logicalDevice, acquireCommandPool, nullptr);
+		}
+		if (transferTimeline)
+		{
+			vkDestroySemaphore(logicalDevice, transferTimeline, nullptr);
+		}
+		if (acquireTimeline)
+		{
+			vkDestroySemaphore(logicalDevice, acquireTimeline, nullptr);
+		}
+		vkDestroyBuffer(logicalDevice, stagingBuffer, nullptr);
+		device->freeAllocation(stagingAllocation);
+		device = nullptr;
+	}
+
+	void UploadManager::uploadBuffer(VkBuffer buffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask)
+	{
+		assert(device);
+		std::lock_guard<std::mutex> lock(mutex);
+		VkBuffer srcBuffer;
+		VkDeviceSize srcOffset;
+		stage(data, size, srcBuffer, srcOffset);
+		beginRecording();
+
+		VkBufferCopy copyRegion{ .srcOffset = srcOffset, .dstOffset = dstOffset, .size = size };
+		vkCmdCopyBuffer(recording.transferCommandBuffer, srcBuffer, buffer, 1, &copyRegion);
+
+		VkBufferMemoryBarrier barrier{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask = dstAccessMask,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.buffer = buffer,
+			.offset = dstOffset,
+			.size = size
+		};
+		if (!ownershipTransfer)
+		{
+			vkCmdPipelineBarrier(recording.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+			return;
+		}
+		// Release the buffer on the transfer queue and acquire it on the graphics queue
+		barrier.srcQueueFamilyIndex = device->queueFamilyIndices.transfer;
+		barrier.dstQueueFamilyIndex = device->queueFamilyIndices.graphics;
+		barrier.dstAccessMask = 0;
+		vkCmdPipelineBarrier(recording.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = dstAccessMask;
+		vkCmdPipelineBarrier(recording.acquireCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+	}
+
+	void UploadManager::uploadImage(VkImage image, const void* data, VkDeviceSize size, const std::vector<VkBufferImageCopy>& regions, const VkImageSubresourceRange& subresourceRange, VkImageLayout finalLayout, VkPipelineStageFlags dstStageMask)
+	{
+		assert(device);
+		std::lock_guard<std::mutex> lock(mutex);
+		VkBuffer srcBuffer;
+		VkDeviceSize srcOffset;
+		stage(data, size, srcBuffer, srcOffset);
+		beginRecording();
+
+		VkImageMemoryBarrier barrier{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.srcAccessMask = 0,
+			.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image = image,
+			.subresourceRange = subresourceRange
+		};
+		vkCmdPipelineBarrier(recording.transferCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		// Region offsets are relative to the uploaded data
+		std::vector<VkBufferImageCopy> stagedRegions(regions);
+		for (VkBufferImageCopy& region : stagedRegions)
+		{
+			region.bufferOffset += srcOffset;
+		}
+		vkCmdCopyBufferToImage(recording.transferCommandBuffer, srcBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(stagedRegions.size()), stagedRegions.data());
+
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = finalLayout;
+		if (!ownershipTransfer)
+		{
+			vkCmdPipelineBarrier(recording.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+			return;
+		}
+		// The layout transition is part of the ownership transfer, release and acquire barriers need to specify the same layouts
+		barrier.srcQueueFamilyIndex = device->queueFamilyIndices.transfer;
+		barrier.dstQueueFamilyIndex = device->queueFamilyIndices.graphics;
+		const VkAccessFlags dstAccessMask = barrier.dstAccessMask;
+		barrier.dstAccessMask = 0;
+		vkCmdPipelineBarrier(recording.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = dstAccessMask;
+		vkCmdPipelineBarrier(recording.acquireCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	}
+
+	uint64_t UploadManager::flush()
+	{
+		if (!device)
+		{
+			return 0;
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		return submit();
+	}
+
+	bool UploadManager::isComplete(uint64_t ticket)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		releaseCompleted(false);
+		return ticket <= completedTicket;
+	}
+
+	void UploadManager::wait(uint64_t ticket)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		while ((ticket > completedTicket) && !inFlight.empty())
+		{
+			releaseCompleted(true);
+		}
+	}
+
+	void UploadManager::waitIdle()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		submit();
+		while (!inFlight.empty())
+		{
+			releaseCompleted(true);
+		}
+	}
+
+	/**
+	* Copy data into the staging ring, or into a temporary staging buffer if it doesn't fit into the ring
+	* Waits for in-flight uploads if the ring is full
+	*/
+	void UploadManager::stage(const void* data, VkDeviceSize size, VkBuffer& buffer, VkDeviceSize& offset)
+	{
+		uploadedBytes += size;
+		if (size > stagingSize)
+		{
+			VkBufferCreateInfo bufferCI{
+				.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+				.size = size,
+				.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				.sharingMode = VK_SHARING_MODE_EXCLUSIVE
+			};
+			MemoryAllocation allocation;
+			VK_CHECK_RESULT(vkCreateBuffer(device->logicalDevice, &bufferCI, nullptr, &buffer));
+			VK_CHECK_RESULT(device->allocateBufferMemory(buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryTag::Staging, &allocation));
+			memcpy(allocation.mapped, data, size);
+			recording.temporaryBuffers.push_back({ buffer, allocation });
+			offset = 0;
+			return;
+		}
+		releaseCompleted(false);
+		while (!allocateStaging(size, offset))
+		{
+			// Make room by submitting what has been recorded so far and waiting for the oldest upload
+			submit();
+			releaseCompleted(true);
+		}
+		buffer = stagingBuffer;
+		memcpy(static_cast<uint8_t*>(stagingAllocation.mapped) + offset, data, size);
+	}
+
+	/**
+	* Take a range from the staging ring, the ring is empty if head and tail are equal, so the head never catches up with the tail
+	*/
+	bool UploadManager::allocateStaging(VkDeviceSize size, VkDeviceSize& offset)
+	{
+		if (stagingHead >= stagingTail)
+		{
+			const VkDeviceSize alignedHead = alignUp(stagingHead, stagingAlignment);
+			if (alignedHead + size <= stagingSize)
+			{
+				offset = alignedHead;
+				stagingHead = alignedHead + size;
+				return true;
+			}
+			// Wrap around to the start of the ring
+			if (size < stagingTail)
+			{
+				offset = 0;
+				stagingHead = size;
+				return true;
+			}
+			return false;
+		}
+		const VkDeviceSize alignedHead = alignUp(stagingHead, stagingAlignment);
+		if (alignedHead + size < stagingTail)
+		{
+			offset = alignedHead;
+			stagingHead = alignedHead + size;
+			return true;
+		}
+		return false;
+	}
+
+	void UploadManager::beginRecording()
+	{
+		if (recording.transferCommandBuffer)
+		{
+			return;
+		}
+		if (!freeSubmissions.empty())
+		{
+			Submission& recycled = freeSubmissions.back();
+			recording.transferCommandBuffer = recycled.transferCommandBuffer;
+			recording.acquireCommandBuffer = recycled.acquireCommandBuffer;
+			recording.fence = recycled.fence;
+			recording.semaphore = recycled.semaphore;
+			freeSubmissions.pop_back();
+		}
+		else
+		{
+			recording.transferCommandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, transferCommandPool);
+			if (ownershipTransfer)
+			{
+				recording.acquireCommandBuffer = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, acquireCommandPool);
+			}
+			if (!timelineSemaphores)
+			{
+				VkFenceCreateInfo fenceCI = vks::initializers::fenceCreateInfo(0);
+				VK_CHECK_RESULT(vkCreateFence(device->logicalDevice, &fenceCI, nullptr, &recording.fence));
+				if (ownershipTransfer)
+				{
+					VkSemaphoreCreateInfo semaphoreCI = vks::initializers::semaphoreCreateInfo();
+					VK_CHECK_RESULT(vkCreateSemaphore(device->logicalDevice, &semaphoreCI, nullptr, &recording.semaphore));
+				}
+			}
+		}
+		VkCommandBufferBeginInfo beginInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+		};
+		VK_CHECK_RESULT(vkBeginCommandBuffer(recording.transferCommandBuffer, &beginInfo));
+		if (recording.acquireCommandBuffer)
+		{
+			VK_CHECK_RESULT(vkBeginCommandBuffer(recording.acquireCommandBuffer, &beginInfo));
+		}
+	}
+
+	/**
+	* Submit the recorded copies to the transfer queue and the ownership acquires to the graphics queue
+	*/
+	uint64_t UploadManager::submit()
+	{
+		if (!recording.transferCommandBuffer)
+		{
+			return 0;
+		}
+		Submission submission = std::move(recording);
+		recording = Submission{};
+		submission.ticket = ++lastTicket;
+		submission.stagingEnd = stagingHead;
+
+		VK_CHECK_RESULT(vkEndCommandBuffer(submission.transferCommandBuffer));
+		VkSubmitInfo submitInfo{
+			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			.commandBufferCount = 1,
+			.pCommandBuffers = &submission.transferCommandBuffer
+		};
+		VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo{
+			.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+			.signalSemaphoreValueCount = 1,
+			.pSignalSemaphoreValues = &submission.ticket
+		};
+		if (timelineSemaphores)
+		{
+			submitInfo.pNext = &timelineSubmitInfo;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &transferTimeline;
+		}
+		else if (ownershipTransfer)
+		{
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &submission.semaphore;
+		}
+		VK_CHECK_RESULT(device->queueSubmit(transferQueue, 1, &submitInfo, ownershipTransfer ? VK_NULL_HANDLE : submission.fence));
+
+		if (ownershipTransfer)
+		{
+			// The acquire barriers must not execute before the release barriers on the transfer queue
+			VK_CHECK_RESULT(vkEndCommandBuffer(submission.acquireCommandBuffer));
+			const VkPipelineStageFlags waitStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			VkSubmitInfo acquireSubmitInfo{
+				.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+				.waitSemaphoreCount = 1,
+				.pWaitSemaphores = timelineSemaphores ? &transferTimeline : &submission.semaphore,
+				.pWaitDstStageMask = &waitStageMask,
+				.commandBufferCount = 1,
+				.pCommandBuffers = &submission.acquireCommandBuffer
+			};
+			VkTimelineSemaphoreSubmitInfoKHR acquireTimelineSubmitInfo{
+				.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+				.waitSemaphoreValueCount = 1,
+				.pWaitSemaphoreValues = &submission.ticket,
+				.signalSemaphoreValueCount = 1,
+				.pSignalSemaphoreValues = &submission.ticket
+			};
+			if (timelineSemaphores)
+			{
+				acquireSubmitInfo.pNext = &acquireTimelineSubmitInfo;
+				acquireSubmitInfo.signalSemaphoreCount = 1;
+				acquireSubmitInfo.pSignalSemaphores = &acquireTimeline;
+			}
+			VK_CHECK_RESULT(device->queueSubmit(graphicsQueue, 1, &acquireSubmitInfo, submission.fence));
+		}
+
+		submissionCount++;
+		inFlight.push_back(std::move(submission));
+		return lastTicket;
+	}
+
+	bool UploadManager::submissionComplete(const Submission& submission)
+	{
+		if (timelineSemaphores)
+		{
+			uint64_t value{ 0 };
+			VK_CHECK_RESULT(vkGetSemaphoreCounterValueKHR(device->logicalDevice, ownershipTransfer ? acquireTimeline : transferTimeline, &value));
+			return value >= submission.ticket;
+		}
+		return vkGetFenceStatus(device->logicalDevice, submission.fence) == VK_SUCCESS;
+	}
+
+	/**
+	* Recycle submissions that have finished executing and return their staging ranges to the ring
+	*
+	* @param waitForOldest If true, blocks until at least the oldest in-flight submission has finished
+	*/
+	void UploadManager::releaseCompleted(bool waitForOldest)
+	{
+		if (waitForOldest && !inFlight.empty())
+		{
+			Submission& oldest = inFlight.front();
+			if (timelineSemaphores)
+			{
+				VkSemaphore semaphore = ownershipTransfer ? acquireTimeline : transferTimeline;
+				VkSemaphoreWaitInfoKHR waitInfo{
+					.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR,
+					.semaphoreCount = 1,
+					.pSemaphores = &semaphore,
+					.pValues = &oldest.ticket
+				};
+				VK_CHECK_RESULT(vkWaitSemaphoresKHR(device->logicalDevice, &waitInfo, UINT64_MAX));
+			}
+			else
+			{
+				VK_CHECK_RESULT(vkWaitForFences(device->logicalDevice, 1, &oldest.fence, VK_TRUE, UINT64_MAX));
+			}
+		}
+		// Submissions finish in order, as they are submitted to the same queues
+		while (!inFlight.empty() && submissionComplete(inFlight.front()))
+		{
+			Submission& submission = inFlight.front();
+			completedTicket = submission.ticket;
+			stagingTail = submission.stagingEnd;
+			recycle(submission);
+			inFlight.pop_front();
+		}
+		if (inFlight.empty() && !recording.transferCommandBuffer)
+		{
+			stagingHead = stagingTail = 0;
+		}
+	}
+
+	void UploadManager::recycle(Submission& submission)
+	{
+		for (auto& [buffer, allocation] : submission.temporaryBuffers)
+		{
+			vkDestroyBuffer(device->logicalDevice, buffer, nullptr);
+			device->freeAllocation(allocation);
+		}
+		submission.temporaryBuffers.clear();
+		VK_CHECK_RESULT(vkResetCommandBuffer(submission.transferCommandBuffer, 0));
+		if (submission.acquireCommandBuffer)
+		{
+			VK_CHECK_RESULT(vkResetCommandBuffer(submission.acquireCommandBuffer, 0));
+		}
+		if (submission.fence)
+		{
+			VK_CHECK_RESULT(vkResetFences(device->logicalDevice, 1, &submission.fence));
+		}
+		freeSubmissions.push_back(std::move(submission));
+	}
+}
@@ -0,0 +1,124 @@
+/*
+* Vulkan asynchronous upload manager
+*
+* Streams buffer and image data through a persistent staging ring on the transfer queue, so uploads overlap with rendering instead of waiting on a fence each
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+#include "VulkanMemoryAllocator.h"
+
+namespace vks
+{
+	struct VulkanDevice;
+
+	/**
+	* @brief Uploads data to device local buffers and images on the transfer queue
+	* Data is copied into a persistently mapped staging ring, copies are recorded into a transfer command buffer and submitted by flush() without waiting for them
+	* If the transfer queue belongs to a different family than the graphics queue, ownership of the resources is released on the transfer queue and acquired by a small command buffer on the graphics queue that waits for the copies, so later graphics submissions can use them right away
+	* Completion is tracked with timeline semaphores if VK_KHR_timeline_semaphore has been enabled, with fences otherwise
+	* Loaders only record uploads. Recorded uploads are submitted in one batch by the next flush(), which the example base calls once per frame before submitting it, and VulkanDevice::flushCommandBuffer and ImmediateContext call before their own submissions
+	* @note flush() may be called from any thread, its submissions hold the device's queue locks like the frame submission does
+	*/
+	class UploadManager
+	{
+	public:
+		/** @brief Default size of the staging ring, uploads larger than the ring get a temporary staging buffer */
+		static constexpr VkDeviceSize defaultStagingSize = 32ull * 1024 * 1024;
+		/** @brief Alignment of staging ranges, satisfies the texel block size of all formats except 96 bit ones and optimalBufferCopyOffsetAlignment on common implementations */
+		static constexpr VkDeviceSize stagingAlignment = 16;
+
+		void prepare(VulkanDevice* device, bool timelineSemaphores, VkDeviceSize stagingSize = defaultStagingSize);
+		/** @brief Waits for all uploads and releases all resources */
+		void destroy();
+
+		/**
+		* @brief Records a copy of data into a buffer
+		* @param dstStageMask Pipeline stages of the graphics queue that access the buffer after the upload
+		* @param dstAccessMask Access types of those stages
+		*/
+		void uploadBuffer(VkBuffer buffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0, VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VkAccessFlags dstAccessMask = VK_ACCESS_MEMORY_READ_BIT);
+		/**
+		* @brief Records a copy of data into an image in VK_IMAGE_LAYOUT_UNDEFINED and transitions it to finalLayout
+		* @param regions Copy regions with buffer offsets relative to data
+		* @param finalLayout Layout the image is in once the upload is complete
+		* @param dstStageMask Pipeline stages of the graphics queue that access the image after the upload
+		*/
+		void uploadImage(VkImage image, const void* data, VkDeviceSize size, const std::vector<VkBufferImageCopy>& regions, const VkImageSubresourceRange& subresourceRange, VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+		/**
+		* @brief Submits all recorded uploads without waiting for them
+		* @return Ticket that can be passed to isComplete() and wait(), zero if nothing had been recorded
+		*/
+		uint64_t flush();
+		bool isComplete(uint64_t ticket);
+		void wait(uint64_t ticket);
+		/** @brief Submits and waits for all recorded uploads */
+		void waitIdle();
+
+		/** @brief Number of submissions and bytes streamed through the staging ring (and temporary staging buffers) since prepare */
+		uint64_t submissionCount{ 0 };
+		VkDeviceSize uploadedBytes{ 0 };
+
+	private:
+		// Command buffers and staging ranges of a flush that may still be in flight
+		struct Submission
+		{
+			uint64_t ticket{ 0 };
+			VkCommandBuffer transferCommandBuffer{ VK_NULL_HANDLE };
+			VkCommandBuffer acquireCommandBuffer{ VK_NULL_HANDLE };
+			// Fence and binary semaphore if timeline semaphores aren't available
+			VkFence fence{ VK_NULL_HANDLE };
+			VkSemaphore semaphore{ VK_NULL_HANDLE };
+			// End of the submission's range in the staging ring
+			VkDeviceSize stagingEnd{ 0 };
+			std::vector<std::pair<VkBuffer, MemoryAllocation>> temporaryBuffers;
+		};
+
+		VulkanDevice* device{ nullptr };
+		std::mutex mutex;
+		VkQueue transferQueue{ VK_NULL_HANDLE };
+		VkQueue graphicsQueue{ VK_NULL_HANDLE };
+		bool ownershipTransfer{ false };
+		bool timelineSemaphores{ false };
+		PFN_vkGetSemaphoreCounterValueKHR vkGetSemaphoreCounterValueKHR{ nullptr };
+		PFN_vkWaitSemaphoresKHR vkWaitSemaphoresKHR{ nullptr };
+		// Signalled with the ticket of a submission once its copies (transfer) and ownership acquires (acquire) are done
+		VkSemaphore transferTimeline{ VK_NULL_HANDLE };
+		VkSemaphore acquireTimeline{ VK_NULL_HANDLE };
+		VkCommandPool transferCommandPool{ VK_NULL_HANDLE };
+		VkCommandPool acquireCommandPool{ VK_NULL_HANDLE };
+
+		VkBuffer stagingBuffer{ VK_NULL_HANDLE };
+		MemoryAllocation stagingAllocation;
+		VkDeviceSize stagingSize{ 0 };
+		// Ring state: ranges between tail and head are in use by recorded or in-flight submissions
+		VkDeviceSize stagingHead{ 0 };
+		VkDeviceSize stagingTail{ 0 };
+
+		// Submission that is currently being recorded, completed submissions are recycled
+		Submission recording;
+		std::deque<Submission> inFlight;
+		std::vector<Submission> freeSubmissions;
+		uint64_t lastTicket{ 0 };
+		uint64_t completedTicket{ 0 };
+
+		void beginRecording();
+		void stage(const void* data, VkDeviceSize size, VkBuffer& buffer, VkDeviceSize& offset);
+		bool allocateStaging(VkDeviceSize size, VkDeviceSize& offset);
+		uint64_t submit();
+		void releaseCompleted(bool waitForOldest);
+		bool submissionComplete(const Submission& submission);
+		void recycle(Submission& submission);
+	};
+}
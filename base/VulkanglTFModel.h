@@ -22,6 +22,7 @@
 
 #include "vulkan/vulkan.h"
 #include "VulkanDevice.h"
+#include "VulkanDescriptorAllocator.h"
 
 #include <ktx.h>
 #include <ktxvulkan.h>
@@ -38,6 +39,8 @@
 #endif
 #include "tiny_gltf.h"
 
+#include "gltfanimation.hpp"
+
 #if defined(__ANDROID__)
 #include <android/asset_manager.h>
 #endif
@@ -64,6 +67,7 @@ namespace vkglTF
 		VkImage image;
 		VkImageLayout imageLayout;
 		VkDeviceMemory deviceMemory;
+		vks::MemoryAllocation allocation;
 		VkImageView view;
 		uint32_t width, height;
 		uint32_t mipLevels;
@@ -99,7 +103,7 @@ namespace vkglTF
 		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
 
 		Material(vks::VulkanDevice* device) : device(device) {};
-		void createDescriptorSet(VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorBindingFlags);
+		void createDescriptorSet(vks::DescriptorAllocator& descriptorAllocator, VkDescriptorSetLayout descriptorSetLayout, uint32_t descriptorBindingFlags);
 	};
 
 	/*
@@ -183,35 +187,10 @@ namespace vkglTF
 	};
 
 	/*
-		glTF animation channel
-	*/
-	struct AnimationChannel {
-		enum PathType { TRANSLATION, ROTATION, SCALE };
-		PathType path;
-		Node* node;
-		uint32_t samplerIndex;
-	};
-
-	/*
-		glTF animation sampler
+		glTF animation channel, sampler and animation (see gltfanimation.hpp)
 	*/
-	struct AnimationSampler {
-		enum InterpolationType { LINEAR, STEP, CUBICSPLINE };
-		InterpolationType interpolation;
-		std::vector<float> inputs;
-		std::vector<glm::vec4> outputsVec4;
-	};
-
-	/*
-		glTF animation
-	*/
-	struct Animation {
-		std::string name;
-		std::vector<AnimationSampler> samplers;
-		std::vector<AnimationChannel> channels;
-		float start = std::numeric_limits<float>::max();
-		float end = std::numeric_limits<float>::min();
-	};
+	using AnimationChannel = AnimationChannelT<Node>;
+	using Animation = AnimationT<Node>;
 
 	/*
 		glTF default vertex layout with easy Vulkan mapping functions
@@ -261,17 +240,19 @@ namespace vkglTF
 		void createEmptyTexture(VkQueue transferQueue);
 	public:
 		vks::VulkanDevice* device;
-		VkDescriptorPool descriptorPool;
+		vks::DescriptorAllocator descriptorAllocator;
 
 		struct Vertices {
 			int count;
 			VkBuffer buffer;
 			VkDeviceMemory memory;
+			vks::MemoryAllocation allocation;
 		} vertices;
 		struct Indices {
 			int count;
 			VkBuffer buffer;
 			VkDeviceMemory memory;
+			vks::MemoryAllocation allocation;
 		} indices;
 
 		std::vector<Node*> nodes;
@@ -12,7 +12,11 @@
 #include <limits>
 #include <functional>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iomanip>
+#include <numeric>
+#include <ostream>
 
 namespace vks
 {
@@ -32,6 +36,45 @@ namespace vks
 		double runtime = 0.0;
 		uint32_t frameCount = 0;
 
+		/** @brief Optional callback returning the segment (e.g. of a camera path) the next frame belongs to, enables per-segment frame statistics */
+		std::function<uint32_t()> currentSegment;
+		std::vector<std::vector<double>> segmentFrameTimes;
+
+		/** @brief Optional callback called once the warm-up has finished, before the first measured frame */
+		std::function<void()> measurementStarted;
+
+		/** @brief Additional named sections written to JSON result files, each callback writes a single JSON value */
+		std::vector<std::pair<std::string, std::function<void(std::ostream&)>>> resultSections;
+
+		static std::string jsonEscape(const std::string& value) {
+			std::string escaped;
+			for (const char c : value) {
+				if (c == '"' || c == '\\') {
+					escaped += '\\';
+					escaped += c;
+				} else if (static_cast<unsigned char>(c) < 0x20) {
+					// Control characters must be escaped as \u00XX in JSON strings
+					char code[7];
+					snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+					escaped += code;
+				} else {
+					escaped += c;
+				}
+			}
+			return escaped;
+		}
+
+		/** @brief Returns the given percentile (0..100) of the measured frame times */
+		double percentile(double p) const {
+			if (frameTimes.empty()) {
+				return 0.0;
+			}
+			std::vector<double> sorted(frameTimes);
+			std::sort(sorted.begin(), sorted.end());
+			size_t index = static_cast<size_t>(std::ceil((p / 100.0) * sorted.size()));
+			return sorted[std::clamp<size_t>(index, 1, sorted.size()) - 1];
+		}
+
 		void run(std::function<void()> renderFunc, VkPhysicalDeviceProperties deviceProps) {
 			active = true;
 			this->deviceProps = deviceProps;
@@ -57,13 +100,23 @@ namespace vks
 			}
 
 			// Benchmark phase
+			if (measurementStarted) {
+				measurementStarted();
+			}
 			{
 				while (runtime < (duration * 1000.0)) {
+					const uint32_t segment = currentSegment ? currentSegment() : 0;
 					auto tStart = std::chrono::high_resolution_clock::now();
 					renderFunc();
 					auto tDiff = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
 					runtime += tDiff;
 					frameTimes.push_back(tDiff);
+					if (currentSegment) {
+						if (segment >= segmentFrameTimes.size()) {
+							segmentFrameTimes.resize(segment + 1);
+						}
+						segmentFrameTimes[segment].push_back(tDiff);
+					}
 					frameCount++;
 					if (outputFrames != -1 && outputFrames == frameCount) break;
 				};
@@ -73,11 +126,80 @@ namespace vks
 				std::cout << "runtime: " << (runtime / 1000.0) << "\n";
 				std::cout << "frames : " << frameCount << "\n";
 				std::cout << "fps    : " << frameCount / (runtime / 1000.0) << "\n";
+				if (!segmentFrameTimes.empty()) {
+					std::cout << "segment  frames  mean (ms)  max (ms)\n";
+					for (size_t i = 0; i < segmentFrameTimes.size(); i++) {
+						const std::vector<double>& times = segmentFrameTimes[i];
+						if (times.empty()) {
+							continue;
+						}
+						std::cout << std::setw(7) << i << std::setw(8) << times.size()
+							<< std::setw(11) << std::accumulate(times.begin(), times.end(), 0.0) / (double)times.size()
+							<< std::setw(10) << *std::max_element(times.begin(), times.end()) << "\n";
+					}
+				}
 			}
 		}
 
+		/** @brief Writes results and frame time statistics as JSON (used if the result file name ends with .json) */
+		void saveResultsJson(std::ofstream& result) {
+			double tMin = frameTimes.empty() ? 0.0 : *std::min_element(frameTimes.begin(), frameTimes.end());
+			double tMax = frameTimes.empty() ? 0.0 : *std::max_element(frameTimes.begin(), frameTimes.end());
+			double tAvg = frameTimes.empty() ? 0.0 : std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / (double)frameTimes.size();
+			double variance = 0.0;
+			for (const double t : frameTimes) {
+				variance += (t - tAvg) * (t - tAvg);
+			}
+			double tStdDev = (frameTimes.size() > 1) ? std::sqrt(variance / (double)(frameTimes.size() - 1)) : 0.0;
+
+			result << "{\n";
+			result << "  \"device\": \"" << jsonEscape(deviceProps.deviceName) << "\",\n";
+			result << "  \"driverVersion\": " << deviceProps.driverVersion << ",\n";
+			result << "  \"warmup\": " << warmup << ",\n";
+			result << "  \"runtime\": " << runtime << ",\n";
+			result << "  \"frames\": " << frameCount << ",\n";
+			result << "  \"fps\": " << ((runtime > 0.0) ? frameCount / (runtime / 1000.0) : 0.0) << ",\n";
+			result << "  \"frameTime\": {";
+			result << "\"min\": " << tMin << ", \"max\": " << tMax << ", \"mean\": " << tAvg << ", \"stddev\": " << tStdDev;
+			result << ", \"median\": " << percentile(50.0) << ", \"p95\": " << percentile(95.0) << ", \"p99\": " << percentile(99.0) << "}";
+			if (!segmentFrameTimes.empty()) {
+				result << ",\n  \"segments\": [";
+				for (size_t i = 0; i < segmentFrameTimes.size(); i++) {
+					const std::vector<double>& times = segmentFrameTimes[i];
+					const double mean = times.empty() ? 0.0 : std::accumulate(times.begin(), times.end(), 0.0) / (double)times.size();
+					result << (i > 0 ? ",\n    " : "\n    ") << "{\"segment\": " << i << ", \"frames\": " << times.size();
+					result << ", \"mean\": " << mean;
+					result << ", \"min\": " << (times.empty() ? 0.0 : *std::min_element(times.begin(), times.end()));
+					result << ", \"max\": " << (times.empty() ? 0.0 : *std::max_element(times.begin(), times.end())) << "}";
+				}
+				result << "\n  ]";
+			}
+			for (auto& [name, writeSection] : resultSections) {
+				result << ",\n  \"" << jsonEscape(name) << "\": ";
+				writeSection(result);
+			}
+			if (outputFrameTimes) {
+				result << ",\n  \"frameTimes\": [";
+				for (size_t i = 0; i < frameTimes.size(); i++) {
+					result << (i > 0 ? ", " : "") << frameTimes[i];
+				}
+				result << "]";
+			}
+			result << "\n}\n";
+		}
+
 		void saveResults() {
 			std::ofstream result(filename, std::ios::out);
+			const bool json = (filename.size() > 5) && (filename.compare(filename.size() - 5, 5, ".json") == 0);
+			if (result.is_open() && json) {
+				result << std::fixed << std::setprecision(4);
+				saveResultsJson(result);
+				result.flush();
+#if defined(_WIN32)
+				FreeConsole();
+#endif
+				return;
+			}
 			if (result.is_open()) {
 				result << std::fixed << std::setprecision(4);
 
@@ -13,6 +13,12 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 class Camera {
  private:
   float fov_;
@@ -50,6 +56,10 @@ class Camera {
     }
   };
 
+  void recordPathKeyframe() {
+    path_.keyframes.push_back({path_.time, position_, rotation_});
+  }
+
  public:
   enum CameraType { lookat, firstperson };
   CameraType type_ = CameraType::lookat;
@@ -76,6 +86,24 @@ class Camera {
     bool down = false;
   } keys_;
 
+  // Camera paths store timestamped poses that can be recorded during
+  // interactive runs and replayed (e.g. in benchmark mode)
+  struct PathKeyframe {
+    float time;
+    glm::vec3 position;
+    glm::vec3 rotation;
+  };
+
+  struct {
+    std::vector<PathKeyframe> keyframes;
+    bool recording = false;
+    bool playing = false;
+    // Current time on the path in seconds (wraps around during playback)
+    float time = 0.0f;
+    // Minimum time between two recorded keyframes in seconds
+    float recordInterval = 0.1f;
+  } path_;
+
   bool moving() const {
     return keys_.left || keys_.right || keys_.up || keys_.down;
   }
@@ -144,8 +172,140 @@ class Camera {
     this->movementSpeed = movementSpeed;
   }
 
+  void startPathRecording() {
+    path_.keyframes.clear();
+    path_.time = 0.0f;
+    path_.playing = false;
+    path_.recording = true;
+    recordPathKeyframe();
+  }
+
+  void stopPathRecording() {
+    if (path_.recording && (path_.keyframes.back().time < path_.time)) {
+      recordPathKeyframe();
+    }
+    path_.recording = false;
+  }
+
+  void startPathPlayback() {
+    path_.recording = false;
+    path_.playing = !path_.keyframes.empty();
+    path_.time = 0.0f;
+    if (path_.playing) {
+      applyPathPose(pathPoseAt(0.0f));
+    }
+  }
+
+  float pathDuration() const {
+    return path_.keyframes.empty() ? 0.0f : path_.keyframes.back().time;
+  }
+
+  // Returns the linearly interpolated pose at the given path time
+  PathKeyframe pathPoseAt(float time) const {
+    const std::vector<PathKeyframe>& keyframes = path_.keyframes;
+    if (keyframes.empty()) {
+      return {time, position_, rotation_};
+    }
+    auto next = std::upper_bound(
+        keyframes.begin(), keyframes.end(), time,
+        [](float t, const PathKeyframe& key) { return t < key.time; });
+    if (next == keyframes.begin()) {
+      return keyframes.front();
+    }
+    if (next == keyframes.end()) {
+      return keyframes.back();
+    }
+    const PathKeyframe& prev = *(next - 1);
+    const float span = next->time - prev.time;
+    const float t = (span > 0.0f) ? (time - prev.time) / span : 0.0f;
+    return {time, glm::mix(prev.position, next->position, t),
+            glm::mix(prev.rotation, next->rotation, t)};
+  }
+
+  // Returns the index of the equally sized path segment the current path
+  // time falls into, used to attribute frame times to parts of the path
+  uint32_t pathSegment(uint32_t segmentCount) const {
+    const float duration = pathDuration();
+    if ((duration <= 0.0f) || (segmentCount == 0)) {
+      return 0;
+    }
+    return std::min(static_cast<uint32_t>(path_.time / duration *
+                                          static_cast<float>(segmentCount)),
+                    segmentCount - 1);
+  }
+
+  // Pose changes from playback count as camera updates, so examples that
+  // only rebuild their uniforms when the camera was updated follow the path
+  void applyPathPose(const PathKeyframe& pose) {
+    if ((position_ != pose.position) || (rotation_ != pose.rotation)) {
+      updated = true;
+    }
+    position_ = pose.position;
+    rotation_ = pose.rotation;
+    updateViewMatrix();
+  }
+
+  // Path files are plain text, one keyframe per line:
+  // time position.x position.y position.z rotation.x rotation.y rotation.z
+  bool savePath(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+      return false;
+    }
+    file << "# camera path: time px py pz rx ry rz\n";
+    for (const PathKeyframe& key : path_.keyframes) {
+      file << key.time << " " << key.position.x << " " << key.position.y
+           << " " << key.position.z << " " << key.rotation.x << " "
+           << key.rotation.y << " " << key.rotation.z << "\n";
+    }
+    return file.good();
+  }
+
+  bool loadPath(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+      return false;
+    }
+    std::vector<PathKeyframe> keyframes;
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      PathKeyframe key{};
+      std::istringstream values(line);
+      if (!(values >> key.time >> key.position.x >> key.position.y >>
+            key.position.z >> key.rotation.x >> key.rotation.y >>
+            key.rotation.z)) {
+        return false;
+      }
+      // Keyframes need to be sorted by time for interpolation
+      if (!keyframes.empty() && key.time < keyframes.back().time) {
+        return false;
+      }
+      keyframes.push_back(key);
+    }
+    if (keyframes.empty()) {
+      return false;
+    }
+    path_.keyframes = std::move(keyframes);
+    return true;
+  }
+
   void update(float deltaTime) {
     updated = false;
+    if (path_.playing) {
+      // Replay the path in a loop, the path pose overrides user input
+      const float duration = pathDuration();
+      path_.time += deltaTime;
+      if (duration > 0.0f) {
+        path_.time = fmodf(path_.time, duration);
+      } else {
+        path_.time = 0.0f;
+      }
+      applyPathPose(pathPoseAt(path_.time));
+      return;
+    }
     if (type_ == CameraType::firstperson) {
       if (moving()) {
         glm::vec3 camFront;
@@ -172,6 +332,12 @@ class Camera {
                        moveSpeed;
       }
     }
+    if (path_.recording) {
+      path_.time += deltaTime;
+      if (path_.time - path_.keyframes.back().time >= path_.recordInterval) {
+        recordPathKeyframe();
+      }
+    }
     updateViewMatrix();
   };
 
@@ -0,0 +1,139 @@
+/*
+* glTF node transform and animation functions used by the Vulkan glTF model class
+*
+* Kept free of Vulkan and templated on the node type so they can also be used by the CPU benchmarks
+*
+* Copyright (C) 2018-2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace vkglTF
+{
+	/*
+		glTF animation channel
+	*/
+	template <typename NodeType>
+	struct AnimationChannelT {
+		enum PathType { TRANSLATION, ROTATION, SCALE };
+		PathType path;
+		NodeType* node;
+		uint32_t samplerIndex;
+	};
+
+	/*
+		glTF animation sampler
+	*/
+	struct AnimationSampler {
+		enum InterpolationType { LINEAR, STEP, CUBICSPLINE };
+		InterpolationType interpolation;
+		std::vector<float> inputs;
+		std::vector<glm::vec4> outputsVec4;
+	};
+
+	/*
+		glTF animation
+	*/
+	template <typename NodeType>
+	struct AnimationT {
+		std::string name;
+		std::vector<AnimationSampler> samplers;
+		std::vector<AnimationChannelT<NodeType>> channels;
+		float start = std::numeric_limits<float>::max();
+		float end = std::numeric_limits<float>::min();
+	};
+
+	/*
+		Node transforms, the node type needs translation, rotation, scale, matrix and parent members
+	*/
+	template <typename NodeType>
+	glm::mat4 nodeLocalMatrix(const NodeType& node) {
+		return glm::translate(glm::mat4(1.0f), node.translation) * glm::mat4(node.rotation) * glm::scale(glm::mat4(1.0f), node.scale) * node.matrix;
+	}
+
+	template <typename NodeType>
+	glm::mat4 nodeMatrix(const NodeType& node) {
+		glm::mat4 m = nodeLocalMatrix(node);
+		const NodeType* p = node.parent;
+		while (p) {
+			m = nodeLocalMatrix(*p) * m;
+			p = p->parent;
+		}
+		return m;
+	}
+
+	/*
+		Joint matrices of a skin relative to the node the skinned mesh is attached to
+	*/
+	template <typename NodeType>
+	void nodeJointMatrices(const glm::mat4& nodeMatrix, const std::vector<NodeType*>& joints, const std::vector<glm::mat4>& inverseBindMatrices, glm::mat4* jointMatrices) {
+		glm::mat4 inverseTransform = glm::inverse(nodeMatrix);
+		for (size_t i = 0; i < joints.size(); i++) {
+			glm::mat4 jointMat = vkglTF::nodeMatrix(*joints[i]) * inverseBindMatrices[i];
+			jointMatrices[i] = inverseTransform * jointMat;
+		}
+	}
+
+	/*
+		Updates the translation, rotation and scale of all nodes animated by the given animation at the given time
+		Returns true if any node has been changed
+	*/
+	template <typename NodeType>
+	bool applyAnimation(AnimationT<NodeType>& animation, float time) {
+		bool updated = false;
+		for (auto& channel : animation.channels) {
+			AnimationSampler &sampler = animation.samplers[channel.samplerIndex];
+			if (sampler.inputs.size() > sampler.outputsVec4.size()) {
+				continue;
+			}
+
+			for (auto i = 0; i < sampler.inputs.size() - 1; i++) {
+				if ((time >= sampler.inputs[i]) && (time <= sampler.inputs[i + 1])) {
+					float u = std::max(0.0f, time - sampler.inputs[i]) / (sampler.inputs[i + 1] - sampler.inputs[i]);
+					if (u <= 1.0f) {
+						switch (channel.path) {
+						case AnimationChannelT<NodeType>::PathType::TRANSLATION: {
+							glm::vec4 trans = glm::mix(sampler.outputsVec4[i], sampler.outputsVec4[i + 1], u);
+							channel.node->translation = glm::vec3(trans);
+							break;
+						}
+						case AnimationChannelT<NodeType>::PathType::SCALE: {
+							glm::vec4 trans = glm::mix(sampler.outputsVec4[i], sampler.outputsVec4[i + 1], u);
+							channel.node->scale = glm::vec3(trans);
+							break;
+						}
+						case AnimationChannelT<NodeType>::PathType::ROTATION: {
+							glm::quat q1;
+							q1.x = sampler.outputsVec4[i].x;
+							q1.y = sampler.outputsVec4[i].y;
+							q1.z = sampler.outputsVec4[i].z;
+							q1.w = sampler.outputsVec4[i].w;
+							glm::quat q2;
+							q2.x = sampler.outputsVec4[i + 1].x;
+							q2.y = sampler.outputsVec4[i + 1].y;
+							q2.z = sampler.outputsVec4[i + 1].z;
+							q2.w = sampler.outputsVec4[i + 1].w;
+							channel.node->rotation = glm::normalize(glm::slerp(q1, q2, u));
+							break;
+						}
+						}
+						updated = true;
+					}
+				}
+			}
+		}
+		return updated;
+	}
+}
@@ -0,0 +1,58 @@
+/*
+* Lock-free single producer, single consumer queue for passing input events between threads
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace vks
+{
+	/**
+	* @brief Fixed size ring buffer that one thread pushes to and another thread pops from
+	* Used to feed window system events from the main thread to the render thread without locks. Head and tail live on separate cache lines, so producer and consumer don't invalidate each other's line on every event
+	*/
+	template <typename T, size_t Capacity>
+	class InputQueue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		/** @brief Called by the producer, returns false if the queue is full */
+		bool push(const T& item)
+		{
+			const size_t tail = this->tail.load(std::memory_order_relaxed);
+			if (tail - head.load(std::memory_order_acquire) == Capacity)
+			{
+				return false;
+			}
+			items[tail & (Capacity - 1)] = item;
+			this->tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** @brief Called by the consumer, returns false if the queue is empty */
+		bool pop(T& item)
+		{
+			const size_t head = this->head.load(std::memory_order_relaxed);
+			if (head == tail.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+			item = items[head & (Capacity - 1)];
+			this->head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		alignas(64) std::atomic<size_t> head{ 0 };
+		alignas(64) std::atomic<size_t> tail{ 0 };
+		std::array<T, Capacity> items{};
+	};
+}
@@ -0,0 +1,172 @@
+/*
+* Hardware performance counters of the calling thread (Linux only, using perf_event_open)
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace vks
+{
+	/**
+	* @brief Reads CPU cycles, retired instructions, last level cache misses and branch misses of the calling thread
+	* The counters of a thread are opened as a single group on its first read, so all values of a read are sampled at the same time. Kernel time is excluded
+	* @note Opening the counters may be prevented by the kernel.perf_event_paranoid setting (needs to be 2 or lower), in which case no values are available
+	*/
+	class PerfCounters
+	{
+	public:
+		enum Counter { Cycles = 0, Instructions, CacheMisses, BranchMisses, CounterCount };
+
+		struct Values
+		{
+			uint64_t counters[CounterCount]{};
+
+			Values& operator+=(const Values& other)
+			{
+				for (uint32_t i = 0; i < CounterCount; i++)
+				{
+					counters[i] += other.counters[i];
+				}
+				return *this;
+			}
+			Values operator-(const Values& other) const
+			{
+				Values difference;
+				for (uint32_t i = 0; i < CounterCount; i++)
+				{
+					difference.counters[i] = counters[i] - other.counters[i];
+				}
+				return difference;
+			}
+		};
+
+		static const char* counterName(Counter counter)
+		{
+			switch (counter)
+			{
+			case Cycles:
+				return "cycles";
+			case Instructions:
+				return "instructions";
+			case CacheMisses:
+				return "llcMisses";
+			case BranchMisses:
+				return "branchMisses";
+			default:
+				return "";
+			}
+		}
+
+		/** @brief Reads the current counter values of the calling thread, returns false if no counters are available. Counters that couldn't be opened read as zero */
+		static bool read(Values& values)
+		{
+#if defined(__linux__)
+			Group& group = threadGroup();
+			if (group.leader < 0)
+			{
+				return false;
+			}
+			// Layout for PERF_FORMAT_GROUP: number of counters followed by the values in the order they were added to the group
+			struct
+			{
+				uint64_t count;
+				uint64_t values[CounterCount];
+			} data{};
+			const ssize_t size = ::read(group.leader, &data, sizeof(data));
+			if (size < static_cast<ssize_t>(sizeof(uint64_t) * (1 + data.count)))
+			{
+				return false;
+			}
+			for (uint32_t i = 0; i < CounterCount; i++)
+			{
+				values.counters[i] = (group.slot[i] >= 0) ? data.values[group.slot[i]] : 0;
+			}
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/** @brief True if counters could be opened for the calling thread */
+		static bool available()
+		{
+			Values values;
+			return read(values);
+		}
+
+	private:
+#if defined(__linux__)
+		struct Group
+		{
+			int leader{ -1 };
+			int fds[CounterCount]{ -1, -1, -1, -1 };
+			// Position of each counter's value in a group read, -1 if the counter couldn't be opened
+			int32_t slot[CounterCount]{ -1, -1, -1, -1 };
+
+			Group()
+			{
+				// Generic cache misses map to last level cache misses on most CPUs
+				const uint64_t configs[CounterCount] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+				int32_t count = 0;
+				for (uint32_t i = 0; i < CounterCount; i++)
+				{
+					perf_event_attr attr;
+					memset(&attr, 0, sizeof(attr));
+					attr.size = sizeof(attr);
+					attr.type = PERF_TYPE_HARDWARE;
+					attr.config = configs[i];
+					attr.read_format = PERF_FORMAT_GROUP;
+					attr.exclude_kernel = 1;
+					attr.exclude_hv = 1;
+					// Counting for the calling thread only, on any CPU
+					fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+					if (fds[i] < 0)
+					{
+						// Without cycles there is no group leader and no counter is read
+						if (i == Cycles)
+						{
+							return;
+						}
+						continue;
+					}
+					if (leader < 0)
+					{
+						leader = fds[i];
+					}
+					slot[i] = count++;
+				}
+			}
+			~Group()
+			{
+				for (int fd : fds)
+				{
+					if (fd >= 0)
+					{
+						close(fd);
+					}
+				}
+			}
+			Group(const Group&) = delete;
+			Group& operator=(const Group&) = delete;
+		};
+
+		static Group& threadGroup()
+		{
+			thread_local Group group;
+			return group;
+		}
+#endif
+	};
+}
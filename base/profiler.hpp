@@ -0,0 +1,360 @@
+/*
+* Lightweight scoped zone profiler with Chrome trace event export
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "perfcounters.hpp"
+
+namespace vks
+{
+	/**
+	* @brief Records named time zones of all threads (and the GPU) for a range of frames and exports them as a Chrome trace
+	* Every thread writes to its own fixed size ring buffer, so recording a zone needs no locks. Only registering a thread's buffer on its first zone is locked
+	* The exported file can be opened in chrome://tracing or https://ui.perfetto.dev
+	* Optionally hardware performance counters are sampled for every zone and accumulated per zone name and frame (see vks::PerfCounters)
+	*/
+	class Profiler
+	{
+	public:
+		struct Zone
+		{
+			const char* name;
+			int64_t begin;
+			int64_t end;
+			uint64_t frame;
+		};
+
+		struct CounterSample
+		{
+			uint32_t calls{ 0 };
+			PerfCounters::Values values;
+		};
+
+		/** @brief Zones recorded by a single thread (or the GPU) */
+		struct Track
+		{
+			uint32_t id;
+			std::string name;
+			std::vector<Zone> zones;
+			// Only written by the thread owning the track, zones before this index are complete
+			std::atomic<uint64_t> count{ 0 };
+			// Performance counters accumulated per frame and zone name for the last counterFrames frames, and per zone name for all frames since the totals started, only written by the thread owning the track
+			std::map<std::pair<uint64_t, const char*>, CounterSample> counterSamples;
+			std::map<const char*, CounterSample> counterTotals;
+		};
+
+		/** @brief Number of zones kept per track, older zones are overwritten */
+		static const size_t zonesPerTrack = 16384;
+		/** @brief Number of most recent frames performance counters are kept per frame for, totals include all frames */
+		static const uint64_t counterFrames = 1024;
+
+		static Profiler& get()
+		{
+			static Profiler profiler;
+			return profiler;
+		}
+
+		/** @brief Current time in nanoseconds, all zones (including GPU zones) use this clock */
+		static int64_t now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		bool capturing() const
+		{
+			return active.load(std::memory_order_relaxed);
+		}
+
+		/** @brief Discards all previously recorded zones and starts recording, must not be called while other threads are recording zones (e.g. only between frames) */
+		void beginCapture()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (auto& track : tracks)
+			{
+				track->count.store(0, std::memory_order_relaxed);
+			}
+			active.store(true);
+		}
+
+		void endCapture()
+		{
+			active.store(false);
+		}
+
+		bool counting() const
+		{
+			return countersEnabled.load(std::memory_order_relaxed);
+		}
+
+		/** @brief Enables sampling of hardware performance counters for all zones, returns false if counters aren't available on this system */
+		bool enableCounters()
+		{
+			if (!PerfCounters::available())
+			{
+				return false;
+			}
+			countersEnabled.store(true);
+			return true;
+		}
+
+		/** @brief Counter totals only include frames from the given one on, e.g. to leave out loading and warm-up frames */
+		void setCounterTotalsFirstFrame(uint64_t frame)
+		{
+			countersFirstFrame.store(frame, std::memory_order_relaxed);
+		}
+
+		/** @brief Sets the frame number stored with all zones recorded from now on */
+		void setFrame(uint64_t frame)
+		{
+			currentFrame.store(frame, std::memory_order_relaxed);
+		}
+
+		/** @brief Sets the name the calling thread is displayed with in the trace */
+		void setThreadName(const std::string& name)
+		{
+			Track& track = threadTrack();
+			std::lock_guard<std::mutex> lock(mutex);
+			track.name = name;
+		}
+
+		/** @brief Adds a zone for the calling thread, name must stay valid until the trace has been written (e.g. a string literal) */
+		void addZone(const char* name, int64_t begin, int64_t end)
+		{
+			if (capturing())
+			{
+				record(threadTrack(), name, begin, end, currentFrame.load(std::memory_order_relaxed));
+			}
+		}
+
+		/** @brief Adds performance counter deltas of a zone of the calling thread to the current frame's totals for that zone name */
+		void addCounters(const char* name, const PerfCounters::Values& values)
+		{
+			Track& track = threadTrack();
+			const uint64_t frame = currentFrame.load(std::memory_order_relaxed);
+			CounterSample& sample = track.counterSamples[{ frame, name }];
+			sample.calls++;
+			sample.values += values;
+			if (frame >= countersFirstFrame.load(std::memory_order_relaxed))
+			{
+				CounterSample& total = track.counterTotals[name];
+				total.calls++;
+				total.values += values;
+			}
+			// Samples are ordered by frame, so the oldest frames are dropped from the front
+			while (track.counterSamples.begin()->first.first + counterFrames <= frame)
+			{
+				track.counterSamples.erase(track.counterSamples.begin());
+			}
+		}
+
+		/** @brief Adds a zone that has been executed on the GPU, with begin and end already converted to the profiler's clock */
+		void addGpuZone(const char* name, int64_t begin, int64_t end, uint64_t frame)
+		{
+			record(*gpuTrack, name, begin, end, frame);
+		}
+
+		/** @brief Writes all recorded zones in the Chrome trace event format */
+		bool writeTrace(const std::string& filename)
+		{
+			std::ofstream file(filename);
+			if (!file.is_open())
+			{
+				return false;
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			// Timestamps are written relative to the earliest zone
+			int64_t origin = INT64_MAX;
+			for (auto& track : tracks)
+			{
+				forEachZone(*track, [&origin](const Zone& zone) { origin = std::min(origin, zone.begin); });
+			}
+			file << std::fixed << std::setprecision(3);
+			file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+			bool first = true;
+			for (auto& track : tracks)
+			{
+				file << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << track->id << ", \"args\": {\"name\": \"" << track->name << "\"}}";
+				file << ",\n{\"name\": \"thread_sort_index\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << track->id << ", \"args\": {\"sort_index\": " << track->id << "}}";
+				first = false;
+				const char* category = (track.get() == gpuTrack) ? "gpu" : "cpu";
+				forEachZone(*track, [&](const Zone& zone) {
+					file << ",\n{\"name\": \"" << zone.name << "\", \"cat\": \"" << category << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << track->id;
+					file << ", \"ts\": " << (zone.begin - origin) / 1000.0 << ", \"dur\": " << (zone.end - zone.begin) / 1000.0;
+					file << ", \"args\": {\"frame\": " << zone.frame << "}}";
+				});
+			}
+			file << "\n]}\n";
+			return true;
+		}
+
+		/**
+		* @brief Writes the performance counters of all threads summed up per zone name as a JSON object, with totals over the frames starting at the one passed to setCounterTotalsFirstFrame and the values of the last counterFrames frames
+		* @note Must not be called while other threads are recording zones
+		*/
+		void writeCountersJson(std::ostream& os)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			// Zone names are compared by value, as the same literal may have different addresses in different translation units
+			std::map<std::string, std::pair<CounterSample, std::map<uint64_t, CounterSample>>> scopes;
+			for (auto& track : tracks)
+			{
+				for (auto& [name, sample] : track->counterTotals)
+				{
+					CounterSample& total = scopes[name].first;
+					total.calls += sample.calls;
+					total.values += sample.values;
+				}
+				for (auto& [key, sample] : track->counterSamples)
+				{
+					CounterSample& frameSample = scopes[key.second].second[key.first];
+					frameSample.calls += sample.calls;
+					frameSample.values += sample.values;
+				}
+			}
+			os << "{\"firstFrame\": " << countersFirstFrame.load(std::memory_order_relaxed) << ", \"counters\": [";
+			for (uint32_t i = 0; i < PerfCounters::CounterCount; i++)
+			{
+				os << (i > 0 ? ", " : "") << "\"" << PerfCounters::counterName(static_cast<PerfCounters::Counter>(i)) << "\"";
+			}
+			os << "],\n    \"scopes\": [";
+			bool first = true;
+			for (auto& [name, scope] : scopes)
+			{
+				const CounterSample& total = scope.first;
+				const uint64_t cycles = total.values.counters[PerfCounters::Cycles];
+				os << (first ? "" : ",") << "\n      {\"name\": \"" << name << "\", \"calls\": " << total.calls;
+				for (uint32_t i = 0; i < PerfCounters::CounterCount; i++)
+				{
+					os << ", \"" << PerfCounters::counterName(static_cast<PerfCounters::Counter>(i)) << "\": " << total.values.counters[i];
+				}
+				os << ", \"ipc\": " << ((cycles > 0) ? static_cast<double>(total.values.counters[PerfCounters::Instructions]) / cycles : 0.0);
+				// Per frame values as [frame, calls, counters...]
+				os << ",\n       \"frames\": [";
+				bool firstSample = true;
+				for (auto& [frame, sample] : scope.second)
+				{
+					os << (firstSample ? "[" : ", [") << frame << ", " << sample.calls;
+					for (uint32_t i = 0; i < PerfCounters::CounterCount; i++)
+					{
+						os << ", " << sample.values.counters[i];
+					}
+					os << "]";
+					firstSample = false;
+				}
+				os << "]}";
+				first = false;
+			}
+			os << "]}";
+		}
+
+	private:
+		std::mutex mutex;
+		std::vector<std::unique_ptr<Track>> tracks;
+		Track* gpuTrack{ nullptr };
+		std::atomic<bool> active{ false };
+		std::atomic<bool> countersEnabled{ false };
+		std::atomic<uint64_t> currentFrame{ 0 };
+		std::atomic<uint64_t> countersFirstFrame{ 0 };
+
+		Profiler()
+		{
+			// The GPU track is listed last
+			gpuTrack = addTrack("GPU");
+			gpuTrack->id = UINT32_MAX;
+		}
+
+		Track* addTrack(const std::string& name)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tracks.push_back(std::unique_ptr<Track>(new Track()));
+			Track* track = tracks.back().get();
+			track->id = static_cast<uint32_t>(tracks.size());
+			track->name = name.empty() ? "thread " + std::to_string(track->id) : name;
+			track->zones.resize(zonesPerTrack);
+			return track;
+		}
+
+		Track& threadTrack()
+		{
+			// Tracks are owned by the profiler, so zones of threads that have already finished are still exported
+			thread_local Track* track = nullptr;
+			if (!track)
+			{
+				track = addTrack("");
+			}
+			return *track;
+		}
+
+		static void record(Track& track, const char* name, int64_t begin, int64_t end, uint64_t frame)
+		{
+			const uint64_t index = track.count.load(std::memory_order_relaxed);
+			track.zones[index % zonesPerTrack] = { name, begin, end, frame };
+			track.count.store(index + 1, std::memory_order_release);
+		}
+
+		template<typename Function>
+		static void forEachZone(Track& track, Function function)
+		{
+			const uint64_t count = track.count.load(std::memory_order_acquire);
+			const uint64_t first = (count > zonesPerTrack) ? count - zonesPerTrack : 0;
+			for (uint64_t i = first; i < count; i++)
+			{
+				function(track.zones[i % zonesPerTrack]);
+			}
+		}
+	};
+
+	/**
+	* @brief Records the enclosing scope as a zone of the calling thread while the profiler is capturing, name must be a string literal
+	* If counters are enabled, the performance counters of the scope (including nested zones) are added to the zone name's totals
+	*/
+	class ProfilerZone
+	{
+	public:
+		explicit ProfilerZone(const char* name) : name(name)
+		{
+			Profiler& profiler = Profiler::get();
+			counting = profiler.counting() && PerfCounters::read(counters);
+			begin = profiler.capturing() ? Profiler::now() : 0;
+		}
+		~ProfilerZone()
+		{
+			const int64_t end = (begin != 0) ? Profiler::now() : 0;
+			PerfCounters::Values values;
+			if (counting && PerfCounters::read(values))
+			{
+				Profiler::get().addCounters(name, values - counters);
+			}
+			if (begin != 0)
+			{
+				Profiler::get().addZone(name, begin, end);
+			}
+		}
+		ProfilerZone(const ProfilerZone&) = delete;
+		ProfilerZone& operator=(const ProfilerZone&) = delete;
+	private:
+		const char* name;
+		int64_t begin;
+		bool counting;
+		PerfCounters::Values counters;
+	};
+}
@@ -9,6 +9,11 @@
 
 #include "vulkanexamplebase.h"
 
+#if defined(VK_USE_PLATFORM_WAYLAND_KHR) || defined(VK_USE_PLATFORM_XCB_KHR)
+#include <poll.h>
+#include <thread>
+#endif
+
 #if defined(VK_EXAMPLE_XCODE_GENERATED)
 #if (defined(VK_USE_PLATFORM_MACOS_MVK) || defined(VK_USE_PLATFORM_METAL_EXT))
 #include <Cocoa/Cocoa.h>
@@ -25,6 +30,9 @@ extern CAMetalLayer* layer;
 
 std::vector<const char*> VulkanExampleBase::args;
 
+// Max. time in ms on-demand rendering blocks on window events at once
+static constexpr int onDemandTimeout = 250;
+
 VkResult VulkanExampleBase::createInstance() {
   std::vector<const char*> instanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME};
 
@@ -94,6 +102,24 @@ VkResult VulkanExampleBase::createInstance() {
     }
   }
 
+  // Querying heap budgets (VK_EXT_memory_budget) for the memory statistics
+  // requires VK_KHR_get_physical_device_properties2 on Vulkan 1.0
+  if ((apiVersion < VK_API_VERSION_1_1) &&
+      (std::find(supportedInstanceExtensions_.begin(),
+                 supportedInstanceExtensions_.end(),
+                 VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) !=
+       supportedInstanceExtensions_.end()) &&
+      (std::find_if(instanceExtensions.begin(), instanceExtensions.end(),
+                    [](const char* extension) {
+                      return strcmp(
+                                 extension,
+                                 VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) ==
+                             0;
+                    }) == instanceExtensions.end())) {
+    instanceExtensions.push_back(
+        VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+  }
+
   // Shaders generated by Slang require a certain SPIR-V environment that can't
   // be satisfied by Vulkan 1.0, so we need to expliclity up that to at
   // least 1.1 and enable some required extensions
@@ -219,6 +245,7 @@ std::string VulkanExampleBase::getWindowTitle() const {
 }
 
 void VulkanExampleBase::createCommandBuffers() {
+  drawCmdBuffers_.resize(framesInFlight_);
   VkCommandBufferAllocateInfo cmdBufAllocateInfo{
       .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
       .commandPool = cmdPool_,
@@ -240,25 +267,71 @@ std::string VulkanExampleBase::getShadersPath() const {
 }
 
 void VulkanExampleBase::createPipelineCache() {
-  VkPipelineCacheCreateInfo pipelineCacheCreateInfo{
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
-  VK_CHECK_RESULT(vkCreatePipelineCache(device_, &pipelineCacheCreateInfo,
-                                        nullptr, &pipelineCache_));
+  // The name is set by the derived example's constructor, so the default file
+  // name can't be set up while parsing the command line
+  if (settings_.pipelineCache && pipelineCacheFile_.empty()) {
+    pipelineCacheFile_ = name + ".pipelinecache";
+  }
+  pipelineCache_ = pipelineCacheStore_.create(
+      device_, deviceProperties_,
+      settings_.pipelineCache ? pipelineCacheFile_ : "");
+}
+
+double VulkanExampleBase::pipelineCreationTime() const {
+  double time = 0.0;
+  for (const StartupPhase& phase : startupPhases_) {
+    if (phase.name == "preparePipelines") {
+      time += phase.duration;
+    }
+  }
+  return time;
 }
 
 void VulkanExampleBase::prepare() {
+  // Window creation happens between initVulkan and prepare, so it's derived
+  // from the end of the last top-level phase
+  if (!startupPhases_.empty()) {
+    auto last = std::find_if(
+        startupPhases_.rbegin(), startupPhases_.rend(),
+        [](const StartupPhase& phase) { return phase.depth == 0; });
+    if (last != startupPhases_.rend()) {
+      const double start = last->start + last->duration;
+      const double now = std::chrono::duration<double, std::milli>(
+                             std::chrono::high_resolution_clock::now() -
+                             startupTime_)
+                             .count();
+      startupPhases_.push_back({"setupWindow", 0, start, now - start});
+    }
+  }
+  // Ends with the first call to renderLoop, so this also includes everything
+  // done by the derived example's prepare
+  prepareStartupPhase_ = beginStartupPhase("prepare");
+  const size_t swapChainPhase = beginStartupPhase("swapchain");
   createSurface();
   createCommandPool();
   createSwapChain();
+  endStartupPhase(swapChainPhase);
   createCommandBuffers();
   createSynchronizationPrimitives();
   setupDepthStencil();
   setupRenderPass();
   createPipelineCache();
   setupFrameBuffer();
+#if !defined(VK_USE_PLATFORM_ANDROID_KHR)
+  if (settings_.shaderArchive) {
+#if defined(VK_EXAMPLE_SHADER_ARCHIVE_DIR)
+    // Archives packed at build time are written to the build folder
+    const std::string archivePath = VK_EXAMPLE_SHADER_ARCHIVE_DIR;
+#else
+    const std::string archivePath = getShaderBasePath();
+#endif
+    shaderArchive_.open(archivePath + shaderDir + ".shaderpack");
+  }
+#endif
   settings_.overlay = settings_.overlay && (!benchmark.active);
   if (settings_.overlay) {
-    ui_.MAX_CONCURRENT_FRAMES = MAX_CONCURRENT_FRAMES;
+    ScopedStartupPhase startupPhase(this, "uiOverlay");
+    ui_.MAX_CONCURRENT_FRAMES = framesInFlight_;
     ui_.device = vulkanDevice_;
     ui_.queue = queue_;
     ui_.shaders = {
@@ -284,10 +357,43 @@ VkPipelineShaderStageCreateInfo VulkanExampleBase::loadShader(
   shaderStage.module = vks::tools::loadShader(
       androidApp->activity->assetManager, fileName.c_str(), device);
 #else
+  // Code from the archive is passed straight from the mapped file, and files
+  // with identical code share a single module. A .spv file that was changed
+  // after packing takes precedence over the outdated archive entry
+  const std::string shadersPath = getShadersPath();
+  vks::ShaderArchive::Shader shader;
+  bool archived =
+      shaderArchive_.isOpen() && fileName.starts_with(shadersPath) &&
+      shaderArchive_.find(std::string_view(fileName).substr(shadersPath.size()),
+                          shader);
+  if (archived && !vks::ShaderArchive::matchesSource(shader, fileName)) {
+    std::cout << "Shader archive is out of date for " << fileName
+              << ", loading the file instead\n";
+    archived = false;
+  }
+  if (archived) {
+    VkShaderModule& shaderModule = shaderArchiveModules_[shader.hash];
+    if (shaderModule == VK_NULL_HANDLE) {
+      VkShaderModuleCreateInfo moduleCI{
+          .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+          .codeSize = shader.size,
+          .pCode = shader.code};
+      VK_CHECK_RESULT(
+          vkCreateShaderModule(device_, &moduleCI, nullptr, &shaderModule));
+      shaderModules_.push_back(shaderModule);
+      pipelineRegistry_.registerShader(shaderModule, shader.hash);
+    }
+    shaderStage.module = shaderModule;
+    return shaderStage;
+  }
   shaderStage.module = vks::tools::loadShader(fileName.c_str(), device_);
 #endif
   assert(shaderStage.module != VK_NULL_HANDLE);
   shaderModules_.push_back(shaderStage.module);
+  // Loose files are identified by their path, which is stable for a run
+  pipelineRegistry_.registerShader(
+      shaderStage.module,
+      vks::PipelineRegistry::hash(fileName.data(), fileName.size()));
   return shaderStage;
 }
 
@@ -306,15 +412,8 @@ void VulkanExampleBase::nextFrame() {
 #else
   auto tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
 #endif
-  frameTimer = (float)tDiff / 1000.0f;
-  camera_.update(frameTimer);
-  // Convert to clamped timer value
-  if (!paused) {
-    timer += timerSpeed * frameTimer;
-    if (timer > 1.0) {
-      timer -= 1.0f;
-    }
-  }
+  updateTimers(tDiff);
+  tPrevEnd_ = tEnd;
   float fpsTimer =
       (float)(std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
                   .count());
@@ -330,10 +429,263 @@ void VulkanExampleBase::nextFrame() {
     frameCounter_ = 0;
     lastTimestamp_ = tEnd;
   }
-  tPrevEnd_ = tEnd;
+}
+
+void VulkanExampleBase::requestRedraw() {
+  // ImGui reacts to input in the frame after it has been received, so a few
+  // frames are rendered to let the overlay settle
+  onDemand_.redrawFrames = 3;
+}
+
+bool VulkanExampleBase::frameRequired() {
+  if (!settings_.onDemand) {
+    return true;
+  }
+  bool required = (animated && !paused) || camera_.moving();
+  if (!required && (onDemand_.redrawFrames > 0)) {
+    onDemand_.redrawFrames--;
+    required = true;
+  }
+  const auto now = std::chrono::high_resolution_clock::now();
+  if (required && onDemand_.idle) {
+    onDemand_.idle = false;
+    onDemand_.idleTime +=
+        std::chrono::duration<double>(now - onDemand_.idleStart).count();
+    // Keep the idle period out of the frame pacing statistics
+    framePacer_.resume();
+  } else if (!required && !onDemand_.idle) {
+    onDemand_.idle = true;
+    onDemand_.idleStart = now;
+    onDemand_.idlePeriods++;
+  }
+  return required;
+}
+
+void VulkanExampleBase::reportFramePacing() const {
+  if (settings_.onDemand) {
+    std::cout << "On-demand rendering: idle for " << onDemand_.idleTime
+              << " s in " << onDemand_.idlePeriods << " periods\n";
+  }
+  if (framePacer_.intervalCount == 0) {
+    return;
+  }
+  std::cout << "Frame pacing (" << framePacer_.intervalCount << " frames"
+            << (settings_.renderThread ? ", render thread" : "");
+  if (framePacer_.enabled) {
+    std::cout << ", limited to " << framePacer_.maxFrameRate << " fps";
+  }
+  std::cout << "): mean " << framePacer_.meanInterval() << " ms, jitter "
+            << framePacer_.jitter() << " ms, p99 "
+            << framePacer_.percentileInterval(0.99) << " ms, max "
+            << framePacer_.maxInterval << " ms";
+  if (framePacer_.enabled) {
+    std::cout << ", " << framePacer_.missedFrames << " frames missed the limit";
+  }
+  std::cout << "\n";
+}
+
+#if defined(VK_USE_PLATFORM_WAYLAND_KHR) || defined(VK_USE_PLATFORM_XCB_KHR)
+void VulkanExampleBase::renderThreadLoop() {
+  while (!quit) {
+    auto tStart = std::chrono::high_resolution_clock::now();
+    handleQueuedInput();
+    render();
+    frameCounter_++;
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    auto tDiff =
+        std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+    updateTimers(tDiff);
+    float fpsTimer =
+        std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
+            .count();
+    if (fpsTimer > 1000.0f) {
+      if (!settings_.overlay) {
+        std::string windowTitle = getWindowTitle();
+#if defined(VK_USE_PLATFORM_WAYLAND_KHR)
+        xdg_toplevel_set_title(xdg_toplevel, windowTitle.c_str());
+#else
+        xcb_change_property(connection, XCB_PROP_MODE_REPLACE, window,
+                            XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8,
+                            windowTitle.size(), windowTitle.c_str());
+#endif
+      }
+      lastFPS = (float)frameCounter_ * (1000.0f / fpsTimer);
+      frameCounter_ = 0;
+      lastTimestamp_ = tEnd;
+    }
+    updateOverlay();
+  }
+}
+#endif
+
+void VulkanExampleBase::updateTimers(double frameTimeMs) {
+  frameTimer = (float)frameTimeMs / 1000.0f;
+  // Deterministic runs and benchmarks advance animations by a fixed step
+  // independent of the measured frame time, so every run does the same work.
+  // The measured time is still used for frame time reporting and profiling
+  animationStep_ = (settings_.deterministic || benchmark.active)
+                       ? settings_.deterministicFrameTime
+                       : frameTimer;
+  camera_.update(animationStep_);
+  // Convert to clamped timer value
+  if (!paused) {
+    timer += timerSpeed * animationStep_;
+    if (timer > 1.0) {
+      timer -= 1.0f;
+    }
+    elapsedTime_ += animationStep_;
+  }
+  if (!firstFrameRendered_) {
+    const double now =
+        std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - startupTime_)
+            .count();
+    startupPhases_.push_back({"firstFrame", 0, now - frameTimeMs, frameTimeMs});
+    firstFrameRendered_ = true;
+    if (commandLineParser.isSet("startupreport")) {
+      writeStartupReport();
+    }
+  }
+  frameNumber_++;
+  if (!traceFile_.empty()) {
+    updateTrace(frameTimeMs);
+  }
+  vks::Profiler::get().setFrame(frameNumber_);
+}
+
+void VulkanExampleBase::updateTrace(double frameTimeMs) {
+  vks::Profiler& profiler = vks::Profiler::get();
+  if (profiler.capturing()) {
+    const int64_t now = vks::Profiler::now();
+    profiler.addZone("frame", now - static_cast<int64_t>(frameTimeMs * 1.0e6),
+                     now);
+  }
+  if (frameNumber_ == settings_.traceStartFrame) {
+    profiler.setThreadName("main");
+    gpuProfiler_.calibrate();
+    profiler.beginCapture();
+  } else if (frameNumber_ ==
+             settings_.traceStartFrame + settings_.traceFrameCount) {
+    endTrace();
+  }
+}
+
+void VulkanExampleBase::endTrace() {
+  vks::Profiler& profiler = vks::Profiler::get();
+  if (!profiler.capturing()) {
+    return;
+  }
+  // GPU zones of the frames still in flight are only available once the queue
+  // is idle
+  {
+    std::lock_guard<std::mutex> lock(vulkanDevice_->queueMutex(queue_));
+    VK_CHECK_RESULT(vkQueueWaitIdle(queue_));
+  }
+  gpuProfiler_.collectAll();
+  profiler.endCapture();
+  if (profiler.writeTrace(traceFile_)) {
+    std::cout << "Trace of frames " << settings_.traceStartFrame << " to "
+              << frameNumber_ - 1 << " written to " << traceFile_ << "\n";
+  } else {
+    std::cerr << "Could not write trace to \"" << traceFile_ << "\"\n";
+  }
+}
+
+size_t VulkanExampleBase::beginStartupPhase(const std::string& name) {
+  if (firstFrameRendered_) {
+    return SIZE_MAX;
+  }
+  const double start = std::chrono::duration<double, std::milli>(
+                           std::chrono::high_resolution_clock::now() -
+                           startupTime_)
+                           .count();
+  startupPhases_.push_back({name, startupPhaseDepth_++, start, 0.0});
+  return startupPhases_.size() - 1;
+}
+
+void VulkanExampleBase::endStartupPhase(size_t index) {
+  if (index >= startupPhases_.size()) {
+    return;
+  }
+  StartupPhase& phase = startupPhases_[index];
+  phase.duration = std::chrono::duration<double, std::milli>(
+                       std::chrono::high_resolution_clock::now() -
+                       startupTime_)
+                       .count() -
+                   phase.start;
+  startupPhaseDepth_ = phase.depth;
+}
+
+void VulkanExampleBase::writeStartupReport() {
+  const StartupPhase& firstFrame = startupPhases_.back();
+  const double timeToFirstFrame = firstFrame.start + firstFrame.duration;
+  // Formatted locally, so std::cout keeps its number formatting
+  std::ostringstream summary;
+  summary << std::fixed << std::setprecision(3);
+  summary << "Startup (ms)\n";
+  for (const StartupPhase& phase : startupPhases_) {
+    summary << std::string(phase.depth * 2, ' ') << phase.name << ": "
+            << phase.duration << "\n";
+  }
+  summary << "time to first frame: " << timeToFirstFrame << "\n";
+  summary << "pipeline creation: " << pipelineCreationTime() << " ("
+          << (pipelineCacheStore_.warm ? "warm" : "cold") << " cache";
+  if (pipelineCacheStore_.warm &&
+      (pipelineCacheStore_.coldCreationTime >= 0.0)) {
+    summary << ", " << pipelineCacheStore_.coldCreationTime << " cold";
+  }
+  summary << ")\n";
+  std::cout << summary.str();
+
+  const std::string filename =
+      commandLineParser.getValueAsString("startupreport", "");
+  std::ofstream report(filename, std::ios::out);
+  if (!report.is_open()) {
+    std::cerr << "Could not write startup report to \"" << filename << "\"\n";
+    return;
+  }
+  report << std::fixed << std::setprecision(4);
+  report << "{\n";
+  report << "  \"example\": \"" << vks::Benchmark::jsonEscape(name)
+         << "\",\n";
+  report << "  \"device\": \""
+         << vks::Benchmark::jsonEscape(deviceProperties_.deviceName)
+         << "\",\n";
+  report << "  \"timeToFirstFrame\": " << timeToFirstFrame << ",\n";
+  report << "  \"pipelineCache\": {\"warm\": "
+         << (pipelineCacheStore_.warm ? "true" : "false")
+         << ", \"loadedBytes\": " << pipelineCacheStore_.loadedSize
+         << ", \"creationTime\": " << pipelineCreationTime()
+         << ", \"coldCreationTime\": " << pipelineCacheStore_.coldCreationTime
+         << "},\n";
+  report << "  \"phases\": [";
+  for (size_t i = 0; i < startupPhases_.size(); i++) {
+    const StartupPhase& phase = startupPhases_[i];
+    report << (i > 0 ? ",\n    " : "\n    ") << "{\"name\": \""
+           << vks::Benchmark::jsonEscape(phase.name)
+           << "\", \"depth\": " << phase.depth
+           << ", \"start\": " << phase.start
+           << ", \"duration\": " << phase.duration << "}";
+  }
+  report << "\n  ]\n}\n";
+}
+
+VulkanExampleBase::ScopedStartupPhase::ScopedStartupPhase(
+    VulkanExampleBase* example,
+    const std::string& name)
+    : example_(example), index_(example->beginStartupPhase(name)) {}
+
+VulkanExampleBase::ScopedStartupPhase::~ScopedStartupPhase() {
+  example_->endStartupPhase(index_);
+}
+
+uint32_t VulkanExampleBase::randomSeed() const {
+  return (benchmark.active || settings_.deterministic) ? 0
+                                                       : std::random_device{}();
 }
 
 void VulkanExampleBase::renderLoop() {
+  endStartupPhase(prepareStartupPhase_);
 // SRS - for non-apple plaforms, handle benchmarking here within
 // VulkanExampleBase::renderLoop()
 //     - for macOS, handle benchmarking within NSApp rendering loop via
@@ -343,20 +695,32 @@ void VulkanExampleBase::renderLoop() {
       defined(VK_USE_PLATFORM_METAL_EXT))
   if (benchmark.active) {
 #if defined(VK_USE_PLATFORM_WAYLAND_KHR)
-    while (!configured) {
-      if (wl_display_dispatch(display) == -1)
-        break;
-    }
-    while (wl_display_prepare_read(display) != 0) {
+    if (!settings_.offscreen) {
+      while (!configured) {
+        if (wl_display_dispatch(display) == -1)
+          break;
+      }
+      while (wl_display_prepare_read(display) != 0) {
+        if (wl_display_dispatch_pending(display) == -1)
+          break;
+      }
+      wl_display_flush(display);
+      wl_display_read_events(display);
       if (wl_display_dispatch_pending(display) == -1)
-        break;
+        return;
     }
-    wl_display_flush(display);
-    wl_display_read_events(display);
-    if (wl_display_dispatch_pending(display) == -1)
-      return;
 #endif
-    benchmark.run([=, this] { render(); }, vulkanDevice_->properties);
+    benchmark.run(
+        [=, this] {
+          const auto tStart = std::chrono::high_resolution_clock::now();
+          render();
+          // Animations advance by a fixed step in benchmarks (see
+          // updateTimers), the measured time is used for reporting
+          updateTimers(std::chrono::duration<double, std::milli>(
+                           std::chrono::high_resolution_clock::now() - tStart)
+                           .count());
+        },
+        vulkanDevice_->properties);
     vkDeviceWaitIdle(device_);
     if (!benchmark.filename.empty()) {
       benchmark.saveResults();
@@ -369,6 +733,30 @@ void VulkanExampleBase::renderLoop() {
   destHeight = height_;
   lastTimestamp_ = std::chrono::high_resolution_clock::now();
   tPrevEnd_ = lastTimestamp_;
+  if (settings_.offscreen) {
+    // There are no window events without a window. Frames are rendered until
+    // the last one to dump has been written, the frame count given with
+    // --benchmarkframes has been reached and the time given with
+    // --benchruntime has passed
+    uint64_t lastFrame =
+        *std::max_element(frameDumpFrames_.begin(), frameDumpFrames_.end());
+    if (benchmark.outputFrames > 0) {
+      lastFrame =
+          std::max(lastFrame, static_cast<uint64_t>(benchmark.outputFrames));
+    }
+    const auto tEnd = std::chrono::steady_clock::now() +
+                      std::chrono::seconds(offscreenDuration_);
+    while ((frameNumber_ < lastFrame) ||
+           (std::chrono::steady_clock::now() < tEnd)) {
+      nextFrame();
+    }
+    if (!traceFile_.empty()) {
+      endTrace();
+    }
+    reportFramePacing();
+    vkDeviceWaitIdle(device_);
+    return;
+  }
 #if defined(_WIN32)
   MSG msg;
   bool quitMessageReceived = false;
@@ -376,13 +764,20 @@ void VulkanExampleBase::renderLoop() {
     while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
       TranslateMessage(&msg);
       DispatchMessage(&msg);
+      requestRedraw();
       if (msg.message == WM_QUIT) {
         quitMessageReceived = true;
         break;
       }
     }
     if (prepared_ && !IsIconic(window)) {
-      nextFrame();
+      if (frameRequired()) {
+        nextFrame();
+      } else {
+        // Nothing changed, sleep until the next message arrives
+        MsgWaitForMultipleObjects(0, nullptr, FALSE, onDemandTimeout,
+                                  QS_ALLINPUT);
+      }
     }
   }
 #elif defined(VK_USE_PLATFORM_ANDROID_KHR)
@@ -421,15 +816,7 @@ void VulkanExampleBase::renderLoop() {
       auto tEnd = std::chrono::high_resolution_clock::now();
       auto tDiff =
           std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-      frameTimer = tDiff / 1000.0f;
-      camera_.update(frameTimer);
-      // Convert to clamped timer value
-      if (!paused) {
-        timer += timerSpeed * frameTimer;
-        if (timer > 1.0) {
-          timer -= 1.0f;
-        }
-      }
+      updateTimers(tDiff);
       float fpsTimer =
           std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
               .count();
@@ -478,15 +865,7 @@ void VulkanExampleBase::renderLoop() {
     auto tEnd = std::chrono::high_resolution_clock::now();
     auto tDiff =
         std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-    frameTimer = tDiff / 1000.0f;
-    camera_.update(frameTimer);
-    // Convert to clamped timer value
-    if (!paused) {
-      timer += timerSpeed * frameTimer;
-      if (timer > 1.0) {
-        timer -= 1.0f;
-      }
-    }
+    updateTimers(tDiff);
     float fpsTimer =
         std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
             .count();
@@ -509,15 +888,7 @@ void VulkanExampleBase::renderLoop() {
     auto tEnd = std::chrono::high_resolution_clock::now();
     auto tDiff =
         std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-    frameTimer = tDiff / 1000.0f;
-    camera_.update(frameTimer);
-    // Convert to clamped timer value
-    if (!paused) {
-      timer += timerSpeed * frameTimer;
-      if (timer > 1.0) {
-        timer -= 1.0f;
-      }
-    }
+    updateTimers(tDiff);
     float fpsTimer =
         std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
             .count();
@@ -529,6 +900,34 @@ void VulkanExampleBase::renderLoop() {
     updateOverlay();
   }
 #elif defined(VK_USE_PLATFORM_WAYLAND_KHR)
+  if (settings_.renderThread) {
+    while (!configured) {
+      if (wl_display_dispatch(display) == -1)
+        break;
+    }
+    // From here on the listeners queue events for the render thread instead of
+    // handling them
+    renderThreadRunning_ = true;
+    std::thread renderThread(&VulkanExampleBase::renderThreadLoop, this);
+    pollfd displayFd{.fd = wl_display_get_fd(display), .events = POLLIN};
+    while (!quit) {
+      while (wl_display_prepare_read(display) != 0) {
+        wl_display_dispatch_pending(display);
+      }
+      wl_display_flush(display);
+      // Wake up regularly to notice a quit request from the render thread
+      if (poll(&displayFd, 1, 10) > 0) {
+        wl_display_read_events(display);
+      } else {
+        wl_display_cancel_read(display);
+      }
+      if (wl_display_dispatch_pending(display) == -1) {
+        quit = true;
+      }
+    }
+    renderThread.join();
+    renderThreadRunning_ = false;
+  }
   while (!quit) {
     auto tStart = std::chrono::high_resolution_clock::now();
 
@@ -536,29 +935,34 @@ void VulkanExampleBase::renderLoop() {
       if (wl_display_dispatch(display) == -1)
         break;
     }
+    int dispatchedEvents = 0;
     while (wl_display_prepare_read(display) != 0) {
-      if (wl_display_dispatch_pending(display) == -1)
+      const int pendingEvents = wl_display_dispatch_pending(display);
+      if (pendingEvents == -1)
         break;
+      dispatchedEvents += pendingEvents;
     }
     wl_display_flush(display);
     wl_display_read_events(display);
-    if (wl_display_dispatch_pending(display) == -1)
+    const int readEvents = wl_display_dispatch_pending(display);
+    if (readEvents == -1)
       break;
+    if (dispatchedEvents + readEvents > 0) {
+      requestRedraw();
+    }
+    if (!frameRequired()) {
+      // Nothing changed, sleep until the compositor sends events
+      pollfd displayFd{.fd = wl_display_get_fd(display), .events = POLLIN};
+      poll(&displayFd, 1, onDemandTimeout);
+      continue;
+    }
 
     render();
     frameCounter_++;
     auto tEnd = std::chrono::high_resolution_clock::now();
     auto tDiff =
         std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-    frameTimer = tDiff / 1000.0f;
-    camera_.update(frameTimer);
-    // Convert to clamped timer value
-    if (!paused) {
-      timer += timerSpeed * frameTimer;
-      if (timer > 1.0) {
-        timer -= 1.0f;
-      }
-    }
+    updateTimers(tDiff);
     float fpsTimer =
         std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
             .count();
@@ -575,27 +979,48 @@ void VulkanExampleBase::renderLoop() {
   }
 #elif defined(VK_USE_PLATFORM_XCB_KHR)
   xcb_flush(connection);
+  if (settings_.renderThread) {
+    std::thread renderThread(&VulkanExampleBase::renderThreadLoop, this);
+    pollfd connectionFd{.fd = xcb_get_file_descriptor(connection),
+                        .events = POLLIN};
+    while (!quit) {
+      // Wake up regularly to notice a quit request from the render thread
+      poll(&connectionFd, 1, 10);
+      xcb_generic_event_t* event;
+      while ((event = xcb_poll_for_event(connection))) {
+        queueInput(event);
+      }
+      if (xcb_connection_has_error(connection)) {
+        quit = true;
+      }
+    }
+    renderThread.join();
+    xcb_generic_event_t* event;
+    while (inputQueue_.pop(event)) {
+      free(event);
+    }
+  }
   while (!quit) {
     auto tStart = std::chrono::high_resolution_clock::now();
     xcb_generic_event_t* event;
     while ((event = xcb_poll_for_event(connection))) {
       handleEvent(event);
       free(event);
+      requestRedraw();
+    }
+    if (!frameRequired()) {
+      // Nothing changed, sleep until the X server sends events
+      pollfd connectionFd{.fd = xcb_get_file_descriptor(connection),
+                          .events = POLLIN};
+      poll(&connectionFd, 1, onDemandTimeout);
+      continue;
     }
     render();
     frameCounter_++;
     auto tEnd = std::chrono::high_resolution_clock::now();
     auto tDiff =
         std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-    frameTimer = tDiff / 1000.0f;
-    camera_.update(frameTimer);
-    // Convert to clamped timer value
-    if (!paused) {
-      timer += timerSpeed * frameTimer;
-      if (timer > 1.0) {
-        timer -= 1.0f;
-      }
-    }
+    updateTimers(tDiff);
     float fpsTimer =
         std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
             .count();
@@ -620,13 +1045,7 @@ void VulkanExampleBase::renderLoop() {
     auto tEnd = std::chrono::high_resolution_clock::now();
     auto tDiff =
         std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-    frameTimer = tDiff / 1000.0f;
-    camera_.update(frameTimer);
-    // Convert to clamped timer value
-    timer += timerSpeed * frameTimer;
-    if (timer > 1.0) {
-      timer -= 1.0f;
-    }
+    updateTimers(tDiff);
     float fpsTimer =
         std::chrono::duration<double, std::milli>(tEnd - lastTimestamp_)
             .count();
@@ -650,16 +1069,49 @@ void VulkanExampleBase::renderLoop() {
     }
   }
 #endif
+  reportFramePacing();
+  if (camera_.path_.recording) {
+    camera_.stopPathRecording();
+    const std::string filename =
+        commandLineParser.getValueAsString("camerapathrecord", "");
+    if (!camera_.savePath(filename)) {
+      std::cerr << "Could not save camera path to \"" << filename << "\"\n";
+    }
+  }
+  // Write the trace if the example was closed before the last traced frame
+  if (!traceFile_.empty()) {
+    endTrace();
+  }
   // Flush device to make sure all resources can be freed
   if (device_ != VK_NULL_HANDLE) {
     vkDeviceWaitIdle(device_);
   }
 }
 
+void VulkanExampleBase::writeCameraPathJson(std::ostream& os) const {
+  // Start pose of each reported segment, matches the "segments" statistics
+  const uint32_t segmentCount = settings_.cameraPathSegments;
+  const float duration = camera_.pathDuration();
+  os << "{\"duration\": " << duration
+     << ", \"keyframes\": " << camera_.path_.keyframes.size()
+     << ", \"segments\": [";
+  for (uint32_t i = 0; i < segmentCount; i++) {
+    const float time = duration * (float)i / (float)segmentCount;
+    const Camera::PathKeyframe pose = camera_.pathPoseAt(time);
+    os << (i > 0 ? ", " : "") << "{\"start\": " << time << ", \"position\": ["
+       << pose.position.x << ", " << pose.position.y << ", " << pose.position.z
+       << "], \"rotation\": [" << pose.rotation.x << ", " << pose.rotation.y
+       << ", " << pose.rotation.z << "]}";
+  }
+  os << "]}";
+}
+
 void VulkanExampleBase::updateOverlay() {
   if (!settings_.overlay)
     return;
 
+  vks::ProfilerZone profilerZone("updateOverlay");
+
   ImGuiIO& io = ImGui::GetIO();
   io.DisplaySize = ImVec2((float)width_, (float)height_);
   io.DeltaTime = frameTimer;
@@ -678,12 +1130,39 @@ void VulkanExampleBase::updateOverlay() {
   ImGui::TextUnformatted(title.c_str());
   ImGui::TextUnformatted(deviceProperties_.deviceName);
   ImGui::Text("%.2f ms/frame (%.1d fps)", (1000.0f / lastFPS), lastFPS);
+  ImGui::Text("%.2f ms latency (%d frames in flight)",
+              frameLatency_.recentLatency, framesInFlight_);
+  if (dynamicResolution_.enabled) {
+    ImGui::Text("%.0f%% resolution (%.2f ms GPU, %.2f ms target)",
+                dynamicResolution_.scale * 100.0f, dynamicResolution_.gpuTime,
+                dynamicResolution_.targetFrameTime);
+    ImGui::PlotLines("##resolution", dynamicResolution_.history.data(),
+                     vks::DynamicResolution::historySize,
+                     dynamicResolution_.historyOffset, nullptr,
+                     dynamicResolution_.minScale, dynamicResolution_.maxScale,
+                     ImVec2(0, 40.0f * ui_.scale));
+  }
+  if (framePacer_.enabled) {
+    ImGui::Text("%.0f fps limit (%.2f ms jitter)", framePacer_.maxFrameRate,
+                framePacer_.recentJitter());
+  }
+  if (commandBufferReuse_.recordCount > 0) {
+    ImGui::Text("%.0f%% command buffers reused (%.2f ms saved)",
+                commandBufferReuse_.reuseRate(),
+                commandBufferReuse_.savedTime);
+  }
 #if defined(VK_USE_PLATFORM_ANDROID_KHR)
   ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0.0f, 5.0f * ui.scale));
 #endif
   ImGui::PushItemWidth(110.0f * ui_.scale);
+  ui_.updated = false;
   OnUpdateUIOverlay(&ui_);
+  // Option changes may affect what the example records
+  if (ui_.updated) {
+    commandBufferReuse_.invalidate();
+  }
   ImGui::PopItemWidth();
+  drawMemoryStatistics();
 #if defined(VK_USE_PLATFORM_ANDROID_KHR)
   ImGui::PopStyleVar();
 #endif
@@ -700,6 +1179,38 @@ void VulkanExampleBase::updateOverlay() {
 #endif
 }
 
+void VulkanExampleBase::drawMemoryStatistics() {
+  if (!ImGui::CollapsingHeader("Device memory")) {
+    return;
+  }
+  constexpr float MiB = 1024.0f * 1024.0f;
+  vks::MemoryTracker& tracker = vulkanDevice_->memoryTracker;
+  const VkPhysicalDeviceMemoryProperties& memoryProperties =
+      tracker.getMemoryProperties();
+  const std::vector<vks::MemoryTracker::HeapBudget> budgets =
+      tracker.getHeapBudgets();
+  for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+    const vks::MemoryTracker::Usage usage = tracker.getHeapUsage(i);
+    const bool deviceLocal = memoryProperties.memoryHeaps[i].flags &
+                             VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    ImGui::Text("Heap %d (%s): %.1f MiB, peak %.1f MiB", i,
+                deviceLocal ? "device" : "host", (float)usage.live / MiB,
+                (float)usage.peak / MiB);
+    if (i < budgets.size()) {
+      ImGui::Text("  process %.1f / budget %.1f MiB",
+                  (float)budgets[i].usage / MiB,
+                  (float)budgets[i].budget / MiB);
+    }
+  }
+  for (uint32_t i = 0; i < static_cast<uint32_t>(vks::MemoryTag::Count); i++) {
+    const vks::MemoryTag tag = static_cast<vks::MemoryTag>(i);
+    const vks::MemoryTracker::Usage usage = tracker.getTagUsage(tag);
+    ImGui::Text("%s: %.1f MiB, peak %.1f MiB (%d)",
+                vks::MemoryTracker::tagName(tag), (float)usage.live / MiB,
+                (float)usage.peak / MiB, usage.allocations);
+  }
+}
+
 void VulkanExampleBase::drawUI(const VkCommandBuffer commandBuffer) {
   if (settings_.overlay && ui_.visible) {
     const VkViewport viewport{.width = (float)width_,
@@ -714,16 +1225,43 @@ void VulkanExampleBase::drawUI(const VkCommandBuffer commandBuffer) {
 }
 
 void VulkanExampleBase::prepareFrame(bool waitForFence) {
+  vks::ProfilerZone profilerZone("prepareFrame");
+  // With a frame limit, the GPU is throttled to the previous frame before
+  // waiting for the next frame to be due. Both waits happen before the frame's
+  // input time, so frames don't queue up behind the limiter and add latency
+  if (framePacer_.enabled) {
+    vks::ProfilerZone limiterZone("frameLimiter");
+    const uint32_t previousFrame =
+        (currentBuffer_ + framesInFlight_ - 1) % framesInFlight_;
+    VK_CHECK_RESULT(vkWaitForFences(device_, 1, &waitFences_[previousFrame],
+                                    VK_TRUE, UINT64_MAX));
+    framePacer_.wait();
+  }
+  // Input is handled right before rendering, so the frame reflects the input
+  // received up to this point
+  frameInputTime_ = vks::FrameLatency::Clock::now();
+  if (frameLatency_.presentWait) {
+    frameLatency_.poll(swapChain_.swapChain_);
+  }
   // Ensure command buffer execution has finished
   if (waitForFence) {
+    vks::ProfilerZone fenceZone("waitForFence");
     VK_CHECK_RESULT(vkWaitForFences(device_, 1, &waitFences_[currentBuffer_],
                                     VK_TRUE, UINT64_MAX));
     VK_CHECK_RESULT(vkResetFences(device_, 1, &waitFences_[currentBuffer_]));
+    frameSlotAvailable();
   }
   updateOverlay();
+  // Uploads recorded since the last frame (e.g. by loaders) are submitted in
+  // a single batch ahead of the frame's command buffers
+  vulkanDevice_->uploadManager.flush();
   // Acquire the next image from the swap chain
-  VkResult result = swapChain_.acquireNextImage(
-      presentCompleteSemaphores_[currentBuffer_], currentImageIndex_);
+  VkResult result;
+  {
+    vks::ProfilerZone acquireZone("acquireNextImage");
+    result = swapChain_.acquireNextImage(
+        presentCompleteSemaphores_[currentBuffer_], currentImageIndex_);
+  }
   // Recreate the swapchain if it's no longer compatible with the surface
   // (OUT_OF_DATE) If no longer optimal (VK_SUBOPTIMAL_KHR), wait until
   // submitFrame() in case number of swapchain images will change on resize
@@ -737,31 +1275,136 @@ void VulkanExampleBase::prepareFrame(bool waitForFence) {
   }
 }
 
+void VulkanExampleBase::frameSlotAvailable() {
+  frameLatency_.frameCompleted(currentBuffer_);
+  frameLatency_.beginFrame(currentBuffer_, frameInputTime_);
+  // Timestamps of the frame previously rendered with this slot are available
+  // once its fence has been signalled
+  gpuProfiler_.beginFrame(currentBuffer_, frameNumber_);
+  const float renderScale = dynamicResolution_.scale;
+  dynamicResolution_.beginFrame(currentBuffer_);
+  if (dynamicResolution_.scale != renderScale) {
+    commandBufferReuse_.invalidate();
+  }
+  uniformRing_.beginFrame(currentBuffer_);
+}
+
+void VulkanExampleBase::updateCommandBuffer(
+    const std::function<void()>& buildCommandBuffer) {
+  // GPU zones are only written to freshly recorded command buffers, so traced
+  // frames are always recorded and the frames after them recorded again
+  const bool traced = gpuProfiler_.active(currentBuffer_);
+  const uint64_t uiSignature = (settings_.overlay && ui_.visible)
+                                   ? ui_.drawSignature(currentBuffer_)
+                                   : 0;
+  if (!traced && commandBufferReuse_.reusable(
+                     currentBuffer_, currentImageIndex_, uiSignature)) {
+    return;
+  }
+  const auto recordStart = std::chrono::high_resolution_clock::now();
+  buildCommandBuffer();
+  commandBufferReuse_.recorded(
+      std::chrono::duration<double, std::milli>(
+          std::chrono::high_resolution_clock::now() - recordStart)
+          .count());
+  if (traced) {
+    commandBufferReuse_.invalidate();
+  }
+}
+
+void VulkanExampleBase::invalidateCommandBuffers() {
+  commandBufferReuse_.invalidate();
+}
+
 void VulkanExampleBase::submitFrame(bool skipQueueSubmit) {
+  vks::ProfilerZone profilerZone("submitFrame");
   if (!skipQueueSubmit) {
-    const VkPipelineStageFlags waitPipelineStage{
-        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    vks::ProfilerZone submitZone("queueSubmit");
+    // Uploads recorded while the frame was built
+    vulkanDevice_->uploadManager.flush();
+    // When traced, the frame's command buffer is enclosed by command buffers
+    // writing the timestamps of the GPU frame zone
+    std::array<VkCommandBuffer, 3> commandBuffers{
+        VK_NULL_HANDLE, drawCmdBuffers_[currentBuffer_], VK_NULL_HANDLE};
+    uint32_t firstCommandBuffer = 1;
+    uint32_t commandBufferCount = 1;
+    if (gpuProfiler_.active(currentBuffer_)) {
+      gpuProfiler_.recordFrameCommandBuffers(
+          currentBuffer_, commandBuffers[0], commandBuffers[2]);
+      firstCommandBuffer = 0;
+      commandBufferCount = 3;
+    }
+    std::array<VkSemaphore, 2> waitSemaphores{
+        presentCompleteSemaphores_[currentBuffer_], VK_NULL_HANDLE};
+    std::array<VkPipelineStageFlags, 2> waitStages{
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0};
+    std::array<uint64_t, 2> waitValues{};
+    std::array<VkSemaphore, 2> signalSemaphores{
+        renderCompleteSemaphores_[currentImageIndex_], VK_NULL_HANDLE};
+    std::array<uint64_t, 2> signalValues{};
     VkSubmitInfo submitInfo{
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
         .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &presentCompleteSemaphores_[currentBuffer_],
-        .pWaitDstStageMask = &waitPipelineStage,
-        .commandBufferCount = 1,
-        .pCommandBuffers = &drawCmdBuffers_[currentBuffer_],
+        .pWaitSemaphores = waitSemaphores.data(),
+        .pWaitDstStageMask = waitStages.data(),
+        .commandBufferCount = commandBufferCount,
+        .pCommandBuffers = &commandBuffers[firstCommandBuffer],
         .signalSemaphoreCount = 1,
-        .pSignalSemaphores = &renderCompleteSemaphores_[currentImageIndex_]};
-    VK_CHECK_RESULT(
-        vkQueueSubmit(queue_, 1, &submitInfo, waitFences_[currentBuffer_]));
+        .pSignalSemaphores = signalSemaphores.data()};
+    // Wait for the compute work submitted for this frame, and signal the
+    // semaphore the next compute submission may wait for. Values are ignored
+    // for the binary swap chain semaphores
+    VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+        .waitSemaphoreValueCount = 2,
+        .pWaitSemaphoreValues = waitValues.data(),
+        .signalSemaphoreValueCount = 2,
+        .pSignalSemaphoreValues = signalValues.data()};
+    vks::AsyncCompute::GraphicsSync computeSync;
+    if (asyncCompute_.graphicsSync(computeSync)) {
+      waitSemaphores[1] = computeSync.waitSemaphore;
+      waitStages[1] = computeSync.waitStage;
+      waitValues[1] = computeSync.waitValue;
+      signalSemaphores[1] = computeSync.signalSemaphore;
+      signalValues[1] = computeSync.signalValue;
+      submitInfo.waitSemaphoreCount = 2;
+      submitInfo.signalSemaphoreCount = 2;
+      if (asyncCompute_.timelineSemaphores) {
+        submitInfo.pNext = &timelineSubmitInfo;
+      }
+    }
+    VK_CHECK_RESULT(vulkanDevice_->queueSubmit(queue_, 1, &submitInfo,
+                                               waitFences_[currentBuffer_]));
   }
 
   VkPresentInfoKHR presentInfo{
       .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+      .pNext = frameLatency_.present(currentBuffer_),
       .waitSemaphoreCount = 1,
       .pWaitSemaphores = &renderCompleteSemaphores_[currentImageIndex_],
       .swapchainCount = 1,
       .pSwapchains = &swapChain_.swapChain_,
       .pImageIndices = &currentImageIndex_};
-  VkResult result = vkQueuePresentKHR(queue_, &presentInfo);
+  VkResult result;
+  {
+    vks::ProfilerZone presentZone("queuePresent");
+    if (swapChain_.offscreen_) {
+      result = swapChain_.presentOffscreen(
+          currentImageIndex_, renderCompleteSemaphores_[currentImageIndex_]);
+    } else {
+      // Uploads and one-shot command buffers of loader threads may be
+      // submitted to the same queue
+      std::lock_guard<std::mutex> lock(vulkanDevice_->queueMutex(queue_));
+      result = vkQueuePresentKHR(queue_, &presentInfo);
+    }
+  }
+  framePacer_.presented();
+  // Frames are counted from 1, like traced frames
+  if (swapChain_.offscreen_ && !frameDumpPath_.empty() &&
+      (std::find(frameDumpFrames_.begin(), frameDumpFrames_.end(),
+                 frameNumber_ + 1) != frameDumpFrames_.end())) {
+    dumpFrame(currentImageIndex_, frameNumber_ + 1);
+  }
   // Recreate the swapchain if it's no longer compatible with the surface
   // (OUT_OF_DATE) or no longer optimal for presentation (SUBOPTIMAL)
   if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) {
@@ -772,12 +1415,16 @@ void VulkanExampleBase::submitFrame(bool skipQueueSubmit) {
   } else {
     VK_CHECK_RESULT(result);
   }
-  // Select the next frame to render to, based on the max. no. of concurrent
-  // frames
-  currentBuffer_ = (currentBuffer_ + 1) % MAX_CONCURRENT_FRAMES;
+  // Frames presented while this one was recorded and submitted
+  if (frameLatency_.presentWait) {
+    frameLatency_.poll(swapChain_.swapChain_);
+  }
+  // Select the next frame to render to, based on the no. of frames in flight
+  currentBuffer_ = (currentBuffer_ + 1) % framesInFlight_;
 }
 
 VulkanExampleBase::VulkanExampleBase() {
+  startupTime_ = std::chrono::high_resolution_clock::now();
   // Command line arguments
   commandLineParser.add("help", {"--help"}, 0, "Show help");
   commandLineParser.add("validation", {"-v", "--validation"}, 0,
@@ -808,6 +1455,70 @@ VulkanExampleBase::VulkanExampleBase() {
                         0, "Save frame times to benchmark results file");
   commandLineParser.add("benchmarkframes", {"-bfs", "--benchmarkframes"}, 1,
                         "Only render the given number of frames");
+  commandLineParser.add(
+      "deterministic", {"-dt", "--deterministic"}, 0,
+      "Use a fixed simulated frame time and fixed random seeds");
+  commandLineParser.add("startupreport", {"-sr", "--startup-report"}, 1,
+                        "Write startup phase timings as JSON to the given "
+                        "file");
+  commandLineParser.add("pipelinecache", {"-pcf", "--pipelinecache"}, 1,
+                        "Load and save the pipeline cache using the given "
+                        "file");
+  commandLineParser.add("nopipelinecache", {"-npc", "--nopipelinecache"}, 0,
+                        "Start with an empty pipeline cache and don't save it");
+  commandLineParser.add("pipelinethreads", {"-pt", "--pipelinethreads"}, 1,
+                        "Maximum number of threads used to create pipelines");
+  commandLineParser.add("noshaderarchive", {"-nsa", "--noshaderarchive"}, 0,
+                        "Load shaders from individual SPIR-V files even if a "
+                        "shader archive is present");
+  commandLineParser.add("offscreen", {"-os", "--offscreen"}, 0,
+                        "Render to offscreen images instead of a window, "
+                        "until the frame count (-bfs) and duration (-br) "
+                        "given have both been reached");
+  commandLineParser.add("framedump", {"-fd", "--framedump"}, 1,
+                        "Write offscreen frames to PPM files in the given "
+                        "directory");
+  commandLineParser.add("framedumpframes", {"-fdf", "--framedumpframes"}, 1,
+                        "Comma separated list of frames to write with "
+                        "--framedump (default 1)");
+  commandLineParser.add("renderthread", {"-rth", "--renderthread"}, 0,
+                        "Update and render on a separate thread (XCB and "
+                        "Wayland)");
+  commandLineParser.add("noasynccompute", {"-nac", "--noasynccompute"}, 0,
+                        "Submit compute work to the graphics queue instead of "
+                        "the compute queue");
+  commandLineParser.add("dynamicresolution", {"-dr", "--dynamicresolution"}, 1,
+                        "Scale the render resolution of supported examples to "
+                        "meet the given GPU frame time in ms");
+  commandLineParser.add("nocommandbufferreuse",
+                        {"-ncr", "--nocommandbufferreuse"}, 0,
+                        "Record command buffers every frame, even if the "
+                        "previous recording is still valid");
+  commandLineParser.add("ondemand", {"-od", "--ondemand"}, 0,
+                        "Only render frames when input, animation or the UI "
+                        "changed them");
+  commandLineParser.add("framelimit", {"-fl", "--framelimit"}, 1,
+                        "Limit the frame rate to the given number of frames "
+                        "per second");
+  commandLineParser.add("framesinflight", {"-fif", "--framesinflight"}, 1,
+                        "Number of frames in flight (1 to 4)");
+  commandLineParser.add("trace", {"-tr", "--trace"}, 1,
+                        "Write a Chrome trace of CPU and GPU zones to the "
+                        "given file");
+  commandLineParser.add("tracestart", {"-trs", "--tracestart"}, 1,
+                        "First frame to capture with --trace");
+  commandLineParser.add("traceframes", {"-trf", "--traceframes"}, 1,
+                        "Number of frames to capture with --trace");
+  commandLineParser.add("perfcounters", {"-pc", "--perfcounters"}, 0,
+                        "Sample CPU performance counters for profiler zones "
+                        "and add them to JSON benchmark results (Linux)");
+  commandLineParser.add("camerapath", {"-cp", "--camerapath"}, 1,
+                        "Replay the camera path stored in the given file");
+  commandLineParser.add("camerapathrecord", {"-cpr", "--camerapathrecord"}, 1,
+                        "Record the camera path to the given file on exit");
+  commandLineParser.add("camerapathsegments", {"-cps", "--camerapathsegments"},
+                        1, "Number of camera path segments to report frame "
+                        "statistics for");
 #if (!(defined(VK_USE_PLATFORM_IOS_MVK) ||   \
        defined(VK_USE_PLATFORM_MACOS_MVK) || \
        defined(VK_USE_PLATFORM_METAL_EXT)))
@@ -860,6 +1571,7 @@ VulkanExampleBase::VulkanExampleBase() {
   if (commandLineParser.isSet("benchmarkruntime")) {
     benchmark.duration =
         commandLineParser.getValueAsInt("benchmarkruntime", benchmark.duration);
+    offscreenDuration_ = benchmark.duration;
   }
   if (commandLineParser.isSet("benchmarkresultfile")) {
     benchmark.filename = commandLineParser.getValueAsString(
@@ -872,6 +1584,136 @@ VulkanExampleBase::VulkanExampleBase() {
     benchmark.outputFrames = commandLineParser.getValueAsInt(
         "benchmarkframes", benchmark.outputFrames);
   }
+  if (commandLineParser.isSet("deterministic")) {
+    settings_.deterministic = true;
+  }
+  randomEngine_.seed(randomSeed());
+  if (commandLineParser.isSet("pipelinecache")) {
+    pipelineCacheFile_ =
+        commandLineParser.getValueAsString("pipelinecache", "");
+  }
+  if (commandLineParser.isSet("nopipelinecache")) {
+    settings_.pipelineCache = false;
+  }
+  if (commandLineParser.isSet("pipelinethreads")) {
+    settings_.pipelineThreads =
+        commandLineParser.getValueAsInt("pipelinethreads", 0);
+  }
+  if (commandLineParser.isSet("noshaderarchive")) {
+    settings_.shaderArchive = false;
+  }
+  if (commandLineParser.isSet("offscreen")) {
+    settings_.offscreen = true;
+  }
+  if (commandLineParser.isSet("framedump")) {
+    frameDumpPath_ = commandLineParser.getValueAsString("framedump", "");
+  }
+  if (commandLineParser.isSet("framedumpframes")) {
+    frameDumpFrames_.clear();
+    std::stringstream frames(
+        commandLineParser.getValueAsString("framedumpframes", ""));
+    std::string frame;
+    while (std::getline(frames, frame, ',')) {
+      const uint64_t frameNumber = std::strtoull(frame.c_str(), nullptr, 10);
+      if (frameNumber > 0) {
+        frameDumpFrames_.push_back(frameNumber);
+      }
+    }
+    if (frameDumpFrames_.empty()) {
+      frameDumpFrames_.push_back(1);
+    }
+  }
+  if (commandLineParser.isSet("renderthread")) {
+    settings_.renderThread = true;
+  }
+  if (commandLineParser.isSet("noasynccompute")) {
+    settings_.asyncCompute = false;
+  }
+  if (commandLineParser.isSet("dynamicresolution")) {
+    dynamicResolutionTarget_ = std::max(
+        0.0f, std::strtof(commandLineParser
+                              .getValueAsString("dynamicresolution", "0")
+                              .c_str(),
+                          nullptr));
+  }
+  if (commandLineParser.isSet("nocommandbufferreuse")) {
+    settings_.commandBufferReuse = false;
+  }
+  if (commandLineParser.isSet("ondemand")) {
+    settings_.onDemand = true;
+    // Idling blocks the thread that waits for window system events
+    if (settings_.renderThread) {
+      std::cout << "On-demand rendering renders on the main thread, ignoring "
+                   "--renderthread\n";
+      settings_.renderThread = false;
+    }
+  }
+  if (commandLineParser.isSet("framelimit")) {
+    maxFrameRate_ = std::max(
+        0.0f,
+        std::strtof(
+            commandLineParser.getValueAsString("framelimit", "0").c_str(),
+            nullptr));
+  }
+  if (commandLineParser.isSet("framesinflight")) {
+    framesInFlight_ = static_cast<uint32_t>(std::clamp(
+        commandLineParser.getValueAsInt("framesinflight", framesInFlight_), 1,
+        static_cast<int32_t>(MAX_CONCURRENT_FRAMES)));
+  }
+  if (commandLineParser.isSet("trace")) {
+    traceFile_ = commandLineParser.getValueAsString("trace", "");
+    // Capturing starts after the given number of frames have been rendered, so
+    // the first frame that can be traced is frame 1
+    settings_.traceStartFrame =
+        std::max(commandLineParser.getValueAsInt("tracestart",
+                                                 settings_.traceStartFrame),
+                 1);
+    settings_.traceFrameCount =
+        std::max(commandLineParser.getValueAsInt("traceframes",
+                                                 settings_.traceFrameCount),
+                 1);
+  }
+  if (commandLineParser.isSet("perfcounters")) {
+    if (vks::Profiler::get().enableCounters()) {
+      // Totals only include the frames of the measurement phase, the last
+      // frames before it may still be listed per frame
+      benchmark.measurementStarted = [this]() {
+        vks::Profiler::get().setCounterTotalsFirstFrame(frameNumber_);
+      };
+      benchmark.resultSections.push_back(
+          {"perfCounters", [](std::ostream& os) {
+             vks::Profiler::get().writeCountersJson(os);
+           }});
+    } else {
+      std::cerr << "CPU performance counters are not available (requires "
+                   "Linux and kernel.perf_event_paranoid <= 2)\n";
+    }
+  }
+  if (commandLineParser.isSet("camerapathsegments")) {
+    settings_.cameraPathSegments = std::max(
+        commandLineParser.getValueAsInt("camerapathsegments",
+                                        settings_.cameraPathSegments),
+        1);
+  }
+  if (commandLineParser.isSet("camerapath")) {
+    const std::string filename =
+        commandLineParser.getValueAsString("camerapath", "");
+    if (camera_.loadPath(filename)) {
+      camera_.startPathPlayback();
+      // Attribute benchmark frame times to the part of the path they were
+      // rendered at so slow viewpoints can be spotted
+      benchmark.currentSegment = [this] {
+        return camera_.pathSegment(settings_.cameraPathSegments);
+      };
+      benchmark.resultSections.push_back(
+          {"cameraPath", [this](std::ostream& os) { writeCameraPathJson(os); }});
+    } else {
+      std::cerr << "Could not load camera path from \"" << filename << "\"\n";
+    }
+  }
+  if (commandLineParser.isSet("camerapathrecord")) {
+    camera_.startPathRecording();
+  }
 #if (!(defined(VK_USE_PLATFORM_IOS_MVK) ||   \
        defined(VK_USE_PLATFORM_MACOS_MVK) || \
        defined(VK_USE_PLATFORM_METAL_EXT)))
@@ -927,9 +1769,13 @@ VulkanExampleBase::VulkanExampleBase() {
 #elif defined(_DIRECT2DISPLAY)
 
 #elif defined(VK_USE_PLATFORM_WAYLAND_KHR)
-  initWaylandConnection();
+  if (!settings_.offscreen) {
+    initWaylandConnection();
+  }
 #elif defined(VK_USE_PLATFORM_XCB_KHR)
-  initxcbConnection();
+  if (!settings_.offscreen) {
+    initxcbConnection();
+  }
 #endif
 
 #if defined(_WIN32)
@@ -948,7 +1794,10 @@ VulkanExampleBase::~VulkanExampleBase() {
   if (descriptorPool_ != VK_NULL_HANDLE) {
     vkDestroyDescriptorPool(device_, descriptorPool_, nullptr);
   }
+  descriptorAllocator_.destroy();
   destroyCommandBuffers();
+  // Pipelines of the registry may still refer to the render pass
+  pipelineRegistry_.destroy();
   if (renderPass_ != VK_NULL_HANDLE) {
     vkDestroyRenderPass(device_, renderPass_, nullptr);
   }
@@ -960,8 +1809,15 @@ VulkanExampleBase::~VulkanExampleBase() {
   }
   vkDestroyImageView(device_, depthStencil_.view, nullptr);
   vkDestroyImage(device_, depthStencil_.image, nullptr);
-  vkFreeMemory(device_, depthStencil_.memory, nullptr);
-  vkDestroyPipelineCache(device_, pipelineCache_, nullptr);
+  if (vulkanDevice_) {
+    freeDepthStencilMemory();
+  }
+  if (settings_.pipelineCache && (pipelineCache_ != VK_NULL_HANDLE) &&
+      !pipelineCacheStore_.save(pipelineCreationTime())) {
+    std::cerr << "Could not save pipeline cache to \"" << pipelineCacheFile_
+              << "\"\n";
+  }
+  pipelineCacheStore_.destroy();
   vkDestroyCommandPool(device_, cmdPool_, nullptr);
   for (auto& fence : waitFences_) {
     vkDestroyFence(device_, fence, nullptr);
@@ -975,6 +1831,10 @@ VulkanExampleBase::~VulkanExampleBase() {
   if (settings_.overlay) {
     ui_.freeResources();
   }
+  gpuProfiler_.destroy();
+  uniformRing_.destroy();
+  asyncCompute_.destroy();
+  dynamicResolution_.destroy();
   delete vulkanDevice_;
   if (settings_.validation) {
     vks::debug::freeDebugCallback(instance_);
@@ -994,22 +1854,26 @@ VulkanExampleBase::~VulkanExampleBase() {
   if (dfb)
     dfb->Release(dfb);
 #elif defined(VK_USE_PLATFORM_WAYLAND_KHR)
-  xdg_toplevel_destroy(xdg_toplevel);
-  xdg_surface_destroy(xdg_surface);
-  wl_surface_destroy(surface);
-  if (keyboard)
-    wl_keyboard_destroy(keyboard);
-  if (pointer)
-    wl_pointer_destroy(pointer);
-  if (seat)
-    wl_seat_destroy(seat);
-  xdg_wm_base_destroy(shell);
-  wl_compositor_destroy(compositor);
-  wl_registry_destroy(registry);
-  wl_display_disconnect(display);
+  if (!settings_.offscreen) {
+    xdg_toplevel_destroy(xdg_toplevel);
+    xdg_surface_destroy(xdg_surface);
+    wl_surface_destroy(surface);
+    if (keyboard)
+      wl_keyboard_destroy(keyboard);
+    if (pointer)
+      wl_pointer_destroy(pointer);
+    if (seat)
+      wl_seat_destroy(seat);
+    xdg_wm_base_destroy(shell);
+    wl_compositor_destroy(compositor);
+    wl_registry_destroy(registry);
+    wl_display_disconnect(display);
+  }
 #elif defined(VK_USE_PLATFORM_XCB_KHR)
-  xcb_destroy_window(connection, window);
-  xcb_disconnect(connection);
+  if (!settings_.offscreen) {
+    xcb_destroy_window(connection, window);
+    xcb_disconnect(connection);
+  }
 #elif defined(VK_USE_PLATFORM_SCREEN_QNX)
   screen_destroy_event(screen_event);
   screen_destroy_window(screen_window);
@@ -1018,6 +1882,7 @@ VulkanExampleBase::~VulkanExampleBase() {
 }
 
 bool VulkanExampleBase::initVulkan() {
+  ScopedStartupPhase startupPhase(this, "initVulkan");
   // Instead of checking for the command line switch, validation can be forced
   // via a define
 #if defined(_VALIDATION)
@@ -1031,7 +1896,9 @@ bool VulkanExampleBase::initVulkan() {
   }
 
   // Create the instance
+  const size_t instancePhase = beginStartupPhase("createInstance");
   VkResult result = createInstance();
+  endStartupPhase(instancePhase);
   if (result != VK_SUCCESS) {
     vks::tools::exitFatal("Could not create Vulkan instance : \n" +
                               vks::tools::errorString(result),
@@ -1126,8 +1993,149 @@ bool VulkanExampleBase::initVulkan() {
   // extensions read from the physical device
   getEnabledExtensions();
 
+  // Enable heap budget queries for the device memory statistics if supported
+  auto getMemoryProperties2 =
+      reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(
+          vkGetInstanceProcAddr(instance_,
+                                (apiVersion >= VK_API_VERSION_1_1)
+                                    ? "vkGetPhysicalDeviceMemoryProperties2"
+                                    : "vkGetPhysicalDeviceMemoryProperties2KHR"));
+  const bool memoryBudget =
+      getMemoryProperties2 &&
+      vulkanDevice_->extensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+  // Adds a device extension unless the example already enabled it
+  auto enableDeviceExtension = [this](const char* name) {
+    if (std::find_if(enabledDeviceExtensions_.begin(),
+                     enabledDeviceExtensions_.end(),
+                     [name](const char* extension) {
+                       return strcmp(extension, name) == 0;
+                     }) == enabledDeviceExtensions_.end()) {
+      enabledDeviceExtensions_.push_back(name);
+    }
+  };
+  if (memoryBudget) {
+    enableDeviceExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+  }
+  // Correlating GPU timestamps with the CPU clock for traces
+  const bool calibratedTimestamps =
+      !traceFile_.empty() && vulkanDevice_->extensionSupported(
+                                 VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+  if (calibratedTimestamps) {
+    enableDeviceExtension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+  }
+  // Descriptor update templates let the descriptor allocator write sets
+  // without building write structures for every update
+  if (vulkanDevice_->extensionSupported(
+          VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME)) {
+    enableDeviceExtension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+  }
+
+  // The upload manager tracks transfers with timeline semaphores if the device
+  // supports them
+  bool timelineSemaphores = false;
+  auto getFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+      vkGetInstanceProcAddr(instance_, (apiVersion >= VK_API_VERSION_1_1)
+                                           ? "vkGetPhysicalDeviceFeatures2"
+                                           : "vkGetPhysicalDeviceFeatures2KHR"));
+  if (getFeatures2 && vulkanDevice_->extensionSupported(
+                          VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR supportedFeatures{
+        .sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR};
+    VkPhysicalDeviceFeatures2KHR features2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR,
+        .pNext = &supportedFeatures};
+    getFeatures2(physicalDevice_, &features2);
+    timelineSemaphores = supportedFeatures.timelineSemaphore == VK_TRUE;
+  }
+  // Enable the feature in the example's feature chain if it already has a
+  // matching structure, otherwise prepend one
+  VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures{
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR,
+      .pNext = deviceCreatepNextChain_,
+      .timelineSemaphore = VK_TRUE};
+  void* pNextChain = deviceCreatepNextChain_;
+  if (timelineSemaphores) {
+    enableDeviceExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    bool chained = false;
+    for (auto* next = static_cast<VkBaseOutStructure*>(deviceCreatepNextChain_);
+         next; next = next->pNext) {
+      if (next->sType ==
+          VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR) {
+        reinterpret_cast<VkPhysicalDeviceTimelineSemaphoreFeaturesKHR*>(next)
+            ->timelineSemaphore = VK_TRUE;
+        chained = true;
+      } else if (next->sType ==
+                 VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES) {
+        reinterpret_cast<VkPhysicalDeviceVulkan12Features*>(next)
+            ->timelineSemaphore = VK_TRUE;
+        chained = true;
+      }
+    }
+    if (!chained) {
+      pNextChain = &timelineSemaphoreFeatures;
+    }
+  }
+
+  // Input to present latency is measured with present ids if the device can
+  // wait for them
+  bool presentWait = false;
+  if (!settings_.offscreen && getFeatures2 &&
+      vulkanDevice_->extensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+      vulkanDevice_->extensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+    VkPhysicalDevicePresentWaitFeaturesKHR supportedPresentWait{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR};
+    VkPhysicalDevicePresentIdFeaturesKHR supportedPresentId{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+        .pNext = &supportedPresentWait};
+    VkPhysicalDeviceFeatures2KHR features2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR,
+        .pNext = &supportedPresentId};
+    getFeatures2(physicalDevice_, &features2);
+    presentWait = (supportedPresentId.presentId == VK_TRUE) &&
+                  (supportedPresentWait.presentWait == VK_TRUE);
+  }
+  VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+      .presentWait = VK_TRUE};
+  VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+      .presentId = VK_TRUE};
+  if (presentWait) {
+    enableDeviceExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+    enableDeviceExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    bool presentIdChained = false;
+    bool presentWaitChained = false;
+    for (auto* next = static_cast<VkBaseOutStructure*>(pNextChain); next;
+         next = next->pNext) {
+      if (next->sType ==
+          VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR) {
+        reinterpret_cast<VkPhysicalDevicePresentIdFeaturesKHR*>(next)
+            ->presentId = VK_TRUE;
+        presentIdChained = true;
+      } else if (next->sType ==
+                 VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR) {
+        reinterpret_cast<VkPhysicalDevicePresentWaitFeaturesKHR*>(next)
+            ->presentWait = VK_TRUE;
+        presentWaitChained = true;
+      }
+    }
+    if (!presentWaitChained) {
+      presentWaitFeatures.pNext = pNextChain;
+      pNextChain = &presentWaitFeatures;
+    }
+    if (!presentIdChained) {
+      presentIdFeatures.pNext = pNextChain;
+      pNextChain = &presentIdFeatures;
+    }
+  }
+
+  // Uploads are streamed on a dedicated transfer queue if there is one
+  const size_t devicePhase = beginStartupPhase("createDevice");
   result = vulkanDevice_->createLogicalDevice(
-      enabledFeatures_, enabledDeviceExtensions_, deviceCreatepNextChain_);
+      enabledFeatures_, enabledDeviceExtensions_, pNextChain, true,
+      VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT);
+  endStartupPhase(devicePhase);
   if (result != VK_SUCCESS) {
     vks::tools::exitFatal(
         "Could not create Vulkan device: \n" + vks::tools::errorString(result),
@@ -1135,11 +2143,112 @@ bool VulkanExampleBase::initVulkan() {
     return false;
   }
   device_ = vulkanDevice_->logicalDevice;
+  if (memoryBudget) {
+    vulkanDevice_->memoryTracker.enableBudget(getMemoryProperties2);
+  }
+  benchmark.resultSections.push_back(
+      {"memory", [this](std::ostream& os) {
+         vulkanDevice_->memoryTracker.writeJson(os);
+       }});
+  benchmark.resultSections.push_back(
+      {"memoryAllocator", [this](std::ostream& os) {
+         vulkanDevice_->memoryAllocator.writeJson(os);
+       }});
+  vulkanDevice_->uploadManager.prepare(vulkanDevice_, timelineSemaphores);
+  descriptorAllocator_.prepare(vulkanDevice_);
+  pipelineRegistry_.prepare(device_);
+  uniformRing_.prepare(vulkanDevice_, framesInFlight_);
+  frameLatency_.prepare(device_, framesInFlight_, presentWait);
+  asyncCompute_.prepare(vulkanDevice_, framesInFlight_, timelineSemaphores,
+                        settings_.asyncCompute);
+  dynamicResolution_.prepare(vulkanDevice_, framesInFlight_,
+                             dynamicResolutionTarget_);
+  commandBufferReuse_.prepare(framesInFlight_, settings_.commandBufferReuse);
+  framePacer_.prepare(maxFrameRate_);
+  // Per-frame samples are only kept for benchmark output
+  dynamicResolution_.recordScales =
+      benchmark.active && benchmark.outputFrameTimes;
+  framePacer_.recordIntervals = benchmark.active && benchmark.outputFrameTimes;
+  // The latency section of the results always reports the median and p99
+  frameLatency_.recordSamples = benchmark.active;
+  benchmark.resultSections.push_back(
+      {"uploads", [this](std::ostream& os) {
+         os << "{\"submissions\": "
+            << vulkanDevice_->uploadManager.submissionCount
+            << ", \"bytes\": " << vulkanDevice_->uploadManager.uploadedBytes
+            << "}";
+       }});
+  benchmark.resultSections.push_back(
+      {"immediateContext", [this](std::ostream& os) {
+         os << "{\"submissions\": "
+            << vulkanDevice_->immediateContext.submissionCount
+            << ", \"commandBuffers\": "
+            << vulkanDevice_->immediateContext.commandBufferCount << "}";
+       }});
+  benchmark.resultSections.push_back(
+      {"descriptors", [this](std::ostream& os) {
+         os << "{\"pools\": " << descriptorAllocator_.poolCount()
+            << ", \"sets\": " << descriptorAllocator_.allocatedSets
+            << ", \"templateUpdates\": "
+            << descriptorAllocator_.templateUpdates << "}";
+       }});
+  benchmark.resultSections.push_back(
+      {"pipelineCache", [this](std::ostream& os) {
+         os << "{\"warm\": "
+            << (pipelineCacheStore_.warm ? "true" : "false")
+            << ", \"loadedBytes\": " << pipelineCacheStore_.loadedSize
+            << ", \"creationTime\": " << pipelineCreationTime()
+            << ", \"coldCreationTime\": "
+            << pipelineCacheStore_.coldCreationTime << "}";
+       }});
+  benchmark.resultSections.push_back(
+      {"pipelineRegistry", [this](std::ostream& os) {
+         os << "{\"pipelines\": " << pipelineRegistry_.pipelineCount()
+            << ", \"hits\": " << pipelineRegistry_.hits
+            << ", \"misses\": " << pipelineRegistry_.misses
+            << ", \"creationTime\": " << pipelineRegistry_.creationTime
+            << "}";
+       }});
+  benchmark.resultSections.push_back(
+      {"uniformRing", [this](std::ostream& os) {
+         os << "{\"peakFrameBytes\": " << uniformRing_.peakFrameUsage << "}";
+       }});
+  benchmark.resultSections.push_back(
+      {"latency", [this](std::ostream& os) {
+         frameLatency_.writeJson(os, framesInFlight_);
+       }});
+  benchmark.resultSections.push_back(
+      {"asyncCompute", [this](std::ostream& os) {
+         os << "{\"separateQueue\": "
+            << (asyncCompute_.separateQueue ? "true" : "false")
+            << ", \"timelineSemaphores\": "
+            << (asyncCompute_.timelineSemaphores ? "true" : "false")
+            << ", \"submissions\": " << asyncCompute_.submissionCount
+            << ", \"graphicsWaits\": " << asyncCompute_.graphicsWaitCount
+            << "}";
+       }});
+  benchmark.resultSections.push_back(
+      {"dynamicResolution", [this](std::ostream& os) {
+         dynamicResolution_.writeJson(os, benchmark.outputFrameTimes);
+       }});
+  benchmark.resultSections.push_back(
+      {"commandBufferReuse",
+       [this](std::ostream& os) { commandBufferReuse_.writeJson(os); }});
+  benchmark.resultSections.push_back(
+      {"framePacing", [this](std::ostream& os) {
+         framePacer_.writeJson(os, benchmark.outputFrameTimes);
+       }});
 
   // Get a graphics queue from the device
   vkGetDeviceQueue(device_, vulkanDevice_->queueFamilyIndices.graphics, 0,
                    &queue_);
 
+  if (!traceFile_.empty()) {
+    gpuProfiler_.prepare(instance_, vulkanDevice_, queue_,
+                         vulkanDevice_->queueFamilyIndices.graphics,
+                         framesInFlight_, calibratedTimestamps);
+  }
+
   // Find a suitable depth and/or stencil format
   VkBool32 validFormat{false};
   // Samples that make use of stencil will require a depth + stencil format, so
@@ -1925,7 +3034,15 @@ void* VulkanExampleBase::setupWindow(void* view) {
 void VulkanExampleBase::displayLinkOutputCb() {
 #if defined(VK_EXAMPLE_XCODE_GENERATED)
   if (benchmark.active) {
-    benchmark.run([=] { render(); }, vulkanDevice->properties);
+    benchmark.run(
+        [=] {
+          const auto tStart = std::chrono::high_resolution_clock::now();
+          render();
+          updateTimers(std::chrono::duration<double, std::milli>(
+                           std::chrono::high_resolution_clock::now() - tStart)
+                           .count());
+        },
+        vulkanDevice->properties);
     if (benchmark.filename != "") {
       benchmark.saveResults();
     }
@@ -2164,6 +3281,13 @@ void VulkanExampleBase::handleEvent(const DFBWindowEvent* event) {
                                                    wl_fixed_t sx,
                                                    wl_fixed_t sy) {
   VulkanExampleBase* self = reinterpret_cast<VulkanExampleBase*>(data);
+  if (self->renderThreadRunning_) {
+    self->queueInput({.type = InputEvent::Type::PointerMotion,
+                      .time = time,
+                      .x = sx,
+                      .y = sy});
+    return;
+  }
   self->pointerMotion(pointer, time, sx, sy);
 }
 void VulkanExampleBase::pointerMotion(wl_pointer* pointer,
@@ -2180,6 +3304,13 @@ void VulkanExampleBase::pointerMotion(wl_pointer* pointer,
                                                    uint32_t button,
                                                    uint32_t state) {
   VulkanExampleBase* self = reinterpret_cast<VulkanExampleBase*>(data);
+  if (self->renderThreadRunning_) {
+    self->queueInput({.type = InputEvent::Type::PointerButton,
+                      .time = time,
+                      .code = button,
+                      .state = state});
+    return;
+  }
   self->pointerButton(pointer, serial, time, button, state);
 }
 
@@ -2209,6 +3340,13 @@ void VulkanExampleBase::pointerButton(struct wl_pointer* pointer,
                                                  uint32_t axis,
                                                  wl_fixed_t value) {
   VulkanExampleBase* self = reinterpret_cast<VulkanExampleBase*>(data);
+  if (self->renderThreadRunning_) {
+    self->queueInput({.type = InputEvent::Type::PointerAxis,
+                      .time = time,
+                      .code = axis,
+                      .x = value});
+    return;
+  }
   self->pointerAxis(pointer, time, axis, value);
 }
 
@@ -2252,6 +3390,13 @@ void VulkanExampleBase::pointerAxis(wl_pointer* pointer,
                                                  uint32_t key,
                                                  uint32_t state) {
   VulkanExampleBase* self = reinterpret_cast<VulkanExampleBase*>(data);
+  if (self->renderThreadRunning_) {
+    self->queueInput({.type = InputEvent::Type::KeyboardKey,
+                      .time = time,
+                      .code = key,
+                      .state = state});
+    return;
+  }
   self->keyboardKey(keyboard, serial, time, key, state);
 }
 
@@ -2397,12 +3542,52 @@ void VulkanExampleBase::setSize(int width_, int height_) {
   if (width_ <= 0 || height_ <= 0)
     return;
 
+  // The swap chain is recreated by the render thread if there is one
+  if (renderThreadRunning_) {
+    queueInput(
+        {.type = InputEvent::Type::Resize, .x = width_, .y = height_});
+    return;
+  }
+
   destWidth = width_;
   destHeight = height_;
 
   windowResize();
 }
 
+void VulkanExampleBase::queueInput(const InputEvent& event) {
+  // The render thread only stops once quit is set, so waiting for it to make
+  // room can't block forever
+  while (!inputQueue_.push(event) && !quit) {
+    std::this_thread::yield();
+  }
+}
+
+void VulkanExampleBase::handleQueuedInput() {
+  InputEvent event;
+  while (inputQueue_.pop(event)) {
+    switch (event.type) {
+      case InputEvent::Type::PointerMotion:
+        pointerMotion(pointer, event.time, event.x, event.y);
+        break;
+      case InputEvent::Type::PointerButton:
+        pointerButton(pointer, 0, event.time, event.code, event.state);
+        break;
+      case InputEvent::Type::PointerAxis:
+        pointerAxis(pointer, event.time, event.code, event.x);
+        break;
+      case InputEvent::Type::KeyboardKey:
+        keyboardKey(keyboard, 0, event.time, event.code, event.state);
+        break;
+      case InputEvent::Type::Resize:
+        destWidth = event.x;
+        destHeight = event.y;
+        windowResize();
+        break;
+    }
+  }
+}
+
 static void xdg_surface_handle_configure(void* data,
                                          struct xdg_surface* surface,
                                          uint32_t serial) {
@@ -2439,6 +3624,9 @@ static const struct xdg_toplevel_listener xdg_toplevel_listener = {
 };
 
 struct xdg_surface* VulkanExampleBase::setupWindow() {
+  if (settings_.offscreen) {
+    return nullptr;
+  }
   surface = wl_compositor_create_surface(compositor);
   xdg_surface = xdg_wm_base_get_xdg_surface(shell, surface);
 
@@ -2470,6 +3658,9 @@ static inline xcb_intern_atom_reply_t* intern_atom_helper(
 
 // Set up a window using XCB and request event types
 xcb_window_t VulkanExampleBase::setupWindow() {
+  if (settings_.offscreen) {
+    return 0;
+  }
   uint32_t value_mask, value_list[32];
 
   window = xcb_generate_id(connection);
@@ -2562,6 +3753,26 @@ void VulkanExampleBase::initxcbConnection() {
   screen = iter.data;
 }
 
+void VulkanExampleBase::queueInput(xcb_generic_event_t* event) {
+  // The render thread only stops once quit is set, so waiting for it to make
+  // room can't block forever
+  while (!inputQueue_.push(event)) {
+    if (quit) {
+      free(event);
+      return;
+    }
+    std::this_thread::yield();
+  }
+}
+
+void VulkanExampleBase::handleQueuedInput() {
+  xcb_generic_event_t* event;
+  while (inputQueue_.pop(event)) {
+    handleEvent(event);
+    free(event);
+  }
+}
+
 void VulkanExampleBase::handleEvent(const xcb_generic_event_t* event) {
   switch (event->response_type & 0x7f) {
     case XCB_CLIENT_MESSAGE:
@@ -2972,6 +4183,8 @@ void VulkanExampleBase::createSynchronizationPrimitives() {
   VkFenceCreateInfo fenceCreateInfo{
       .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
       .flags = VK_FENCE_CREATE_SIGNALED_BIT};
+  waitFences_.resize(framesInFlight_);
+  presentCompleteSemaphores_.resize(framesInFlight_);
   for (auto& fence : waitFences_) {
     VK_CHECK_RESULT(vkCreateFence(device_, &fenceCreateInfo, nullptr, &fence));
   }
@@ -3004,6 +4217,15 @@ void VulkanExampleBase::createCommandPool() {
       vkCreateCommandPool(device_, &cmdPoolInfo, nullptr, &cmdPool_));
 }
 
+void VulkanExampleBase::freeDepthStencilMemory() {
+  if (depthStencil_.allocation.valid()) {
+    vulkanDevice_->freeAllocation(depthStencil_.allocation);
+  } else {
+    vulkanDevice_->freeMemory(depthStencil_.memory);
+  }
+  depthStencil_.memory = VK_NULL_HANDLE;
+}
+
 void VulkanExampleBase::setupDepthStencil() {
   VkImageCreateInfo imageCI{
       .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
@@ -3017,18 +4239,10 @@ void VulkanExampleBase::setupDepthStencil() {
       .usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT};
   VK_CHECK_RESULT(
       vkCreateImage(device_, &imageCI, nullptr, &depthStencil_.image));
-  VkMemoryRequirements memReqs{};
-  vkGetImageMemoryRequirements(device_, depthStencil_.image, &memReqs);
-
-  VkMemoryAllocateInfo memAllloc{
-      .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-      .allocationSize = memReqs.size,
-      .memoryTypeIndex = vulkanDevice_->getMemoryType(
-          memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)};
-  VK_CHECK_RESULT(
-      vkAllocateMemory(device_, &memAllloc, nullptr, &depthStencil_.memory));
-  VK_CHECK_RESULT(
-      vkBindImageMemory(device_, depthStencil_.image, depthStencil_.memory, 0));
+  VK_CHECK_RESULT(vulkanDevice_->allocateImageMemory(
+      depthStencil_.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+      vks::MemoryTag::Attachments, &depthStencil_.allocation));
+  depthStencil_.memory = depthStencil_.allocation.memory;
 
   VkImageViewCreateInfo imageViewCI{
       .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
@@ -3162,11 +4376,15 @@ void VulkanExampleBase::windowResize() {
   width_ = destWidth;
   height_ = destHeight;
   createSwapChain();
+  // Present ids of the old swap chain can no longer be waited for
+  frameLatency_.reset();
+  // Recorded command buffers reference the old frame buffers and extent
+  commandBufferReuse_.invalidate();
 
   // Recreate the frame buffers
   vkDestroyImageView(device_, depthStencil_.view, nullptr);
   vkDestroyImage(device_, depthStencil_.image, nullptr);
-  vkFreeMemory(device_, depthStencil_.memory, nullptr);
+  freeDepthStencilMemory();
   setupDepthStencil();
   for (auto& frameBuffer : frameBuffers_) {
     vkDestroyFramebuffer(device_, frameBuffer, nullptr);
@@ -3235,6 +4453,11 @@ void VulkanExampleBase::handleMouseMove(int32_t x, int32_t y) {
 void VulkanExampleBase::windowResized() {}
 
 void VulkanExampleBase::createSurface() {
+  // Offscreen images are rendered to and "presented" on the graphics queue
+  if (settings_.offscreen) {
+    swapChain_.queueNodeIndex_ = vulkanDevice_->queueFamilyIndices.graphics;
+    return;
+  }
 #if defined(_WIN32)
   swapChain_.initSurface(windowInstance, window);
 #elif defined(VK_USE_PLATFORM_ANDROID_KHR)
@@ -3257,9 +4480,83 @@ void VulkanExampleBase::createSurface() {
 }
 
 void VulkanExampleBase::createSwapChain() {
+  if (settings_.offscreen) {
+    // Same number of images a swap chain usually has
+    swapChain_.createOffscreen(vulkanDevice_, queue_, width_, height_, 3);
+    return;
+  }
   swapChain_.create(width_, height_, settings_.vsync, settings_.fullscreen);
 }
 
+void VulkanExampleBase::dumpFrame(uint32_t imageIndex, uint64_t frame) {
+  vks::Buffer readback;
+  VK_CHECK_RESULT(vulkanDevice_->createBuffer(
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+          VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+      &readback, static_cast<VkDeviceSize>(width_) * height_ * 4));
+
+  // The image has been rendered and "presented" by earlier submissions, so a
+  // barrier on all commands orders the copy after them
+  VkCommandBuffer copyCmd = vulkanDevice_->createCommandBuffer(
+      VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+  VkImageMemoryBarrier imageBarrier{
+      .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+      .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                       VK_ACCESS_TRANSFER_WRITE_BIT,
+      .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+      .oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+      .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .image = swapChain_.images_[imageIndex],
+      .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
+  vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                       nullptr, 1, &imageBarrier);
+  VkBufferImageCopy copyRegion{
+      .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+      .imageExtent = {width_, height_, 1}};
+  vkCmdCopyImageToBuffer(copyCmd, swapChain_.images_[imageIndex],
+                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback.buffer,
+                         1, &copyRegion);
+  imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  imageBarrier.dstAccessMask = 0;
+  imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  imageBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+  vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0,
+                       nullptr, 1, &imageBarrier);
+  vulkanDevice_->flushCommandBuffer(copyCmd, queue_);
+
+  std::filesystem::create_directories(frameDumpPath_);
+  const std::string filename =
+      frameDumpPath_ + "/" + name + "_" + std::to_string(frame) + ".ppm";
+  std::ofstream file(filename, std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Could not write frame to \"" << filename << "\"\n";
+    readback.destroy();
+    return;
+  }
+  // PPM stores RGB, offscreen images are either BGRA or RGBA
+  const bool bgra = swapChain_.colorFormat_ == VK_FORMAT_B8G8R8A8_UNORM;
+  VK_CHECK_RESULT(readback.map());
+  const uint8_t* pixels = static_cast<const uint8_t*>(readback.mapped);
+  file << "P6\n" << width_ << "\n" << height_ << "\n255\n";
+  std::vector<char> row(width_ * 3);
+  for (uint32_t y = 0; y < height_; y++) {
+    for (uint32_t x = 0; x < width_; x++) {
+      const uint8_t* pixel = pixels + (y * width_ + x) * 4;
+      row[x * 3 + 0] = pixel[bgra ? 2 : 0];
+      row[x * 3 + 1] = pixel[1];
+      row[x * 3 + 2] = pixel[bgra ? 0 : 2];
+    }
+    file.write(row.data(), row.size());
+  }
+  readback.destroy();
+  std::cout << "Frame " << frame << " written to \"" << filename << "\"\n";
+}
+
 void VulkanExampleBase::OnUpdateUIOverlay(vks::UIOverlay* overlay) {}
 
 #if defined(_WIN32)
@@ -43,11 +43,16 @@
 #include <sys/stat.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <numeric>
 #include <random>
+#include <sstream>
 #include <unordered_map>
 #include <vector>
 
@@ -63,31 +68,90 @@
 #include "vulkan/vulkan.h"
 
 #include "CommandLineParser.hpp"
+#include "VulkanAsyncCompute.h"
 #include "VulkanBuffer.h"
+#include "VulkanCommandBufferReuse.h"
 #include "VulkanDebug.h"
+#include "VulkanDescriptorAllocator.h"
 #include "VulkanDevice.h"
+#include "VulkanDynamicResolution.h"
+#include "VulkanFrameLatency.h"
+#include "VulkanFramePacer.h"
+#include "VulkanGpuProfiler.h"
+#include "VulkanPipelineBuilder.h"
+#include "VulkanPipelineCache.h"
+#include "VulkanPipelineRegistry.h"
+#include "VulkanShaderArchive.h"
 #include "VulkanSwapChain.h"
 #include "VulkanTexture.h"
 #include "VulkanTools.h"
 #include "VulkanUIOverlay.h"
+#include "VulkanUniformRing.h"
 #include "keycodes.hpp"
 
 #include "VulkanInitializers.hpp"
 #include "benchmark.hpp"
 #include "camera.hpp"
+#include "inputqueue.hpp"
+#include "profiler.hpp"
 
 // NOT the same number as swap chain size!
-constexpr uint32_t MAX_CONCURRENT_FRAMES{2};
+// Upper bound for the number of frames in flight selected at startup, per-frame
+// resources are sized by the selected number (framesInFlight_)
+constexpr uint32_t MAX_CONCURRENT_FRAMES{4};
 
 class VulkanExampleBase {
  private:
   std::string getWindowTitle() const;
   uint32_t destWidth{};
   uint32_t destHeight{};
+  std::chrono::time_point<std::chrono::high_resolution_clock> startupTime_;
+  uint32_t startupPhaseDepth_{0};
+  size_t prepareStartupPhase_{SIZE_MAX};
+  bool firstFrameRendered_{false};
   bool resizing = false;
   void handleMouseMove(int32_t x, int32_t y);
   void nextFrame();
+  void updateTimers(double frameTimeMs);
+  void reportFramePacing() const;
+  // On-demand rendering (see Settings::onDemand): frames still to render after
+  // a redraw request, and the time spent waiting for events instead
+  struct {
+    uint32_t redrawFrames{0};
+    bool idle{false};
+    std::chrono::time_point<std::chrono::high_resolution_clock> idleStart;
+    double idleTime{0.0};
+    uint32_t idlePeriods{0};
+  } onDemand_;
+  bool frameRequired();
+#if defined(VK_USE_PLATFORM_WAYLAND_KHR) || defined(VK_USE_PLATFORM_XCB_KHR)
+  // Renders frames until quit is set while the main thread handles the window
+  // system connection, see Settings::renderThread
+  void renderThreadLoop();
+  void handleQueuedInput();
+#endif
+  void writeCameraPathJson(std::ostream& os) const;
   void updateOverlay();
+  void drawMemoryStatistics();
+  size_t beginStartupPhase(const std::string& name);
+  void endStartupPhase(size_t index);
+  void writeStartupReport();
+  double pipelineCreationTime() const;
+  std::string traceFile_;
+  // GPU frame time in ms dynamicResolution_ scales for, zero disables it
+  float dynamicResolutionTarget_{0.0f};
+  // Frame rate framePacer_ limits to, zero disables limiting
+  float maxFrameRate_{0.0f};
+  // Offscreen frames written to frameDumpPath_ as PPM files, counted from 1
+  std::string frameDumpPath_;
+  std::vector<uint64_t> frameDumpFrames_{1};
+  // Seconds an offscreen run without -b renders for, set with --benchruntime
+  uint32_t offscreenDuration_{0};
+  void dumpFrame(uint32_t imageIndex, uint64_t frame);
+  // Defaults to <name>.pipelinecache in the working directory
+  std::string pipelineCacheFile_;
+  void updateTrace(double frameTimeMs);
+  void endTrace();
   void createPipelineCache();
   void createCommandPool();
   void createSynchronizationPrimitives();
@@ -95,6 +159,7 @@ class VulkanExampleBase {
   void createSwapChain();
   void createCommandBuffers();
   void destroyCommandBuffers();
+  void freeDepthStencilMemory();
   std::string shaderDir = "glsl";
 
  protected:
@@ -142,17 +207,31 @@ class VulkanExampleBase {
   // Command buffer pool
   VkCommandPool cmdPool_{VK_NULL_HANDLE};
   // Command buffers used for rendering
-  std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> drawCmdBuffers_;
+  std::vector<VkCommandBuffer> drawCmdBuffers_;
   // Global render pass for frame buffer writes
   VkRenderPass renderPass_{VK_NULL_HANDLE};
   // List of available frame buffers (same as number of swap chain images)
   std::vector<VkFramebuffer> frameBuffers_;
   // Descriptor set pool
   VkDescriptorPool descriptorPool_{VK_NULL_HANDLE};
+  // Growable descriptor set allocator, examples can use it instead of sizing
+  // descriptorPool_ by hand
+  vks::DescriptorAllocator descriptorAllocator_;
+  // Per-frame linear allocator for uniform data bound with dynamic offsets,
+  // rewound by prepareFrame for the current frame
+  vks::UniformRing uniformRing_;
   // List of shader modules created (stored for cleanup)
   std::vector<VkShaderModule> shaderModules_;
-  // Pipeline cache object
+  // Packed SPIR-V of the selected shading language, if available, and the
+  // modules created from it keyed by content hash
+  vks::ShaderArchive shaderArchive_;
+  std::unordered_map<uint64_t, VkShaderModule> shaderArchiveModules_;
+  // Pipeline cache object, loaded from and saved to pipelineCacheFile_
   VkPipelineCache pipelineCache_{VK_NULL_HANDLE};
+  vks::PipelineCache pipelineCacheStore_;
+  // Returns existing pipelines for repeated create infos, e.g. when examples
+  // recreate their pipelines on option changes
+  vks::PipelineRegistry pipelineRegistry_;
   // Wraps the swap chain to present images (framebuffers) to the windowing
   // system
   VulkanSwapChain swapChain_;
@@ -162,9 +241,28 @@ class VulkanExampleBase {
   // CPU/GPU parallelism
   uint32_t currentImageIndex_{0};
   uint32_t currentBuffer_{0};
-  std::array<VkSemaphore, MAX_CONCURRENT_FRAMES> presentCompleteSemaphores_{};
+  // Number of frames in flight (1..MAX_CONCURRENT_FRAMES), currentBuffer_
+  // cycles through this many per-frame resources
+  uint32_t framesInFlight_{2};
+  std::vector<VkSemaphore> presentCompleteSemaphores_{};
   std::vector<VkSemaphore> renderCompleteSemaphores_{};
-  std::array<VkFence, MAX_CONCURRENT_FRAMES> waitFences_;
+  std::vector<VkFence> waitFences_;
+  // Input to present latency of the frames in flight
+  vks::FrameLatency frameLatency_;
+  // Input time of the frame being prepared, recorded by prepareFrame
+  vks::FrameLatency::Clock::time_point frameInputTime_;
+  // Per-frame compute command buffers on the compute queue, submitFrame waits
+  // for the compute work submitted in the same frame
+  vks::AsyncCompute asyncCompute_;
+  // Render scale of examples that support dynamic resolution, adjusted by
+  // prepareFrame from the GPU time measured for the frame slot
+  vks::DynamicResolution dynamicResolution_;
+  // Validity of the recorded drawCmdBuffers_ for examples that record them
+  // with updateCommandBuffer
+  vks::CommandBufferReuse commandBufferReuse_;
+  // Optional frame rate limit applied by prepareFrame, and the frame pacing
+  // statistics measured from the intervals between presents
+  vks::FramePacer framePacer_;
 
   bool requiresStencil_{false};
 
@@ -180,6 +278,9 @@ class VulkanExampleBase {
   /** @brief Last frame time measured using a high performance timer (if
    * available) */
   float frameTimer = 1.0f;
+  /** @brief Time in seconds animations advance by this frame, the measured
+   * frame time or a fixed step in deterministic and benchmark runs */
+  float animationStep_ = 1.0f;
 
   vks::Benchmark benchmark;
 
@@ -199,6 +300,44 @@ class VulkanExampleBase {
     bool vsync = false;
     /** @brief Enable UI overlay */
     bool overlay = true;
+    /** @brief Advance animations with a fixed simulated frame time and use
+     * fixed random seeds, so that runs are reproducible */
+    bool deterministic = false;
+    /** @brief Simulated frame time (in seconds) animations advance by in
+     * deterministic mode and benchmarks */
+    float deterministicFrameTime = 1.0f / 60.0f;
+    /** @brief Number of equally sized camera path segments frame statistics
+     * are reported for when benchmarking with a camera path */
+    uint32_t cameraPathSegments = 10;
+    /** @brief First frame (and number of frames) captured with --trace */
+    uint32_t traceStartFrame = 100;
+    uint32_t traceFrameCount = 10;
+    /** @brief Load the pipeline cache from disk at startup and save it on
+     * shutdown */
+    bool pipelineCache = true;
+    /** @brief Maximum number of threads used to create pipelines with
+     * vks::PipelineBuilder, 0 uses one per hardware thread */
+    uint32_t pipelineThreads = 0;
+    /** @brief Load shaders from <shaders dir>/<language>.shaderpack if present
+     */
+    bool shaderArchive = true;
+    /** @brief Render to a pool of offscreen images instead of a swap chain,
+     * no window or display server is required */
+    bool offscreen = false;
+    /** @brief Update and render on a separate thread, while the main thread
+     * only waits for window system events and passes them on (XCB and
+     * Wayland) */
+    bool renderThread = false;
+    /** @brief Submit compute work of asyncCompute_ to the compute queue, if
+     * false it goes to the graphics queue */
+    bool asyncCompute = true;
+    /** @brief Resubmit command buffers recorded with updateCommandBuffer as
+     * long as they are valid, if false they are recorded every frame */
+    bool commandBufferReuse = true;
+    /** @brief Only render when input, animation or a redraw request changed
+     * the frame, and block on window events otherwise (Windows, XCB and
+     * Wayland) */
+    bool onDemand = false;
   } settings_;
 
   /** @brief State of gamepad input (only used on Android) */
@@ -227,6 +366,48 @@ class VulkanExampleBase {
   // Multiplier for speeding up (or slowing down) the global timer
   float timerSpeed = 0.25f;
   bool paused = false;
+  // Set to false by examples without time based animation, so on-demand
+  // rendering can idle while the example isn't paused
+  bool animated = true;
+  // Total (simulated) time in seconds, advanced by animationStep_
+  double elapsedTime_ = 0.0;
+  // Number of frames rendered so far
+  uint64_t frameNumber_ = 0;
+
+  /** @brief Timestamp queries for GPU zones in traces (see --trace), examples
+   * can add zones to their command buffers with beginZone/endZone */
+  vks::GpuProfiler gpuProfiler_;
+
+  /** @brief Random engine for examples, seeded with randomSeed() */
+  std::default_random_engine randomEngine_;
+  /** @brief Returns a fixed seed in benchmark and deterministic mode, a random
+   * one otherwise */
+  uint32_t randomSeed() const;
+
+  /** @brief Startup phase timing in milliseconds, relative to the construction
+   * of the example, reported with --startup-report */
+  struct StartupPhase {
+    std::string name;
+    uint32_t depth;
+    double start;
+    double duration;
+  };
+  std::vector<StartupPhase> startupPhases_;
+
+  /** @brief Times the enclosing scope as a (nested) startup phase, e.g. for
+   * asset loading, pipeline creation or precompute passes. Does nothing once
+   * the first frame has been rendered */
+  class ScopedStartupPhase {
+   public:
+    ScopedStartupPhase(VulkanExampleBase* example, const std::string& name);
+    ~ScopedStartupPhase();
+    ScopedStartupPhase(const ScopedStartupPhase&) = delete;
+    ScopedStartupPhase& operator=(const ScopedStartupPhase&) = delete;
+
+   private:
+    VulkanExampleBase* example_;
+    size_t index_;
+  };
 
   Camera camera_;
 
@@ -238,6 +419,9 @@ class VulkanExampleBase {
   struct {
     VkImage image;
     VkDeviceMemory memory;
+    // Only valid if the image was created by the base class, samples that
+    // override setupDepthStencil allocate memory themselves
+    vks::MemoryAllocation allocation;
     VkImageView view;
   } depthStencil_{};
 
@@ -283,17 +467,39 @@ class VulkanExampleBase {
   wl_surface* surface = nullptr;
   struct xdg_surface* xdg_surface;
   struct xdg_toplevel* xdg_toplevel;
-  bool quit = false;
+  std::atomic<bool> quit{false};
   bool configured = false;
+  // Input and resize events received on the main thread while the render
+  // thread is running, handled by the render thread before its next frame
+  struct InputEvent {
+    enum class Type {
+      PointerMotion,
+      PointerButton,
+      PointerAxis,
+      KeyboardKey,
+      Resize
+    } type;
+    uint32_t time;
+    // Button, axis or key
+    uint32_t code;
+    uint32_t state;
+    // Pointer position or axis value (wl_fixed_t), new size for resizes
+    int32_t x;
+    int32_t y;
+  };
+  vks::InputQueue<InputEvent, 1024> inputQueue_;
+  bool renderThreadRunning_ = false;
 
 #elif defined(_DIRECT2DISPLAY)
   bool quit = false;
 #elif defined(VK_USE_PLATFORM_XCB_KHR)
-  bool quit = false;
+  std::atomic<bool> quit{false};
   xcb_connection_t* connection;
   xcb_screen_t* screen;
   xcb_window_t window;
   xcb_intern_atom_reply_t* atom_wm_delete_window;
+  // Events polled by the main thread while the render thread is running
+  vks::InputQueue<xcb_generic_event_t*, 1024> inputQueue_;
 #elif defined(VK_USE_PLATFORM_HEADLESS_EXT)
   bool quit = false;
 #elif defined(VK_USE_PLATFORM_SCREEN_QNX)
@@ -333,6 +539,7 @@ class VulkanExampleBase {
   struct xdg_surface* setupWindow();
   void initWaylandConnection();
   void setSize(int width, int height);
+  void queueInput(const InputEvent& event);
   static void registryGlobalCb(void* data,
                                struct wl_registry* registry,
                                uint32_t name,
@@ -425,6 +632,7 @@ class VulkanExampleBase {
   xcb_window_t setupWindow();
   void initxcbConnection();
   void handleEvent(const xcb_generic_event_t* event);
+  void queueInput(xcb_generic_event_t* event);
 #elif defined(VK_USE_PLATFORM_SCREEN_QNX)
   void setupWindow();
   void handleEvent();
@@ -480,8 +688,31 @@ class VulkanExampleBase {
   /** Prepare the next frame for workload submission by acquiring the next swap
    * chain image and waiting for the previous command buffer to finish */
   void prepareFrame(bool waitForFence = true);
+  /** @brief Reads back the results of the frame previously rendered with the
+   * current frame slot (latency, GPU timings, dynamic resolution) and recycles
+   * its uniform ring space. Called by prepareFrame after the fence wait.
+   * Examples that call prepareFrame(false) must call it themselves once the
+   * slot's previous work is known to have finished */
+  void frameSlotAvailable();
   /** @brief Presents the current image to the swap chain */
   void submitFrame(bool skipQueueSubmit = false);
+  /** @brief Records the current frame's command buffer with
+   * buildCommandBuffer, unless the one recorded for this frame slot and swap
+   * chain image is still valid and can be submitted as-is. Recordings are
+   * invalidated by resizes, UI changes and option widgets of the overlay
+   * @note Only state that is read at execution time (e.g. uniform buffer
+   * contents) may change without invalidation. Callers must call
+   * invalidateCommandBuffers() whenever anything that is baked into the
+   * recorded commands changes: pipelines, descriptor sets, bound buffers,
+   * push constants, draw counts, viewports or render targets */
+  void updateCommandBuffer(const std::function<void()>& buildCommandBuffer);
+  /** @brief Makes all frames record their command buffers again, required
+   * after any change to recorded state that isn't made through the overlay's
+   * widgets (see updateCommandBuffer) */
+  void invalidateCommandBuffers();
+  /** @brief Makes on-demand rendering render the next frames, e.g. after
+   * state changed outside of input handling */
+  void requestRedraw();
 
   /** @brief (Virtual) Called when the UI overlay is updating, can be used to
    * add custom elements to the overlay */
@@ -0,0 +1,467 @@
+/*
+* CPU micro benchmarks for math and generation kernels used by the base code and the examples
+*
+* Runs each kernel at scale with warm-up and a fixed number of repetitions and reports timing statistics (optionally as JSON)
+* Doesn't create a Vulkan instance or device, so it can be run on any machine
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "frustum.hpp"
+#include "gltfanimation.hpp"
+#include "noise.hpp"
+#include "gears/gears.h"
+#include "particlesystem/particlesystem.h"
+#include "terraintessellation/terraintessellation.h"
+
+// Fixed seed so that all runs do the same work
+constexpr uint32_t benchmarkSeed = 0;
+
+struct Kernel
+{
+	std::string name;
+	// Number of work items (e.g. spheres, texels, vertices) processed per repetition
+	uint64_t items;
+	// Returns a checksum of the results so the work can't be optimized away
+	std::function<double()> run;
+};
+
+struct Statistics
+{
+	double min, max, mean, median, stddev, p95;
+};
+
+Statistics statistics(std::vector<double> times)
+{
+	Statistics stats{};
+	std::sort(times.begin(), times.end());
+	const size_t count = times.size();
+	stats.min = times.front();
+	stats.max = times.back();
+	stats.mean = std::accumulate(times.begin(), times.end(), 0.0) / count;
+	stats.median = (count % 2 == 0) ? (times[count / 2 - 1] + times[count / 2]) / 2.0 : times[count / 2];
+	double variance = 0.0;
+	for (double time : times)
+	{
+		variance += (time - stats.mean) * (time - stats.mean);
+	}
+	stats.stddev = std::sqrt(variance / count);
+	stats.p95 = times[std::min(count - 1, static_cast<size_t>(std::ceil(0.95 * count)) - 1)];
+	return stats;
+}
+
+/*
+	Kernels
+*/
+
+// vks::Frustum::checkSphere against a large set of random spheres (see multithreading and terraintessellation)
+Kernel frustumKernel()
+{
+	const size_t sphereCount = 1 << 20;
+	auto spheres = std::make_shared<std::vector<glm::vec4>>(sphereCount);
+	std::default_random_engine randomEngine(benchmarkSeed);
+	std::uniform_real_distribution<float> positionDist(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> radiusDist(0.5f, 5.0f);
+	for (auto& sphere : *spheres)
+	{
+		sphere = glm::vec4(positionDist(randomEngine), positionDist(randomEngine), positionDist(randomEngine), radiusDist(randomEngine));
+	}
+	auto frustum = std::make_shared<vks::Frustum>();
+	return { "frustum.checkSphere", sphereCount, [spheres, frustum]() {
+		const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 256.0f);
+		const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, -50.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		frustum->update(projection * view);
+		uint64_t visible = 0;
+		for (const auto& sphere : *spheres)
+		{
+			visible += frustum->checkSphere(glm::vec3(sphere), sphere.w) ? 1 : 0;
+		}
+		return static_cast<double>(visible);
+	} };
+}
+
+// Single octave perlin noise (see texture3d)
+Kernel perlinNoiseKernel()
+{
+	const uint32_t dim = 128;
+	std::default_random_engine randomEngine(benchmarkSeed);
+	auto perlinNoise = std::make_shared<vks::PerlinNoise<float>>(randomEngine);
+	return { "texture3d.perlinNoise", dim * dim * dim, [perlinNoise, dim]() {
+		double sum = 0.0;
+		for (uint32_t z = 0; z < dim; z++)
+		{
+			for (uint32_t y = 0; y < dim; y++)
+			{
+				for (uint32_t x = 0; x < dim; x++)
+				{
+					sum += perlinNoise->noise(x * 0.1f, y * 0.1f, z * 0.1f);
+				}
+			}
+		}
+		return sum;
+	} };
+}
+
+// Fractal noise volume generation as done by texture3d's updateNoiseTexture (single threaded)
+Kernel fractalNoiseKernel()
+{
+	const uint32_t dim = 64;
+	std::default_random_engine randomEngine(benchmarkSeed);
+	vks::PerlinNoise<float> perlinNoise(randomEngine);
+	auto fractalNoise = std::make_shared<vks::FractalNoise<float>>(perlinNoise);
+	auto data = std::make_shared<std::vector<uint8_t>>(dim * dim * dim);
+	return { "texture3d.fractalNoise", dim * dim * dim, [fractalNoise, data, dim]() {
+		const float noiseScale = 8.0f;
+		for (uint32_t z = 0; z < dim; z++)
+		{
+			for (uint32_t y = 0; y < dim; y++)
+			{
+				for (uint32_t x = 0; x < dim; x++)
+				{
+					float nx = (float)x / (float)dim;
+					float ny = (float)y / (float)dim;
+					float nz = (float)z / (float)dim;
+					float n = fractalNoise->noise(nx * noiseScale, ny * noiseScale, nz * noiseScale);
+					n = n - floor(n);
+					(*data)[x + y * dim + z * dim * dim] = static_cast<uint8_t>(floor(n * 255));
+				}
+			}
+		}
+		return static_cast<double>(std::accumulate(data->begin(), data->end(), uint64_t(0)));
+	} };
+}
+
+// Sobel filtered terrain normals as generated by terraintessellation, for a larger patch and a synthetic height map
+Kernel terrainNormalsKernel()
+{
+	const uint32_t dim = 4096;
+	const uint32_t patchSize = 1024;
+	const uint32_t scale = dim / patchSize;
+	auto heightdata = std::make_shared<std::vector<uint16_t>>(dim * dim);
+	for (uint32_t y = 0; y < dim; y++)
+	{
+		for (uint32_t x = 0; x < dim; x++)
+		{
+			const float height = 0.5f + 0.25f * sinf(x * 0.01f) + 0.25f * cosf(y * 0.013f);
+			(*heightdata)[x + y * dim] = static_cast<uint16_t>(height * 65535.0f);
+		}
+	}
+	auto normals = std::make_shared<std::vector<glm::vec3>>(patchSize * patchSize);
+	return { "terraintessellation.sobelNormals", patchSize * patchSize, [heightdata, normals, dim, patchSize, scale]() {
+		for (int32_t x = 0; x < static_cast<int32_t>(patchSize); x++)
+		{
+			for (int32_t y = 0; y < static_cast<int32_t>(patchSize); y++)
+			{
+				(*normals)[x + y * patchSize] = terrainNormal(heightdata->data(), dim, scale, x, y);
+			}
+		}
+		double sum = 0.0;
+		for (const auto& normal : *normals)
+		{
+			sum += normal.y;
+		}
+		return sum;
+	} };
+}
+
+// CPU particle simulation of the particlesystem example with more particles
+Kernel particlesKernel()
+{
+	const size_t particleCount = PARTICLE_COUNT * 128;
+	const uint32_t steps = 10;
+	auto randomEngine = std::make_shared<std::default_random_engine>(benchmarkSeed);
+	auto simulation = std::make_shared<ParticleSimulation>(*randomEngine);
+	simulation->init(particleCount);
+	return { "particlesystem.updateParticles", particleCount * steps, [randomEngine, simulation, steps]() {
+		for (uint32_t i = 0; i < steps; i++)
+		{
+			simulation->update(1.0f / 60.0f);
+		}
+		double sum = 0.0;
+		for (const auto& particle : simulation->particles)
+		{
+			sum += particle.alpha;
+		}
+		return sum;
+	} };
+}
+
+// Geometry generation of the gears example for a larger number of gears
+Kernel gearsKernel()
+{
+	const uint32_t gearCount = 64;
+	auto definitions = std::make_shared<std::vector<GearDefinition>>(gearCount);
+	uint64_t teeth = 0;
+	for (uint32_t i = 0; i < gearCount; i++)
+	{
+		GearDefinition& definition = (*definitions)[i];
+		definition.innerRadius = 1.0f;
+		definition.outerRadius = 4.0f;
+		definition.width = 1.0f;
+		definition.numTeeth = 20 + i;
+		definition.toothDepth = 0.7f;
+		definition.color = glm::vec3(1.0f, 0.0f, 0.0f);
+		definition.pos = glm::vec3(0.0f);
+		definition.rotSpeed = 1.0f;
+		definition.rotOffset = 0.0f;
+		teeth += definition.numTeeth;
+	}
+	auto vertices = std::make_shared<std::vector<Gear::Vertex>>();
+	auto indices = std::make_shared<std::vector<uint32_t>>();
+	return { "gears.generate", teeth, [definitions, vertices, indices]() {
+		vertices->clear();
+		indices->clear();
+		for (auto& definition : *definitions)
+		{
+			Gear gear;
+			gear.generate(definition, *vertices, *indices);
+		}
+		return static_cast<double>(vertices->size() + indices->size());
+	} };
+}
+
+// glTF node animation and joint matrix calculation as done by vkglTF::Model::updateAnimation for a synthetic skeleton
+struct BenchmarkNode
+{
+	BenchmarkNode* parent{ nullptr };
+	glm::vec3 translation{};
+	glm::vec3 scale{ 1.0f };
+	glm::quat rotation{};
+	glm::mat4 matrix{ 1.0f };
+};
+
+Kernel gltfAnimationKernel()
+{
+	// 8 chains of 8 joints each, matching the max. joint count supported by vkglTF
+	const uint32_t chainCount = 8;
+	const uint32_t chainLength = 8;
+	const uint32_t keyframeCount = 120;
+	const uint32_t steps = 100;
+	const float keyframeTime = 1.0f / 30.0f;
+
+	struct Skeleton
+	{
+		std::vector<std::unique_ptr<BenchmarkNode>> nodes;
+		std::vector<BenchmarkNode*> joints;
+		std::vector<glm::mat4> inverseBindMatrices;
+		std::vector<glm::mat4> jointMatrices;
+		vkglTF::AnimationT<BenchmarkNode> animation;
+	};
+	auto skeleton = std::make_shared<Skeleton>();
+	std::default_random_engine randomEngine(benchmarkSeed);
+	std::uniform_real_distribution<float> angleDist(-1.0f, 1.0f);
+	skeleton->nodes.push_back(std::make_unique<BenchmarkNode>());
+	BenchmarkNode* root = skeleton->nodes.back().get();
+	for (uint32_t c = 0; c < chainCount; c++)
+	{
+		BenchmarkNode* parent = root;
+		for (uint32_t j = 0; j < chainLength; j++)
+		{
+			skeleton->nodes.push_back(std::make_unique<BenchmarkNode>());
+			BenchmarkNode* joint = skeleton->nodes.back().get();
+			joint->parent = parent;
+			joint->translation = glm::vec3(0.0f, 1.0f, 0.0f);
+			skeleton->joints.push_back(joint);
+			skeleton->inverseBindMatrices.push_back(glm::inverse(vkglTF::nodeMatrix(*joint)));
+			// Each joint has an animated rotation and translation
+			vkglTF::AnimationSampler rotationSampler{ vkglTF::AnimationSampler::LINEAR };
+			vkglTF::AnimationSampler translationSampler{ vkglTF::AnimationSampler::LINEAR };
+			for (uint32_t k = 0; k < keyframeCount; k++)
+			{
+				const glm::quat rotation = glm::normalize(glm::quat(glm::vec3(angleDist(randomEngine), angleDist(randomEngine), angleDist(randomEngine))));
+				rotationSampler.inputs.push_back(k * keyframeTime);
+				rotationSampler.outputsVec4.push_back(glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w));
+				translationSampler.inputs.push_back(k * keyframeTime);
+				translationSampler.outputsVec4.push_back(glm::vec4(0.0f, 1.0f + 0.1f * angleDist(randomEngine), 0.0f, 0.0f));
+			}
+			const uint32_t samplerIndex = static_cast<uint32_t>(skeleton->animation.samplers.size());
+			skeleton->animation.samplers.push_back(rotationSampler);
+			skeleton->animation.samplers.push_back(translationSampler);
+			skeleton->animation.channels.push_back({ vkglTF::AnimationChannelT<BenchmarkNode>::ROTATION, joint, samplerIndex });
+			skeleton->animation.channels.push_back({ vkglTF::AnimationChannelT<BenchmarkNode>::TRANSLATION, joint, samplerIndex + 1 });
+			parent = joint;
+		}
+	}
+	skeleton->jointMatrices.resize(skeleton->joints.size());
+	const float duration = (keyframeCount - 1) * keyframeTime;
+	return { "vkglTF.updateAnimation", steps * skeleton->joints.size(), [skeleton, root, steps, duration]() {
+		double sum = 0.0;
+		for (uint32_t i = 0; i < steps; i++)
+		{
+			const float time = fmod(i * 0.0123f, duration);
+			vkglTF::applyAnimation(skeleton->animation, time);
+			vkglTF::nodeJointMatrices(vkglTF::nodeMatrix(*root), skeleton->joints, skeleton->inverseBindMatrices, skeleton->jointMatrices.data());
+			sum += skeleton->jointMatrices.back()[3][1];
+		}
+		return sum;
+	} };
+}
+
+/*
+	Runner
+*/
+
+struct Options
+{
+	uint32_t warmup{ 3 };
+	uint32_t repetitions{ 20 };
+	std::string output;
+	std::vector<std::string> only;
+	bool list{ false };
+};
+
+void printHelp()
+{
+	std::cout << "Usage: cpu_benchmarks [options]\n"
+		<< " --warmup <n>: Number of untimed repetitions per kernel (default 3)\n"
+		<< " --repetitions <n>: Number of timed repetitions per kernel (default 20)\n"
+		<< " --output <file>: Write results as JSON to the given file\n"
+		<< " --only <name>: Only run kernels whose name contains the given string (can be repeated)\n"
+		<< " --list: List all kernels\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool hasValue = (i + 1 < argc);
+		if ((arg == "--warmup") && hasValue)
+		{
+			options.warmup = static_cast<uint32_t>(std::max(std::atoi(argv[++i]), 0));
+		}
+		else if ((arg == "--repetitions") && hasValue)
+		{
+			options.repetitions = static_cast<uint32_t>(std::max(std::atoi(argv[++i]), 1));
+		}
+		else if ((arg == "--output") && hasValue)
+		{
+			options.output = argv[++i];
+		}
+		else if ((arg == "--only") && hasValue)
+		{
+			options.only.push_back(argv[++i]);
+		}
+		else if (arg == "--list")
+		{
+			options.list = true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printHelp();
+		return 1;
+	}
+
+	const std::vector<std::function<Kernel()>> kernelFactories = {
+		frustumKernel,
+		perlinNoiseKernel,
+		fractalNoiseKernel,
+		terrainNormalsKernel,
+		particlesKernel,
+		gearsKernel,
+		gltfAnimationKernel,
+	};
+
+	struct Result
+	{
+		Kernel kernel;
+		Statistics stats;
+		double checksum;
+	};
+	std::vector<Result> results;
+
+	std::cout << std::fixed << std::setprecision(3);
+	for (auto& kernelFactory : kernelFactories)
+	{
+		Kernel kernel = kernelFactory();
+		if (options.list)
+		{
+			std::cout << kernel.name << "\n";
+			continue;
+		}
+		if (!options.only.empty() && std::none_of(options.only.begin(), options.only.end(), [&kernel](const std::string& filter) { return kernel.name.find(filter) != std::string::npos; }))
+		{
+			continue;
+		}
+		double checksum = 0.0;
+		for (uint32_t i = 0; i < options.warmup; i++)
+		{
+			checksum += kernel.run();
+		}
+		std::vector<double> times(options.repetitions);
+		for (uint32_t i = 0; i < options.repetitions; i++)
+		{
+			auto tStart = std::chrono::high_resolution_clock::now();
+			checksum += kernel.run();
+			auto tEnd = std::chrono::high_resolution_clock::now();
+			times[i] = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+		}
+		const Statistics stats = statistics(times);
+		std::cout << std::left << std::setw(36) << kernel.name << std::right
+			<< " median " << std::setw(10) << stats.median << " ms"
+			<< "  min " << std::setw(10) << stats.min << " ms"
+			<< "  stddev " << std::setw(8) << stats.stddev << " ms"
+			<< "  " << std::setw(10) << (kernel.items / (stats.median / 1000.0)) / 1.0e6 << " M items/s\n";
+		results.push_back({ kernel, stats, checksum });
+	}
+
+	if (!options.output.empty())
+	{
+		std::ofstream result(options.output, std::ios::out);
+		if (!result.is_open())
+		{
+			std::cerr << "Could not write results to \"" << options.output << "\"\n";
+			return 1;
+		}
+		result << std::setprecision(6) << std::fixed;
+		result << "{\n  \"warmup\": " << options.warmup << ",\n  \"repetitions\": " << options.repetitions << ",\n";
+#if defined(NDEBUG)
+		result << "  \"build\": \"release\",\n";
+#else
+		result << "  \"build\": \"debug\",\n";
+#endif
+		result << "  \"kernels\": [";
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const Result& r = results[i];
+			result << (i > 0 ? "," : "") << "\n    {\"name\": \"" << r.kernel.name << "\", \"items\": " << r.kernel.items;
+			result << ", \"time\": {\"min\": " << r.stats.min << ", \"max\": " << r.stats.max << ", \"mean\": " << r.stats.mean;
+			result << ", \"median\": " << r.stats.median << ", \"stddev\": " << r.stats.stddev << ", \"p95\": " << r.stats.p95 << "}";
+			result << ", \"itemsPerSecond\": " << r.kernel.items / (r.stats.median / 1000.0) << ", \"checksum\": " << r.checksum << "}";
+		}
+		result << "\n  ]\n}\n";
+	}
+	return 0;
+}
@@ -0,0 +1,182 @@
+# Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+# This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+
+# Runs all samples in benchmark mode, collects their JSON results into a single report
+# and optionally compares that report against a stored baseline to detect regressions
+
+# Note: Needs to be run from (or pointed at with --bindir) the folder where the binary files have been compiled (e.g. build/bin)
+# For headless runs (e.g. CI with lavapipe) build with -DUSE_HEADLESS=ON and pass the lavapipe ICD via --icd
+
+# Examples:
+#   python benchmark_all.py --output report.json
+#   python benchmark_all.py --icd /usr/share/vulkan/icd.d/lvp_icd.x86_64.json --baseline baseline.json --tolerance 0.05
+#   python benchmark_all.py --only triangle gears --update-baseline baseline.json
+
+import argparse
+import glob
+import json
+import math
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+
+# Samples that can't be run unattended in benchmark mode
+SKIPPED_SAMPLES = ["computeheadless", "renderheadless"]
+
+
+def find_samples(bindir, only, exclude):
+    if platform.system() == "Windows":
+        candidates = glob.glob(os.path.join(bindir, "*.exe"))
+    else:
+        candidates = [f for f in glob.glob(os.path.join(bindir, "*")) if os.path.isfile(f) and os.access(f, os.X_OK) and not f.endswith(".py")]
+    samples = {}
+    for binary in sorted(candidates):
+        name = os.path.splitext(os.path.basename(binary))[0]
+        if name in SKIPPED_SAMPLES or name in exclude:
+            continue
+        if only and name not in only:
+            continue
+        samples[name] = binary
+    return samples
+
+
+def run_sample(name, binary, args, resultdir, env):
+    resultfile = os.path.join(resultdir, name + ".json")
+    command = [binary, "-b",
+               "-bw", str(args.warmup), "-br", str(args.runtime),
+               "-w", str(args.width), "-h", str(args.height),
+               "-bf", resultfile]
+    if args.shaders:
+        command += ["-s", args.shaders]
+    command += args.extra
+    try:
+        process = subprocess.run(command, env=env, timeout=args.timeout, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    except subprocess.TimeoutExpired:
+        return {"status": "timeout"}
+    if process.returncode != 0 or not os.path.exists(resultfile):
+        return {"status": "failed", "returncode": process.returncode, "log": process.stdout.decode(errors="replace")[-2000:]}
+    with open(resultfile) as f:
+        result = json.load(f)
+    result["status"] = "ok"
+    return result
+
+
+def welch_t_test(a, b):
+    """Two sided Welch's t-test from summary statistics, returns (t, p) using a normal approximation for the large sample counts of frame time series"""
+    (mean_a, sd_a, n_a), (mean_b, sd_b, n_b) = a, b
+    if n_a < 2 or n_b < 2:
+        return 0.0, 1.0
+    se = math.sqrt((sd_a * sd_a) / n_a + (sd_b * sd_b) / n_b)
+    if se == 0.0:
+        return (0.0, 1.0) if mean_a == mean_b else (math.copysign(math.inf, mean_b - mean_a), 0.0)
+    t = (mean_b - mean_a) / se
+    p = math.erfc(abs(t) / math.sqrt(2.0))
+    return t, p
+
+
+def summary(result):
+    frametime = result["frameTime"]
+    return frametime["mean"], frametime["stddev"], result["frames"]
+
+
+def compare(report, baseline, tolerance, alpha):
+    comparisons = {}
+    for name, result in report["results"].items():
+        reference = baseline["results"].get(name)
+        if result.get("status") != "ok" or reference is None or reference.get("status") != "ok":
+            continue
+        mean_base, mean_new = reference["frameTime"]["mean"], result["frameTime"]["mean"]
+        change = (mean_new - mean_base) / mean_base if mean_base > 0.0 else 0.0
+        t, p = welch_t_test(summary(reference), summary(result))
+        # Only treat a slowdown as a regression if it exceeds the tolerance and is statistically significant
+        regression = change > tolerance and p < alpha
+        comparisons[name] = {"baseline": mean_base, "current": mean_new, "change": change, "t": t, "p": p, "regression": regression}
+    return comparisons
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark all samples and detect performance regressions")
+    parser.add_argument("--bindir", default=".", help="Folder containing the compiled samples")
+    parser.add_argument("--warmup", type=int, default=1, help="Warm-up time per sample in seconds")
+    parser.add_argument("--runtime", type=int, default=10, help="Benchmark duration per sample in seconds")
+    parser.add_argument("--width", type=int, default=1280, help="Render width")
+    parser.add_argument("--height", type=int, default=720, help="Render height")
+    parser.add_argument("--shaders", help="Shader language to use (glsl, hlsl or slang)")
+    parser.add_argument("--timeout", type=int, default=300, help="Timeout per sample in seconds")
+    parser.add_argument("--only", nargs="*", default=[], help="Only run the given samples")
+    parser.add_argument("--exclude", nargs="*", default=[], help="Samples to skip")
+    parser.add_argument("--icd", help="Vulkan ICD json to use (e.g. lavapipe's lvp_icd json for headless CI runs)")
+    parser.add_argument("--output", default="benchmark_report.json", help="File to store the collected report in")
+    parser.add_argument("--baseline", help="Baseline report to compare against")
+    parser.add_argument("--update-baseline", help="Write the collected report to this baseline file")
+    parser.add_argument("--tolerance", type=float, default=0.05, help="Allowed relative frame time increase (0.05 = 5%%)")
+    parser.add_argument("--alpha", type=float, default=0.01, help="Significance level for the regression test")
+    parser.add_argument("--fail-on-error", action="store_true", help="Also fail if a sample could not be run")
+    parser.add_argument("extra", nargs=argparse.REMAINDER, help="Additional arguments passed to every sample (after --)")
+    args = parser.parse_args()
+    if args.extra and args.extra[0] == "--":
+        args.extra = args.extra[1:]
+
+    env = dict(os.environ)
+    if args.icd:
+        env["VK_DRIVER_FILES"] = args.icd
+        env["VK_ICD_FILENAMES"] = args.icd
+
+    samples = find_samples(args.bindir, args.only, args.exclude)
+    if not samples:
+        print("No samples found in %s" % os.path.abspath(args.bindir))
+        return 1
+
+    report = {
+        "settings": {"warmup": args.warmup, "runtime": args.runtime, "width": args.width, "height": args.height, "shaders": args.shaders or "glsl"},
+        "results": {},
+    }
+    with tempfile.TemporaryDirectory() as resultdir:
+        for index, (name, binary) in enumerate(samples.items()):
+            print("[%d/%d] %s" % (index + 1, len(samples), name), flush=True)
+            result = run_sample(name, binary, args, resultdir, env)
+            if result["status"] == "ok":
+                print("  %.3f ms/frame (%.1f fps)" % (result["frameTime"]["mean"], result["fps"]))
+            else:
+                print("  %s" % result["status"])
+            report["results"][name] = result
+
+    devices = {r["device"] for r in report["results"].values() if r.get("status") == "ok"}
+    report["device"] = ", ".join(sorted(devices))
+
+    failed = [name for name, r in report["results"].items() if r["status"] != "ok"]
+    regressions = []
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if baseline.get("settings") != report["settings"]:
+            print("Warning: baseline was recorded with different settings %s" % baseline.get("settings"))
+        report["comparison"] = compare(report, baseline, args.tolerance, args.alpha)
+        print("\n%-32s %12s %12s %9s %10s" % ("sample", "baseline ms", "current ms", "change", "p"))
+        for name, c in sorted(report["comparison"].items(), key=lambda item: -item[1]["change"]):
+            marker = "  REGRESSION" if c["regression"] else ""
+            print("%-32s %12.3f %12.3f %+8.1f%% %10.2g%s" % (name, c["baseline"], c["current"], c["change"] * 100.0, c["p"], marker))
+            if c["regression"]:
+                regressions.append(name)
+
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2)
+    if args.update_baseline:
+        with open(args.update_baseline, "w") as f:
+            json.dump(report, f, indent=2)
+
+    print("\n%d samples run, %d failed, %d regressions" % (len(samples), len(failed), len(regressions)))
+    if failed:
+        print("Failed: %s" % ", ".join(failed))
+    if regressions:
+        print("Regressions: %s" % ", ".join(regressions))
+        return 1
+    if failed and args.fail_on_error:
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
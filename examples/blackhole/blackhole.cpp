@@ -105,7 +105,8 @@ class VulkanExample : public VulkanExampleBase {
     vks::Buffer blend;
   };
 
-  std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_{};
+  std::vector<UniformBuffers> uniformBuffers_ =
+      std::vector<UniformBuffers>(framesInFlight_);
 
   struct {
     VkPipelineLayout blackhole;
@@ -131,6 +132,11 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSetLayout blend;
   } descriptorSetLayouts_{};
 
+  struct {
+    std::vector<VkDescriptorSetLayoutBinding> blackhole, brightness,
+        downsample, upsample, blend;
+  } setLayoutBindings_;
+
   struct DescriptorSets {
     VkDescriptorSet blackhole;
     VkDescriptorSet brightness;
@@ -139,7 +145,8 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSet blend;
   };
 
-  std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<DescriptorSets> descriptorSets_ =
+      std::vector<DescriptorSets>(framesInFlight_);
 
   // Framebuffer for offscreen rendering
   struct FrameBufferAttachment {
@@ -161,6 +168,10 @@ class VulkanExample : public VulkanExampleBase {
     // Holds the first offscreen framebuffer
     // used by first down sample pass
     FrameBuffer original;
+    // Full resolution copy of the part of original the blackhole has been
+    // rendered to with dynamic resolution, sampled instead of original
+    FrameBuffer upscaled;
+    VkFilter upscaleFilter{VK_FILTER_LINEAR};
     FrameBuffer brightness;
     // Holds all downsampled framebuffers
     std::array<FrameBuffer, NUM_SAMPLE_SIZES> down_samples;
@@ -308,6 +319,16 @@ class VulkanExample : public VulkanExampleBase {
     offscreenPass_.original.width = width_;
     prepareOffscreenFramebuffer(&offscreenPass_.original, FB_COLOR_FORMAT);
 
+    // With dynamic resolution, the blackhole is only rendered to a scaled part
+    // of the original framebuffer and then upscaled for the following passes
+    if (dynamicResolution_.enabled) {
+      offscreenPass_.upscaled.height = height_;
+      offscreenPass_.upscaled.width = width_;
+      prepareOffscreenFramebuffer(&offscreenPass_.upscaled, FB_COLOR_FORMAT);
+      offscreenPass_.upscaleFilter =
+          dynamicResolution_.upscaleFilter(FB_COLOR_FORMAT);
+    }
+
     // Generate framebuffer for brightness pass
     offscreenPass_.brightness.height = height_;
     offscreenPass_.brightness.width = width_;
@@ -341,9 +362,11 @@ class VulkanExample : public VulkanExampleBase {
     imageCI.arrayLayers = 1;
     imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
     imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
-    // We will sample directly from the color attachment
+    // We will sample directly from the color attachment, transfers are used to
+    // upscale with dynamic resolution
     imageCI.usage =
-        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
     VkMemoryAllocateInfo memAlloc = vks::initializers::memoryAllocateInfo();
     VkMemoryRequirements memReqs;
@@ -366,8 +389,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &frameBuf->color.mem));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &frameBuf->color.mem, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(vkBindImageMemory(device_, frameBuf->color.image,
                                       frameBuf->color.mem, 0));
 
@@ -396,135 +419,73 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   // (A.4)
-  void setupDescriptors() {
-    // Pool
-    std::vector<VkDescriptorPoolSize> poolSizes = {
-        vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            /* descriptorCount */ MAX_CONCURRENT_FRAMES * 1 * NUM_SAMPLE_SIZES),
-        vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            /* descriptorCount */ MAX_CONCURRENT_FRAMES * 2 *
-                NUM_SAMPLE_SIZES)};
-    VkDescriptorPoolCreateInfo descriptorPoolInfo =
-        vks::initializers::descriptorPoolCreateInfo(
-            poolSizes, MAX_CONCURRENT_FRAMES * 5 * NUM_SAMPLE_SIZES);
-    VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
-                                           nullptr, &descriptorPool_));
+  void setupDescriptorSetLayouts() {
+    // Bindings are kept, as they are also passed to the descriptor allocator
+    // when writing sets
+    auto uniformBinding = [](VkShaderStageFlags stages) {
+      return vks::initializers::descriptorSetLayoutBinding(
+          VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, stages, /*binding id*/ 0);
+    };
+    auto textureBinding = [](uint32_t binding) {
+      return vks::initializers::descriptorSetLayoutBinding(
+          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+          VK_SHADER_STAGE_FRAGMENT_BIT, binding);
+    };
+    const VkShaderStageFlags vertexFragment =
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
     // Layout: Blackhole
-    std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
-        // Binding 0 : Fragment shader blackhole uniform buffer
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-
-        // Binding 1 : Fragment shader cubemap
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT, /*binding id*/ 1),
-
-        // Binding 2 : Fragment shader blackhole 2D texture
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 2)};
-
-    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCI =
-        vks::initializers::descriptorSetLayoutCreateInfo(
-            setLayoutBindings.data(),
-            static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.blackhole));
-
+    // Binding 0 : blackhole uniform buffer, Binding 1 : cubemap,
+    // Binding 2 : blackhole 2D texture
+    setLayoutBindings_.blackhole = {uniformBinding(vertexFragment),
+                                    textureBinding(1), textureBinding(2)};
     // Layout: Brightness
-    setLayoutBindings = {
-        // Binding 0 : Fragment shader brightness uniform buffer
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-
-        // Binding 1 : Fragment shader blackhole 2D texture
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1)};
-
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.brightness));
-
+    // Binding 0 : brightness uniform buffer, Binding 1 : blackhole 2D texture
+    setLayoutBindings_.brightness = {uniformBinding(vertexFragment),
+                                     textureBinding(1)};
     // Layout: Downsample
-    setLayoutBindings = {
-        // Binding 0: uniform buffer
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-
-        // Binding 1: Source texture to downsample
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT, /*binding id*/ 1)};
-    descriptorSetLayoutCI =
-        vks::initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.downsample));
-
+    // Binding 1 : source texture to downsample
+    setLayoutBindings_.downsample = {
+        uniformBinding(VK_SHADER_STAGE_FRAGMENT_BIT), textureBinding(1)};
     // Layout: Upsample
-    setLayoutBindings = {
-        // Binding 0: uniform buffer
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-
-        // Binding 1: Source texture to upsample
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT, /*binding id*/ 1, 1),
-
-        // Binding 2: Source texture to upsample
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT, /*binding id*/ 2, 1)};
-    descriptorSetLayoutCI =
-        vks::initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.upsample));
+    // Binding 1 and 2 : source textures to upsample
+    setLayoutBindings_.upsample = {
+        uniformBinding(VK_SHADER_STAGE_FRAGMENT_BIT), textureBinding(1),
+        textureBinding(2)};
     // Layout: Blend
-    setLayoutBindings = {
-        // Binding 0 : uniform buffer
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-
-        // Binding 1 : up sampled texture map
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT, /*binding id*/ 1),
-
-        // Binding 2 : down sample texture map
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT, /*binding id*/ 2),
-
-        // Binding 3 : Texture map for debugging
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT, /*binding id*/ 3)};
-
-    descriptorSetLayoutCI =
-        vks::initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
-    VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI,
-                                                nullptr,
-                                                &descriptorSetLayouts_.blend));
+    // Binding 1 : up sampled texture map, Binding 2 : down sample texture map,
+    // Binding 3 : texture map for debugging
+    setLayoutBindings_.blend = {uniformBinding(VK_SHADER_STAGE_FRAGMENT_BIT),
+                                textureBinding(1), textureBinding(2),
+                                textureBinding(3)};
+
+    auto createLayout =
+        [this](const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+               VkDescriptorSetLayout& layout) {
+          VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCI =
+              vks::initializers::descriptorSetLayoutCreateInfo(bindings);
+          VK_CHECK_RESULT(vkCreateDescriptorSetLayout(
+              device_, &descriptorSetLayoutCI, nullptr, &layout));
+        };
+    createLayout(setLayoutBindings_.blackhole, descriptorSetLayouts_.blackhole);
+    createLayout(setLayoutBindings_.brightness,
+                 descriptorSetLayouts_.brightness);
+    createLayout(setLayoutBindings_.downsample,
+                 descriptorSetLayouts_.downsample);
+    createLayout(setLayoutBindings_.upsample, descriptorSetLayouts_.upsample);
+    createLayout(setLayoutBindings_.blend, descriptorSetLayouts_.blend);
+  }
+
+  void setupDescriptors() {
+    // Sets are allocated from the base descriptor allocator, which adds pools
+    // as needed instead of relying on hand counted pool sizes. The layouts
+    // don't depend on the window size, so only the sets are recreated on
+    // resize
+
+    // Full resolution blackhole image read by the brightness and blend passes
+    VkDescriptorImageInfo sceneDescriptor =
+        dynamicResolution_.enabled ? offscreenPass_.upscaled.descriptor
+                                   : offscreenPass_.original.descriptor;
 
     // Image descriptor for the blackhole color texture
     VkDescriptorImageInfo accretionDiskTextureMap =
@@ -532,139 +493,69 @@ class VulkanExample : public VulkanExampleBase {
             accretionDiskTextureMap_.sampler, accretionDiskTextureMap_.view,
             accretionDiskTextureMap_.imageLayout);
 
+    // Descriptors are passed in binding order and written with the
+    // allocator's cached update template for the layout
+    auto allocateSet =
+        [this](VkDescriptorSetLayout layout,
+               const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+               const std::vector<vks::DescriptorInfo>& descriptors) {
+          VkDescriptorSet descriptorSet;
+          VK_CHECK_RESULT(
+              descriptorAllocator_.allocate(layout, bindings, &descriptorSet));
+          descriptorAllocator_.update(descriptorSet, layout, bindings,
+                                      descriptors);
+          return descriptorSet;
+        };
+
     for (auto i = 0; i < uniformBuffers_.size(); i++) {
       // Descriptor for blackhole
-      VkDescriptorSetAllocateInfo allocInfo =
-          vks::initializers::descriptorSetAllocateInfo(
-              descriptorPool_, &descriptorSetLayouts_.blackhole, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].blackhole));
-      std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].blackhole, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].blackhole.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].blackhole,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, /*binding id*/ 1,
-              &cubeMap_.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].blackhole,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, /*binding id*/ 2,
-              &accretionDiskTextureMap),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
+      descriptorSets_[i].blackhole = allocateSet(
+          descriptorSetLayouts_.blackhole, setLayoutBindings_.blackhole,
+          {uniformBuffers_[i].blackhole.descriptor, cubeMap_.descriptor,
+           accretionDiskTextureMap});
 
       // Descriptor for brightness pass
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.brightness, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].brightness));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].brightness, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].brightness.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].brightness,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, /*binding id*/ 1,
-              &offscreenPass_.original.descriptor)};
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
+      descriptorSets_[i].brightness = allocateSet(
+          descriptorSetLayouts_.brightness, setLayoutBindings_.brightness,
+          {uniformBuffers_[i].brightness.descriptor, sceneDescriptor});
 
       // Descriptor for downsample
       for (int sample_level = 0; sample_level < NUM_SAMPLE_SIZES;
            sample_level++) {
-        allocInfo = vks::initializers::descriptorSetAllocateInfo(
-            descriptorPool_, &descriptorSetLayouts_.downsample, 1);
-        VK_CHECK_RESULT(vkAllocateDescriptorSets(
-            device_, &allocInfo,
-            &descriptorSets_[i].downsamples[sample_level]));
-        writeDescriptorSets = {
-            vks::initializers::writeDescriptorSet(
-                descriptorSets_[i].downsamples[sample_level],
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                /*binding id*/ 0,
-                &uniformBuffers_[i].downsample[sample_level].descriptor),
-            vks::initializers::writeDescriptorSet(
-                descriptorSets_[i].downsamples[sample_level],
-                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, /*binding id*/ 1,
-                sample_level == 0
-                    ? &offscreenPass_.brightness.descriptor
-                    : &offscreenPass_.down_samples[sample_level - 1]
-                           .descriptor)};
-        vkUpdateDescriptorSets(
-            device_, static_cast<uint32_t>(writeDescriptorSets.size()),
-            writeDescriptorSets.data(), 0, nullptr);
+        descriptorSets_[i].downsamples[sample_level] = allocateSet(
+            descriptorSetLayouts_.downsample, setLayoutBindings_.downsample,
+            {uniformBuffers_[i].downsample[sample_level].descriptor,
+             sample_level == 0
+                 ? offscreenPass_.brightness.descriptor
+                 : offscreenPass_.down_samples[sample_level - 1].descriptor});
       }
 
       // Descriptor for upsample
       for (int sample_level = NUM_SAMPLE_SIZES - 1; sample_level >= 0;
            sample_level--) {
-        allocInfo = vks::initializers::descriptorSetAllocateInfo(
-            descriptorPool_, &descriptorSetLayouts_.upsample, 1);
-        VK_CHECK_RESULT(vkAllocateDescriptorSets(
-            device_, &allocInfo, &descriptorSets_[i].upsamples[sample_level]));
-        writeDescriptorSets = {
-            vks::initializers::writeDescriptorSet(
-                descriptorSets_[i].upsamples[sample_level],
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                /*binding id*/ 0,
-                &uniformBuffers_[i].upsample[sample_level].descriptor),
-
-            vks::initializers::writeDescriptorSet(
-                descriptorSets_[i].upsamples[sample_level],
-                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, /*binding id*/ 1,
-                sample_level == NUM_SAMPLE_SIZES - 1
-                    ? &offscreenPass_.down_samples[sample_level].descriptor
-                    : &offscreenPass_.up_samples[sample_level + 1].descriptor),
-
-            vks::initializers::writeDescriptorSet(
-                descriptorSets_[i].upsamples[sample_level],
-                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, /*binding id*/ 2,
-                sample_level == 0
-                    ? &offscreenPass_.brightness.descriptor
-                    : &offscreenPass_.down_samples[sample_level - 1]
-                           .descriptor),
-        };
-        vkUpdateDescriptorSets(
-            device_, static_cast<uint32_t>(writeDescriptorSets.size()),
-            writeDescriptorSets.data(), 0, nullptr);
+        descriptorSets_[i].upsamples[sample_level] = allocateSet(
+            descriptorSetLayouts_.upsample, setLayoutBindings_.upsample,
+            {uniformBuffers_[i].upsample[sample_level].descriptor,
+             sample_level == NUM_SAMPLE_SIZES - 1
+                 ? offscreenPass_.down_samples[sample_level].descriptor
+                 : offscreenPass_.up_samples[sample_level + 1].descriptor,
+             sample_level == 0
+                 ? offscreenPass_.brightness.descriptor
+                 : offscreenPass_.down_samples[sample_level - 1].descriptor});
       }
 
-      // Descriptor for blend
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.blend, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].blend));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].blend, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].blend.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].blend,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &offscreenPass_.original.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].blend,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 2, &offscreenPass_.up_samples[0].descriptor),
-          /*this descriptor is a texture for debugging only*/
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].blend,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 3,
-              &offscreenPass_.down_samples[DEBUG_IDX].descriptor)};
-
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
+      // Descriptor for blend, binding 3 is a texture for debugging only
+      descriptorSets_[i].blend = allocateSet(
+          descriptorSetLayouts_.blend, setLayoutBindings_.blend,
+          {uniformBuffers_[i].blend.descriptor, sceneDescriptor,
+           offscreenPass_.up_samples[0].descriptor,
+           offscreenPass_.down_samples[DEBUG_IDX].descriptor});
     }
   }
 
   // (A.5)
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     VkPipelineLayoutCreateInfo pipelineLayoutCI =
         vks::initializers::pipelineLayoutCreateInfo(
@@ -714,6 +605,9 @@ class VulkanExample : public VulkanExampleBase {
     VkPipelineDynamicStateCreateInfo dynamicState =
         vks::initializers::pipelineDynamicStateCreateInfo(dynamicStateEnables);
     std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages;
+    // Pipelines are queued and then created in parallel, the builder copies
+    // the create info and its state so it can be modified after each add
+    vks::PipelineBuilder pipelineBuilder;
 
     VkGraphicsPipelineCreateInfo pipelineCI =
         vks::initializers::pipelineCreateInfo(pipelineLayouts_.blend,
@@ -738,8 +632,7 @@ class VulkanExample : public VulkanExampleBase {
                                  VK_SHADER_STAGE_VERTEX_BIT);
     shaderStages[1] = loadShader(getShadersPath() + "blackhole/blend.frag.spv",
                                  VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(
-        device_, pipelineCache_, 1, &pipelineCI, nullptr, &pipelines_.blend));
+    pipelineBuilder.add(pipelineCI, &pipelines_.blend);
 
     // Blackhole pipeline
     pipelineCI.layout = pipelineLayouts_.blackhole;
@@ -748,9 +641,7 @@ class VulkanExample : public VulkanExampleBase {
         loadShader(getShadersPath() + "blackhole/blackhole.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
     rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.blackhole));
+    pipelineBuilder.add(pipelineCI, &pipelines_.blackhole);
     // Brightness pipeline
     pipelineCI.layout = pipelineLayouts_.brightness;
     pipelineCI.renderPass = offscreenPass_.renderPass;
@@ -758,9 +649,7 @@ class VulkanExample : public VulkanExampleBase {
         loadShader(getShadersPath() + "blackhole/brightness.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
     rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.brightness));
+    pipelineBuilder.add(pipelineCI, &pipelines_.brightness);
 
     // Downsample pipeline
     pipelineCI.layout = pipelineLayouts_.downsample;
@@ -769,9 +658,7 @@ class VulkanExample : public VulkanExampleBase {
         loadShader(getShadersPath() + "blackhole/downsample.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
     rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.downsample));
+    pipelineBuilder.add(pipelineCI, &pipelines_.downsample);
 
     // Upsample pipeline
     pipelineCI.layout = pipelineLayouts_.upsample;
@@ -791,9 +678,9 @@ class VulkanExample : public VulkanExampleBase {
         loadShader(getShadersPath() + "blackhole/upsample.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
     rasterizationState.cullMode = VK_CULL_MODE_BACK_BIT;
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.upsample));
+    pipelineBuilder.add(pipelineCI, &pipelines_.upsample);
+
+    pipelineBuilder.build(device_, pipelineCache_, settings_.pipelineThreads);
   }
 
   // (B) Called in VulkanExampleBase::renderLoop()
@@ -808,14 +695,21 @@ class VulkanExample : public VulkanExampleBase {
 
   // (B.1)
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     ubos_.blackhole.cameraView = camera_.matrices_.view;
     ubos_.blackhole.cameraPos = camera_.position_;
     ubos_.blackhole.time =
-        std::chrono::duration<float>(
-            std::chrono::high_resolution_clock::now().time_since_epoch())
-            .count();
-    ubos_.blackhole.resolution = glm::vec2(offscreenPass_.original.width,
-                                           offscreenPass_.original.height);
+        settings_.deterministic
+            ? (float)elapsedTime_
+            : std::chrono::duration<float>(
+                  std::chrono::high_resolution_clock::now().time_since_epoch())
+                  .count();
+    // The shader maps fragment coordinates by this resolution, so with dynamic
+    // resolution the whole view ends up in the scaled part of the framebuffer
+    const VkExtent2D blackholeExtent = dynamicResolution_.scaledExtent(
+        offscreenPass_.original.width, offscreenPass_.original.height);
+    ubos_.blackhole.resolution =
+        glm::vec2(blackholeExtent.width, blackholeExtent.height);
     ubos_.blackhole.showBlackhole = showBlackholeUI;
     ubos_.blackhole.gravatationalLensingEnabled = gravatationalLensingEnabled;
     ubos_.blackhole.accDiskEnabled = accDiskEnabled;
@@ -836,15 +730,29 @@ class VulkanExample : public VulkanExampleBase {
 
   // (B.2)
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
         vks::initializers::commandBufferBeginInfo();
     VK_CHECK_RESULT(vkBeginCommandBuffer(cmdBuffer, &cmdBufInfo));
+    dynamicResolution_.beginTiming(cmdBuffer, currentBuffer_);
 
     // Blackhole
     blackholeCmdBuffer(cmdBuffer);
 
+    // Upscale the blackhole to full resolution for bloom and blending
+    if (dynamicResolution_.enabled) {
+      const FrameBuffer& src = offscreenPass_.original;
+      const FrameBuffer& dst = offscreenPass_.upscaled;
+      dynamicResolution_.upscale(
+          cmdBuffer, src.color.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+          dynamicResolution_.scaledExtent(src.width, src.height),
+          dst.color.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+          {static_cast<uint32_t>(dst.width), static_cast<uint32_t>(dst.height)},
+          offscreenPass_.upscaleFilter);
+    }
+
     // Brightness
     brightnessCmdBuffer(cmdBuffer);
 
@@ -857,6 +765,7 @@ class VulkanExample : public VulkanExampleBase {
     // Blend
     blendCmdBuffer(cmdBuffer);
 
+    dynamicResolution_.endTiming(cmdBuffer, currentBuffer_);
     VK_CHECK_RESULT(vkEndCommandBuffer(cmdBuffer));
   }
 
@@ -871,9 +780,11 @@ class VulkanExample : public VulkanExampleBase {
     renderPassBeginInfo.renderPass = offscreenPass_.renderPass;
 
     const VulkanExample::FrameBuffer& fb = offscreenPass_.original;
+    // Only the scaled part of the framebuffer is rendered to
+    const VkExtent2D extent =
+        dynamicResolution_.scaledExtent(fb.width, fb.height);
     renderPassBeginInfo.framebuffer = fb.framebuffer;
-    renderPassBeginInfo.renderArea.extent.width = fb.width;
-    renderPassBeginInfo.renderArea.extent.height = fb.height;
+    renderPassBeginInfo.renderArea.extent = extent;
     renderPassBeginInfo.clearValueCount = 1;
     renderPassBeginInfo.pClearValues = &clearValues;
 
@@ -881,10 +792,11 @@ class VulkanExample : public VulkanExampleBase {
                          VK_SUBPASS_CONTENTS_INLINE);
 
     VkViewport viewport = vks::initializers::viewport(
-        (float)fb.width, (float)fb.height, 0.0f, 1.0f);
+        (float)extent.width, (float)extent.height, 0.0f, 1.0f);
     vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
 
-    VkRect2D scissor = vks::initializers::rect2D(fb.width, fb.height, 0, 0);
+    VkRect2D scissor =
+        vks::initializers::rect2D(extent.width, extent.height, 0, 0);
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
     vkCmdBindDescriptorSets(
@@ -1182,8 +1094,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAllocInfo, nullptr, &stagingMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &stagingMemory, vks::MemoryTag::Staging));
     VK_CHECK_RESULT(
         vkBindBufferMemory(device_, stagingBuffer, stagingMemory, 0));
 
@@ -1238,8 +1150,9 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.allocationSize = memReqs.size;
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr,
-                                     &accretionDiskTextureMap_.deviceMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &accretionDiskTextureMap_.deviceMemory,
+        vks::MemoryTag::Textures));
     VK_CHECK_RESULT(vkBindImageMemory(device_, accretionDiskTextureMap_.image,
                                       accretionDiskTextureMap_.deviceMemory,
                                       0));
@@ -1311,7 +1224,7 @@ class VulkanExample : public VulkanExampleBase {
     vulkanDevice_->flushCommandBuffer(copyCmd, queue_, true);
 
     // Clean up staging resources
-    vkFreeMemory(device_, stagingMemory, nullptr);
+    vulkanDevice_->freeMemory(stagingMemory);
     vkDestroyBuffer(device_, stagingBuffer, nullptr);
     ktxTexture_Destroy(ktxTexture);
 
@@ -1381,7 +1294,20 @@ class VulkanExample : public VulkanExampleBase {
     }
   }
 
+  void destroyUpscaledFramebuffer() {
+    FrameBuffer& upscaled = offscreenPass_.upscaled;
+    if (upscaled.color.image == VK_NULL_HANDLE) {
+      return;
+    }
+    vkDestroyFramebuffer(device_, upscaled.framebuffer, nullptr);
+    vkDestroyImageView(device_, upscaled.color.view, nullptr);
+    vkDestroyImage(device_, upscaled.color.image, nullptr);
+    vulkanDevice_->freeMemory(upscaled.color.mem);
+    upscaled = {};
+  }
+
   void destroyOffscreenPass() {
+    destroyUpscaledFramebuffer();
     vkDestroyRenderPass(device_, offscreenPass_.renderPass, nullptr);
     vkDestroyFramebuffer(device_, offscreenPass_.original.framebuffer, nullptr);
     vkDestroyFramebuffer(device_, offscreenPass_.brightness.framebuffer,
@@ -1394,7 +1320,7 @@ class VulkanExample : public VulkanExampleBase {
   void windowResized() override {
     destroyOffscreenPass();
     prepareOffscreen();
-    vkResetDescriptorPool(device_, descriptorPool_, 0);
+    descriptorAllocator_.reset();
     setupDescriptors();
     resized_ = false;
   }
@@ -1414,6 +1340,7 @@ class VulkanExample : public VulkanExampleBase {
     loadAssets();
     prepareUniformBuffers();
     prepareOffscreen();
+    setupDescriptorSetLayouts();
     setupDescriptors();
     preparePipelines();
     prepared_ = true;
@@ -1421,6 +1348,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // (A.1)
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     // Cubemap texture
     cubeMap_.loadFromFile(
         getAssetPath() + "textures/blackhole/skybox/cubemap.ktx",
@@ -1431,37 +1359,36 @@ class VulkanExample : public VulkanExampleBase {
 
   ~VulkanExample() {
     if (device_) {
-      vkDestroyImageView(device_, cubeMap_.view, nullptr);
-      vkDestroyImage(device_, cubeMap_.image, nullptr);
-      vkDestroySampler(device_, cubeMap_.sampler, nullptr);
-      vkFreeMemory(device_, cubeMap_.deviceMemory, nullptr);
+      cubeMap_.destroy();
       vkDestroyPipeline(device_, pipelines_.blackhole, nullptr);
       vkDestroyPipeline(device_, pipelines_.blend, nullptr);
       vkDestroyPipelineLayout(device_, pipelineLayouts_.blackhole, nullptr);
       vkDestroyPipelineLayout(device_, pipelineLayouts_.blend, nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.blackhole,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.downsample,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.upsample,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.blend,
-                                   nullptr);
+      for (VkDescriptorSetLayout layout :
+           {descriptorSetLayouts_.blackhole, descriptorSetLayouts_.brightness,
+            descriptorSetLayouts_.downsample, descriptorSetLayouts_.upsample,
+            descriptorSetLayouts_.blend}) {
+        // The base descriptor allocator outlives the example, so drop its
+        // update templates for the layout first
+        descriptorAllocator_.forget(layout);
+        vkDestroyDescriptorSetLayout(device_, layout, nullptr);
+      }
       vkDestroyImageView(device_, offscreenPass_.original.color.view, nullptr);
       vkDestroyImage(device_, offscreenPass_.original.color.image, nullptr);
-      vkFreeMemory(device_, offscreenPass_.original.color.mem, nullptr);
+      vulkanDevice_->freeMemory(offscreenPass_.original.color.mem);
       vkDestroyFramebuffer(device_, offscreenPass_.original.framebuffer,
                            nullptr);
+      destroyUpscaledFramebuffer();
       vkDestroyImageView(device_, offscreenPass_.brightness.color.view,
                          nullptr);
       vkDestroyImage(device_, offscreenPass_.brightness.color.image, nullptr);
-      vkFreeMemory(device_, offscreenPass_.brightness.color.mem, nullptr);
+      vulkanDevice_->freeMemory(offscreenPass_.brightness.color.mem);
       vkDestroyFramebuffer(device_, offscreenPass_.brightness.framebuffer,
                            nullptr);
       for (auto& sample : offscreenPass_.down_samples) {
         vkDestroyImageView(device_, sample.color.view, nullptr);
         vkDestroyImage(device_, sample.color.image, nullptr);
-        vkFreeMemory(device_, sample.color.mem, nullptr);
+        vulkanDevice_->freeMemory(sample.color.mem);
         vkDestroyFramebuffer(device_, sample.framebuffer, nullptr);
       }
       for (auto& buffer : uniformBuffers_) {
@@ -48,7 +48,8 @@ class VulkanExample : public VulkanExampleBase {
     vks::Buffer skyBox;
     vks::Buffer blurParams;
   };
-  std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_{};
+  std::vector<UniformBuffers> uniformBuffers_ =
+      std::vector<UniformBuffers>(framesInFlight_);
 
   struct {
     VkPipelineLayout blur;
@@ -74,7 +75,8 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSet scene;
     VkDescriptorSet skyBox;
   };
-  std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<DescriptorSets> descriptorSets_ =
+      std::vector<DescriptorSets>(framesInFlight_);
 
   // Framebuffer for offscreen rendering
   struct FrameBufferAttachment {
@@ -117,6 +119,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // (A.1)
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     const uint32_t glTFLoadingFlags =
         vkglTF::FileLoadingFlags::PreTransformVertices |
         vkglTF::FileLoadingFlags::PreMultiplyVertexColors |
@@ -319,8 +322,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &frameBuf->color.mem));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &frameBuf->color.mem, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(vkBindImageMemory(device_, frameBuf->color.image,
                                       frameBuf->color.mem, 0));
 
@@ -354,8 +357,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &frameBuf->depth.mem));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &frameBuf->depth.mem, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(vkBindImageMemory(device_, frameBuf->depth.image,
                                       frameBuf->depth.mem, 0));
 
@@ -388,13 +391,13 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES * 8),
+                                              framesInFlight_ * 8),
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            MAX_CONCURRENT_FRAMES * 6)};
+            framesInFlight_ * 6)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES * 4);
+                                                    framesInFlight_ * 4);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -509,6 +512,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // (A.6)
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layouts
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayouts_.blur,
@@ -653,6 +657,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // (B.1)
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     // UFO
     ubos_.scene.projection = camera_.matrices_.perspective;
     ubos_.scene.view = camera_.matrices_.view;
@@ -684,6 +689,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // (B.2)
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBufferBeginInfo cmdBufInfo =
         vks::initializers::commandBufferBeginInfo();
 
@@ -843,10 +849,10 @@ class VulkanExample : public VulkanExampleBase {
       for (auto& framebuffer : offscreenPass_.framebuffers) {
         vkDestroyImageView(device_, framebuffer.color.view, nullptr);
         vkDestroyImage(device_, framebuffer.color.image, nullptr);
-        vkFreeMemory(device_, framebuffer.color.mem, nullptr);
+        vulkanDevice_->freeMemory(framebuffer.color.mem);
         vkDestroyImageView(device_, framebuffer.depth.view, nullptr);
         vkDestroyImage(device_, framebuffer.depth.image, nullptr);
-        vkFreeMemory(device_, framebuffer.depth.mem, nullptr);
+        vulkanDevice_->freeMemory(framebuffer.depth.mem);
         vkDestroyFramebuffer(device_, framebuffer.framebuffer, nullptr);
       }
       vkDestroyRenderPass(device_, offscreenPass_.renderPass, nullptr);
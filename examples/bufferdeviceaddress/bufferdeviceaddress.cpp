@@ -22,8 +22,8 @@ class VulkanExample : public VulkanExampleBase {
   struct Cube {
     glm::mat4 modelMatrix;
     glm::vec3 rotation;
-    std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> buffers{};
-    std::array<VkDeviceAddress, MAX_CONCURRENT_FRAMES> bufferDeviceAddresses{};
+    std::vector<vks::Buffer> buffers;
+    std::vector<VkDeviceAddress> bufferDeviceAddresses;
   };
   std::array<Cube, 2> cubes{};
 
@@ -33,8 +33,8 @@ class VulkanExample : public VulkanExampleBase {
   // Global matrices
   struct Scene {
     glm::mat4 mvp;
-    std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> buffers;
-    std::array<VkDeviceAddress, MAX_CONCURRENT_FRAMES> bufferDeviceAddresses{};
+    std::vector<vks::Buffer> buffers;
+    std::vector<VkDeviceAddress> bufferDeviceAddresses;
   } scene;
 
   VkPipeline pipeline{VK_NULL_HANDLE};
@@ -101,6 +101,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     const uint32_t glTFLoadingFlags =
         vkglTF::FileLoadingFlags::PreTransformVertices |
         vkglTF::FileLoadingFlags::PreMultiplyVertexColors |
@@ -151,6 +152,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // The buffer addresses will be passed to the shader using push constants
     // That way it's very easy to do a draw call, change the reference to
     // another buffer (or part of that buffer) and do the next draw call using
@@ -221,7 +223,13 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void prepareUniformBuffers() {
-    for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    scene.buffers.resize(framesInFlight_);
+    scene.bufferDeviceAddresses.resize(framesInFlight_);
+    for (auto& cube : cubes) {
+      cube.buffers.resize(framesInFlight_);
+      cube.bufferDeviceAddresses.resize(framesInFlight_);
+    }
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       // Note that we don't use this buffer for uniforms but rather pass it's
       // address as a reference to the shader, so isntead of the uniform buffer
       // usage we use a different flag
@@ -262,6 +270,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     scene.mvp = camera_.matrices_.perspective * camera_.matrices_.view;
     memcpy(scene.buffers[currentBuffer_].mapped, &scene, sizeof(glm::mat4));
 
@@ -303,6 +312,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -374,10 +384,10 @@ class VulkanExample : public VulkanExampleBase {
       return;
     VulkanExampleBase::prepareFrame();
     if (animate && !paused) {
-      cubes[0].rotation.x += 2.5f * frameTimer;
+      cubes[0].rotation.x += 2.5f * animationStep_;
       if (cubes[0].rotation.x > 360.0f)
         cubes[0].rotation.x -= 360.0f;
-      cubes[1].rotation.y += 2.0f * frameTimer;
+      cubes[1].rotation.y += 2.0f * animationStep_;
       if (cubes[1].rotation.x > 360.0f)
         cubes[1].rotation.x -= 360.0f;
     }
@@ -53,7 +53,7 @@ public:
 	// Resources for the graphics part of the example
 	struct Graphics {
 		VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{};
+		std::vector<VkDescriptorSet> descriptorSets;
 		VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 		struct Pipelines {
 			VkPipeline cloth{ VK_NULL_HANDLE };
@@ -66,7 +66,7 @@ public:
 			glm::mat4 view;
 			glm::vec4 lightPos{ -2.0f, 4.0f, -2.0f, 1.0f };
 		} uniformData;
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
+		std::vector<vks::Buffer> uniformBuffers;
 	} graphics;
 
 	// Resources for the compute part of the example
@@ -76,13 +76,14 @@ public:
 			VkSemaphore ready{ VK_NULL_HANDLE };
 			VkSemaphore complete{ VK_NULL_HANDLE };
 		};
-		std::array<ComputeSemaphores, MAX_CONCURRENT_FRAMES> semaphores{};
-		std::array<VkFence, MAX_CONCURRENT_FRAMES> fences{};
+		std::vector<ComputeSemaphores> semaphores;
+		std::vector<VkFence> fences;
 		VkQueue queue{ VK_NULL_HANDLE };
 		VkCommandPool commandPool{ VK_NULL_HANDLE };
-		std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers{};
+		std::vector<VkCommandBuffer> commandBuffers;
 		VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{ VK_NULL_HANDLE };
+		// Two sets with input and output buffers switched, not per frame in flight
+		std::array<VkDescriptorSet, 2> descriptorSets{ VK_NULL_HANDLE };
 		VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 		VkPipeline pipeline{ VK_NULL_HANDLE };
 		struct UniformData {
@@ -157,6 +158,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		modelSphere.loadFromFile(getAssetPath() + "models/sphere.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		textureCloth.loadFromFile(getAssetPath() + "textures/vulkan_cloth_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
@@ -346,17 +348,19 @@ public:
 	{
 		// This is shared between graphics and compute
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 3),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES * 4),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 2)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 3),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_ * 4),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 2)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 3);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 3);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 	}
 
 	// Prepare the resources used for the graphics part of the sample
 	void prepareGraphics()
 	{
+		graphics.uniformBuffers.resize(framesInFlight_);
+		graphics.descriptorSets.resize(framesInFlight_);
 		// Uniform buffers for passing data to the vertex shader
 		for (auto& buffer : graphics.uniformBuffers) {
 			vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, sizeof(Graphics::UniformData));
@@ -455,6 +459,10 @@ public:
 		// Create a compute capable device queue
 		vkGetDeviceQueue(device_, vulkanDevice_->queueFamilyIndices.compute, 0, &compute.queue);
 
+		compute.semaphores.resize(framesInFlight_);
+		compute.fences.resize(framesInFlight_);
+		compute.commandBuffers.resize(framesInFlight_);
+
 		// Uniform buffer for passing data to the compute shader
 		vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &compute.uniformBuffer, sizeof(Compute::UniformData));
 		VK_CHECK_RESULT(compute.uniformBuffer.map());
@@ -535,21 +543,21 @@ public:
 		// Signal first used ready semaphore
 		VkSubmitInfo computeSubmitInfo = vks::initializers::submitInfo();
 		computeSubmitInfo.signalSemaphoreCount = 1;
-		computeSubmitInfo.pSignalSemaphores = &compute.semaphores[MAX_CONCURRENT_FRAMES - 1].ready;
+		computeSubmitInfo.pSignalSemaphores = &compute.semaphores[framesInFlight_ - 1].ready;
 		VK_CHECK_RESULT(vkQueueSubmit(compute.queue, 1, &computeSubmitInfo, VK_NULL_HANDLE));
 	}
 
 	void updateComputeUBO()
 	{
 		if (!paused) {
-			// SRS - Clamp frameTimer to max 20ms refresh period (e.g. if blocked on resize), otherwise image breakup can occur
-			compute.uniformData.deltaT = fmin(frameTimer, 0.02f) * 0.0025f;
+			// SRS - Clamp the animation step to max 20ms refresh period (e.g. if blocked on resize), otherwise image breakup can occur
+			compute.uniformData.deltaT = fmin(animationStep_, 0.02f) * 0.0025f;
 
 			if (simulateWind) {
-				std::default_random_engine rndEngine(benchmark.active ? 0 : (unsigned)time(nullptr));
+				// The base engine is seeded once at startup, so wind is reproducible in benchmark and deterministic mode
 				std::uniform_real_distribution<float> rd(1.0f, 12.0f);
-				compute.uniformData.gravity.x = cos(glm::radians(-timer * 360.0f)) * (rd(rndEngine) - rd(rndEngine));
-				compute.uniformData.gravity.z = sin(glm::radians(timer * 360.0f)) * (rd(rndEngine) - rd(rndEngine));
+				compute.uniformData.gravity.x = cos(glm::radians(-timer * 360.0f)) * (rd(randomEngine_) - rd(randomEngine_));
+				compute.uniformData.gravity.z = sin(glm::radians(timer * 360.0f)) * (rd(randomEngine_) - rd(randomEngine_));
 			} else {
 				compute.uniformData.gravity.x = 0.0f;
 				compute.uniformData.gravity.z = 0.0f;
@@ -692,7 +700,7 @@ public:
 			VkPipelineStageFlags waitDstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 			VkSubmitInfo submitInfo = vks::initializers::submitInfo();
 			submitInfo.waitSemaphoreCount = 1;
-			submitInfo.pWaitSemaphores = &compute.semaphores[((int)currentBuffer_ - 1) % MAX_CONCURRENT_FRAMES].ready;
+			submitInfo.pWaitSemaphores = &compute.semaphores[(currentBuffer_ + framesInFlight_ - 1) % framesInFlight_].ready;
 			submitInfo.pWaitDstStageMask = &waitDstStageMask;
 			submitInfo.signalSemaphoreCount = 1;
 			submitInfo.pSignalSemaphores = &compute.semaphores[currentBuffer_].complete;
@@ -707,6 +715,7 @@ public:
 			VK_CHECK_RESULT(vkResetFences(device_, 1, &waitFences_[currentBuffer_]));
 
 			VulkanExampleBase::prepareFrame(false);
+			VulkanExampleBase::frameSlotAvailable();
 
 			updateGraphicsUBO();
 			buildGraphicsCommandBuffer();
@@ -38,8 +38,8 @@ public:
 	// Contains the instanced data
 	vks::Buffer instanceBuffer;
 	// Contains the indirect drawing commands
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> indirectCommandsBuffers;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> indirectDrawCountBuffers;
+	std::vector<vks::Buffer> indirectCommandsBuffers = std::vector<vks::Buffer>(framesInFlight_);
+	std::vector<vks::Buffer> indirectDrawCountBuffers = std::vector<vks::Buffer>(framesInFlight_);
 
 	// Indirect draw statistics (updated via compute)
 	struct {
@@ -56,28 +56,27 @@ public:
 		glm::vec4 cameraPos;
 		glm::vec4 frustumPlanes[6];
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkPipeline pipeline{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	// Resources for the compute part of the example
 	struct Compute {
 		vks::Buffer lodLevelsBuffers;										// Contains index start and counts for the different lod levels
 		VkQueue queue;														// Separate queue for compute commands (queue family may differ from the one used for graphics)
 		VkCommandPool commandPool;											// Use a separate command pool (queue family may differ from the one used for graphics)
-		std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers;	// Command buffer storing the dispatch commands and barriers
-		std::array<VkFence, MAX_CONCURRENT_FRAMES> fences;					// Synchronization fence to avoid rewriting compute CB if still in use
+		std::vector<VkCommandBuffer> commandBuffers;						// Command buffer storing the dispatch commands and barriers
+		std::vector<VkFence> fences;										// Synchronization fence to avoid rewriting compute CB if still in use
 		struct ComputeSemaphores {
 			VkSemaphore ready{ VK_NULL_HANDLE };
 			VkSemaphore complete{ VK_NULL_HANDLE };
 		};
-		std::array<ComputeSemaphores, MAX_CONCURRENT_FRAMES> semaphores{};	// Used as a wait semaphore for graphics submission
-		//std::array<VkSemaphore, MAX_CONCURRENT_FRAMES> semaphores;			// Used as a wait semaphore for graphics submission
+		std::vector<ComputeSemaphores> semaphores;							// Used as a wait semaphore for graphics submission
 		VkDescriptorSetLayout descriptorSetLayout;							// Compute shader binding layout
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{};	// Compute shader bindings
+		std::vector<VkDescriptorSet> descriptorSets;						// Compute shader bindings
 		VkPipelineLayout pipelineLayout;									// Layout of the compute pipeline
 		VkPipeline pipeline;												// Compute pipeline
 	} compute{};
@@ -141,6 +140,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		lodModel.loadFromFile(getAssetPath() + "models/suzanne_lods.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 	}
@@ -149,10 +149,10 @@ public:
 	{
 		// This is shared between graphics and compute
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES * 4)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_ * 4)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 	}
 
@@ -405,6 +405,11 @@ public:
 		// Get a compute capable device queue
 		vkGetDeviceQueue(device_, vulkanDevice_->queueFamilyIndices.compute, 0, &compute.queue);
 
+		compute.commandBuffers.resize(framesInFlight_);
+		compute.fences.resize(framesInFlight_);
+		compute.semaphores.resize(framesInFlight_);
+		compute.descriptorSets.resize(framesInFlight_);
+
 		// Create compute pipeline
 		// Compute pipelines are created separate from graphics pipelines even if they use the same queue (family index)
 
@@ -493,7 +498,7 @@ public:
 		// Signal first used ready semaphore
 		VkSubmitInfo computeSubmitInfo = vks::initializers::submitInfo();
 		computeSubmitInfo.signalSemaphoreCount = 1;
-		computeSubmitInfo.pSignalSemaphores = &compute.semaphores[MAX_CONCURRENT_FRAMES - 1].ready;
+		computeSubmitInfo.pSignalSemaphores = &compute.semaphores[framesInFlight_ - 1].ready;
 		VK_CHECK_RESULT(vkQueueSubmit(compute.queue, 1, &computeSubmitInfo, VK_NULL_HANDLE));
 	}
 
@@ -739,7 +744,7 @@ public:
 			VkPipelineStageFlags waitDstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 			VkSubmitInfo submitInfo = vks::initializers::submitInfo();
 			submitInfo.waitSemaphoreCount = 1;
-			submitInfo.pWaitSemaphores = &compute.semaphores[((int)currentBuffer_ - 1) % MAX_CONCURRENT_FRAMES].ready;
+			submitInfo.pWaitSemaphores = &compute.semaphores[(currentBuffer_ + framesInFlight_ - 1) % framesInFlight_].ready;
 			submitInfo.pWaitDstStageMask = &waitDstStageMask;
 			submitInfo.signalSemaphoreCount = 1;
 			submitInfo.pSignalSemaphores = &compute.semaphores[currentBuffer_].complete;
@@ -754,6 +759,7 @@ public:
 			VK_CHECK_RESULT(vkResetFences(device_, 1, &waitFences_[currentBuffer_]));
 		
 			VulkanExampleBase::prepareFrame(false);
+			VulkanExampleBase::frameSlotAvailable();
 
 			updateUniformBuffer();
 			buildGraphicsCommandBuffer();
@@ -40,9 +40,12 @@ class VulkanExample : public VulkanExampleBase {
   uint32_t numParticles_{0};
 
   // We use a shader storage buffer object to store the particlces
-  // This is updated by the compute pipeline and displayed as a vertex buffer by
-  // the graphics pipeline
+  // This is only accessed by the compute pipeline, which updates it in place
   vks::Buffer storageBuffer_;
+  // Copies of the particles per frame in flight that are displayed as vertex
+  // buffers by the graphics pipeline. Compute writes the copy of the current
+  // frame while the previous frame still draws from its own copy
+  std::vector<vks::Buffer> vertexBuffers_;
 
   // Resources for the graphics part of the example
   struct Graphics {
@@ -51,7 +54,7 @@ class VulkanExample : public VulkanExampleBase {
     // Particle system rendering shader binding layout
     VkDescriptorSetLayout descriptorSetLayout;
     // Particle system rendering shader bindings
-    std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets;
+    std::vector<VkDescriptorSet> descriptorSets;
     // Layout of the graphics pipeline
     VkPipelineLayout pipelineLayout;
     // Particle rendering pipeline
@@ -64,37 +67,20 @@ class VulkanExample : public VulkanExampleBase {
     } uniformData;
 
     // Contains scene matrices
-    std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
+    std::vector<vks::Buffer> uniformBuffers;
   } graphics_;
 
   // Resources for the compute part of the example
   struct Compute {
     // Used to check if compute and graphics queue
     // families differ and require additional barriers
+    // Command buffers, queue and synchronization with graphics are provided by
+    // the base class (asyncCompute_)
     uint32_t queueFamilyIndex;
-    // Separate queue for compute commands (queue family may
-    // differ from the one used for graphics)
-    VkQueue queue;
-    // Use a separate command pool (queue family may
-    // differ from the one used for graphics)
-    VkCommandPool commandPool;
-    // Command buffer storing the dispatch commands and
-    // barriers
-    std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers;
     // Compute shader binding layout
     VkDescriptorSetLayout descriptorSetLayout;
     // Compute shader bindings
-    std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets;
-    // Fences to make sure command buffers are done
-    std::array<VkFence, MAX_CONCURRENT_FRAMES> fences{};
-
-    // Semaphores for submission ordering
-    struct ComputeSemaphores {
-      VkSemaphore ready{VK_NULL_HANDLE};
-      VkSemaphore complete{VK_NULL_HANDLE};
-    };
-
-    std::array<ComputeSemaphores, MAX_CONCURRENT_FRAMES> semaphores{};
+    std::vector<VkDescriptorSet> descriptorSets;
 
     // Layout of the compute pipeline
     VkPipelineLayout pipelineLayout;
@@ -117,7 +103,7 @@ class VulkanExample : public VulkanExampleBase {
 
     // Uniform buffer object containing particle system
     // parameters
-    std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
+    std::vector<vks::Buffer> uniformBuffers;
   } compute_;
 
   VulkanExample() : VulkanExampleBase() {
@@ -136,7 +122,7 @@ class VulkanExample : public VulkanExampleBase {
     // compute queue families differ If that's the case, we need additional
     // barriers for acquiring and releasing resources
     graphics_.queueFamilyIndex = vulkanDevice_->queueFamilyIndices.graphics;
-    compute_.queueFamilyIndex = vulkanDevice_->queueFamilyIndices.compute;
+    compute_.queueFamilyIndex = asyncCompute_.queueFamilyIndex;
     loadAssets();
     prepareDescriptorPool();
     prepareStorageBuffers();
@@ -147,6 +133,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // A1
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     textures_.particle.loadFromFile(
         getAssetPath() + "textures/particle01_rgba.ktx",
         VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
@@ -160,15 +147,15 @@ class VulkanExample : public VulkanExampleBase {
     // This is shared between graphics and compute
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES * 2),
+                                              framesInFlight_ * 2),
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                              MAX_CONCURRENT_FRAMES * 1),
+                                              framesInFlight_ * 1),
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            MAX_CONCURRENT_FRAMES * 2)};
+            framesInFlight_ * 2)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES * 2);
+                                                    framesInFlight_ * 2);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
   }
@@ -190,8 +177,7 @@ class VulkanExample : public VulkanExampleBase {
     // Initial particle positions
     std::vector<Particle> particleBuffer(numParticles_);
 
-    std::default_random_engine rndEngine(
-        benchmark.active ? 0 : (unsigned)time(nullptr));
+    std::default_random_engine rndEngine(randomSeed());
     std::normal_distribution<float> rndDist(0.0f, 1.0f);
 
     for (uint32_t i = 0; i < static_cast<uint32_t>(attractors.size()); i++) {
@@ -242,45 +228,42 @@ class VulkanExample : public VulkanExampleBase {
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                                 &stagingBuffer, storageBufferSize,
                                 particleBuffer.data());
-    // The SSBO will be used as a storage buffer for the compute pipeline and as
-    // a vertex buffer in the graphics pipeline
-    vulkanDevice_->createBuffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-                                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+    // The SSBO is used as a storage buffer by the compute pipeline and copied
+    // to the vertex buffer of the frame after each simulation step
+    vulkanDevice_->createBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
                                     VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                                 &storageBuffer_, storageBufferSize);
+    vertexBuffers_.resize(framesInFlight_);
+    for (auto& buffer : vertexBuffers_) {
+      vulkanDevice_->createBuffer(
+          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &buffer, storageBufferSize);
+    }
 
     // Copy from staging buffer to storage buffer
+    // This is done on the compute queue, so the storage buffer is owned by the
+    // compute queue family from the start and never needs to be transferred
+    VkCommandPool commandPool =
+        vulkanDevice_->createCommandPool(compute_.queueFamilyIndex);
     VkCommandBuffer copyCmd = vulkanDevice_->createCommandBuffer(
-        VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+        VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandPool, true);
     VkBufferCopy copyRegion = {};
     copyRegion.size = storageBufferSize;
     vkCmdCopyBuffer(copyCmd, stagingBuffer.buffer, storageBuffer_.buffer, 1,
                     &copyRegion);
-    // Execute a transfer barrier to the compute queue, if necessary
-    if (graphics_.queueFamilyIndex != compute_.queueFamilyIndex) {
-      VkBufferMemoryBarrier buffer_barrier = {
-          VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
-          nullptr,
-          VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
-          0,
-          graphics_.queueFamilyIndex,
-          compute_.queueFamilyIndex,
-          storageBuffer_.buffer,
-          0,
-          storageBuffer_.size};
-
-      vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-                           VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
-                           1, &buffer_barrier, 0, nullptr);
-    }
-    vulkanDevice_->flushCommandBuffer(copyCmd, queue_, true);
+    vulkanDevice_->flushCommandBuffer(copyCmd, asyncCompute_.queue,
+                                      commandPool, true);
+    vkDestroyCommandPool(device_, commandPool, nullptr);
 
     stagingBuffer.destroy();
   }
 
   // A4
   void prepareGraphics() {
+    graphics_.uniformBuffers.resize(framesInFlight_);
+    graphics_.descriptorSets.resize(framesInFlight_);
     // Vertex shader uniform buffer block
     for (auto& buffer : graphics_.uniformBuffers) {
       vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
@@ -429,14 +412,15 @@ class VulkanExample : public VulkanExampleBase {
 
   // A5
   void prepareCompute() {
-    // Create a compute capable device queue
+    // Compute work is submitted to the compute queue of the base class
     // The VulkanDevice::createLogicalDevice functions finds a compute capable
     // queue and prefers queue families that only support compute Depending on
     // the implementation this may result in different queue family indices for
     // graphics and computes, requiring proper synchronization (see the memory
     // barriers in buildComputeCommandBuffer)
-    vkGetDeviceQueue(device_, compute_.queueFamilyIndex, 0, &compute_.queue);
 
+    compute_.uniformBuffers.resize(framesInFlight_);
+    compute_.descriptorSets.resize(framesInFlight_);
     // Compute shader uniform buffer block
     for (auto& buffer : compute_.uniformBuffers) {
       vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
@@ -524,44 +508,6 @@ class VulkanExample : public VulkanExampleBase {
     VK_CHECK_RESULT(vkCreateComputePipelines(
         device_, pipelineCache_, 1, &computePipelineCreateInfo, nullptr,
         &compute_.pipelineIntegrate));
-
-    // Separate command pool as queue family for compute may be different than
-    // graphics
-    VkCommandPoolCreateInfo cmdPoolInfo =
-        vks::initializers::commandPoolCreateInfo();
-    cmdPoolInfo.queueFamilyIndex = compute_.queueFamilyIndex;
-    cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    VK_CHECK_RESULT(vkCreateCommandPool(device_, &cmdPoolInfo, nullptr,
-                                        &compute_.commandPool));
-
-    // Create command buffers for compute operations
-    for (auto& cmdBuffer : compute_.commandBuffers) {
-      cmdBuffer = vulkanDevice_->createCommandBuffer(
-          VK_COMMAND_BUFFER_LEVEL_PRIMARY, compute_.commandPool);
-    }
-
-    // Fences to check for command buffer completion
-    for (auto& fence : compute_.fences) {
-      VkFenceCreateInfo fenceCreateInfo =
-          vks::initializers::fenceCreateInfo(VK_FENCE_CREATE_SIGNALED_BIT);
-      VK_CHECK_RESULT(
-          vkCreateFence(device_, &fenceCreateInfo, nullptr, &fence));
-    }
-
-    // Semaphores to order compute and graphics submissions
-    for (auto& semaphore : compute_.semaphores) {
-      VkSemaphoreCreateInfo semaphoreInfo{
-          .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
-      vkCreateSemaphore(device_, &semaphoreInfo, nullptr, &semaphore.ready);
-      vkCreateSemaphore(device_, &semaphoreInfo, nullptr, &semaphore.complete);
-    }
-    // Signal first used ready semaphore
-    VkSubmitInfo computeSubmitInfo = vks::initializers::submitInfo();
-    computeSubmitInfo.signalSemaphoreCount = 1;
-    computeSubmitInfo.pSignalSemaphores =
-        &compute_.semaphores[MAX_CONCURRENT_FRAMES - 1].ready;
-    VK_CHECK_RESULT(
-        vkQueueSubmit(compute_.queue, 1, &computeSubmitInfo, VK_NULL_HANDLE));
   }
 
   // B0
@@ -570,74 +516,30 @@ class VulkanExample : public VulkanExampleBase {
       return;
     }
 
+    VulkanExampleBase::prepareFrame();
+
     // Submit compute commands
-    {
-      VK_CHECK_RESULT(vkWaitForFences(
-          device_, 1, &compute_.fences[currentBuffer_], VK_TRUE, UINT64_MAX));
-      VK_CHECK_RESULT(
-          vkResetFences(device_, 1, &compute_.fences[currentBuffer_]));
-
-      updateComputeUniformBuffers();
-      buildComputeCommandBuffer();
-
-      // Wait for rendering finished
-      VkPipelineStageFlags waitDstStageMask =
-          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-      VkSubmitInfo submitInfo = vks::initializers::submitInfo();
-      submitInfo.waitSemaphoreCount = 1;
-      submitInfo.pWaitSemaphores =
-          &compute_
-               .semaphores[((int)currentBuffer_ - 1) % MAX_CONCURRENT_FRAMES]
-               .ready;
-      submitInfo.pWaitDstStageMask = &waitDstStageMask;
-      submitInfo.signalSemaphoreCount = 1;
-      submitInfo.pSignalSemaphores =
-          &compute_.semaphores[currentBuffer_].complete;
-      submitInfo.commandBufferCount = 1;
-      submitInfo.pCommandBuffers = &compute_.commandBuffers[currentBuffer_];
-      VK_CHECK_RESULT(vkQueueSubmit(compute_.queue, 1, &submitInfo,
-                                    compute_.fences[currentBuffer_]));
-    }
+    // The simulation of this frame runs on the compute queue while the
+    // previous frame is still being rendered. Graphics only reads the vertex
+    // buffer copies, and the copy written here was last drawn by a frame that
+    // has already finished (prepareFrame waited for it), so compute doesn't
+    // wait for graphics. The graphics submission in submitFrame waits for the
+    // simulation before vertex input
+    updateComputeUniformBuffers();
+    buildComputeCommandBuffer(asyncCompute_.beginFrame(currentBuffer_));
+    asyncCompute_.submit(currentBuffer_, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                         /*waitForGraphics*/ false);
 
     // Submit graphics commands
-    {
-      VK_CHECK_RESULT(vkWaitForFences(device_, 1, &waitFences_[currentBuffer_],
-                                      VK_TRUE, UINT64_MAX));
-      VK_CHECK_RESULT(vkResetFences(device_, 1, &waitFences_[currentBuffer_]));
-
-      VulkanExampleBase::prepareFrame(false);
-
-      updateGraphicsUniformBuffers();
-      buildGraphicsCommandBuffer();
-
-      VkPipelineStageFlags waitDstStageMask[2] = {
-          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-          VK_PIPELINE_STAGE_VERTEX_INPUT_BIT};
-      VkSemaphore waitSemaphores[2] = {
-          presentCompleteSemaphores_[currentBuffer_],
-          compute_.semaphores[currentBuffer_].complete};
-      VkSemaphore signalSemaphores[2] = {
-          renderCompleteSemaphores_[currentImageIndex_],
-          compute_.semaphores[currentBuffer_].ready};
-
-      VkSubmitInfo submitInfo = vks::initializers::submitInfo();
-      submitInfo.waitSemaphoreCount = 2;
-      submitInfo.pWaitSemaphores = waitSemaphores;
-      submitInfo.pWaitDstStageMask = waitDstStageMask;
-      submitInfo.commandBufferCount = 1;
-      submitInfo.pCommandBuffers = &drawCmdBuffers_[currentBuffer_];
-      submitInfo.signalSemaphoreCount = 2;
-      submitInfo.pSignalSemaphores = signalSemaphores;
-      VK_CHECK_RESULT(
-          vkQueueSubmit(queue_, 1, &submitInfo, waitFences_[currentBuffer_]));
-
-      VulkanExampleBase::submitFrame(true);
-    }
+    updateGraphicsUniformBuffers();
+    buildGraphicsCommandBuffer();
+
+    VulkanExampleBase::submitFrame();
   }
 
   // B1
   void updateComputeUniformBuffers() {
-    compute_.uniformData_.deltaT = paused ? 0.0f : frameTimer * 0.05f;
+    compute_.uniformData_.deltaT = paused ? 0.0f : animationStep_ * 0.05f;
     memcpy(compute_.uniformBuffers[currentBuffer_].mapped,
            &compute_.uniformData_, sizeof(Compute::UniformData));
   }
@@ -675,6 +577,8 @@ class VulkanExample : public VulkanExampleBase {
 
     VK_CHECK_RESULT(vkBeginCommandBuffer(cmdBuffer, &cmdBufInfo));
 
+    const vks::Buffer& vertexBuffer = vertexBuffers_[currentBuffer_];
+
     // Acquire barrier
     if (graphics_.queueFamilyIndex != compute_.queueFamilyIndex) {
       VkBufferMemoryBarrier buffer_barrier = {
@@ -684,9 +588,9 @@ class VulkanExample : public VulkanExampleBase {
           VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
           compute_.queueFamilyIndex,
           graphics_.queueFamilyIndex,
-          storageBuffer_.buffer,
+          vertexBuffer.buffer,
           0,
-          storageBuffer_.size};
+          vertexBuffer.size};
 
       vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
                            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1,
@@ -711,60 +615,37 @@ class VulkanExample : public VulkanExampleBase {
         1, &graphics_.descriptorSets[currentBuffer_], 0, nullptr);
 
     VkDeviceSize offsets[1] = {0};
-    vkCmdBindVertexBuffers(cmdBuffer, 0, 1, &storageBuffer_.buffer, offsets);
+    vkCmdBindVertexBuffers(cmdBuffer, 0, 1, &vertexBuffer.buffer, offsets);
     vkCmdDraw(cmdBuffer, numParticles_, 1, 0, 0);
 
     drawUI(cmdBuffer);
 
     vkCmdEndRenderPass(cmdBuffer);
 
-    // Release barrier
-    if (graphics_.queueFamilyIndex != compute_.queueFamilyIndex) {
-      VkBufferMemoryBarrier buffer_barrier = {
-          VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
-          nullptr,
-          VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
-          0,
-          graphics_.queueFamilyIndex,
-          compute_.queueFamilyIndex,
-          storageBuffer_.buffer,
-          0,
-          storageBuffer_.size};
-
-      vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-                           VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
-                           1, &buffer_barrier, 0, nullptr);
-    }
+    // The vertex buffer isn't released back to compute, which overwrites it
+    // without needing its previous contents
 
     VK_CHECK_RESULT(vkEndCommandBuffer(cmdBuffer));
   }
 
   // B4
-  void buildComputeCommandBuffer() {
-    VkCommandBuffer cmdBuffer = compute_.commandBuffers[currentBuffer_];
-
-    VkCommandBufferBeginInfo cmdBufInfo =
-        vks::initializers::commandBufferBeginInfo();
-
-    VK_CHECK_RESULT(vkBeginCommandBuffer(cmdBuffer, &cmdBufInfo));
-
-    // Acquire barrier
-    if (graphics_.queueFamilyIndex != compute_.queueFamilyIndex) {
-      VkBufferMemoryBarrier buffer_barrier = {
-          VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
-          nullptr,
-          0,
-          VK_ACCESS_SHADER_WRITE_BIT,
-          graphics_.queueFamilyIndex,
-          compute_.queueFamilyIndex,
-          storageBuffer_.buffer,
-          0,
-          storageBuffer_.size};
-
-      vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr,
-                           1, &buffer_barrier, 0, nullptr);
-    }
+  // The command buffer has been begun by asyncCompute_.beginFrame and is ended
+  // on submission
+  void buildComputeCommandBuffer(VkCommandBuffer cmdBuffer) {
+    // The previous simulation step must have been copied to its vertex buffer
+    // before the particles are updated again
+    VkBufferMemoryBarrier stepBarrier =
+        vks::initializers::bufferMemoryBarrier();
+    stepBarrier.buffer = storageBuffer_.buffer;
+    stepBarrier.size = storageBuffer_.size;
+    stepBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    stepBarrier.dstAccessMask =
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(
+        cmdBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_FLAGS_NONE, 0, nullptr, 1,
+        &stepBarrier, 0, nullptr);
 
     // First pass: Calculate particle movement
     // -------------------------------------------------------------------------------------------------------
@@ -797,25 +678,35 @@ class VulkanExample : public VulkanExampleBase {
                       compute_.pipelineIntegrate);
     vkCmdDispatch(cmdBuffer, numParticles_ / 256, 1, 1);
 
+    // Copy the particles to the vertex buffer of this frame
+    bufferBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, VK_FLAGS_NONE, 0,
+                         nullptr, 1, &bufferBarrier, 0, nullptr);
+    const vks::Buffer& vertexBuffer = vertexBuffers_[currentBuffer_];
+    VkBufferCopy copyRegion = {};
+    copyRegion.size = storageBuffer_.size;
+    vkCmdCopyBuffer(cmdBuffer, storageBuffer_.buffer, vertexBuffer.buffer, 1,
+                    &copyRegion);
+
     // Release barrier
     if (graphics_.queueFamilyIndex != compute_.queueFamilyIndex) {
       VkBufferMemoryBarrier buffer_barrier = {
           VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
           nullptr,
-          VK_ACCESS_SHADER_WRITE_BIT,
+          VK_ACCESS_TRANSFER_WRITE_BIT,
           0,
           compute_.queueFamilyIndex,
           graphics_.queueFamilyIndex,
-          storageBuffer_.buffer,
+          vertexBuffer.buffer,
           0,
-          storageBuffer_.size};
+          vertexBuffer.size};
 
-      vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
                            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
                            1, &buffer_barrier, 0, nullptr);
     }
-
-    vkEndCommandBuffer(cmdBuffer);
   }
 
   ~VulkanExample() {
@@ -835,19 +726,14 @@ class VulkanExample : public VulkanExampleBase {
                                    nullptr);
       vkDestroyPipeline(device_, compute_.pipelineCalculate, nullptr);
       vkDestroyPipeline(device_, compute_.pipelineIntegrate, nullptr);
-      vkDestroyCommandPool(device_, compute_.commandPool, nullptr);
       for (auto& buffer : compute_.uniformBuffers) {
         buffer.destroy();
       }
-      for (auto& fence : compute_.fences) {
-        vkDestroyFence(device_, fence, nullptr);
-      }
-      for (auto& semaphore : compute_.semaphores) {
-        vkDestroySemaphore(device_, semaphore.ready, nullptr);
-        vkDestroySemaphore(device_, semaphore.complete, nullptr);
-      }
 
       storageBuffer_.destroy();
+      for (auto& buffer : vertexBuffers_) {
+        buffer.destroy();
+      }
 
       textures_.particle.destroy();
       textures_.gradient.destroy();
@@ -41,7 +41,7 @@ public:
 
 	// We use a shader storage buffer object to store the particlces
 	// This is updated by the compute pipeline and displayed as a vertex buffer by the graphics pipeline
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> storageBuffers;
+	std::vector<vks::Buffer> storageBuffers = std::vector<vks::Buffer>(framesInFlight_);
 
 	// Resources for the graphics part of the example
 	struct Graphics {
@@ -57,13 +57,13 @@ public:
 		uint32_t queueFamilyIndex;											// Used to check if compute and graphics queue families differ and require additional barriers
 		VkQueue queue;														// Separate queue for compute commands (queue family may differ from the one used for graphics)
 		VkCommandPool commandPool;											// Use a separate command pool (queue family may differ from the one used for graphics)
-		std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers;	// Command buffer storing the dispatch commands and barriers
-		std::array<VkFence, MAX_CONCURRENT_FRAMES> fences;					// Synchronization fence to avoid rewriting compute CB if still in use
+		std::vector<VkCommandBuffer> commandBuffers;						// Command buffer storing the dispatch commands and barriers
+		std::vector<VkFence> fences;										// Synchronization fence to avoid rewriting compute CB if still in use
 		VkDescriptorSetLayout descriptorSetLayout;							// Compute shader binding layout
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{};	// Compute shader bindings
+		std::vector<VkDescriptorSet> descriptorSets;						// Compute shader bindings
 		VkPipelineLayout pipelineLayout;									// Layout of the compute pipeline
 		VkPipeline pipeline;												// Compute pipeline for updating particle positions
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;		// Uniform buffer object containing particle system parameters
+		std::vector<vks::Buffer> uniformBuffers;							// Uniform buffer object containing particle system parameters
 		struct UniformData {												// Compute shader uniform block object
 			float deltaT;													//		Frame delta time
 			float destX;													//		x position of the attractor
@@ -107,6 +107,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		textures_.particle.loadFromFile(getAssetPath() + "textures/particle01_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
 		textures_.gradient.loadFromFile(getAssetPath() + "textures/particle_gradient_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
 	}
@@ -114,7 +115,7 @@ public:
 	// Setup and fill the compute shader storage buffers containing the particles
 	void prepareStorageBuffers()
 	{
-		std::default_random_engine rndEngine(benchmark.active ? 0 : (unsigned)time(nullptr));
+		std::default_random_engine rndEngine(randomSeed());
 		std::uniform_real_distribution<float> rndDist(-1.0f, 1.0f);
 
 		// Initial particle positions
@@ -177,11 +178,11 @@ public:
 	void setupDescriptorPool()
 	{
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES * 4),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 2)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_ * 4),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 2)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 	}
 
@@ -288,6 +289,10 @@ public:
 		VK_CHECK_RESULT(vkCreateCommandPool(device_, &cmdPoolInfo, nullptr, &compute.commandPool));
 
 		// Some objects need to be duplicated per frames in flight
+		compute.commandBuffers.resize(framesInFlight_);
+		compute.fences.resize(framesInFlight_);
+		compute.descriptorSets.resize(framesInFlight_);
+		compute.uniformBuffers.resize(framesInFlight_);
 
 		// Create command buffers for compute operations
 		VkCommandBufferAllocateInfo cmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(compute.commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1);
@@ -327,7 +332,7 @@ public:
 			VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo, &compute.descriptorSets[i]));
 			std::vector<VkWriteDescriptorSet> computeWriteDescriptorSets = {
 				// Binding 0 : Previous particles storage buffer
-				vks::initializers::writeDescriptorSet(compute.descriptorSets[i], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &storageBuffers[(i - 1) % MAX_CONCURRENT_FRAMES].descriptor),
+				vks::initializers::writeDescriptorSet(compute.descriptorSets[i], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &storageBuffers[(i + framesInFlight_ - 1) % framesInFlight_].descriptor),
 				// Binding 1 : Current particles storage buffer
 				vks::initializers::writeDescriptorSet(compute.descriptorSets[i], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, &storageBuffers[i].descriptor),
 				// Binding 2 : Uniform buffer
@@ -346,16 +351,17 @@ public:
 
 	void updateUniformBuffers()
 	{
-		compute.uniformData.deltaT = paused ? 0.0f : frameTimer * 2.5f;
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
+		compute.uniformData.deltaT = paused ? 0.0f : animationStep_ * 2.5f;
 		if (!attachToCursor)
 		{
 			if (animStart > 0.0f)
 			{
-				animStart -= frameTimer * 5.0f;
+				animStart -= animationStep_ * 5.0f;
 			}
 			else if (animStart <= 0.0f)
 			{
-				timer += frameTimer * 0.04f;
+				timer += animationStep_ * 0.04f;
 				if (timer > 1.f)
 					timer = 0.f;
 			}
@@ -32,8 +32,8 @@ public:
 	struct Compute {
 		VkQueue queue{ VK_NULL_HANDLE };									// Separate queue for compute commands (queue family may differ from the one used for graphics)
 		VkCommandPool commandPool{ VK_NULL_HANDLE };						// Use a separate command pool (queue family may differ from the one used for graphics)
-		std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers;	// Command buffers storing the dispatch commands and barriers
-		std::array<VkFence, MAX_CONCURRENT_FRAMES> fences;					// Synchronization fence to avoid rewriting compute CB if still in use
+		std::vector<VkCommandBuffer> commandBuffers;						// Command buffers storing the dispatch commands and barriers
+		std::vector<VkFence> fences;										// Synchronization fence to avoid rewriting compute CB if still in use
 		VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };		// Compute shader binding layout
 		VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };					// Layout of the compute pipeline
 		VkPipeline pipeline{ VK_NULL_HANDLE };								// Compute raytracing pipeline
@@ -53,8 +53,8 @@ public:
 		vks::Buffer objectStorageBuffer;
 		// Uniform buffer object containing scene parameters
 		// These need to be per frames in flight, as CPU writes to while GPU reads from
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{};
+		std::vector<vks::Buffer> uniformBuffers;
+		std::vector<VkDescriptorSet> descriptorSets;
 	} compute;
 
 	// Definitions for scene objects
@@ -153,7 +153,7 @@ public:
 		vkGetImageMemoryRequirements(device_, storageImage.image, &memReqs);
 		memAllocInfo.allocationSize = memReqs.size;
 		memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr, &storageImage.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllocInfo, &storageImage.deviceMemory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, storageImage.image, storageImage.deviceMemory, 0));
 
 		VkCommandBuffer layoutCmd = vulkanDevice_->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
@@ -277,12 +277,12 @@ public:
 	void setupDescriptorPool()
 	{
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 4),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_CONCURRENT_FRAMES * 1),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 4),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight_ * 1),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_ * 2),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 3);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 3);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 	}
 
@@ -366,6 +366,10 @@ public:
 		VK_CHECK_RESULT(vkCreateCommandPool(device_, &cmdPoolInfo, nullptr, &compute.commandPool));
 
 		// Some objects need to be duplicated per frames in flight
+		compute.commandBuffers.resize(framesInFlight_);
+		compute.fences.resize(framesInFlight_);
+		compute.uniformBuffers.resize(framesInFlight_);
+		compute.descriptorSets.resize(framesInFlight_);
 
 		// Create command buffers for compute operations
 		VkCommandBufferAllocateInfo cmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(compute.commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1);
@@ -424,6 +428,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		compute.uniformData.aspectRatio = (float)width_ / (float)height_;
 		compute.uniformData.lightPos.x = 0.0f + sin(glm::radians(timer * 360.0f)) * cos(glm::radians(timer * 360.0f)) * 2.0f;
 		compute.uniformData.lightPos.y = 0.0f + sin(glm::radians(timer * 360.0f)) * 2.0f;
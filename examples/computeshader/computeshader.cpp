@@ -31,7 +31,7 @@ public:
 			VkDescriptorSet preCompute{ VK_NULL_HANDLE };				// Image display shader bindings before compute shader image manipulation
 			VkDescriptorSet postCompute{ VK_NULL_HANDLE };				// Image display shader bindings after compute shader image manipulation
 		};
-		std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets;
+		std::vector<DescriptorSets> descriptorSets;
 		VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };				// Layout of the graphics pipeline
 		VkPipeline pipeline{ VK_NULL_HANDLE };							// Image display pipeline
 		// Used to pass data to the graphics shaders
@@ -39,15 +39,15 @@ public:
 			glm::mat4 projection;
 			glm::mat4 modelView;
 		} uniformData;
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
+		std::vector<vks::Buffer> uniformBuffers;
 	} graphics;
 
 	// Resources for the compute part of the example
 	struct Compute {
 		VkQueue queue{ VK_NULL_HANDLE };								// Separate queue for compute commands (queue family may differ from the one used for graphics)
 		VkCommandPool commandPool{ VK_NULL_HANDLE };					// Use a separate command pool (queue family may differ from the one used for graphics)
-		std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers;// Command buffers storing the dispatch commands and barriers
-		std::array<VkFence, MAX_CONCURRENT_FRAMES> fences;				// Synchronization fence to avoid rewriting compute CB if still in use
+		std::vector<VkCommandBuffer> commandBuffers;// Command buffers storing the dispatch commands and barriers
+		std::vector<VkFence> fences;									// Synchronization fence to avoid rewriting compute CB if still in use
 		VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };	// Compute shader binding layout
 		VkDescriptorSet descriptorSet{ VK_NULL_HANDLE };				// Compute shader bindings
 		VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };				// Layout of the compute pipeline
@@ -143,7 +143,7 @@ public:
 		vkGetImageMemoryRequirements(device_, storageImage.image, &memReqs);
 		memAllocInfo.allocationSize = memReqs.size;
 		memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr, &storageImage.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllocInfo, &storageImage.deviceMemory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, storageImage.image, storageImage.deviceMemory, 0));
 
 		// Transition image to the general layout, so we can use it as a storage image in the compute shader
@@ -186,6 +186,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		textureColorMap.loadFromFile(getAssetPath() + "textures/vulkan_11_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT, VK_IMAGE_LAYOUT_GENERAL);
 	}
 
@@ -233,13 +234,13 @@ public:
 	{
 		std::vector<VkDescriptorPoolSize> poolSizes = {
 			// Graphics pipelines uniform buffers
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
 			// Graphics pipelines image samplers for displaying compute output image
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 2),
 			// Compute pipelines uses a storage image for image reads and writes
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_CONCURRENT_FRAMES * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight_ * 2),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 3);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 3);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 	}
 
@@ -343,6 +344,8 @@ public:
 		VK_CHECK_RESULT(vkCreateCommandPool(device_, &cmdPoolInfo, nullptr, &compute.commandPool));
 
 		// Some objects need to be duplicated per frames in flight
+		compute.commandBuffers.resize(framesInFlight_);
+		compute.fences.resize(framesInFlight_);
 
 		// Create command buffers for compute operations
 		VkCommandBufferAllocateInfo cmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(compute.commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1);
@@ -396,6 +399,8 @@ public:
 
 	void prepareUniformBuffers()
 	{
+		graphics.uniformBuffers.resize(framesInFlight_);
+		graphics.descriptorSets.resize(framesInFlight_);
 		for (auto& buffer : graphics.uniformBuffers) {
 			// Scene matrices uniform buffer
 			VK_CHECK_RESULT(vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, sizeof(Graphics::UniformData)));
@@ -405,6 +410,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// We need to adjust the perspective as this sample displays two viewports side-by-side
 		camera_.setPerspective(60.0f, (float)width_ * 0.5f / (float)height_, 1.0f, 256.0f);
 		graphics.uniformData.projection = camera_.matrices_.perspective;
@@ -27,15 +27,15 @@ public:
 		glm::mat4 view;
 		glm::mat4 model;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	std::vector<int32_t> conditionalVisibility{};
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> conditionalBuffers;
+	std::vector<vks::Buffer> conditionalBuffers = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkPipeline pipeline{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	VulkanExample() : VulkanExampleBase()
 	{
@@ -107,6 +107,7 @@ public:
 
 		void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		scene.loadFromFile(getAssetPath() + "models/gltf/glTF-Embedded/Buggy.gltf", vulkanDevice_, queue_);
 	}
 
@@ -114,9 +115,9 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolCI = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolCI = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCI, nullptr, &descriptorPool_));
 
 		// Layouts
@@ -142,6 +143,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		std::array<VkDescriptorSetLayout, 2> setLayouts = {
 			descriptorSetLayout, vkglTF::descriptorSetLayoutUbo
@@ -195,6 +197,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.view = glm::scale(camera_.matrices_.view, glm::vec3(0.1f , -0.1f, 0.1f));
 		uniformData_.model = glm::translate(glm::mat4(1.0f), scene.dimensions.min);
@@ -267,6 +270,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
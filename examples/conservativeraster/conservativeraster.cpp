@@ -35,7 +35,7 @@ public:
 		glm::mat4 projection;
 		glm::mat4 model;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	struct PipelineLayouts {
 		VkPipelineLayout scene{ VK_NULL_HANDLE };
@@ -58,7 +58,7 @@ public:
 		VkDescriptorSet scene{ VK_NULL_HANDLE };
 		VkDescriptorSet fullscreen{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_;
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	// Framebuffer for offscreen rendering
 	struct FrameBufferAttachment {
@@ -94,10 +94,10 @@ public:
 		if (device_) {
 			vkDestroyImageView(device_, offscreenPass_.color.view, nullptr);
 			vkDestroyImage(device_, offscreenPass_.color.image, nullptr);
-			vkFreeMemory(device_, offscreenPass_.color.mem, nullptr);
+			vulkanDevice_->freeMemory(offscreenPass_.color.mem);
 			vkDestroyImageView(device_, offscreenPass_.depth.view, nullptr);
 			vkDestroyImage(device_, offscreenPass_.depth.image, nullptr);
-			vkFreeMemory(device_, offscreenPass_.depth.mem, nullptr);
+			vulkanDevice_->freeMemory(offscreenPass_.depth.mem);
 			vkDestroyRenderPass(device_, offscreenPass_.renderPass, nullptr);
 			vkDestroySampler(device_, offscreenPass_.sampler, nullptr);
 			vkDestroyFramebuffer(device_, offscreenPass_.frameBuffer, nullptr);
@@ -162,7 +162,7 @@ public:
 		vkGetImageMemoryRequirements(device_, offscreenPass_.color.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreenPass_.color.mem));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreenPass_.color.mem, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, offscreenPass_.color.image, offscreenPass_.color.mem, 0));
 
 		VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -200,7 +200,7 @@ public:
 		vkGetImageMemoryRequirements(device_, offscreenPass_.depth.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreenPass_.depth.mem));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreenPass_.depth.mem, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, offscreenPass_.depth.image, offscreenPass_.depth.mem, 0));
 
 		VkImageViewCreateInfo depthStencilView = vks::initializers::imageViewCreateInfo();
@@ -308,6 +308,7 @@ public:
 		
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		// Create a single triangle
 		struct Vertex {
 			float position[3];
@@ -368,10 +369,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 2)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 2)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layouts
@@ -415,6 +416,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layouts
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
 		pipelineLayoutCreateInfo = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayouts_.scene, 1);
@@ -537,6 +539,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.model = camera_.matrices_.view;
 		memcpy(uniformBuffers_[currentBuffer_].mapped, &uniformData_, sizeof(UniformData));
@@ -555,6 +558,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -24,7 +24,7 @@ public:
 		glm::mat4 model;
 		glm::vec4 lightPos = glm::vec4(0.0f, 5.0f, 15.0f, 1.0f);
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	struct Pipelines {
 		VkPipeline toonshading;
@@ -35,7 +35,7 @@ public:
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	// Framebuffer for offscreen rendering
 	struct FrameBufferAttachment {
@@ -104,12 +104,12 @@ public:
 			// Color attachment
 			vkDestroyImageView(device_, offscreenPass_.color.view, nullptr);
 			vkDestroyImage(device_, offscreenPass_.color.image, nullptr);
-			vkFreeMemory(device_, offscreenPass_.color.memory, nullptr);
+			vulkanDevice_->freeMemory(offscreenPass_.color.memory);
 
 			// Depth attachment
 			vkDestroyImageView(device_, offscreenPass_.depth.view, nullptr);
 			vkDestroyImage(device_, offscreenPass_.depth.image, nullptr);
-			vkFreeMemory(device_, offscreenPass_.depth.memory, nullptr);
+			vulkanDevice_->freeMemory(offscreenPass_.depth.memory);
 
 			vkDestroyRenderPass(device_, offscreenPass_.renderPass, nullptr);
 			vkDestroySampler(device_, offscreenPass_.sampler, nullptr);
@@ -279,7 +279,7 @@ public:
 		vkGetImageMemoryRequirements(device_, offscreenPass_.color.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreenPass_.color.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreenPass_.color.memory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, offscreenPass_.color.image, offscreenPass_.color.memory, 0));
 
 		VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -317,7 +317,7 @@ public:
 		vkGetImageMemoryRequirements(device_, offscreenPass_.depth.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreenPass_.depth.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreenPass_.depth.memory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, offscreenPass_.depth.image, offscreenPass_.depth.memory, 0));
 
 		VkImageViewCreateInfo depthStencilView = vks::initializers::imageViewCreateInfo();
@@ -417,6 +417,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		models_.scene.loadFromFile(getAssetPath() + "models/treasure_smooth.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		models_.sceneGlow.loadFromFile(getAssetPath() + "models/treasure_glow.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -438,10 +439,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layout
@@ -471,6 +472,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
@@ -568,7 +570,7 @@ public:
 
 		// Shared objects
 		setObjectName(device_, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, (uint64_t)descriptorSetLayout, "Shared descriptor set layout");
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			setObjectName(device_, VK_OBJECT_TYPE_BUFFER, (uint64_t)uniformBuffers_[i].buffer, "Scene uniform buffer block for frame " + std::to_string(i));
 			setObjectName(device_, VK_OBJECT_TYPE_DESCRIPTOR_SET, (uint64_t)descriptorSets_[i], "Shared descriptor set for frame " + std::to_string(i));
 		}
@@ -585,6 +587,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.model = camera_.matrices_.view;
 		memcpy(uniformBuffers_[currentBuffer_].mapped, &uniformData_, sizeof(uniformData_));
@@ -605,6 +608,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 
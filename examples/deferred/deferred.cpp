@@ -59,7 +59,7 @@ public:
 		vks::Buffer offscreen;
 		vks::Buffer composition;
 	};
-	std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffers> uniformBuffers_ = std::vector<UniformBuffers>(framesInFlight_);
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	struct {
@@ -73,7 +73,7 @@ public:
 		VkDescriptorSet floor{ VK_NULL_HANDLE };
 		VkDescriptorSet composition{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_;
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	// Framebuffers holding the deferred attachments
 	struct FrameBufferAttachment {
@@ -113,16 +113,16 @@ public:
 			vkDestroySampler(device_, colorSampler, nullptr);
 			vkDestroyImageView(device_, offScreenFrameBuf.position.view, nullptr);
 			vkDestroyImage(device_, offScreenFrameBuf.position.image, nullptr);
-			vkFreeMemory(device_, offScreenFrameBuf.position.mem, nullptr);
+			vulkanDevice_->freeMemory(offScreenFrameBuf.position.mem);
 			vkDestroyImageView(device_, offScreenFrameBuf.normal.view, nullptr);
 			vkDestroyImage(device_, offScreenFrameBuf.normal.image, nullptr);
-			vkFreeMemory(device_, offScreenFrameBuf.normal.mem, nullptr);
+			vulkanDevice_->freeMemory(offScreenFrameBuf.normal.mem);
 			vkDestroyImageView(device_, offScreenFrameBuf.albedo.view, nullptr);
 			vkDestroyImage(device_, offScreenFrameBuf.albedo.image, nullptr);
-			vkFreeMemory(device_, offScreenFrameBuf.albedo.mem, nullptr);
+			vulkanDevice_->freeMemory(offScreenFrameBuf.albedo.mem);
 			vkDestroyImageView(device_, offScreenFrameBuf.depth.view, nullptr);
 			vkDestroyImage(device_, offScreenFrameBuf.depth.image, nullptr);
-			vkFreeMemory(device_, offScreenFrameBuf.depth.mem, nullptr);
+			vulkanDevice_->freeMemory(offScreenFrameBuf.depth.mem);
 			vkDestroyFramebuffer(device_, offScreenFrameBuf.frameBuffer, nullptr);
 			vkDestroyPipeline(device_, pipelines_.composition, nullptr);
 			vkDestroyPipeline(device_, pipelines_.offscreen, nullptr);
@@ -194,7 +194,7 @@ public:
 		vkGetImageMemoryRequirements(device_, attachment->image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &attachment->mem));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &attachment->mem, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, attachment->image, attachment->mem, 0));
 
 		VkImageViewCreateInfo imageView = vks::initializers::imageViewCreateInfo();
@@ -365,6 +365,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		models_.model.loadFromFile(getAssetPath() + "models/armor/armor.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		models_.floor.loadFromFile(getAssetPath() + "models/deferred_floor.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -378,10 +379,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 8),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 9)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 8),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 9)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 3);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 3);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layouts
@@ -453,6 +454,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Pipeline layout
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
@@ -608,6 +610,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -18,12 +18,12 @@ public:
 	struct Cube {
 		glm::mat4 matrix;
 		vks::Texture2D texture;
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
+		std::vector<vks::Buffer> uniformBuffers;
 		glm::vec3 rotation;
 	};
 	std::array<Cube, 2> cubes;
 
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffersCamera;
+	std::vector<vks::Buffer> uniformBuffersCamera = std::vector<vks::Buffer>(framesInFlight_);
 
 	vkglTF::Model model;
 
@@ -49,7 +49,7 @@ public:
 		VkDescriptorSetLayout setLayout;
 	};
 	struct BufferDescriptorInfo : DescriptorInfo {
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> buffers;
+		std::vector<vks::Buffer> buffers;
 	};
 	BufferDescriptorInfo uniformDescriptor{};
 
@@ -147,6 +147,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Set 0 = Camera UBO
 		// Set 1 = Model UBO
 		// Set 2 = Model image
@@ -218,7 +219,8 @@ public:
 
 		// This buffer will contain resource descriptors for all the uniform buffers of a single frame (global matrices and cubes)
 		uint32_t bufferDescriptorSize = (static_cast<uint32_t>(cubes.size()) + 1) * uniformDescriptor.layoutSize;
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		uniformDescriptor.buffers.resize(framesInFlight_);
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			VK_CHECK_RESULT(vulkanDevice_->createBuffer(
 				VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
 				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -248,7 +250,7 @@ public:
 		}
 
 		// For uniform buffers we only need buffer device addresses and store them in the descriptor buffer
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			// Offset for the frame to be updated
 			char* uniformDescriptorBufPtr = (char*)uniformDescriptor.buffers[i].mapped;
 
@@ -280,6 +282,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		model.loadFromFile(getAssetPath() + "models/cube.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		cubes[0].texture.loadFromFile(getAssetPath() + "textures/crate01_color_height_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
@@ -288,7 +291,10 @@ public:
 
 	void prepareUniformBuffers()
 	{
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (auto& cube : cubes) {
+			cube.uniformBuffers.resize(framesInFlight_);
+		}
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			// UBO for camera matrices
 			VK_CHECK_RESULT(vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &uniformBuffersCamera[i], sizeof(glm::mat4) * 2));
 			VK_CHECK_RESULT(uniformBuffersCamera[i].map());
@@ -302,6 +308,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		memcpy(uniformBuffersCamera[currentBuffer_].mapped, &camera_.matrices_.perspective, sizeof(glm::mat4));
 		memcpy((char*)uniformBuffersCamera[currentBuffer_].mapped + sizeof(glm::mat4), &camera_.matrices_.view, sizeof(glm::mat4));
 
@@ -339,6 +346,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -376,7 +384,7 @@ public:
 		// Set 0 = uniform buffer
 		VkDescriptorBufferBindingInfoEXT bindingInfos[2]{};
 		bindingInfos[0].sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
-		bindingInfos[0].address = uniformDescriptor.buffers[1].deviceAddress;
+		bindingInfos[0].address = uniformDescriptor.buffers[currentBuffer_].deviceAddress;
 		bindingInfos[0].usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT;
 		// Set 1 = Image
 		bindingInfos[1].sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
@@ -416,10 +424,10 @@ public:
 		if (!prepared_)
 			return;
 		if (animate && !paused) {
-			cubes[0].rotation.x += 2.5f * frameTimer;
+			cubes[0].rotation.x += 2.5f * animationStep_;
 			if (cubes[0].rotation.x > 360.0f)
 				cubes[0].rotation.x -= 360.0f;
-			cubes[1].rotation.y += 2.0f * frameTimer;
+			cubes[1].rotation.y += 2.0f * animationStep_;
 			if (cubes[1].rotation.y > 360.0f)
 				cubes[1].rotation.y -= 360.0f;
 		}
@@ -31,12 +31,14 @@ class VulkanExample : public VulkanExampleBase {
     glm::mat4 view;
     glm::mat4 model;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VkPhysicalDeviceDescriptorIndexingFeaturesEXT
       physicalDeviceDescriptorIndexingFeatures{};
@@ -115,8 +117,7 @@ class VulkanExample : public VulkanExampleBase {
   void generateTextures() {
     textures_.resize(32);
     for (size_t i = 0; i < textures_.size(); i++) {
-      std::random_device rndDevice;
-      std::default_random_engine rndEngine(benchmark.active ? 0 : rndDevice());
+      std::default_random_engine rndEngine(randomSeed());
       std::uniform_int_distribution<> rndDist(50, UCHAR_MAX);
       const int32_t dim = 3;
       const size_t bufferSize = dim * dim * 4;
@@ -140,8 +141,7 @@ class VulkanExample : public VulkanExampleBase {
     std::vector<uint32_t> indices;
 
     // Generate random per-face texture indices
-    std::random_device rndDevice;
-    std::default_random_engine rndEngine(benchmark.active ? 0 : rndDevice());
+    std::default_random_engine rndEngine(randomSeed());
     std::uniform_int_distribution<int32_t> rndDist(
         0, static_cast<uint32_t>(textures_.size()) - 1);
 
@@ -245,13 +245,13 @@ class VulkanExample : public VulkanExampleBase {
     // Descriptor pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            static_cast<uint32_t>(textures_.size()) * MAX_CONCURRENT_FRAMES)};
+            static_cast<uint32_t>(textures_.size()) * framesInFlight_)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
 #if (defined(VK_USE_PLATFORM_IOS_MVK) || defined(VK_USE_PLATFORM_MACOS_MVK) || \
      defined(VK_USE_PLATFORM_METAL_EXT))
     // Increase the per-stage descriptor samplers limit on macOS/iOS
@@ -388,6 +388,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
@@ -479,6 +480,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.view = camera_.matrices_.view;
     uniformData_.model = glm::mat4(1.0f);
@@ -497,6 +499,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkClearValue clearValues[2]{};
@@ -24,8 +24,8 @@ public:
 			glm::mat4 model;
 		} matrices;
 		vks::Texture2D texture;
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers{};
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{};
+		std::vector<vks::Buffer> uniformBuffers;
+		std::vector<VkDescriptorSet> descriptorSets;
 		glm::vec3 rotation{ 0.0f };
 	};
 	std::array<Cube, 2> cubes;
@@ -67,6 +67,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		model.loadFromFile(getAssetPath() + "models/cube.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		cubes[0].texture.loadFromFile(getAssetPath() + "textures/crate01_color_height_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
@@ -94,23 +95,23 @@ public:
 
 		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
 
-		// Uniform buffers : 1 per object and max. frame in flight
+		// Uniform buffers : 1 per object and frame in flight
 		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 		// Uniform buffers are duplicated, so we can update buffer n+1 on the CPU while the GPU still reads from buffer n
-		descriptorPoolSizes[0].descriptorCount = static_cast<uint32_t>(cubes.size()) * MAX_CONCURRENT_FRAMES;
+		descriptorPoolSizes[0].descriptorCount = static_cast<uint32_t>(cubes.size()) * framesInFlight_;
 
 		// Combined image samples : 1 per object texture
 		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		// Images are static, and never update after initial upload, but as they use the same descriptor set as buffers, we need to duplicate the descriptor count here too
-		descriptorPoolSizes[1].descriptorCount = static_cast<uint32_t>(cubes.size()) * MAX_CONCURRENT_FRAMES;
+		descriptorPoolSizes[1].descriptorCount = static_cast<uint32_t>(cubes.size()) * framesInFlight_;
 
 		// Create the global descriptor pool
 		VkDescriptorPoolCreateInfo descriptorPoolCI = {};
 		descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		descriptorPoolCI.poolSizeCount = static_cast<uint32_t>(descriptorPoolSizes.size());
 		descriptorPoolCI.pPoolSizes = descriptorPoolSizes.data();
-		// Max. number of descriptor sets that can be allocated from this pool (one per object and per max. frame in flight)
-		descriptorPoolCI.maxSets = static_cast<uint32_t>(cubes.size() * MAX_CONCURRENT_FRAMES);
+		// Max. number of descriptor sets that can be allocated from this pool (one per object and per frame in flight)
+		descriptorPoolCI.maxSets = static_cast<uint32_t>(cubes.size() * framesInFlight_);
 
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCI, nullptr, &descriptorPool_));
 
@@ -224,6 +225,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		/*
 			[POI] Create a pipeline layout used for our graphics pipeline
 		*/
@@ -265,10 +267,12 @@ public:
 
 	void prepareUniformBuffers()
 	{
-		// Each cube has one buffer per max. frame-in-flight
+		// Each cube has one buffer per frame-in-flight
 		// This way we can update one buffer on the CPU while the other is being processed by the GPU
 		// Another option instead of using separate buffers could be using one large buffer with separate ranges per cube and fram
 		for (auto& cube : cubes) {
+			cube.uniformBuffers.resize(framesInFlight_);
+			cube.descriptorSets.resize(framesInFlight_);
 			for (auto& buffer : cube.uniformBuffers) {
 				// Scene matrices uniform buffer
 				VK_CHECK_RESULT(vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, sizeof(Cube::Matrices)));
@@ -279,6 +283,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		cubes[0].matrices.model = glm::translate(glm::mat4(1.0f), glm::vec3(-2.0f, 0.0f, 0.0f));
 		cubes[1].matrices.model = glm::translate(glm::mat4(1.0f), glm::vec3( 1.5f, 0.5f, 0.0f));
 
@@ -308,6 +313,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -361,10 +367,10 @@ public:
 		if (!prepared_)
 			return;
 		if (animate && !paused) {
-			cubes[0].rotation.x += 2.5f * frameTimer;
+			cubes[0].rotation.x += 2.5f * animationStep_;
 			if (cubes[0].rotation.x > 360.0f)
 				cubes[0].rotation.x -= 360.0f;
-			cubes[1].rotation.y += 2.0f * frameTimer;
+			cubes[1].rotation.y += 2.0f * animationStep_;
 			if (cubes[1].rotation.y > 360.0f)
 				cubes[1].rotation.y -= 360.0f;
 		}
@@ -26,12 +26,14 @@ class VulkanExample : public VulkanExampleBase {
     glm::mat4 modelView;
     glm::vec4 viewPos;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline_{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VulkanExample() : VulkanExampleBase() {
     title = "Dynamic rendering";
@@ -93,6 +95,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     const uint32_t glTFLoadingFlags =
         vkglTF::FileLoadingFlags::PreTransformVertices |
         vkglTF::FileLoadingFlags::PreMultiplyVertexColors |
@@ -105,11 +108,11 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
     };
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
     // Layout
@@ -140,6 +143,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     // Uses set 0 for passing vertex shader ubo and set 1 for fragment shader
     // images (taken from glTF model)
@@ -232,6 +236,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.modelView = camera_.matrices_.view;
     uniformData_.viewPos = camera_.viewPos_;
@@ -257,6 +262,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
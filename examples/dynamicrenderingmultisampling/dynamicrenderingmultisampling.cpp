@@ -26,12 +26,12 @@ public:
 		glm::mat4 modelView;
 		glm::vec4 viewPos;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipeline pipeline{ VK_NULL_HANDLE };
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	// Intermediate images used for multi sampling
 	struct Image {
@@ -74,7 +74,7 @@ public:
 			vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
 			vkDestroyImage(device_, renderImage.image, nullptr);
 			vkDestroyImageView(device_, renderImage.view, nullptr);
-			vkFreeMemory(device_, renderImage.memory, nullptr);
+			vulkanDevice_->freeMemory(renderImage.memory);
 			for (auto& buffer : uniformBuffers_) {
 				buffer.destroy();
 			}
@@ -93,7 +93,7 @@ public:
 		// For multi sampling we need intermediate images that are then resolved to the final presentation image 
 		vkDestroyImage(device_, renderImage.image, nullptr);
 		vkDestroyImageView(device_, renderImage.view, nullptr);
-		vkFreeMemory(device_, renderImage.memory, nullptr);
+		vulkanDevice_->freeMemory(renderImage.memory);
 		VkImageCreateInfo renderImageCI = vks::initializers::imageCreateInfo();
 		renderImageCI.imageType = VK_IMAGE_TYPE_2D;
 		renderImageCI.format = swapChain_.colorFormat_;
@@ -111,7 +111,7 @@ public:
 		memAllloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
 		memAllloc.allocationSize = memReqs.size;
 		memAllloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllloc, nullptr, &renderImage.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllloc, &renderImage.memory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, renderImage.image, renderImage.memory, 0));
 		VkImageViewCreateInfo imageViewCI = vks::initializers::imageViewCreateInfo();
 		imageViewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
@@ -141,7 +141,7 @@ public:
 		memAllloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
 		memAllloc.allocationSize = memReqs.size;
 		memAllloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllloc, nullptr, &depthStencil_.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllloc, &depthStencil_.memory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, depthStencil_.image, depthStencil_.memory, 0));
 		VkImageViewCreateInfo depthImageViewCI{};
 		depthImageViewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -171,6 +171,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		model.loadFromFile(getAssetPath() + "models/voyager.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 	}
@@ -179,9 +180,9 @@ public:
 	{	
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 		// Layout
 		const std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
@@ -203,6 +204,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		// Uses set 0 for passing vertex shader ubo and set 1 for fragment shader images (taken from glTF model)
 		const std::vector<VkDescriptorSetLayout> setLayouts = {
@@ -264,6 +266,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.modelView = camera_.matrices_.view;
 		uniformData_.viewPos = camera_.viewPos_;
@@ -287,6 +290,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
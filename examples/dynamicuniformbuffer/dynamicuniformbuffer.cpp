@@ -61,7 +61,7 @@ public:
 		vks::Buffer view;
 		vks::Buffer dynamic;
 	};
-	std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffers> uniformBuffers_ = std::vector<UniformBuffers>(framesInFlight_);
 
 	struct {
 		glm::mat4 projection;
@@ -153,12 +153,12 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
 			// Dynamic uniform buffers require a different descriptor type
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, MAX_CONCURRENT_FRAMES)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, framesInFlight_)
 		};
 
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layout
@@ -189,6 +189,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
@@ -281,7 +282,7 @@ public:
 		}
 
 		// Prepare per-object matrices with offsets and random rotations
-		std::default_random_engine rndEngine(benchmark.active ? 0 : (unsigned)time(nullptr));
+		std::default_random_engine rndEngine(randomSeed());
 		std::normal_distribution<float> rndDist(-1.0f, 1.0f);
 		for (uint32_t i = 0; i < OBJECT_INSTANCES; i++) {
 			rotations[i] = glm::vec3(rndDist(rndEngine), rndDist(rndEngine), rndDist(rndEngine)) * 2.0f * (float)M_PI;
@@ -291,6 +292,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// Fixed ubo with projection and view matrices
 		uboVS.projection = camera_.matrices_.perspective;
 		uboVS.view = camera_.matrices_.view;
@@ -311,7 +313,7 @@ public:
 					glm::mat4* modelMat = (glm::mat4*)(((uint64_t)uboDataDynamic.model + (index * dynamicAlignment)));
 
 					// Update rotations
-					rotations[index] += frameTimer * rotationSpeeds[index];
+					rotations[index] += animationStep_ * rotationSpeeds[index];
 
 					// Update matrices
 					glm::vec3 pos = glm::vec3(-((dim * offset.x) / 2.0f) + offset.x / 2.0f + x * offset.x, -((dim * offset.y) / 2.0f) + offset.y / 2.0f + y * offset.y, -((dim * offset.z) / 2.0f) + offset.z / 2.0f + z * offset.z);
@@ -324,10 +326,8 @@ public:
 		}
 		memcpy(uniformBuffers_[currentBuffer_].dynamic.mapped, uboDataDynamic.model, uniformBuffers_[currentBuffer_].dynamic.size);
 		// Flush to make changes visible to the host
-		VkMappedMemoryRange memoryRange = vks::initializers::mappedMemoryRange();
-		memoryRange.memory = uniformBuffers_[currentBuffer_].dynamic.memory;
-		memoryRange.size = uniformBuffers_[currentBuffer_].dynamic.size;
-		vkFlushMappedMemoryRanges(device_, 1, &memoryRange);
+		// The buffer's memory is sub-allocated, so the flushed range needs to be relative to the buffer's offset in the memory block (see vks::Buffer::flush)
+		uniformBuffers_[currentBuffer_].dynamic.flush(uniformBuffers_[currentBuffer_].dynamic.size);
 	}
 
 	void prepare()
@@ -342,6 +342,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
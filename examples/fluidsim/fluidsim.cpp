@@ -119,19 +119,18 @@ class VulkanExample : public VulkanExampleBase {
     VelocityArrowsUBO velocityArrows;
   } ubos_;
 
-  struct UniformBuffers {
-    vks::Buffer colorInit;
-    vks::Buffer velocityInit;
-    vks::Buffer advection;
-    vks::Buffer impulse;
-    vks::Buffer boundary;
-    vks::Buffer jacobi;
-    vks::Buffer divergence;
-    vks::Buffer gradient;
-    vks::Buffer textureViewSwitcher;
-    vks::Buffer velocityArrows;
-  };
-  std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_{};
+  // Dynamic offsets of this frame's uniform data in the base uniform ring
+  struct {
+    uint32_t colorInit;
+    uint32_t velocityInit;
+    uint32_t advection;
+    uint32_t impulse;
+    uint32_t jacobi;
+    uint32_t divergence;
+    uint32_t gradient;
+    uint32_t textureViewSwitcher;
+    uint32_t velocityArrows;
+  } uniformOffsets_{};
 
   vks::Buffer vertex_buffer_;
 
@@ -148,6 +147,12 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSetLayout colorPass;
   } descriptorSetLayouts_{};
 
+  struct {
+    std::vector<VkDescriptorSetLayoutBinding> colorInit, advection, boundary,
+        impulse, jacobi, divergence, gradient, textureViewSwitcher,
+        velocityArrows, colorPass;
+  } setLayoutBindings_;
+
   struct DescriptorSets {
     VkDescriptorSet colorInit;
     VkDescriptorSet velocityInit;
@@ -164,7 +169,7 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSet velocityArrows;
     VkDescriptorSet colorPass;
   };
-  std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  DescriptorSets descriptorSets_{};
 
   struct {
     VkPipelineLayout colorInit;
@@ -238,9 +243,9 @@ class VulkanExample : public VulkanExampleBase {
   // (Part A)
   void prepare() override {
     VulkanExampleBase::prepare();
-    prepareUniformBuffers();
     prepareVertices();
     prepareOffscreen();
+    setupDescriptorSetLayouts();
     setupDescriptors();
     preparePipelines();
     prepareDebug();
@@ -274,92 +279,6 @@ class VulkanExample : public VulkanExampleBase {
     VK_CHECK_RESULT(vertex_buffer_.map());
   }
 
-  void prepareUniformBuffers() {
-    for (auto& buffer : uniformBuffers_) {
-      // Color Init
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.colorInit, sizeof(ColorInitUBO), &ubos_.colorInit));
-      VK_CHECK_RESULT(buffer.colorInit.map());
-
-      // Velocity Init
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.velocityInit, sizeof(ColorInitUBO), &ubos_.colorInit));
-      VK_CHECK_RESULT(buffer.velocityInit.map());
-
-      // Advection
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.advection, sizeof(AdvectionUBO), &ubos_.advection));
-      VK_CHECK_RESULT(buffer.advection.map());
-
-      // Boundary
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.boundary, sizeof(BoundaryUBO), &ubos_.boundary));
-      VK_CHECK_RESULT(buffer.boundary.map());
-
-      // Jacobi
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.jacobi, sizeof(JacobiUBO), &ubos_.jacobi));
-      VK_CHECK_RESULT(buffer.jacobi.map());
-
-      // Divergence
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.divergence, sizeof(DivergenceUBO), &ubos_.divergence));
-      VK_CHECK_RESULT(buffer.divergence.map());
-
-      // Gradient
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.gradient, sizeof(GradientUBO), &ubos_.gradient));
-      VK_CHECK_RESULT(buffer.gradient.map());
-
-      // Impulse
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.impulse, sizeof(ImpulseUBO), &ubos_.impulse));
-      VK_CHECK_RESULT(buffer.impulse.map());
-
-      // texture view switcher
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.textureViewSwitcher, sizeof(TextureViewSwitcherUBO),
-          &ubos_.textureViewSwitcher));
-      VK_CHECK_RESULT(buffer.textureViewSwitcher.map());
-
-      // Velocity arrows
-      VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-          &buffer.velocityArrows, sizeof(VelocityArrowsUBO),
-          &ubos_.velocityArrows));
-      VK_CHECK_RESULT(buffer.velocityArrows.map());
-    }
-  }
-
   void prepareOffscreen() {
     // Create a separate render pass for the offscreen rendering as it may
     // differ from the one used for scene rendering
@@ -480,522 +399,199 @@ class VulkanExample : public VulkanExampleBase {
     }
   }
 
-  void setupDescriptors() {
-    std::vector<VkDescriptorPoolSize> poolSizes = {
-        vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            /* descriptorCount */ MAX_CONCURRENT_FRAMES *
-                /*max number of uniform buffers*/ 1),
-        vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            /* descriptorCount */ MAX_CONCURRENT_FRAMES *
-                /*max number of textures*/ 3)};
-    VkDescriptorPoolCreateInfo descriptorPoolInfo =
-        vks::initializers::descriptorPoolCreateInfo(
-            poolSizes,
-            /* max number of descriptor sets that can be allocated at once*/
-            15 * MAX_CONCURRENT_FRAMES);
-    VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
-                                           nullptr, &descriptorPool_));
-    // Layout: Color init
-    std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
-        // Binding 0 : uniform buffer
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
+  void setupDescriptorSetLayouts() {
+    // Bindings are kept, as they are also passed to the descriptor allocator
+    // when writing sets
+    auto uniformBinding = [](VkShaderStageFlags stages) {
+      return vks::initializers::descriptorSetLayoutBinding(
+          VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, stages,
+          /*binding id*/ 0);
     };
-
-    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCI =
-        vks::initializers::descriptorSetLayoutCreateInfo(
-            setLayoutBindings.data(),
-            static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.colorInit));
-
-    // Layout: Velocity Init
-    setLayoutBindings = {
-        // Binding 0 : Fragment shader
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
+    auto textureBinding = [](VkShaderStageFlags stages, uint32_t binding) {
+      return vks::initializers::descriptorSetLayoutBinding(
+          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, stages, binding);
     };
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.colorInit));
+    const VkShaderStageFlags fragment = VK_SHADER_STAGE_FRAGMENT_BIT;
 
+    // Layout: Color init, also used for velocity init
+    // Binding 0 : uniform buffer
+    setLayoutBindings_.colorInit = {uniformBinding(fragment)};
     // Layout: Advection
-    setLayoutBindings = {
-        // Binding 0 : Fragment shader
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : Fragment shader field texture 1
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1),
-        // Binding 2 : Fragment shader field texture 2
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 2),
-    };
-
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.advection));
-
+    // Binding 1 : field texture 1, Binding 2 : field texture 2
+    setLayoutBindings_.advection = {uniformBinding(fragment),
+                                    textureBinding(fragment, 1),
+                                    textureBinding(fragment, 2)};
     // Layout: Impulse
-    setLayoutBindings = {
-        // Binding 0 : Fragment shader
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : Fragment shader field texture 1
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1)};
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.impulse));
+    // Binding 1 : field texture
+    setLayoutBindings_.impulse = {uniformBinding(fragment),
+                                  textureBinding(fragment, 1)};
     // Layout: Boundary
-    setLayoutBindings = {
-        // Binding 0 : Fragment shader
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : Fragment shader field texture 1
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1)};
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.boundary));
-
+    // Binding 1 : field texture
+    setLayoutBindings_.boundary = {uniformBinding(fragment),
+                                   textureBinding(fragment, 1)};
     // Layout: Jacobi
-    setLayoutBindings = {
-        // Binding 0 : Fragment shader
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : Fragment shader field texture 1
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1),
-        // Binding 2 : Fragment shader field texture 2
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 2),
-    };
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI,
-                                                nullptr,
-                                                &descriptorSetLayouts_.jacobi));
-
+    // Binding 1 : field texture 1, Binding 2 : field texture 2
+    setLayoutBindings_.jacobi = {uniformBinding(fragment),
+                                 textureBinding(fragment, 1),
+                                 textureBinding(fragment, 2)};
     // Layout: Divergence
-    setLayoutBindings = {
-        // Binding 0 : Fragment shader
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : Fragment shader field texture 1
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1),
-    };
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.divergence));
-
+    // Binding 1 : velocity field
+    setLayoutBindings_.divergence = {uniformBinding(fragment),
+                                     textureBinding(fragment, 1)};
     // Layout: Gradient
-    setLayoutBindings = {
-        // Binding 0 : Uniform
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : velocity field
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1),
-        // Binding 2 : pressure field
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 2),
-    };
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.gradient));
-
+    // Binding 1 : velocity field, Binding 2 : pressure field
+    setLayoutBindings_.gradient = {uniformBinding(fragment),
+                                   textureBinding(fragment, 1),
+                                   textureBinding(fragment, 2)};
     // Layout: Texture view switcher
-    setLayoutBindings = {
-        // Binding 0 : Uniform
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : Color field
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 1),
-        // Binding 2 : Velocity field
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 2),
-        // Binding 3 : Pressure field
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 3),
-    };
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(vkCreateDescriptorSetLayout(
-        device_, &descriptorSetLayoutCI, nullptr,
-        &descriptorSetLayouts_.textureViewSwitcher));
-
+    // Binding 1 : color field, Binding 2 : velocity field,
+    // Binding 3 : pressure field
+    setLayoutBindings_.textureViewSwitcher = {
+        uniformBinding(fragment), textureBinding(fragment, 1),
+        textureBinding(fragment, 2), textureBinding(fragment, 3)};
     // Layout: Velocity Arrows
-    setLayoutBindings = {
-        // Binding 0 : Uniform
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT,
-            /*binding id*/ 0),
-        // Binding 1 : Velocity field texture map
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_VERTEX_BIT,
-            /*binding id*/ 1),
-    };
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.velocityArrows));
-
+    // Binding 1 : velocity field texture map
+    setLayoutBindings_.velocityArrows = {
+        uniformBinding(VK_SHADER_STAGE_VERTEX_BIT),
+        textureBinding(VK_SHADER_STAGE_VERTEX_BIT, 1)};
     // Layout: Color pass
-    setLayoutBindings = {
-        // Binding 0 : final texture map to show to screen
-        vks::initializers::descriptorSetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            VK_SHADER_STAGE_FRAGMENT_BIT,
-            /*binding id*/ 0),
+    // Binding 0 : final texture map to show to screen
+    setLayoutBindings_.colorPass = {textureBinding(fragment, 0)};
+
+    auto createLayout =
+        [this](const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+               VkDescriptorSetLayout& layout) {
+          VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCI =
+              vks::initializers::descriptorSetLayoutCreateInfo(
+                  bindings.data(), static_cast<uint32_t>(bindings.size()));
+          VK_CHECK_RESULT(vkCreateDescriptorSetLayout(
+              device_, &descriptorSetLayoutCI, nullptr, &layout));
+        };
+    createLayout(setLayoutBindings_.colorInit, descriptorSetLayouts_.colorInit);
+    createLayout(setLayoutBindings_.advection, descriptorSetLayouts_.advection);
+    createLayout(setLayoutBindings_.impulse, descriptorSetLayouts_.impulse);
+    createLayout(setLayoutBindings_.boundary, descriptorSetLayouts_.boundary);
+    createLayout(setLayoutBindings_.jacobi, descriptorSetLayouts_.jacobi);
+    createLayout(setLayoutBindings_.divergence,
+                 descriptorSetLayouts_.divergence);
+    createLayout(setLayoutBindings_.gradient, descriptorSetLayouts_.gradient);
+    createLayout(setLayoutBindings_.textureViewSwitcher,
+                 descriptorSetLayouts_.textureViewSwitcher);
+    createLayout(setLayoutBindings_.velocityArrows,
+                 descriptorSetLayouts_.velocityArrows);
+    createLayout(setLayoutBindings_.colorPass, descriptorSetLayouts_.colorPass);
+  }
+
+  void setupDescriptors() {
+    // Sets are allocated from the base descriptor allocator, which adds pools
+    // as needed instead of relying on hand counted pool sizes. The layouts
+    // don't depend on the window size, so only the sets are recreated on
+    // resize
+
+    // Uniform data is pushed to the base uniform ring every frame and selected
+    // with a dynamic offset at bind time, so all sets point at the same buffer
+    struct {
+      VkDescriptorBufferInfo colorInit, velocityInit, advection, impulse,
+          boundary, jacobi, divergence, gradient, textureViewSwitcher,
+          velocityArrows;
+    } uniformDescriptors = {
+        uniformRing_.descriptor(sizeof(ColorInitUBO)),
+        uniformRing_.descriptor(sizeof(ColorInitUBO)),
+        uniformRing_.descriptor(sizeof(AdvectionUBO)),
+        uniformRing_.descriptor(sizeof(ImpulseUBO)),
+        uniformRing_.descriptor(sizeof(BoundaryUBO)),
+        uniformRing_.descriptor(sizeof(JacobiUBO)),
+        uniformRing_.descriptor(sizeof(DivergenceUBO)),
+        uniformRing_.descriptor(sizeof(GradientUBO)),
+        uniformRing_.descriptor(sizeof(TextureViewSwitcherUBO)),
+        uniformRing_.descriptor(sizeof(VelocityArrowsUBO)),
     };
-    descriptorSetLayoutCI = vks::initializers::descriptorSetLayoutCreateInfo(
-        setLayoutBindings.data(),
-        static_cast<uint32_t>(setLayoutBindings.size()));
-    VK_CHECK_RESULT(
-        vkCreateDescriptorSetLayout(device_, &descriptorSetLayoutCI, nullptr,
-                                    &descriptorSetLayouts_.colorPass));
 
     // Descriptor Sets
-    for (auto i = 0; i < uniformBuffers_.size(); i++) {
-      // Color Init
-      VkDescriptorSetAllocateInfo allocInfo =
-          vks::initializers::descriptorSetAllocateInfo(
-              descriptorPool_, &descriptorSetLayouts_.colorInit, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].colorInit));
-      std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].colorInit, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].colorInit.descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Velocity Init
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.colorInit, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].velocityInit));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].velocityInit,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].velocityInit.descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Advection: Color + Velocity
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.advection, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].advectColor));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].advectColor, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].advection.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].advectColor,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &velocity_field_[0].descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].advectColor,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 2, &color_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Advection: Velocity + Velocity
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.advection, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].advectVelocity));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].advectVelocity,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].advection.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].advectVelocity,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &velocity_field_[0].descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].advectVelocity,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 2, &velocity_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-      // Impulse
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.impulse, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].impulse));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].impulse, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].impulse.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].impulse,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &velocity_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Boundary: Velocty
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.boundary, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].boundaryVelocity));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].boundaryVelocity,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].boundary.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].boundaryVelocity,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &velocity_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Boundary: Pressure
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.boundary, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].boundaryPressure));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].boundaryPressure,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].boundary.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].boundaryPressure,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &pressure_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Boundary: Color
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.boundary, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].boundaryColor));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].boundaryColor,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].boundary.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].boundaryColor,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &color_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Jacobi: Pressure
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.jacobi, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].jacobiPressure));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].jacobiPressure,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].jacobi.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].jacobiPressure,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &pressure_field_[0].descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].jacobiPressure,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 2, &divergence_field_.descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Divergence
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.divergence, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].divergence));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].divergence, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].divergence.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].divergence,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &velocity_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Gradient
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.gradient, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].gradient));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].gradient, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].gradient.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].gradient,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &velocity_field_[0].descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].gradient,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 2, &pressure_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Texture view switcher
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.textureViewSwitcher, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].textureViewSwitcher));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].textureViewSwitcher,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0,
-              &uniformBuffers_[i].textureViewSwitcher.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].textureViewSwitcher,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &color_field_[0].descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].textureViewSwitcher,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 2, &velocity_field_[0].descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].textureViewSwitcher,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 3, &pressure_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Velocity arrows
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.velocityArrows, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(
-          device_, &allocInfo, &descriptorSets_[i].velocityArrows));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].velocityArrows,
-              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-              /*binding id*/ 0, &uniformBuffers_[i].velocityArrows.descriptor),
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].velocityArrows,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 1, &velocity_field_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-
-      // Color pass
-      allocInfo = vks::initializers::descriptorSetAllocateInfo(
-          descriptorPool_, &descriptorSetLayouts_.colorPass, 1);
-      VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo,
-                                               &descriptorSets_[i].colorPass));
-      writeDescriptorSets = {
-          vks::initializers::writeDescriptorSet(
-              descriptorSets_[i].colorPass,
-              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-              /*binding id*/ 0, &color_pass_[0].descriptor),
-      };
-      vkUpdateDescriptorSets(device_,
-                             static_cast<uint32_t>(writeDescriptorSets.size()),
-                             writeDescriptorSets.data(), 0, nullptr);
-    }
+    // One set per pass is enough, as the uniform data of every frame is
+    // selected with a dynamic offset into the uniform ring
+    // Descriptors are passed in binding order and written with the
+    // allocator's cached update template for the layout
+    auto allocateSet =
+        [this](VkDescriptorSetLayout layout,
+               const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+               const std::vector<vks::DescriptorInfo>& descriptors) {
+          VkDescriptorSet descriptorSet;
+          VK_CHECK_RESULT(
+              descriptorAllocator_.allocate(layout, bindings, &descriptorSet));
+          descriptorAllocator_.update(descriptorSet, layout, bindings,
+                                      descriptors);
+          return descriptorSet;
+        };
+
+    // Color Init
+    descriptorSets_.colorInit = allocateSet(
+        descriptorSetLayouts_.colorInit, setLayoutBindings_.colorInit,
+        {uniformDescriptors.colorInit});
+    // Velocity Init
+    descriptorSets_.velocityInit = allocateSet(
+        descriptorSetLayouts_.colorInit, setLayoutBindings_.colorInit,
+        {uniformDescriptors.velocityInit});
+    // Advection: Color + Velocity
+    descriptorSets_.advectColor = allocateSet(
+        descriptorSetLayouts_.advection, setLayoutBindings_.advection,
+        {uniformDescriptors.advection, velocity_field_[0].descriptor,
+         color_field_[0].descriptor});
+    // Advection: Velocity + Velocity
+    descriptorSets_.advectVelocity = allocateSet(
+        descriptorSetLayouts_.advection, setLayoutBindings_.advection,
+        {uniformDescriptors.advection, velocity_field_[0].descriptor,
+         velocity_field_[0].descriptor});
+    // Impulse
+    descriptorSets_.impulse = allocateSet(
+        descriptorSetLayouts_.impulse, setLayoutBindings_.impulse,
+        {uniformDescriptors.impulse, velocity_field_[0].descriptor});
+    // Boundary: Velocty
+    descriptorSets_.boundaryVelocity = allocateSet(
+        descriptorSetLayouts_.boundary, setLayoutBindings_.boundary,
+        {uniformDescriptors.boundary, velocity_field_[0].descriptor});
+    // Boundary: Pressure
+    descriptorSets_.boundaryPressure = allocateSet(
+        descriptorSetLayouts_.boundary, setLayoutBindings_.boundary,
+        {uniformDescriptors.boundary, pressure_field_[0].descriptor});
+    // Boundary: Color
+    descriptorSets_.boundaryColor = allocateSet(
+        descriptorSetLayouts_.boundary, setLayoutBindings_.boundary,
+        {uniformDescriptors.boundary, color_field_[0].descriptor});
+    // Jacobi: Pressure
+    descriptorSets_.jacobiPressure = allocateSet(
+        descriptorSetLayouts_.jacobi, setLayoutBindings_.jacobi,
+        {uniformDescriptors.jacobi, pressure_field_[0].descriptor,
+         divergence_field_.descriptor});
+    // Divergence
+    descriptorSets_.divergence = allocateSet(
+        descriptorSetLayouts_.divergence, setLayoutBindings_.divergence,
+        {uniformDescriptors.divergence, velocity_field_[0].descriptor});
+    // Gradient
+    descriptorSets_.gradient = allocateSet(
+        descriptorSetLayouts_.gradient, setLayoutBindings_.gradient,
+        {uniformDescriptors.gradient, velocity_field_[0].descriptor,
+         pressure_field_[0].descriptor});
+    // Texture view switcher
+    descriptorSets_.textureViewSwitcher =
+        allocateSet(descriptorSetLayouts_.textureViewSwitcher,
+                    setLayoutBindings_.textureViewSwitcher,
+                    {uniformDescriptors.textureViewSwitcher,
+                     color_field_[0].descriptor, velocity_field_[0].descriptor,
+                     pressure_field_[0].descriptor});
+    // Velocity arrows
+    descriptorSets_.velocityArrows = allocateSet(
+        descriptorSetLayouts_.velocityArrows,
+        setLayoutBindings_.velocityArrows,
+        {uniformDescriptors.velocityArrows, velocity_field_[0].descriptor});
+    // Color pass
+    descriptorSets_.colorPass =
+        allocateSet(descriptorSetLayouts_.colorPass,
+                    setLayoutBindings_.colorPass, {color_pass_[0].descriptor});
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     VkPipelineLayoutCreateInfo pipelineLayoutCI =
         vks::initializers::pipelineLayoutCreateInfo(
             &descriptorSetLayouts_.colorInit, 1);
@@ -1079,6 +675,9 @@ class VulkanExample : public VulkanExampleBase {
     VkPipelineDynamicStateCreateInfo dynamicState =
         vks::initializers::pipelineDynamicStateCreateInfo(dynamicStateEnables);
     std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages;
+    // Pipelines are queued and then created in parallel, the builder copies
+    // the create info and its state so it can be modified after each add
+    vks::PipelineBuilder pipelineBuilder;
 
     VkGraphicsPipelineCreateInfo pipelineCI =
         vks::initializers::pipelineCreateInfo(pipelineLayouts_.advection,
@@ -1103,95 +702,68 @@ class VulkanExample : public VulkanExampleBase {
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/advection.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.advection));
+    pipelineBuilder.add(pipelineCI, &pipelines_.advection);
 
     // Color init pipeline
     pipelineCI.layout = pipelineLayouts_.colorInit;
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/colorinit.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.colorInit));
+    pipelineBuilder.add(pipelineCI, &pipelines_.colorInit);
 
     // Velocity init pipeline
     pipelineCI.layout = pipelineLayouts_.velocityInit;
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/velocityinit.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.velocityInit));
+    pipelineBuilder.add(pipelineCI, &pipelines_.velocityInit);
 
     // Boundary pipeline
     pipelineCI.layout = pipelineLayouts_.boundary;
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/boundary.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.boundary));
+    pipelineBuilder.add(pipelineCI, &pipelines_.boundary);
 
     // Impulse Pipeline
     pipelineCI.layout = pipelineLayouts_.impulse;
     shaderStages[1] = loadShader(getShadersPath() + "fluidsim/impulse.frag.spv",
                                  VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(
-        device_, pipelineCache_, 1, &pipelineCI, nullptr, &pipelines_.impulse));
-
-    // Boundary pipeline
-    pipelineCI.layout = pipelineLayouts_.boundary;
-    shaderStages[1] =
-        loadShader(getShadersPath() + "fluidsim/boundary.frag.spv",
-                   VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.boundary));
+    pipelineBuilder.add(pipelineCI, &pipelines_.impulse);
 
     // Jacobi pipeline
     pipelineCI.layout = pipelineLayouts_.jacobi;
     shaderStages[1] = loadShader(getShadersPath() + "fluidsim/jacobi.frag.spv",
                                  VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(
-        device_, pipelineCache_, 1, &pipelineCI, nullptr, &pipelines_.jacobi));
+    pipelineBuilder.add(pipelineCI, &pipelines_.jacobi);
 
     // Divergence pipeline
     pipelineCI.layout = pipelineLayouts_.divergence;
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/divergence.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.divergence));
+    pipelineBuilder.add(pipelineCI, &pipelines_.divergence);
 
     // Gradient pipeline
     pipelineCI.layout = pipelineLayouts_.gradient;
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/gradient.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.gradient));
+    pipelineBuilder.add(pipelineCI, &pipelines_.gradient);
 
     // Texture view switcher pipeline
     pipelineCI.layout = pipelineLayouts_.textureViewSwitcher;
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/textureviewswitcher.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.textureViewSwitcher));
+    pipelineBuilder.add(pipelineCI, &pipelines_.textureViewSwitcher);
 
     // Color pass pipeline
     pipelineCI.layout = pipelineLayouts_.colorPass;
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/colorpass.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.colorPass));
+    pipelineBuilder.add(pipelineCI, &pipelines_.colorPass);
 
     // Arrow vector pipeline
     auto bindingDescription = Vertex::getBindingDescription();
@@ -1211,9 +783,9 @@ class VulkanExample : public VulkanExampleBase {
     shaderStages[1] =
         loadShader(getShadersPath() + "fluidsim/velocityarrows.frag.spv",
                    VK_SHADER_STAGE_FRAGMENT_BIT);
-    VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1,
-                                              &pipelineCI, nullptr,
-                                              &pipelines_.velocityArrows));
+    pipelineBuilder.add(pipelineCI, &pipelines_.velocityArrows);
+
+    pipelineBuilder.build(device_, pipelineCache_, settings_.pipelineThreads);
   }
 
   void prepareDebug() {
@@ -1250,42 +822,33 @@ class VulkanExample : public VulkanExampleBase {
 
   // B.1
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     ubos_.colorInit.bufferResolution = glm::vec2(width_, height_);
-    memcpy(uniformBuffers_[currentBuffer_].colorInit.mapped, &ubos_.colorInit,
-           sizeof(ColorInitUBO));
-
-    memcpy(uniformBuffers_[currentBuffer_].velocityInit.mapped,
-           &ubos_.colorInit, sizeof(ColorInitUBO));
+    uniformOffsets_.colorInit = uniformRing_.push(ubos_.colorInit);
+    uniformOffsets_.velocityInit = uniformRing_.push(ubos_.colorInit);
 
     ubos_.advection.bufferResolution = glm::vec2(width_, height_);
-    memcpy(uniformBuffers_[currentBuffer_].advection.mapped, &ubos_.advection,
-           sizeof(AdvectionUBO));
+    uniformOffsets_.advection = uniformRing_.push(ubos_.advection);
 
+    // Boundary data is pushed per pass as the scale differs between fields
     ubos_.boundary.bufferResolution = glm::vec2(width_, height_);
-    memcpy(uniformBuffers_[currentBuffer_].boundary.mapped, &ubos_.boundary,
-           sizeof(BoundaryUBO));
 
     ubos_.jacobi.bufferResolution = glm::vec2(width_, height_);
-    memcpy(uniformBuffers_[currentBuffer_].jacobi.mapped, &ubos_.jacobi,
-           sizeof(JacobiUBO));
+    uniformOffsets_.jacobi = uniformRing_.push(ubos_.jacobi);
 
     ubos_.gradient.bufferResolution = glm::vec2(width_, height_);
-    memcpy(uniformBuffers_[currentBuffer_].gradient.mapped, &ubos_.gradient,
-           sizeof(GradientUBO));
+    uniformOffsets_.gradient = uniformRing_.push(ubos_.gradient);
 
     ubos_.divergence.bufferResolution = glm::vec2(width_, height_);
-    memcpy(uniformBuffers_[currentBuffer_].divergence.mapped, &ubos_.divergence,
-           sizeof(DivergenceUBO));
+    uniformOffsets_.divergence = uniformRing_.push(ubos_.divergence);
 
     ubos_.impulse.bufferResolution = glm::vec2(width_, height_);
-    memcpy(uniformBuffers_[currentBuffer_].impulse.mapped, &ubos_.impulse,
-           sizeof(ImpulseUBO));
+    uniformOffsets_.impulse = uniformRing_.push(ubos_.impulse);
 
-    memcpy(uniformBuffers_[currentBuffer_].textureViewSwitcher.mapped,
-           &ubos_.textureViewSwitcher, sizeof(TextureViewSwitcherUBO));
+    uniformOffsets_.textureViewSwitcher =
+        uniformRing_.push(ubos_.textureViewSwitcher);
 
-    memcpy(uniformBuffers_[currentBuffer_].velocityArrows.mapped,
-           &ubos_.velocityArrows, sizeof(VelocityArrowsUBO));
+    uniformOffsets_.velocityArrows = uniformRing_.push(ubos_.velocityArrows);
   }
 
   void OnUpdateUIOverlay(vks::UIOverlay* overlay) override {
@@ -1305,6 +868,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // B.2
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -1313,8 +877,7 @@ class VulkanExample : public VulkanExampleBase {
 
     if (shouldInitColorField_) {
       ubos_.colorInit.whichTexture = 0;
-      memcpy(uniformBuffers_[currentBuffer_].colorInit.mapped, &ubos_.colorInit,
-             sizeof(BoundaryUBO));
+      uniformOffsets_.colorInit = uniformRing_.push(ubos_.colorInit);
       initColorCmd(cmdBuffer);
       copyImage(cmdBuffer, color_field_);
       shouldInitColorField_ = false;
@@ -1400,9 +963,10 @@ class VulkanExample : public VulkanExampleBase {
     VkRect2D scissor = vks::initializers::rect2D(width_, height_, 0, 0);
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
-    vkCmdBindDescriptorSets(
-        cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayouts_.colorInit,
-        0, 1, &descriptorSets_[currentBuffer_].colorInit, 0, nullptr);
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipelineLayouts_.colorInit, 0, 1,
+                            &descriptorSets_.colorInit, 1,
+                            &uniformOffsets_.colorInit);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.colorInit);
@@ -1453,8 +1017,8 @@ class VulkanExample : public VulkanExampleBase {
 
     vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                             pipelineLayouts_.velocityInit, 0, 1,
-                            &descriptorSets_[currentBuffer_].velocityInit, 0,
-                            nullptr);
+                            &descriptorSets_.velocityInit, 1,
+                            &uniformOffsets_.velocityInit);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.velocityInit);
@@ -1480,14 +1044,14 @@ class VulkanExample : public VulkanExampleBase {
   void advectColorCmd(VkCommandBuffer& cmdBuffer) {
     cmdBeginLabel(cmdBuffer, "Advecting Color", debugColor);
     advectionCmd(cmdBuffer, color_field_,
-                 &descriptorSets_[currentBuffer_].advectColor);
+                 &descriptorSets_.advectColor);
     cmdEndLabel(cmdBuffer);
   }
 
   void advectVelocityCmd(VkCommandBuffer& cmdBuffer) {
     cmdBeginLabel(cmdBuffer, "Advecting velocity", debugColor);
     advectionCmd(cmdBuffer, velocity_field_,
-                 &descriptorSets_[currentBuffer_].advectVelocity);
+                 &descriptorSets_.advectVelocity);
     cmdEndLabel(cmdBuffer);
   }
 
@@ -1519,8 +1083,8 @@ class VulkanExample : public VulkanExampleBase {
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
     vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            pipelineLayouts_.advection, 0, 1, descriptor_set, 0,
-                            nullptr);
+                            pipelineLayouts_.advection, 0, 1, descriptor_set, 1,
+                            &uniformOffsets_.advection);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.advection);
@@ -1568,9 +1132,10 @@ class VulkanExample : public VulkanExampleBase {
     VkRect2D scissor = vks::initializers::rect2D(width_, height_, 0, 0);
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
-    vkCmdBindDescriptorSets(
-        cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayouts_.impulse, 0,
-        1, &descriptorSets_[currentBuffer_].impulse, 0, nullptr);
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipelineLayouts_.impulse, 0, 1,
+                            &descriptorSets_.impulse, 1,
+                            &uniformOffsets_.impulse);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.impulse);
@@ -1594,31 +1159,28 @@ class VulkanExample : public VulkanExampleBase {
 
   void velocityBoundaryCmd(VkCommandBuffer& cmdBuffer) {
     ubos_.boundary.scale = -1;
-    memcpy(uniformBuffers_[currentBuffer_].boundary.mapped, &ubos_.boundary,
-           sizeof(BoundaryUBO));
     boundaryCmd(cmdBuffer, velocity_field_,
-                &descriptorSets_[currentBuffer_].boundaryVelocity);
+                &descriptorSets_.boundaryVelocity,
+                uniformRing_.push(ubos_.boundary));
   }
 
   void pressureBoundaryCmd(VkCommandBuffer& cmdBuffer) {
     ubos_.boundary.scale = 1;
-    memcpy(uniformBuffers_[currentBuffer_].boundary.mapped, &ubos_.boundary,
-           sizeof(BoundaryUBO));
     boundaryCmd(cmdBuffer, pressure_field_,
-                &descriptorSets_[currentBuffer_].boundaryPressure);
+                &descriptorSets_.boundaryPressure,
+                uniformRing_.push(ubos_.boundary));
   }
 
   void colorBoundaryCmd(VkCommandBuffer& cmdBuffer) {
     ubos_.boundary.scale = 1;
-    memcpy(uniformBuffers_[currentBuffer_].boundary.mapped, &ubos_.boundary,
-           sizeof(BoundaryUBO));
     boundaryCmd(cmdBuffer, color_field_,
-                &descriptorSets_[currentBuffer_].boundaryColor);
+                &descriptorSets_.boundaryColor,
+                uniformRing_.push(ubos_.boundary));
   }
 
   void boundaryCmd(VkCommandBuffer& cmdBuffer,
                    std::array<FrameBuffer, 2>& output_field,
-                   VkDescriptorSet* descriptor_set) {
+                   VkDescriptorSet* descriptor_set, uint32_t uniformOffset) {
     /*
     VkClearValue clearValues{};
     clearValues.color = {0.0f, 0.0f, 0.0f, 0.f};
@@ -1645,8 +1207,8 @@ class VulkanExample : public VulkanExampleBase {
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
     vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            pipelineLayouts_.boundary, 0, 1, descriptor_set, 0,
-                            nullptr);
+                            pipelineLayouts_.boundary, 0, 1, descriptor_set, 1,
+                            &uniformOffset);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.boundary);
@@ -1693,9 +1255,10 @@ class VulkanExample : public VulkanExampleBase {
     VkRect2D scissor = vks::initializers::rect2D(width_, height_, 0, 0);
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
-    vkCmdBindDescriptorSets(
-        cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayouts_.jacobi, 0,
-        1, &descriptorSets_[currentBuffer_].jacobiPressure, 0, nullptr);
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipelineLayouts_.jacobi, 0, 1,
+                            &descriptorSets_.jacobiPressure, 1,
+                            &uniformOffsets_.jacobi);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.jacobi);
@@ -1742,9 +1305,10 @@ class VulkanExample : public VulkanExampleBase {
     VkRect2D scissor = vks::initializers::rect2D(width_, height_, 0, 0);
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
-    vkCmdBindDescriptorSets(
-        cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayouts_.divergence,
-        0, 1, &descriptorSets_[currentBuffer_].divergence, 0, nullptr);
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipelineLayouts_.divergence, 0, 1,
+                            &descriptorSets_.divergence, 1,
+                            &uniformOffsets_.divergence);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.divergence);
@@ -1791,9 +1355,10 @@ class VulkanExample : public VulkanExampleBase {
     VkRect2D scissor = vks::initializers::rect2D(width_, height_, 0, 0);
     vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
-    vkCmdBindDescriptorSets(
-        cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayouts_.gradient,
-        0, 1, &descriptorSets_[currentBuffer_].gradient, 0, nullptr);
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipelineLayouts_.gradient, 0, 1,
+                            &descriptorSets_.gradient, 1,
+                            &uniformOffsets_.gradient);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.gradient);
@@ -1843,7 +1408,8 @@ class VulkanExample : public VulkanExampleBase {
     vkCmdBindDescriptorSets(
         cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
         pipelineLayouts_.textureViewSwitcher, 0, 1,
-        &descriptorSets_[currentBuffer_].textureViewSwitcher, 0, nullptr);
+        &descriptorSets_.textureViewSwitcher, 1,
+        &uniformOffsets_.textureViewSwitcher);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.textureViewSwitcher);
@@ -1892,8 +1458,8 @@ class VulkanExample : public VulkanExampleBase {
 
     vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                             pipelineLayouts_.velocityArrows, 0, 1,
-                            &descriptorSets_[currentBuffer_].velocityArrows, 0,
-                            nullptr);
+                            &descriptorSets_.velocityArrows, 1,
+                            &uniformOffsets_.velocityArrows);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.velocityArrows);
@@ -1945,7 +1511,7 @@ class VulkanExample : public VulkanExampleBase {
 
     vkCmdBindDescriptorSets(
         cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayouts_.colorPass,
-        0, 1, &descriptorSets_[currentBuffer_].colorPass, 0, nullptr);
+        0, 1, &descriptorSets_.colorPass, 0, nullptr);
 
     vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       pipelines_.colorPass);
@@ -2002,7 +1568,7 @@ class VulkanExample : public VulkanExampleBase {
     destroyVertexBuffer();
     destroyOffscreenPass();
     prepareOffscreen();
-    vkResetDescriptorPool(device_, descriptorPool_, 0);
+    descriptorAllocator_.reset();
     setupDescriptors();
     prepareVertices();
 
@@ -2079,8 +1645,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &frameBuf->color.mem));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &frameBuf->color.mem, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(vkBindImageMemory(device_, frameBuf->color.image,
                                       frameBuf->color.mem, 0));
 
@@ -2135,24 +1701,18 @@ class VulkanExample : public VulkanExampleBase {
       vkDestroyPipelineLayout(device_, pipelineLayouts_.divergence, nullptr);
       vkDestroyPipelineLayout(device_, pipelineLayouts_.textureViewSwitcher,
                               nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.colorInit,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.advection,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.boundary,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.divergence,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(device_, descriptorSetLayouts_.jacobi,
-                                   nullptr);
-      vkDestroyDescriptorSetLayout(
-          device_, descriptorSetLayouts_.textureViewSwitcher, nullptr);
-      for (auto& buffer : uniformBuffers_) {
-        buffer.colorInit.destroy();
-        buffer.advection.destroy();
-        buffer.boundary.destroy();
-        buffer.divergence.destroy();
-        buffer.jacobi.destroy();
+      for (VkDescriptorSetLayout layout :
+           {descriptorSetLayouts_.colorInit, descriptorSetLayouts_.advection,
+            descriptorSetLayouts_.boundary, descriptorSetLayouts_.impulse,
+            descriptorSetLayouts_.jacobi, descriptorSetLayouts_.divergence,
+            descriptorSetLayouts_.gradient,
+            descriptorSetLayouts_.textureViewSwitcher,
+            descriptorSetLayouts_.velocityArrows,
+            descriptorSetLayouts_.colorPass}) {
+        // The base descriptor allocator outlives the example, so drop its
+        // update templates for the layout first
+        descriptorAllocator_.forget(layout);
+        vkDestroyDescriptorSetLayout(device_, layout, nullptr);
       }
     }
   }
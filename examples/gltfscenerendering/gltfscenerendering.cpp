@@ -25,14 +25,11 @@ VulkanglTFScene::~VulkanglTFScene()
 	}
 	// Release all Vulkan resources allocated for the model
 	vkDestroyBuffer(vulkanDevice->logicalDevice, vertices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, vertices.memory, nullptr);
+	vulkanDevice->freeMemory(vertices.memory);
 	vkDestroyBuffer(vulkanDevice->logicalDevice, indices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, indices.memory, nullptr);
+	vulkanDevice->freeMemory(indices.memory);
 	for (Image image : images) {
-		vkDestroyImageView(vulkanDevice->logicalDevice, image.texture.view, nullptr);
-		vkDestroyImage(vulkanDevice->logicalDevice, image.texture.image, nullptr);
-		vkDestroySampler(vulkanDevice->logicalDevice, image.texture.sampler, nullptr);
-		vkFreeMemory(vulkanDevice->logicalDevice, image.texture.deviceMemory, nullptr);
+		image.texture.destroy();
 	}
 	for (Material material : materials) {
 		vkDestroyPipeline(vulkanDevice->logicalDevice, material.pipeline, nullptr);
@@ -292,6 +289,7 @@ VulkanExample::VulkanExample() : VulkanExampleBase()
 	camera_.setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
 	camera_.setRotation(glm::vec3(0.0f, -90.0f, 0.0f));
 	camera_.setPerspective(60.0f, (float)width_ / (float)height_, 0.1f, 256.0f);
+	animated = false;
 }
 
 VulkanExample::~VulkanExample()
@@ -418,6 +416,7 @@ void VulkanExample::loadglTFFile(std::string filename)
 
 void VulkanExample::loadAssets()
 {
+	ScopedStartupPhase startupPhase(this, "loadAssets");
 	loadglTFFile(getAssetPath() + "models/sponza/sponza.gltf");
 }
 
@@ -430,11 +429,11 @@ void VulkanExample::setupDescriptors()
 	// One ubo to pass dynamic data to the shader
 	// Two combined image samplers per material as each material uses color and normal maps
 	std::vector<VkDescriptorPoolSize> poolSizes = {
-		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
-		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(glTFScene.materials.size()) * 2 * MAX_CONCURRENT_FRAMES),
+		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
+		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(glTFScene.materials.size()) * 2 * framesInFlight_),
 	};
 	// One set for matrices and one per model image/texture
-	const uint32_t maxSetCount = static_cast<uint32_t>(glTFScene.images.size()) + MAX_CONCURRENT_FRAMES;
+	const uint32_t maxSetCount = static_cast<uint32_t>(glTFScene.images.size()) + framesInFlight_;
 	VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, maxSetCount);
 	VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
@@ -481,6 +480,7 @@ void VulkanExample::setupDescriptors()
 
 void VulkanExample::preparePipelines()
 {
+	ScopedStartupPhase startupPhase(this, "preparePipelines");
 	// Layout
 	// Pipeline layout uses both descriptor sets (set 0 = matrices, set 1 = material)
 	std::array<VkDescriptorSetLayout, 2> setLayouts = { descriptorSetLayouts_.matrices, descriptorSetLayouts_.textures };
@@ -567,6 +567,7 @@ void VulkanExample::prepareUniformBuffers()
 
 void VulkanExample::updateUniformBuffers()
 {
+	vks::ProfilerZone profilerZone("updateUniformBuffers");
 	uniformData_.projection = camera_.matrices_.perspective;
 	uniformData_.view = camera_.matrices_.view;
 	uniformData_.viewPos = camera_.viewPos_;
@@ -585,6 +586,7 @@ void VulkanExample::prepare()
 
 void VulkanExample::buildCommandBuffer()
 {
+	vks::ProfilerZone profilerZone("buildCommandBuffer");
 	VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 	
 	VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -624,7 +626,8 @@ void VulkanExample::render()
 {
 	VulkanExampleBase::prepareFrame();
 	updateUniformBuffers();
-	buildCommandBuffer();
+	// The scene is static, so the command buffer only needs to be recorded again if the visibility of nodes or the UI changed
+	updateCommandBuffer([this] { buildCommandBuffer(); });
 	VulkanExampleBase::submitFrame();
 }
 
@@ -41,14 +41,11 @@ glm::mat4 VulkanglTFModel::Node::getLocalMatrix()
 VulkanglTFModel::~VulkanglTFModel()
 {
 	vkDestroyBuffer(vulkanDevice->logicalDevice, vertices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, vertices.memory, nullptr);
+	vulkanDevice->freeMemory(vertices.memory);
 	vkDestroyBuffer(vulkanDevice->logicalDevice, indices.buffer, nullptr);
-	vkFreeMemory(vulkanDevice->logicalDevice, indices.memory, nullptr);
+	vulkanDevice->freeMemory(indices.memory);
 	for (auto& image : images) {
-		vkDestroyImageView(vulkanDevice->logicalDevice, image.texture.view, nullptr);
-		vkDestroyImage(vulkanDevice->logicalDevice, image.texture.image, nullptr);
-		vkDestroySampler(vulkanDevice->logicalDevice, image.texture.sampler, nullptr);
-		vkFreeMemory(vulkanDevice->logicalDevice, image.texture.deviceMemory, nullptr);
+		image.texture.destroy();
 	}
 	for (auto& skin : skins) {
 		for (auto& buffer : skin.storageBuffers) {
@@ -202,6 +199,8 @@ void VulkanglTFModel::loadSkins(tinygltf::Model &input)
 			// Store inverse bind matrices for this skin in a shader storage buffer object
 			// Just like other buffers that can be updated on the CPU while the GPU reads we need to duplicate them per frames in flight
 			// To keep things simple, we use separate buffers, in a real-world application a better solution would be using one large storage buffer with separate regions per frames in flight
+			skins[i].storageBuffers.resize(framesInFlight);
+			skins[i].descriptorSets.resize(framesInFlight);
 			for (auto& buffer : skins[i].storageBuffers) {
 				VK_CHECK_RESULT(vulkanDevice->createBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, sizeof(glm::mat4) * skins[i].inverseBindMatrices.size(), skins[i].inverseBindMatrices.data()));
 				VK_CHECK_RESULT(buffer.map());
@@ -689,8 +688,9 @@ void VulkanExample::loadglTFFile(std::string filename)
 	bool fileLoaded = gltfContext.LoadASCIIFromFile(&glTFInput, &error, &warning, filename);
 
 	// Pass some Vulkan resources required for setup and rendering to the glTF model loading class
-	glTFModel.vulkanDevice = vulkanDevice_;
-	glTFModel.copyQueue    = queue_;
+	glTFModel.vulkanDevice   = vulkanDevice_;
+	glTFModel.copyQueue      = queue_;
+	glTFModel.framesInFlight = framesInFlight_;
 
 	std::vector<uint32_t>                indexBuffer;
 	std::vector<VulkanglTFModel::Vertex> vertexBuffer;
@@ -776,15 +776,15 @@ void VulkanExample::setupDescriptors()
 	*/
 
 	std::vector<VkDescriptorPoolSize> poolSizes = {
-	    vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
+	    vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
 	    // One combined image sampler per material image/texture
-	    vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(glTFModel.images.size()) * MAX_CONCURRENT_FRAMES),
+	    vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(glTFModel.images.size()) * framesInFlight_),
 	    // One ssbo per skin
-	    vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(glTFModel.skins.size()) * MAX_CONCURRENT_FRAMES),
+	    vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(glTFModel.skins.size()) * framesInFlight_),
 	};
 	// Number of descriptor sets = One for the scene ubo + one per image + one per skin
 	const uint32_t             maxSetCount        = static_cast<uint32_t>(glTFModel.images.size()) + static_cast<uint32_t>(glTFModel.skins.size()) + 1;
-	VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, maxSetCount * MAX_CONCURRENT_FRAMES);
+	VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, maxSetCount * framesInFlight_);
 	VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 	// Descriptor set layouts
@@ -831,6 +831,7 @@ void VulkanExample::setupDescriptors()
 
 void VulkanExample::preparePipelines()
 {
+	ScopedStartupPhase startupPhase(this, "preparePipelines");
 	// Layout
 	// The pipeline layout uses three sets:
 	// Set 0 = Scene matrices (VS)
@@ -917,6 +918,7 @@ void VulkanExample::prepareUniformBuffers()
 
 void VulkanExample::updateUniformBuffers()
 {
+	vks::ProfilerZone profilerZone("updateUniformBuffers");
 	uniformData_.projection = camera_.matrices_.perspective;
 	uniformData_.model      = camera_.matrices_.view;
 	memcpy(uniformBuffers_[currentBuffer_].mapped, &uniformData_, sizeof(UniformData));
@@ -924,6 +926,7 @@ void VulkanExample::updateUniformBuffers()
 
 void VulkanExample::loadAssets()
 {
+	ScopedStartupPhase startupPhase(this, "loadAssets");
 	loadglTFFile(getAssetPath() + "models/CesiumMan/glTF/CesiumMan.gltf");
 }
 
@@ -980,7 +983,7 @@ void VulkanExample::render()
 	updateUniformBuffers();
 	// POI: Advance animation
 	if (!paused) {
-		glTFModel.updateAnimation(frameTimer, currentBuffer_);
+		glTFModel.updateAnimation(animationStep_, currentBuffer_);
 	}
 	buildCommandBuffer();
 	VulkanExampleBase::submitFrame();
@@ -46,6 +46,8 @@ class VulkanglTFModel
   public:
 	vks::VulkanDevice *vulkanDevice;
 	VkQueue            copyQueue;
+	// Number of frames in flight, per-frame skin buffers are duplicated this many times
+	uint32_t           framesInFlight{ 0 };
 
 	/*
 		Base glTF structures, see gltfscene sample for details
@@ -130,8 +132,8 @@ class VulkanglTFModel
 		std::vector<glm::mat4> inverseBindMatrices;
 		std::vector<Node *> joints;
 		// Animation data changes between frames, it needs to be duplicated (per frame in flight)
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> storageBuffers;
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{};
+		std::vector<vks::Buffer> storageBuffers;
+		std::vector<VkDescriptorSet> descriptorSets;
 	};
 
 	/*
@@ -199,7 +201,7 @@ class VulkanExample : public VulkanExampleBase
 		glm::mat4 model;
 		glm::vec4 lightPos = glm::vec4(5.0f, 5.0f, 5.0f, 1.0f);
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	struct Pipelines
@@ -214,7 +216,7 @@ class VulkanExample : public VulkanExampleBase
 		VkDescriptorSetLayout textures{ VK_NULL_HANDLE };
 		VkDescriptorSetLayout jointMatrices{ VK_NULL_HANDLE };
 	} descriptorSetLayouts_;
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	VulkanglTFModel glTFModel;
 
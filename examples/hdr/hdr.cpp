@@ -38,7 +38,8 @@ class VulkanExample : public VulkanExampleBase {
     glm::mat4 inverseModelview;
     float exposure{1.0f};
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   struct {
     VkPipelineLayout models{VK_NULL_HANDLE};
@@ -66,7 +67,8 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSet composition{VK_NULL_HANDLE};
     VkDescriptorSet bloomFilter{VK_NULL_HANDLE};
   };
-  std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<DescriptorSets> descriptorSets_ =
+      std::vector<DescriptorSets>(framesInFlight_);
 
   // Framebuffer for offscreen rendering
   struct FrameBufferAttachment {
@@ -74,10 +76,10 @@ class VulkanExample : public VulkanExampleBase {
     VkDeviceMemory mem;
     VkImageView view;
     VkFormat format;
-    void destroy(VkDevice device) {
-      vkDestroyImageView(device, view, nullptr);
-      vkDestroyImage(device, image, nullptr);
-      vkFreeMemory(device, mem, nullptr);
+    void destroy(vks::VulkanDevice* device) {
+      vkDestroyImageView(device->logicalDevice, view, nullptr);
+      vkDestroyImage(device->logicalDevice, image, nullptr);
+      device->freeMemory(mem);
     }
   };
   struct FrameBuffer {
@@ -147,8 +149,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &attachment->mem));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &attachment->mem, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(
         vkBindImageMemory(device_, attachment->image, attachment->mem, 0));
 
@@ -177,6 +179,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     // Load glTF models
     const uint32_t glTFLoadingFlags =
         vkglTF::FileLoadingFlags::PreTransformVertices |
@@ -467,14 +470,14 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES * 2),
+                                              framesInFlight_ * 2),
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            MAX_CONCURRENT_FRAMES * 6)};
+            framesInFlight_ * 6)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(
             static_cast<uint32_t>(poolSizes.size()), poolSizes.data(),
-            MAX_CONCURRENT_FRAMES * 4);
+            framesInFlight_ * 4);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -625,6 +628,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layouts
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         vks::initializers::pipelineLayoutCreateInfo(
@@ -794,6 +798,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.modelview = camera_.matrices_.view;
     uniformData_.inverseModelview = glm::inverse(camera_.matrices_.view);
@@ -802,6 +807,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -994,10 +1000,10 @@ class VulkanExample : public VulkanExampleBase {
       vkDestroyFramebuffer(device_, filterPass_.frameBuffer, nullptr);
       vkDestroySampler(device_, offscreen_.sampler, nullptr);
       vkDestroySampler(device_, filterPass_.sampler, nullptr);
-      offscreen_.depth.destroy(device_);
-      offscreen_.color[0].destroy(device_);
-      offscreen_.color[1].destroy(device_);
-      filterPass_.color[0].destroy(device_);
+      offscreen_.depth.destroy(vulkanDevice_);
+      offscreen_.color[0].destroy(vulkanDevice_);
+      offscreen_.color[1].destroy(vulkanDevice_);
+      filterPass_.color[0].destroy(vulkanDevice_);
       textures_.envmap.destroy();
       for (auto& buffer : uniformBuffers_) {
         buffer.destroy();
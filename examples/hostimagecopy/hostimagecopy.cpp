@@ -46,12 +46,14 @@ class VulkanExample : public VulkanExampleBase {
     glm::vec4 viewPos;
     float lodBias = 0.0f;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VulkanExample() : VulkanExampleBase() {
     title = "Host image copy";
@@ -201,8 +203,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.allocationSize = memReqs.size;
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr,
-                                     &texture_.deviceMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &texture_.deviceMemory, vks::MemoryTag::Textures));
     VK_CHECK_RESULT(
         vkBindImageMemory(device_, texture_.image, texture_.deviceMemory, 0));
 
@@ -307,19 +309,19 @@ class VulkanExample : public VulkanExampleBase {
     vkDestroyImageView(device_, texture.view, nullptr);
     vkDestroyImage(device_, texture.image, nullptr);
     vkDestroySampler(device_, texture.sampler, nullptr);
-    vkFreeMemory(device_, texture.deviceMemory, nullptr);
+    vulkanDevice_->freeMemory(texture.deviceMemory);
   }
 
   void setupDescriptors() {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES)};
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -369,6 +371,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
@@ -439,6 +442,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.modelView = camera_.matrices_.view;
     uniformData_.viewPos = camera_.viewPos_;
@@ -447,6 +451,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     const uint32_t glTFLoadingFlags =
         vkglTF::FileLoadingFlags::PreTransformVertices |
         vkglTF::FileLoadingFlags::PreMultiplyVertexColors |
@@ -478,6 +483,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
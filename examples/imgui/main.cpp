@@ -22,7 +22,8 @@ private:
 		int32_t vertexCount = 0;
 		int32_t indexCount = 0;
 	};
-	std::array<Buffers, MAX_CONCURRENT_FRAMES> buffers{};
+	// One set of buffers per frame in flight
+	std::vector<Buffers> buffers;
 	VkSampler sampler{ VK_NULL_HANDLE };
 	VkDeviceMemory fontMemory{ VK_NULL_HANDLE };
 	VkImage fontImage{ VK_NULL_HANDLE };
@@ -57,7 +58,7 @@ public:
 	float lightSpeed = 0.25f;
 	float lightTimer = 0.0f;
 
-	ImGUI(VulkanExampleBase *example) : example(example)
+	ImGUI(VulkanExampleBase *example, uint32_t framesInFlight) : buffers(framesInFlight), example(example)
 	{
 		device = example->vulkanDevice_;
 		ImGui::CreateContext();
@@ -78,7 +79,7 @@ public:
 		}
 		vkDestroyImage(device->logicalDevice, fontImage, nullptr);
 		vkDestroyImageView(device->logicalDevice, fontView, nullptr);
-		vkFreeMemory(device->logicalDevice, fontMemory, nullptr);
+		device->freeMemory(fontMemory);
 		vkDestroySampler(device->logicalDevice, sampler, nullptr);
 		vkDestroyPipeline(device->logicalDevice, pipeline, nullptr);
 		vkDestroyPipelineLayout(device->logicalDevice, pipelineLayout, nullptr);
@@ -169,7 +170,7 @@ public:
 		VkMemoryAllocateInfo memAllocInfo = vks::initializers::memoryAllocateInfo();
 		memAllocInfo.allocationSize = memReqs.size;
 		memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &fontMemory));
+		VK_CHECK_RESULT(device->allocateMemory(&memAllocInfo, &fontMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, fontImage, fontMemory, 0));
 
 		// Image view
@@ -513,12 +514,12 @@ public:
 		glm::mat4 modelview;
 		glm::vec4 lightPos;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkPipeline pipeline{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	VulkanExample() : VulkanExampleBase()
 	{
@@ -574,6 +575,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
@@ -618,12 +620,13 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// Vertex shader
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.modelview = camera_.matrices_.view * glm::mat4(1.0f);
 		// Light source
 		if (imGui->animateLight) {
-			imGui->lightTimer += frameTimer * imGui->lightSpeed;
+			imGui->lightTimer += animationStep_ * imGui->lightSpeed;
 			uniformData_.lightPos.x = sin(glm::radians(imGui->lightTimer * 360.0f)) * 15.0f;
 			uniformData_.lightPos.z = cos(glm::radians(imGui->lightTimer * 360.0f)) * 15.0f;
 		};
@@ -632,6 +635,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		models_.models.loadFromFile(getAssetPath() + "models/vulkanscenemodels.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		models_.background.loadFromFile(getAssetPath() + "models/vulkanscenebackground.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -640,7 +644,7 @@ public:
 
 	void prepareImGui()
 	{
-		imGui = new ImGUI(this);
+		imGui = new ImGUI(this, framesInFlight_);
 		imGui->init((float)width_, (float)height_);
 		imGui->initResources(renderPass_, queue_, getShadersPath());
 		imGui->sampleName = title;
@@ -660,6 +664,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
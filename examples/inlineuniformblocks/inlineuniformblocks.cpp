@@ -30,10 +30,8 @@ class VulkanExample : public VulkanExampleBase {
       float r, g, b;
       float ambient;
     } material;
-    std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets{};
-    void setRandomMaterial(bool applyRandomSeed) {
-      std::random_device rndDevice;
-      std::default_random_engine rndEngine(applyRandomSeed ? rndDevice() : 0);
+    std::vector<VkDescriptorSet> descriptorSets;
+    void setRandomMaterial(std::default_random_engine& rndEngine) {
       std::uniform_real_distribution<float> rndDist(0.1f, 1.0f);
       material.r = rndDist(rndEngine);
       material.g = rndDist(rndEngine);
@@ -51,7 +49,8 @@ class VulkanExample : public VulkanExampleBase {
     glm::mat4 view;
     glm::vec3 camPos;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkPipeline pipeline{VK_NULL_HANDLE};
@@ -60,7 +59,8 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSetLayout scene{VK_NULL_HANDLE};
     VkDescriptorSetLayout object{VK_NULL_HANDLE};
   } descriptorSetLayouts_;
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   bool doUpdateMaterials{false};
 
@@ -107,12 +107,13 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     model.loadFromFile(getAssetPath() + "models/sphere.gltf", vulkanDevice_,
                        queue_);
 
     // Setup random materials for every object in the scene
     for (uint32_t i = 0; i < objects.size(); i++) {
-      objects[i].setRandomMaterial(!benchmark.active);
+      objects[i].setRandomMaterial(randomEngine_);
     }
   }
 
@@ -120,7 +121,7 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         /* [POI] Allocate inline uniform blocks */
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT,
@@ -129,7 +130,7 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorPoolCreateInfo descriptorPoolCI =
         vks::initializers::descriptorPoolCreateInfo(
             poolSizes, (static_cast<uint32_t>(objects.size()) + 1) *
-                           MAX_CONCURRENT_FRAMES);
+                           framesInFlight_);
     /*
             [POI] New structure that has to be chained into the descriptor
        pool's createinfo if you want to allocate inline uniform blocks
@@ -190,6 +191,7 @@ class VulkanExample : public VulkanExampleBase {
                              writeDescriptorSets.data(), 0, nullptr);
       // Objects with inline uniform blocks
       for (auto& object : objects) {
+        object.descriptorSets.resize(framesInFlight_);
         VkDescriptorSetAllocateInfo descriptorAllocateInfo =
             vks::initializers::descriptorSetAllocateInfo(
                 descriptorPool_, &descriptorSetLayouts_.object, 1);
@@ -232,6 +234,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     /*
             [POI] Pipeline layout usin two sets, one for the scene matrices and
        one for the per-object inline uniform blocks
@@ -318,6 +321,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.view = camera_.matrices_.view;
     uniformData_.model = glm::scale(glm::mat4(1.0f), glm::vec3(0.5f));
@@ -372,6 +376,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -451,7 +456,7 @@ class VulkanExample : public VulkanExampleBase {
     if (overlay->button("Randomize")) {
       // Randomize material properties
       for (uint32_t i = 0; i < objects.size(); i++) {
-        objects[i].setRandomMaterial(!benchmark.active);
+        objects[i].setRandomMaterial(randomEngine_);
       }
     }
   }
@@ -34,7 +34,7 @@ public:
 		vks::Buffer matrices;
 		vks::Buffer params;
 	};
-	std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffers> uniformBuffers_ = std::vector<UniformBuffers>(framesInFlight_);
 
 	struct {
 		VkPipelineLayout attachmentWrite{ VK_NULL_HANDLE };
@@ -55,7 +55,7 @@ public:
 		VkDescriptorSet attachmentWrite{ VK_NULL_HANDLE };
 		VkDescriptorSet attachmentRead{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	struct FrameBufferAttachment {
 		VkImage image{ VK_NULL_HANDLE };
@@ -86,10 +86,10 @@ public:
 		if (device_) {
 			vkDestroyImageView(device_, attachments.color.view, nullptr);
 			vkDestroyImage(device_, attachments.color.image, nullptr);
-			vkFreeMemory(device_, attachments.color.memory, nullptr);
+			vulkanDevice_->freeMemory(attachments.color.memory);
 			vkDestroyImageView(device_, attachments.depth.view, nullptr);
 			vkDestroyImage(device_, attachments.depth.image, nullptr);
-			vkFreeMemory(device_, attachments.depth.memory, nullptr);
+			vulkanDevice_->freeMemory(attachments.depth.memory);
 			vkDestroyPipeline(device_, pipelines_.attachmentRead, nullptr);
 			vkDestroyPipeline(device_, pipelines_.attachmentWrite, nullptr);
 			vkDestroyPipelineLayout(device_, pipelineLayouts_.attachmentWrite, nullptr);
@@ -107,7 +107,7 @@ public:
 	{
 		vkDestroyImageView(device_, attachment->view, nullptr);
 		vkDestroyImage(device_, attachment->image, nullptr);
-		vkFreeMemory(device_, attachment->memory, nullptr);
+		vulkanDevice_->freeMemory(attachment->memory);
 	}
 
 	// Create a frame buffer attachment
@@ -147,7 +147,7 @@ public:
 		vkGetImageMemoryRequirements(device_, attachment->image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &attachment->memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &attachment->memory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, attachment->image, attachment->memory, 0));
 
 		VkImageViewCreateInfo imageViewCI = vks::initializers::imageViewCreateInfo();
@@ -330,6 +330,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		scene.loadFromFile(getAssetPath() + "models/treasure_smooth.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 	}
@@ -358,10 +359,10 @@ public:
 			Pool
 		*/
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, MAX_CONCURRENT_FRAMES * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, framesInFlight_ * 2),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(static_cast<uint32_t>(poolSizes.size()), poolSizes.data(), MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(static_cast<uint32_t>(poolSizes.size()), poolSizes.data(), framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layouts
@@ -403,6 +404,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layouts
 		VkPipelineLayoutCreateInfo pipelineLayoutCI = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayouts_.attachmentWrite, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCI, nullptr, &pipelineLayouts_.attachmentWrite));
@@ -481,6 +483,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uboMatrices.projection = camera_.matrices_.perspective;
 		uboMatrices.view = camera_.matrices_.view;
 		uboMatrices.model = glm::mat4(1.0f);
@@ -500,6 +503,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -51,7 +51,7 @@ public:
 		float locSpeed = 0.0f;
 		float globSpeed = 0.0f;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	struct {
@@ -65,7 +65,7 @@ public:
 		VkDescriptorSet instancedRocks{ VK_NULL_HANDLE };
 		VkDescriptorSet staticObjects{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	VulkanExample() : VulkanExampleBase()
 	{
@@ -85,7 +85,7 @@ public:
 			vkDestroyPipelineLayout(device_, pipelineLayout, nullptr);
 			vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
 			vkDestroyBuffer(device_, instanceBuffer.buffer, nullptr);
-			vkFreeMemory(device_, instanceBuffer.memory, nullptr);
+			vulkanDevice_->freeMemory(instanceBuffer.memory);
 			textures_.rocks.destroy();
 			textures_.planet.destroy();
 			for (auto& buffer : uniformBuffers_) {
@@ -105,6 +105,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		models_.rock.loadFromFile(getAssetPath() + "models/rock01.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		models_.planet.loadFromFile(getAssetPath() + "models/lavaplanet.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -117,10 +118,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 2),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layout
@@ -163,6 +164,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		VkPipelineLayoutCreateInfo pipelineLayoutCI = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCI, nullptr, &pipelineLayout));
@@ -262,7 +264,7 @@ public:
 		std::vector<InstanceData> instanceData;
 		instanceData.resize(INSTANCE_COUNT);
 
-		std::default_random_engine rndGenerator(benchmark.active ? 0 : (unsigned)time(nullptr));
+		std::default_random_engine rndGenerator(randomSeed());
 		std::uniform_real_distribution<float> uniformDist(0.0, 1.0);
 		std::uniform_int_distribution<uint32_t> rndTextureIndex(0, textures_.rocks.layerCount);
 
@@ -338,7 +340,7 @@ public:
 
 		// Destroy staging resources
 		vkDestroyBuffer(device_, stagingBuffer.buffer, nullptr);
-		vkFreeMemory(device_, stagingBuffer.memory, nullptr);
+		vulkanDevice_->freeMemory(stagingBuffer.memory);
 	}
 
 	void prepareUniformBuffers()
@@ -352,12 +354,13 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.view = camera_.matrices_.view;
 		// Animate asteroids
 		if (!paused) {
-			uniformData_.locSpeed += frameTimer * 0.35f;
-			uniformData_.globSpeed += frameTimer * 0.01f;
+			uniformData_.locSpeed += animationStep_ * 0.35f;
+			uniformData_.globSpeed += animationStep_ * 0.01f;
 		}
 		memcpy(uniformBuffers_[currentBuffer_].mapped, &uniformData_, sizeof(uniformData_));
 	}
@@ -375,6 +378,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -25,7 +25,7 @@ public:
 		glm::mat4 model;
 		glm::vec4 lightPos = glm::vec4(5.0f, -5.0f, 5.0f, 1.0f);
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	struct {
 		VkPipeline MSAA{ VK_NULL_HANDLE };
@@ -34,7 +34,7 @@ public:
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	VkExtent2D attachmentSize{};
 
@@ -73,10 +73,10 @@ public:
 			// Destroy MSAA target
 			vkDestroyImage(device_, multisampleTarget.color.image, nullptr);
 			vkDestroyImageView(device_, multisampleTarget.color.view, nullptr);
-			vkFreeMemory(device_, multisampleTarget.color.memory, nullptr);
+			vulkanDevice_->freeMemory(multisampleTarget.color.memory);
 			vkDestroyImage(device_, multisampleTarget.depth.image, nullptr);
 			vkDestroyImageView(device_, multisampleTarget.depth.view, nullptr);
-			vkFreeMemory(device_, multisampleTarget.depth.memory, nullptr);
+			vulkanDevice_->freeMemory(multisampleTarget.depth.memory);
 
 			for (auto& buffer : uniformBuffers_) {
 				buffer.destroy();
@@ -135,7 +135,7 @@ public:
 			// If this is not available, fall back to device local memory
 			memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 		}
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &multisampleTarget.color.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &multisampleTarget.color.memory, vks::MemoryTag::Attachments));
 		vkBindImageMemory(device_, multisampleTarget.color.image, multisampleTarget.color.memory, 0);
 
 		// Create image view for the MSAA target
@@ -180,7 +180,7 @@ public:
 			memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 		}
 
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &multisampleTarget.depth.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &multisampleTarget.depth.memory, vks::MemoryTag::Attachments));
 		vkBindImageMemory(device_, multisampleTarget.depth.image, multisampleTarget.depth.memory, 0);
 
 		// Create image view for the MSAA target
@@ -308,10 +308,10 @@ public:
 			// Destroy MSAA target
 			vkDestroyImage(device_, multisampleTarget.color.image, nullptr);
 			vkDestroyImageView(device_, multisampleTarget.color.view, nullptr);
-			vkFreeMemory(device_, multisampleTarget.color.memory, nullptr);
+			vulkanDevice_->freeMemory(multisampleTarget.color.memory);
 			vkDestroyImage(device_, multisampleTarget.depth.image, nullptr);
 			vkDestroyImageView(device_, multisampleTarget.depth.view, nullptr);
-			vkFreeMemory(device_, multisampleTarget.depth.memory, nullptr);
+			vulkanDevice_->freeMemory(multisampleTarget.depth.memory);
 		}
 		
 		std::array<VkImageView, 3> attachments;
@@ -343,6 +343,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		model.loadFromFile(getAssetPath() + "models/voyager.gltf", vulkanDevice_, queue_, vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::FlipY);
 	}
 
@@ -350,10 +351,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layout
@@ -377,6 +378,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout uses set 0 for passing vertex shader ubo and set 1 for fragment shader images (taken from glTF model)
 		const std::vector<VkDescriptorSetLayout> setLayouts = {
 			descriptorSetLayout,
@@ -444,6 +446,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.model = camera_.matrices_.view;
 		memcpy(uniformBuffers_[currentBuffer_].mapped, &uniformData_, sizeof(UniformData));
@@ -479,6 +482,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -40,7 +40,7 @@ public:
 		VkCommandBuffer background{ VK_NULL_HANDLE };
 		VkCommandBuffer ui{ VK_NULL_HANDLE };
 	};
-	std::array<SecondaryCommandBuffers, MAX_CONCURRENT_FRAMES> secondaryCommandBuffers{};
+	std::vector<SecondaryCommandBuffers> secondaryCommandBuffers = std::vector<SecondaryCommandBuffers>(framesInFlight_);
 
 	// Number of animated objects to be renderer
 	// by using threads and secondary command buffers
@@ -71,8 +71,8 @@ public:
 
 	struct ThreadData {
 		VkCommandPool commandPool{ VK_NULL_HANDLE };
-		// One command buffer per render object per max. frames in flight
-		std::array<std::vector<VkCommandBuffer>, MAX_CONCURRENT_FRAMES> commandBuffer;
+		// One command buffer per render object per frames in flight
+		std::vector<std::vector<VkCommandBuffer>> commandBuffer;
 		// One push constant block per render object
 		std::vector<ThreadPushConstantBlock> pushConstBlock;
 		// Per object information (position, rotation, etc.)
@@ -105,7 +105,7 @@ public:
 #endif
 		threadPool.setThreadCount(numThreads);
 		numObjectsPerThread = 512 / numThreads;
-		rndEngine.seed(benchmark.active ? 0 : (unsigned)time(nullptr));
+		rndEngine.seed(randomSeed());
 	}
 
 	~VulkanExample()
@@ -133,7 +133,7 @@ public:
 	void prepareMultiThreadedRenderer()
 	{
 		// The actual commands are issued in secondary command buffers, this also applies to the background and the user interface
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			VkCommandBufferAllocateInfo cmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(cmdPool_, VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1);
 			VK_CHECK_RESULT(vkAllocateCommandBuffers(device_, &cmdBufAllocateInfo, &secondaryCommandBuffers[i].background));
 			VK_CHECK_RESULT(vkAllocateCommandBuffers(device_, &cmdBufAllocateInfo, &secondaryCommandBuffers[i].ui));
@@ -151,7 +151,8 @@ public:
 			VK_CHECK_RESULT(vkCreateCommandPool(device_, &cmdPoolInfo, nullptr, &thread->commandPool));
 
 			// One secondary command buffer per object that is updated by this thread
-			// We also duplicate the command buffers per max. frames in flight
+			// We also duplicate the command buffers per frames in flight
+			thread->commandBuffer.resize(framesInFlight_);
 			for (auto& commandBuffers : thread->commandBuffer) {
 				commandBuffers.resize(numObjectsPerThread);
 				// Generate secondary command buffers for each thread
@@ -179,11 +180,15 @@ public:
 	// Builds the secondary command buffer for each thread
 	void threadRenderCode(uint32_t threadIndex, uint32_t cmdBufferIndex, VkCommandBufferInheritanceInfo inheritanceInfo)
 	{
+		vks::ProfilerZone profilerZone("threadRenderCode");
 		ThreadData *thread = &threadData[threadIndex];
 		ObjectData *objectData = &thread->objectData[cmdBufferIndex];
 
 		// Check visibility against view frustum using a simple sphere check based on the radius of the mesh
-		objectData->visible = frustum.checkSphere(objectData->pos, models_.ufo.dimensions.radius * 0.5f);
+		{
+			vks::ProfilerZone cullingZone("frustumCulling");
+			objectData->visible = frustum.checkSphere(objectData->pos, models_.ufo.dimensions.radius * 0.5f);
+		}
 
 		if (!objectData->visible)
 		{
@@ -208,11 +213,11 @@ public:
 
 		// Update
 		if (!paused) {
-			objectData->rotation.y += 2.5f * objectData->rotationSpeed * frameTimer;
+			objectData->rotation.y += 2.5f * objectData->rotationSpeed * animationStep_;
 			if (objectData->rotation.y > 360.0f) {
 				objectData->rotation.y -= 360.0f;
 			}
-			objectData->deltaT += 0.15f * frameTimer;
+			objectData->deltaT += 0.15f * animationStep_;
 			if (objectData->deltaT > 1.0f)
 				objectData->deltaT -= 1.0f;
 			objectData->pos.y = sin(glm::radians(objectData->deltaT * 360.0f)) * 2.5f;
@@ -302,6 +307,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		models_.ufo.loadFromFile(getAssetPath() + "models/retroufo_red_lowpoly.gltf",vulkanDevice_, queue_,glTFLoadingFlags);
 		models_.starSphere.loadFromFile(getAssetPath() + "models/sphere.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -309,6 +315,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = vks::initializers::pipelineLayoutCreateInfo(nullptr, 0);
 		// Push constants for model matrices
@@ -400,6 +407,9 @@ public:
 
 		VK_CHECK_RESULT(vkBeginCommandBuffer(drawCmdBuffers_[currentBuffer_], &cmdBufInfo));
 
+		// Measure the GPU time of the render pass in traces (timestamps can't be written inside a render pass that executes secondary command buffers)
+		const uint32_t gpuZone = gpuProfiler_.beginZone(drawCmdBuffers_[currentBuffer_], currentBuffer_, "renderPass");
+
 		// The primary command buffer does not contain any rendering commands
 		// These are stored (and retrieved) from the secondary command buffers
 		vkCmdBeginRenderPass(drawCmdBuffers_[currentBuffer_], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
@@ -424,7 +434,10 @@ public:
 			}
 		}
 
-		threadPool.wait();
+		{
+			vks::ProfilerZone profilerZone("waitForThreads");
+			threadPool.wait();
+		}
 
 		// Only submit if object is within the current view frustum
 		for (uint32_t t = 0; t < numThreads; t++) {
@@ -445,6 +458,8 @@ public:
 
 		vkCmdEndRenderPass(drawCmdBuffers_[currentBuffer_]);
 
+		gpuProfiler_.endZone(drawCmdBuffers_[currentBuffer_], currentBuffer_, gpuZone);
+
 		VK_CHECK_RESULT(vkEndCommandBuffer(drawCmdBuffers_[currentBuffer_]));
 	}
 
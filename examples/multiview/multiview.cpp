@@ -34,12 +34,12 @@ public:
 		glm::vec4 lightPos = glm::vec4(-2.5f, -3.5f, 0.0f, 1.0f);
 		float distortionAlpha = 0.2f;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipeline pipeline{ VK_NULL_HANDLE };
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	VkPipeline viewDisplayPipelines[2]{};
 
@@ -80,10 +80,10 @@ public:
 			vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
 			vkDestroyImageView(device_, multiviewPass.color.view, nullptr);
 			vkDestroyImage(device_, multiviewPass.color.image, nullptr);
-			vkFreeMemory(device_, multiviewPass.color.memory, nullptr);
+			vulkanDevice_->freeMemory(multiviewPass.color.memory);
 			vkDestroyImageView(device_, multiviewPass.depth.view, nullptr);
 			vkDestroyImage(device_, multiviewPass.depth.image, nullptr);
-			vkFreeMemory(device_, multiviewPass.depth.memory, nullptr);
+			vulkanDevice_->freeMemory(multiviewPass.depth.memory);
 			vkDestroyRenderPass(device_, multiviewPass.renderPass, nullptr);
 			vkDestroySampler(device_, multiviewPass.sampler, nullptr);
 			vkDestroyFramebuffer(device_, multiviewPass.frameBuffer, nullptr);
@@ -148,7 +148,7 @@ public:
 
 			memAllocInfo.allocationSize = memReqs.size;
 			memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr, &multiviewPass.depth.memory));
+			VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllocInfo, &multiviewPass.depth.memory, vks::MemoryTag::Attachments));
 			VK_CHECK_RESULT(vkBindImageMemory(device_, multiviewPass.depth.image, multiviewPass.depth.memory, 0));
 			VK_CHECK_RESULT(vkCreateImageView(device_, &depthStencilView, nullptr, &multiviewPass.depth.view));
 		}
@@ -174,7 +174,7 @@ public:
 			VkMemoryAllocateInfo memoryAllocInfo = vks::initializers::memoryAllocateInfo();
 			memoryAllocInfo.allocationSize = memReqs.size;
 			memoryAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device_, &memoryAllocInfo, nullptr, &multiviewPass.color.memory));
+			VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memoryAllocInfo, &multiviewPass.color.memory, vks::MemoryTag::Attachments));
 			VK_CHECK_RESULT(vkBindImageMemory(device_, multiviewPass.color.image, multiviewPass.color.memory, 0));
 
 			VkImageViewCreateInfo imageViewCI = vks::initializers::imageViewCreateInfo();
@@ -334,6 +334,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		scene.loadFromFile(getAssetPath() + "models/sampleroom.gltf", vulkanDevice_, queue_, vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY);
 	}
 
@@ -341,10 +342,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(static_cast<uint32_t>(poolSizes.size()), poolSizes.data(), MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(static_cast<uint32_t>(poolSizes.size()), poolSizes.data(), framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layouts
@@ -378,6 +379,7 @@ public:
 	
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		/*
 			Display multi view features and properties
 		*/
@@ -485,6 +487,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// Matrices for the two viewports
 		// See http://paulbourke.net/stereographics/stereorender/
 
@@ -547,10 +550,10 @@ public:
 	{
 		vkDestroyImageView(device_, multiviewPass.color.view, nullptr);
 		vkDestroyImage(device_, multiviewPass.color.image, nullptr);
-		vkFreeMemory(device_, multiviewPass.color.memory, nullptr);
+		vulkanDevice_->freeMemory(multiviewPass.color.memory);
 		vkDestroyImageView(device_, multiviewPass.depth.view, nullptr);
 		vkDestroyImage(device_, multiviewPass.depth.image, nullptr);
-		vkFreeMemory(device_, multiviewPass.depth.memory, nullptr);
+		vulkanDevice_->freeMemory(multiviewPass.depth.memory);
 
 		vkDestroyRenderPass(device_, multiviewPass.renderPass, nullptr);
 		vkDestroySampler(device_, multiviewPass.sampler, nullptr);
@@ -564,6 +567,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
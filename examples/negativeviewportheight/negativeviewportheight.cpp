@@ -57,7 +57,8 @@ public:
 
 	~VulkanExample()
 	{
-		vkDestroyPipeline(device_, pipeline, nullptr);
+		// The pipeline is owned by the base pipeline registry, drop it before its layout is destroyed
+		pipelineRegistry_.forget(pipelineLayout);
 		vkDestroyPipelineLayout(device_, pipelineLayout, nullptr);
 		vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
 		textures_.CW.destroy();
@@ -67,6 +68,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		textures_.CW.loadFromFile(getAssetPath() + "textures/texture_orientation_cw_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
 		textures_.CCW.loadFromFile(getAssetPath() + "textures/texture_orientation_ccw_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
 
@@ -135,10 +137,7 @@ public:
 
 	void preparePipelines()
 	{
-		if (pipeline != VK_NULL_HANDLE) {
-			vkDestroyPipeline(device_, pipeline, nullptr);
-		}
-
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		const std::vector<VkDynamicState> dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
 
 		VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCI = vks::initializers::pipelineInputAssemblyStateCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 0, VK_FALSE);
@@ -189,7 +188,8 @@ public:
 		pipelineCreateInfoCI.stageCount = static_cast<uint32_t>(shaderStages.size());
 		pipelineCreateInfoCI.pStages = shaderStages.data();
 
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device_, pipelineCache_, 1, &pipelineCreateInfoCI, nullptr, &pipeline));
+		// Called again when winding order or cull mode change, the registry returns the pipeline created for an earlier combination instead of building it again
+		pipeline = pipelineRegistry_.getGraphicsPipeline(pipelineCreateInfoCI, pipelineCache_);
 	}
 
 	void prepare()
@@ -203,6 +203,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
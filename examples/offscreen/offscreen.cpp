@@ -35,7 +35,8 @@ class VulkanExample : public VulkanExampleBase {
     vks::Buffer mirror;
     vks::Buffer offscreen;
   };
-  std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<UniformBuffers> uniformBuffers_ =
+      std::vector<UniformBuffers>(framesInFlight_);
 
   struct {
     VkPipelineLayout textured{VK_NULL_HANDLE};
@@ -59,7 +60,8 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSet mirror{VK_NULL_HANDLE};
     VkDescriptorSet model{VK_NULL_HANDLE};
   };
-  std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_;
+  std::vector<DescriptorSets> descriptorSets_ =
+      std::vector<DescriptorSets>(framesInFlight_);
 
   // Framebuffer for offscreen rendering
   struct FrameBufferAttachment {
@@ -95,10 +97,10 @@ class VulkanExample : public VulkanExampleBase {
     if (device_) {
       vkDestroyImageView(device_, offscreenPass_.color.view, nullptr);
       vkDestroyImage(device_, offscreenPass_.color.image, nullptr);
-      vkFreeMemory(device_, offscreenPass_.color.mem, nullptr);
+      vulkanDevice_->freeMemory(offscreenPass_.color.mem);
       vkDestroyImageView(device_, offscreenPass_.depth.view, nullptr);
       vkDestroyImage(device_, offscreenPass_.depth.image, nullptr);
-      vkFreeMemory(device_, offscreenPass_.depth.mem, nullptr);
+      vulkanDevice_->freeMemory(offscreenPass_.depth.mem);
       vkDestroyRenderPass(device_, offscreenPass_.renderPass, nullptr);
       vkDestroySampler(device_, offscreenPass_.sampler, nullptr);
       vkDestroyFramebuffer(device_, offscreenPass_.frameBuffer, nullptr);
@@ -157,8 +159,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr,
-                                     &offscreenPass_.color.mem));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &offscreenPass_.color.mem, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(vkBindImageMemory(device_, offscreenPass_.color.image,
                                       offscreenPass_.color.mem, 0));
 
@@ -202,8 +204,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr,
-                                     &offscreenPass_.depth.mem));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &offscreenPass_.depth.mem, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(vkBindImageMemory(device_, offscreenPass_.depth.image,
                                       offscreenPass_.depth.mem, 0));
 
@@ -333,6 +335,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     const uint32_t glTFLoadingFlags =
         vkglTF::FileLoadingFlags::PreTransformVertices |
         vkglTF::FileLoadingFlags::PreMultiplyVertexColors |
@@ -347,13 +350,13 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES * 3),
+                                              framesInFlight_ * 3),
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            MAX_CONCURRENT_FRAMES * 2)};
+            framesInFlight_ * 2)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES * 3);
+                                                    framesInFlight_ * 3);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -443,6 +446,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layouts
     VkPipelineLayoutCreateInfo pipelineLayoutInfo =
         vks::initializers::pipelineLayoutCreateInfo(
@@ -564,8 +568,9 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     if (!paused) {
-      modelRotation.y += frameTimer * 10.0f;
+      modelRotation.y += animationStep_ * 10.0f;
     }
 
     uniformData_.projection = camera_.matrices_.perspective;
@@ -609,6 +614,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -43,7 +43,7 @@ public:
 		glm::mat4 projection;
 		glm::mat4 view;
 	} renderPassUniformData;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> renderPassUniformBuffer;
+	std::vector<vks::Buffer> renderPassUniformBuffer = std::vector<vks::Buffer>(framesInFlight_);
 
 	struct ObjectData {
 		glm::mat4 model;
@@ -69,7 +69,7 @@ public:
 		VkDescriptorSet geometry{ VK_NULL_HANDLE };
 		VkDescriptorSet color{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	VkDeviceSize objectUniformBufferSize{ 0 };
 
@@ -110,6 +110,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::FlipY;
 		models_.sphere.loadFromFile(getAssetPath() + "models/sphere.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		models_.cube.loadFromFile(getAssetPath() + "models/cube.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -209,7 +210,7 @@ public:
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &geometryPass.headIndex.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &geometryPass.headIndex.deviceMemory, vks::MemoryTag::Other));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, geometryPass.headIndex.image, geometryPass.headIndex.deviceMemory, 0));
 
 		VkImageViewCreateInfo imageViewInfo = vks::initializers::imageViewCreateInfo();
@@ -274,12 +275,12 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES * 3),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_CONCURRENT_FRAMES * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_ * 3),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight_ * 2),
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layouts
@@ -346,6 +347,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layouts
 
 		// Create a geometry pipeline layout
@@ -418,6 +420,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		renderPassUniformData.projection = camera_.matrices_.perspective;
 		renderPassUniformData.view = camera_.matrices_.view;
 		memcpy(renderPassUniformBuffer[currentBuffer_].mapped, &renderPassUniformData, sizeof(RenderPassUniformData));
@@ -436,6 +439,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -10,26 +10,7 @@
 
 #include "vulkanexamplebase.h"
 #include "VulkanglTFModel.h"
-
-constexpr auto PARTICLE_COUNT = 512;
-
-constexpr auto FLAME_RADIUS = 8.0f;
-
-// The particle system is made from two different particle types
-// That type defines how a particle is rendered
-constexpr auto PARTICLE_TYPE_FLAME = 0;
-constexpr auto PARTICLE_TYPE_SMOKE = 1;
-
-struct Particle {
-	glm::vec4 pos;
-	glm::vec4 color;
-	float alpha;
-	float size;
-	float rotation;
-	uint32_t type;
-	glm::vec4 vel;
-	float rotationSpeed;
-};
+#include "particlesystem.h"
 
 class VulkanExample : public VulkanExampleBase
 {
@@ -49,11 +30,6 @@ public:
 
 	vkglTF::Model environment;
 
-	// These parameters define the particle system behaviour
-	glm::vec3 emitterPos = glm::vec3(0.0f, -FLAME_RADIUS + 2.0f, 0.0f);
-	glm::vec3 minVel = glm::vec3(-3.0f, 0.5f, -3.0f);
-	glm::vec3 maxVel = glm::vec3(3.0f, 7.0f, 3.0f);
-
 	// All buffers can change between frames, so they need to be duplicated (per frame)
 
 	struct ParticleBuffer {
@@ -64,7 +40,7 @@ public:
 		// Size of the particle buffer in bytes
 		size_t size{ 0 };
 	};
-	std::array<ParticleBuffer, MAX_CONCURRENT_FRAMES> particleBuffers;
+	std::vector<ParticleBuffer> particleBuffers = std::vector<ParticleBuffer>(framesInFlight_);
 
 	struct UniformBuffers {
 		vks::Buffer particles;
@@ -72,7 +48,7 @@ public:
 		VkDescriptorSet particlesDescriptor{ VK_NULL_HANDLE };
 		VkDescriptorSet environmentDescriptor{ VK_NULL_HANDLE };
 	};
-	std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffers> uniformBuffers_ = std::vector<UniformBuffers>(framesInFlight_);
 
 	struct UniformDataParticles {
 		glm::mat4 projection;
@@ -99,9 +75,8 @@ public:
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
 
-	std::vector<Particle> particles{};
-
-	std::default_random_engine rndEngine;
+	// Particles are simulated in CPU memory
+	ParticleSimulation particleSimulation{ randomEngine_ };
 
 	VulkanExample() : VulkanExampleBase()
 	{
@@ -111,7 +86,6 @@ public:
 		camera_.setRotation(glm::vec3(-15.0f, 45.0f, 0.0f));
 		camera_.setPerspective(60.0f, (float)width_ / (float)height_, 1.0f, 256.0f);
 		timerSpeed *= 8.0f;
-		rndEngine.seed(benchmark.active ? 0 : (unsigned)time(nullptr));
 	}
 
 	~VulkanExample()
@@ -128,7 +102,7 @@ public:
 			for (auto& buffer : particleBuffers) {
 				vkUnmapMemory(device_, buffer.memory);
 				vkDestroyBuffer(device_, buffer.buffer, nullptr);
-				vkFreeMemory(device_, buffer.memory, nullptr);
+				vulkanDevice_->freeMemory(buffer.memory);
 			}
 			for (auto& buffer : uniformBuffers_) {
 				buffer.environment.destroy();
@@ -146,73 +120,12 @@ public:
 		};
 	}
 
-	float rnd(float range)
-	{
-		std::uniform_real_distribution<float> rndDist(0.0f, range);
-		return rndDist(rndEngine);
-	}
-
-	void initParticle(Particle *particle, glm::vec3 emitterPos)
-	{
-		particle->vel = glm::vec4(0.0f, minVel.y + rnd(maxVel.y - minVel.y), 0.0f, 0.0f);
-		particle->alpha = rnd(0.75f);
-		particle->size = 1.0f + rnd(0.5f);
-		particle->color = glm::vec4(1.0f);
-		particle->type = PARTICLE_TYPE_FLAME;
-		particle->rotation = rnd(2.0f * float(M_PI));
-		particle->rotationSpeed = rnd(2.0f) - rnd(2.0f);
-
-		// Get random sphere point
-		float theta = rnd(2.0f * float(M_PI));
-		float phi = rnd(float(M_PI)) - float(M_PI) / 2.0f;
-		float r = rnd(FLAME_RADIUS);
-
-		particle->pos.x = r * cos(theta) * cos(phi);
-		particle->pos.y = r * sin(phi);
-		particle->pos.z = r * sin(theta) * cos(phi);
-
-		particle->pos += glm::vec4(emitterPos, 0.0f);
-	}
-
-	// Change the type of a particle, e.g. from flame to smoke
-	void transitionParticle(Particle *particle)
-	{
-		switch (particle->type)
-		{
-		case PARTICLE_TYPE_FLAME:
-			// Flame particles have a chance of turning into smoke
-			if (rnd(1.0f) < 0.05f)
-			{
-				particle->alpha = 0.0f;
-				particle->color = glm::vec4(0.25f + rnd(0.25f));
-				particle->pos.x *= 0.5f;
-				particle->pos.z *= 0.5f;
-				particle->vel = glm::vec4(rnd(1.0f) - rnd(1.0f), (minVel.y * 2) + rnd(maxVel.y - minVel.y), rnd(1.0f) - rnd(1.0f), 0.0f);
-				particle->size = 1.0f + rnd(0.5f);
-				particle->rotationSpeed = rnd(1.0f) - rnd(1.0f);
-				particle->type = PARTICLE_TYPE_SMOKE;
-			}
-			else
-			{
-				initParticle(particle, emitterPos);
-			}
-			break;
-		case PARTICLE_TYPE_SMOKE:
-			// Respawn at end of life
-			initParticle(particle, emitterPos);
-			break;
-		}
-	}
-
 	// Initialize the particle system and create vertex buffers for rendering the particles
 	void prepareParticles()
 	{
 		// We store particles in CPU memory
-		particles.resize(PARTICLE_COUNT);
-		for (auto& particle : particles) {
-			initParticle(&particle, emitterPos);
-			particle.alpha = 1.0f - (abs(particle.pos.y) / (FLAME_RADIUS * 2.0f));
-		}
+		particleSimulation.init(PARTICLE_COUNT);
+		std::vector<Particle>& particles = particleSimulation.particles;
 
 		// One buffer per concurrent frame, so we can update one frame while the other is still rendering
 		for (auto& buffer : particleBuffers) {
@@ -234,30 +147,9 @@ public:
 	// Update the state of all particles
 	void updateParticles()
 	{
-		float particleTimer = frameTimer * 0.45f;
-		for (auto& particle : particles) {
-			switch (particle.type)
-			{
-			case PARTICLE_TYPE_FLAME:
-				particle.pos.y -= particle.vel.y * particleTimer * 3.5f;
-				particle.alpha += particleTimer * 2.5f;
-				particle.size -= particleTimer * 0.5f;
-				break;
-			case PARTICLE_TYPE_SMOKE:
-				particle.pos -= particle.vel * frameTimer * 1.0f;
-				particle.alpha += particleTimer * 1.25f;
-				particle.size += particleTimer * 0.125f;
-				particle.color -= particleTimer * 0.05f;
-				break;
-			}
-			particle.rotation += particleTimer * particle.rotationSpeed;
-			// If a particle has faded out, turn it into the other type (e.g. flame to smoke and vice versa)
-			if (particle.alpha > 2.0f)
-			{
-				transitionParticle(&particle);
-			}
-		}
-		
+		particleSimulation.update(animationStep_);
+		std::vector<Particle>& particles = particleSimulation.particles;
+
 		// Copy the updated particles to the vertex buffer for the next frame to be updated
 		size_t size = particles.size() * sizeof(Particle);
 		memcpy(particleBuffers[currentBuffer_].mappedMemory, particles.data(), size);
@@ -265,6 +157,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		// Particles
 		textures_.particles.smoke.loadFromFile(getAssetPath() + "textures/particle_smoke.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
 		textures_.particles.fire.loadFromFile(getAssetPath() + "textures/particle_fire.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
@@ -310,10 +203,10 @@ public:
 
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 * MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 * MAX_CONCURRENT_FRAMES)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 * framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 * framesInFlight_)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, 2 * MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, 2 * framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layout
@@ -361,6 +254,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		VkPipelineLayoutCreateInfo pipelineLayoutCI = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCI, nullptr, &pipelineLayout));
@@ -457,6 +351,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// Particle system fire
 		uniformDataParticles.projection = camera_.matrices_.perspective;
 		uniformDataParticles.modelView = camera_.matrices_.view;
@@ -489,6 +384,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
 
 		VkClearValue clearValues[2]{};
@@ -530,7 +426,7 @@ public:
 		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &uniformBuffers_[currentBuffer_].particlesDescriptor, 0, nullptr);
 		vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines_.particles);
 		vkCmdBindVertexBuffers(cmdBuffer, 0, 1, &particleBuffers[currentBuffer_].buffer, offsets);
-		vkCmdDraw(cmdBuffer, static_cast<uint32_t>(particles.size()), 1, 0, 0);
+		vkCmdDraw(cmdBuffer, static_cast<uint32_t>(particleSimulation.particles.size()), 1, 0, 0);
 
 		drawUI(cmdBuffer);
 
@@ -0,0 +1,149 @@
+/*
+* Vulkan Example - CPU based particle system
+*
+* Particle simulation running on the host, kept free of Vulkan so it can also be used by the CPU benchmarks
+*
+* Copyright (C) 2016-2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+constexpr auto PARTICLE_COUNT = 512;
+
+constexpr auto FLAME_RADIUS = 8.0f;
+
+// The particle system is made from two different particle types
+// That type defines how a particle is rendered
+constexpr auto PARTICLE_TYPE_FLAME = 0;
+constexpr auto PARTICLE_TYPE_SMOKE = 1;
+
+struct Particle {
+	glm::vec4 pos;
+	glm::vec4 color;
+	float alpha;
+	float size;
+	float rotation;
+	uint32_t type;
+	glm::vec4 vel;
+	float rotationSpeed;
+};
+
+class ParticleSimulation
+{
+public:
+	std::vector<Particle> particles{};
+
+	// These parameters define the particle system behaviour
+	glm::vec3 emitterPos = glm::vec3(0.0f, -FLAME_RADIUS + 2.0f, 0.0f);
+	glm::vec3 minVel = glm::vec3(-3.0f, 0.5f, -3.0f);
+	glm::vec3 maxVel = glm::vec3(3.0f, 7.0f, 3.0f);
+
+	explicit ParticleSimulation(std::default_random_engine& randomEngine) : randomEngine(randomEngine) {}
+
+	// Spawns the given number of particles around the emitter
+	void init(size_t count)
+	{
+		particles.resize(count);
+		for (auto& particle : particles) {
+			initParticle(&particle, emitterPos);
+			particle.alpha = 1.0f - (abs(particle.pos.y) / (FLAME_RADIUS * 2.0f));
+		}
+	}
+
+	// Update the state of all particles
+	void update(float frameTimer)
+	{
+		float particleTimer = frameTimer * 0.45f;
+		for (auto& particle : particles) {
+			switch (particle.type)
+			{
+			case PARTICLE_TYPE_FLAME:
+				particle.pos.y -= particle.vel.y * particleTimer * 3.5f;
+				particle.alpha += particleTimer * 2.5f;
+				particle.size -= particleTimer * 0.5f;
+				break;
+			case PARTICLE_TYPE_SMOKE:
+				particle.pos -= particle.vel * frameTimer * 1.0f;
+				particle.alpha += particleTimer * 1.25f;
+				particle.size += particleTimer * 0.125f;
+				particle.color -= particleTimer * 0.05f;
+				break;
+			}
+			particle.rotation += particleTimer * particle.rotationSpeed;
+			// If a particle has faded out, turn it into the other type (e.g. flame to smoke and vice versa)
+			if (particle.alpha > 2.0f)
+			{
+				transitionParticle(&particle);
+			}
+		}
+	}
+
+private:
+	std::default_random_engine& randomEngine;
+
+	float rnd(float range)
+	{
+		std::uniform_real_distribution<float> rndDist(0.0f, range);
+		return rndDist(randomEngine);
+	}
+
+	void initParticle(Particle *particle, glm::vec3 emitterPos)
+	{
+		particle->vel = glm::vec4(0.0f, minVel.y + rnd(maxVel.y - minVel.y), 0.0f, 0.0f);
+		particle->alpha = rnd(0.75f);
+		particle->size = 1.0f + rnd(0.5f);
+		particle->color = glm::vec4(1.0f);
+		particle->type = PARTICLE_TYPE_FLAME;
+		particle->rotation = rnd(2.0f * float(M_PI));
+		particle->rotationSpeed = rnd(2.0f) - rnd(2.0f);
+
+		// Get random sphere point
+		float theta = rnd(2.0f * float(M_PI));
+		float phi = rnd(float(M_PI)) - float(M_PI) / 2.0f;
+		float r = rnd(FLAME_RADIUS);
+
+		particle->pos.x = r * cos(theta) * cos(phi);
+		particle->pos.y = r * sin(phi);
+		particle->pos.z = r * sin(theta) * cos(phi);
+
+		particle->pos += glm::vec4(emitterPos, 0.0f);
+	}
+
+	// Change the type of a particle, e.g. from flame to smoke
+	void transitionParticle(Particle *particle)
+	{
+		switch (particle->type)
+		{
+		case PARTICLE_TYPE_FLAME:
+			// Flame particles have a chance of turning into smoke
+			if (rnd(1.0f) < 0.05f)
+			{
+				particle->alpha = 0.0f;
+				particle->color = glm::vec4(0.25f + rnd(0.25f));
+				particle->pos.x *= 0.5f;
+				particle->pos.z *= 0.5f;
+				particle->vel = glm::vec4(rnd(1.0f) - rnd(1.0f), (minVel.y * 2) + rnd(maxVel.y - minVel.y), rnd(1.0f) - rnd(1.0f), 0.0f);
+				particle->size = 1.0f + rnd(0.5f);
+				particle->rotationSpeed = rnd(1.0f) - rnd(1.0f);
+				particle->type = PARTICLE_TYPE_SMOKE;
+			}
+			else
+			{
+				initParticle(particle, emitterPos);
+			}
+			break;
+		case PARTICLE_TYPE_SMOKE:
+			// Respawn at end of life
+			initParticle(particle, emitterPos);
+			break;
+		}
+	}
+};
@@ -54,7 +54,7 @@ public:
 		vks::Buffer skybox;
 		vks::Buffer params;
 	};
-	std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffers> uniformBuffers_ = std::vector<UniformBuffers>(framesInFlight_);
 
 	struct UniformDataMatrices {
 		glm::mat4 projection;
@@ -80,7 +80,7 @@ public:
 		VkDescriptorSet scene{ VK_NULL_HANDLE };
 		VkDescriptorSet skybox{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	// Default materials to select from
 	std::vector<Material> materials;
@@ -150,6 +150,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::FlipY;
 		// Skybox
 		models_.skybox.loadFromFile(getAssetPath() + "models/cube.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -167,10 +168,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 4),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 6)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 4),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 6)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo =	vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo =	vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layout
@@ -212,6 +213,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		VkPipelineInputAssemblyStateCreateInfo inputAssemblyState =
 			vks::initializers::pipelineInputAssemblyStateCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 0, VK_FALSE);
 
@@ -283,6 +285,7 @@ public:
 	// Generate a BRDF integration map used as a look-up-table (stores roughness / NdotV)
 	void generateBRDFLUT()
 	{
+		ScopedStartupPhase startupPhase(this, "generateBRDFLUT");
 		auto tStart = std::chrono::high_resolution_clock::now();
 
 		const VkFormat format = VK_FORMAT_R16G16_SFLOAT;	// R16G16 is supported pretty much everywhere
@@ -306,7 +309,7 @@ public:
 		vkGetImageMemoryRequirements(device_, textures_.lutBrdf.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &textures_.lutBrdf.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &textures_.lutBrdf.deviceMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, textures_.lutBrdf.image, textures_.lutBrdf.deviceMemory, 0));
 		// Image view
 		VkImageViewCreateInfo viewCI = vks::initializers::imageViewCreateInfo();
@@ -487,6 +490,7 @@ public:
 	// Generate an irradiance cube map from the environment cube map
 	void generateIrradianceCube()
 	{
+		ScopedStartupPhase startupPhase(this, "generateIrradianceCube");
 		auto tStart = std::chrono::high_resolution_clock::now();
 
 		const VkFormat format = VK_FORMAT_R32G32B32A32_SFLOAT;
@@ -513,7 +517,7 @@ public:
 		vkGetImageMemoryRequirements(device_, textures_.irradianceCube.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &textures_.irradianceCube.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &textures_.irradianceCube.deviceMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, textures_.irradianceCube.image, textures_.irradianceCube.deviceMemory, 0));
 		// Image view
 		VkImageViewCreateInfo viewCI = vks::initializers::imageViewCreateInfo();
@@ -619,7 +623,7 @@ public:
 			vkGetImageMemoryRequirements(device_, offscreen.image, &memReqs);
 			memAlloc.allocationSize = memReqs.size;
 			memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreen.memory));
+			VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreen.memory, vks::MemoryTag::Attachments));
 			VK_CHECK_RESULT(vkBindImageMemory(device_, offscreen.image, offscreen.memory, 0));
 
 			VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -850,7 +854,7 @@ public:
 
 		vkDestroyRenderPass(device_, renderpass, nullptr);
 		vkDestroyFramebuffer(device_, offscreen.framebuffer, nullptr);
-		vkFreeMemory(device_, offscreen.memory, nullptr);
+		vulkanDevice_->freeMemory(offscreen.memory);
 		vkDestroyImageView(device_, offscreen.view, nullptr);
 		vkDestroyImage(device_, offscreen.image, nullptr);
 		vkDestroyDescriptorPool(device_, descriptorpool, nullptr);
@@ -867,6 +871,7 @@ public:
 	// See https://placeholderart.wordpress.com/2015/07/28/implementation-notes-runtime-environment-map-filtering-for-image-based-lighting/
 	void generatePrefilteredCube()
 	{
+		ScopedStartupPhase startupPhase(this, "generatePrefilteredCube");
 		auto tStart = std::chrono::high_resolution_clock::now();
 
 		const VkFormat format = VK_FORMAT_R16G16B16A16_SFLOAT;
@@ -893,7 +898,7 @@ public:
 		vkGetImageMemoryRequirements(device_, textures_.prefilteredCube.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &textures_.prefilteredCube.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &textures_.prefilteredCube.deviceMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, textures_.prefilteredCube.image, textures_.prefilteredCube.deviceMemory, 0));
 		// Image view
 		VkImageViewCreateInfo viewCI = vks::initializers::imageViewCreateInfo();
@@ -999,7 +1004,7 @@ public:
 			vkGetImageMemoryRequirements(device_, offscreen.image, &memReqs);
 			memAlloc.allocationSize = memReqs.size;
 			memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreen.memory));
+			VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreen.memory, vks::MemoryTag::Attachments));
 			VK_CHECK_RESULT(vkBindImageMemory(device_, offscreen.image, offscreen.memory, 0));
 
 			VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -1230,7 +1235,7 @@ public:
 
 		vkDestroyRenderPass(device_, renderpass, nullptr);
 		vkDestroyFramebuffer(device_, offscreen.framebuffer, nullptr);
-		vkFreeMemory(device_, offscreen.memory, nullptr);
+		vulkanDevice_->freeMemory(offscreen.memory);
 		vkDestroyImageView(device_, offscreen.view, nullptr);
 		vkDestroyImage(device_, offscreen.image, nullptr);
 		vkDestroyDescriptorPool(device_, descriptorpool, nullptr);
@@ -1261,6 +1266,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// 3D objects
 		uniformDataMatrices.projection = camera_.matrices_.perspective;
 		uniformDataMatrices.view = camera_.matrices_.view;
@@ -1296,6 +1302,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
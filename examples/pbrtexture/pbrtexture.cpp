@@ -40,7 +40,7 @@ public:
 		vks::Buffer skybox;
 		vks::Buffer params;
 	};
-	std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffers> uniformBuffers_ = std::vector<UniformBuffers>(framesInFlight_);
 
 	struct UniformDataMatrices {
 		glm::mat4 projection;
@@ -66,7 +66,7 @@ public:
 		VkDescriptorSet scene{ VK_NULL_HANDLE };
 		VkDescriptorSet skybox{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	VulkanExample() : VulkanExampleBase()
 	{
@@ -112,6 +112,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		const uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::PreMultiplyVertexColors | vkglTF::FileLoadingFlags::FlipY;
 		models_.skybox.loadFromFile(getAssetPath() + "models/cube.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
 		models_.object.loadFromFile(getAssetPath() + "models/cerberus/cerberus.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -127,10 +128,10 @@ public:
 	{
 		// Descriptor Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 4),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 16)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 4),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 16)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo =	vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo =	vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Descriptor set layout
@@ -182,6 +183,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		VkPipelineInputAssemblyStateCreateInfo inputAssemblyState = vks::initializers::pipelineInputAssemblyStateCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 0, VK_FALSE);
 		VkPipelineRasterizationStateCreateInfo rasterizationState = vks::initializers::pipelineRasterizationStateCreateInfo(VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, VK_FRONT_FACE_COUNTER_CLOCKWISE);
 		VkPipelineColorBlendAttachmentState blendAttachmentState = vks::initializers::pipelineColorBlendAttachmentState(0xf, VK_FALSE);
@@ -229,6 +231,7 @@ public:
 	// Generate a BRDF integration map used as a look-up-table (stores roughness / NdotV)
 	void generateBRDFLUT()
 	{
+		ScopedStartupPhase startupPhase(this, "generateBRDFLUT");
 		auto tStart = std::chrono::high_resolution_clock::now();
 
 		const VkFormat format = VK_FORMAT_R16G16_SFLOAT;	// R16G16 is supported pretty much everywhere
@@ -252,7 +255,7 @@ public:
 		vkGetImageMemoryRequirements(device_, textures_.lutBrdf.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &textures_.lutBrdf.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &textures_.lutBrdf.deviceMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, textures_.lutBrdf.image, textures_.lutBrdf.deviceMemory, 0));
 		// Image view
 		VkImageViewCreateInfo viewCI = vks::initializers::imageViewCreateInfo();
@@ -433,6 +436,7 @@ public:
 	// Generate an irradiance cube map from the environment cube map
 	void generateIrradianceCube()
 	{
+		ScopedStartupPhase startupPhase(this, "generateIrradianceCube");
 		auto tStart = std::chrono::high_resolution_clock::now();
 
 		const VkFormat format = VK_FORMAT_R32G32B32A32_SFLOAT;
@@ -459,7 +463,7 @@ public:
 		vkGetImageMemoryRequirements(device_, textures_.irradianceCube.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &textures_.irradianceCube.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &textures_.irradianceCube.deviceMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, textures_.irradianceCube.image, textures_.irradianceCube.deviceMemory, 0));
 		// Image view
 		VkImageViewCreateInfo viewCI = vks::initializers::imageViewCreateInfo();
@@ -565,7 +569,7 @@ public:
 			vkGetImageMemoryRequirements(device_, offscreen.image, &memReqs);
 			memAlloc.allocationSize = memReqs.size;
 			memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreen.memory));
+			VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreen.memory, vks::MemoryTag::Attachments));
 			VK_CHECK_RESULT(vkBindImageMemory(device_, offscreen.image, offscreen.memory, 0));
 
 			VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -796,7 +800,7 @@ public:
 
 		vkDestroyRenderPass(device_, renderpass, nullptr);
 		vkDestroyFramebuffer(device_, offscreen.framebuffer, nullptr);
-		vkFreeMemory(device_, offscreen.memory, nullptr);
+		vulkanDevice_->freeMemory(offscreen.memory);
 		vkDestroyImageView(device_, offscreen.view, nullptr);
 		vkDestroyImage(device_, offscreen.image, nullptr);
 		vkDestroyDescriptorPool(device_, descriptorpool, nullptr);
@@ -813,6 +817,7 @@ public:
 	// See https://placeholderart.wordpress.com/2015/07/28/implementation-notes-runtime-environment-map-filtering-for-image-based-lighting/
 	void generatePrefilteredCube()
 	{
+		ScopedStartupPhase startupPhase(this, "generatePrefilteredCube");
 		auto tStart = std::chrono::high_resolution_clock::now();
 
 		const VkFormat format = VK_FORMAT_R16G16B16A16_SFLOAT;
@@ -839,7 +844,7 @@ public:
 		vkGetImageMemoryRequirements(device_, textures_.prefilteredCube.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &textures_.prefilteredCube.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &textures_.prefilteredCube.deviceMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, textures_.prefilteredCube.image, textures_.prefilteredCube.deviceMemory, 0));
 		// Image view
 		VkImageViewCreateInfo viewCI = vks::initializers::imageViewCreateInfo();
@@ -945,7 +950,7 @@ public:
 			vkGetImageMemoryRequirements(device_, offscreen.image, &memReqs);
 			memAlloc.allocationSize = memReqs.size;
 			memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &offscreen.memory));
+			VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &offscreen.memory, vks::MemoryTag::Attachments));
 			VK_CHECK_RESULT(vkBindImageMemory(device_, offscreen.image, offscreen.memory, 0));
 
 			VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -1176,7 +1181,7 @@ public:
 
 		vkDestroyRenderPass(device_, renderpass, nullptr);
 		vkDestroyFramebuffer(device_, offscreen.framebuffer, nullptr);
-		vkFreeMemory(device_, offscreen.memory, nullptr);
+		vulkanDevice_->freeMemory(offscreen.memory);
 		vkDestroyImageView(device_, offscreen.view, nullptr);
 		vkDestroyImage(device_, offscreen.image, nullptr);
 		vkDestroyDescriptorPool(device_, descriptorpool, nullptr);
@@ -1207,6 +1212,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// 3D object
 		uniformDataMatrices.projection = camera_.matrices_.perspective;
 		uniformDataMatrices.view = camera_.matrices_.view;
@@ -1243,6 +1249,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -45,12 +45,14 @@ class VulkanExample : public VulkanRaytracingSample {
     glm::mat4 projInverse;
     uint32_t frame{0};
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   vkglTF::Model model;
 
@@ -123,8 +125,9 @@ class VulkanExample : public VulkanRaytracingSample {
     memoryAllocateInfo.allocationSize = memoryRequirements.size;
     memoryAllocateInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memoryAllocateInfo, nullptr,
-                                     &accelerationStructure.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memoryAllocateInfo, &accelerationStructure.memory,
+        vks::MemoryTag::Geometry));
     VK_CHECK_RESULT(vkBindBufferMemory(device_, accelerationStructure.buffer,
                                        accelerationStructure.memory, 0));
   }
@@ -666,16 +669,16 @@ class VulkanExample : public VulkanRaytracingSample {
   void createDescriptorSets() {
     uint32_t imageCount = static_cast<uint32_t>(model.textures.size());
     std::vector<VkDescriptorPoolSize> poolSizes = {
-        {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES},
+        {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_},
         {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-         static_cast<uint32_t>(model.textures.size()) * MAX_CONCURRENT_FRAMES}};
+         static_cast<uint32_t>(model.textures.size()) * framesInFlight_}};
     VkDescriptorPoolCreateInfo descriptorPoolCreateInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCreateInfo,
                                            nullptr, &descriptorPool_));
 
@@ -695,7 +698,7 @@ class VulkanExample : public VulkanRaytracingSample {
                                                      &descriptorSetLayout, 1);
     // Required for the variable no. of images used by the glTF model
     descriptorSetAllocateInfo.pNext = &variableDescriptorCountAllocInfo;
-    for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VK_CHECK_RESULT(vkAllocateDescriptorSets(
           device_, &descriptorSetAllocateInfo, &descriptorSets_[i]));
 
@@ -787,7 +790,7 @@ class VulkanExample : public VulkanRaytracingSample {
     // Update descriptors
     VkDescriptorImageInfo storageImageDescriptor{
         VK_NULL_HANDLE, storageImage.view, VK_IMAGE_LAYOUT_GENERAL};
-    for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VkWriteDescriptorSet resultImageWrite =
           vks::initializers::writeDescriptorSet(
               descriptorSets_[i], VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1,
@@ -798,6 +801,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projInverse = glm::inverse(camera_.matrices_.perspective);
     uniformData_.viewInverse = glm::inverse(camera_.matrices_.view);
     // This value is used to accumulate multiple frames into the finale picture
@@ -844,6 +848,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     vkglTF::memoryPropertyFlags =
         VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR |
         VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
@@ -871,6 +876,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     if (resized_) {
       handleResize();
     }
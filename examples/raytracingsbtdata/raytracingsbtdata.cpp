@@ -72,12 +72,12 @@ public:
 		glm::mat4 viewInverse;
 		glm::mat4 projInverse;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipeline pipeline{ VK_NULL_HANDLE };
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	VulkanExample() : VulkanExampleBase()
 	{
@@ -117,11 +117,11 @@ public:
 		vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
 		vkDestroyImageView(device_, storageImage.view, nullptr);
 		vkDestroyImage(device_, storageImage.image, nullptr);
-		vkFreeMemory(device_, storageImage.memory, nullptr);
-		vkFreeMemory(device_, bottomLevelAS.memory, nullptr);
+		vulkanDevice_->freeMemory(storageImage.memory);
+		vulkanDevice_->freeMemory(bottomLevelAS.memory);
 		vkDestroyBuffer(device_, bottomLevelAS.buffer, nullptr);
 		vkDestroyAccelerationStructureKHR(device_, bottomLevelAS.handle, nullptr);
-		vkFreeMemory(device_, topLevelAS.memory, nullptr);
+		vulkanDevice_->freeMemory(topLevelAS.memory);
 		vkDestroyBuffer(device_, topLevelAS.buffer, nullptr);
 		vkDestroyAccelerationStructureKHR(device_, topLevelAS.handle, nullptr);
 		vertexBuffer.destroy();
@@ -160,7 +160,7 @@ public:
 		memoryAllocateInfo.pNext = &memoryAllocateFlagsInfo;
 		memoryAllocateInfo.allocationSize = memoryRequirements.size;
 		memoryAllocateInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memoryAllocateInfo, nullptr, &scratchBuffer.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memoryAllocateInfo, &scratchBuffer.memory, vks::MemoryTag::Geometry));
 		VK_CHECK_RESULT(vkBindBufferMemory(device_, scratchBuffer.handle, scratchBuffer.memory, 0));
 
 		VkBufferDeviceAddressInfoKHR bufferDeviceAddressInfo{};
@@ -174,7 +174,7 @@ public:
 	void deleteScratchBuffer(RayTracingScratchBuffer& scratchBuffer) 
 	{
 		if (scratchBuffer.memory != VK_NULL_HANDLE) {
-			vkFreeMemory(device_, scratchBuffer.memory, nullptr);
+			vulkanDevice_->freeMemory(scratchBuffer.memory);
 		}
 		if (scratchBuffer.handle != VK_NULL_HANDLE) {
 			vkDestroyBuffer(device_, scratchBuffer.handle, nullptr);
@@ -198,7 +198,7 @@ public:
 		memoryAllocateInfo.pNext = &memoryAllocateFlagsInfo;
 		memoryAllocateInfo.allocationSize = memoryRequirements.size;
 		memoryAllocateInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memoryAllocateInfo, nullptr, &accelerationStructure.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memoryAllocateInfo, &accelerationStructure.memory, vks::MemoryTag::Geometry));
 		VK_CHECK_RESULT(vkBindBufferMemory(device_, accelerationStructure.buffer, accelerationStructure.memory, 0));
 	}
 
@@ -223,7 +223,7 @@ public:
 		if (storageImage.image != VK_NULL_HANDLE) {
 			vkDestroyImageView(device_, storageImage.view, nullptr);
 			vkDestroyImage(device_, storageImage.image, nullptr);
-			vkFreeMemory(device_, storageImage.memory, nullptr);
+			vulkanDevice_->freeMemory(storageImage.memory);
 			storageImage = {};
 		}
 
@@ -246,7 +246,7 @@ public:
 		VkMemoryAllocateInfo memoryAllocateInfo = vks::initializers::memoryAllocateInfo();
 		memoryAllocateInfo.allocationSize = memReqs.size;
 		memoryAllocateInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memoryAllocateInfo, nullptr, &storageImage.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memoryAllocateInfo, &storageImage.memory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, storageImage.image, storageImage.memory, 0));
 
 		VkImageViewCreateInfo colorImageView = vks::initializers::imageViewCreateInfo();
@@ -583,17 +583,17 @@ public:
 	void createDescriptorSets()
 	{
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			{ VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, MAX_CONCURRENT_FRAMES },
-			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_CONCURRENT_FRAMES },
-			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES }
+			{ VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, framesInFlight_ },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight_ },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ }
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCreateInfo, nullptr, &descriptorPool_));
 
 		// Sets per frame, just like the buffers themselves
 		// Acceleration structure and storage images do not need to be duplicated per frame, we use the same for each descriptor to keep things simple
 		VkDescriptorSetAllocateInfo allocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool_, &descriptorSetLayout, 1);
-		for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			VK_CHECK_RESULT(vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSets_[i]));
 
 			// The fragment shader needs access to the ray tracing acceleration structure, so we pass it as a descriptor
@@ -747,7 +747,7 @@ public:
 		createStorageImage();
 		// Update descriptors
 		VkDescriptorImageInfo storageImageDescriptor{ VK_NULL_HANDLE, storageImage.view, VK_IMAGE_LAYOUT_GENERAL };
-		for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			VkWriteDescriptorSet resultImageWrite = vks::initializers::writeDescriptorSet(descriptorSets_[i], VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, &storageImageDescriptor);
 			vkUpdateDescriptorSets(device_, 1, &resultImageWrite, 0, VK_NULL_HANDLE);
 		}
@@ -756,6 +756,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projInverse = glm::inverse(camera_.matrices_.perspective);
 		uniformData_.viewInverse = glm::inverse(camera_.matrices_.view);
 		memcpy(uniformBuffers_[currentBuffer_].mapped, &uniformData_, sizeof(uniformData_));
@@ -822,6 +823,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		if (resized_)
 		{
 			handleResize();
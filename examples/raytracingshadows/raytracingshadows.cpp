@@ -31,12 +31,14 @@ class VulkanExample : public VulkanRaytracingSample {
     glm::vec4 lightPos;
     int32_t vertexSize{0};
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   vkglTF::Model scene;
 
@@ -350,13 +352,13 @@ class VulkanExample : public VulkanRaytracingSample {
   */
   void createDescriptorSets() {
     std::vector<VkDescriptorPoolSize> poolSizes = {
-        {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES * 2}};
+        {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_ * 2}};
     VkDescriptorPoolCreateInfo descriptorPoolCreateInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCreateInfo,
                                            nullptr, &descriptorPool_));
 
@@ -367,7 +369,7 @@ class VulkanExample : public VulkanRaytracingSample {
     VkDescriptorSetAllocateInfo allocInfo =
         vks::initializers::descriptorSetAllocateInfo(descriptorPool_,
                                                      &descriptorSetLayout, 1);
-    for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VK_CHECK_RESULT(
           vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSets_[i]));
 
@@ -572,7 +574,7 @@ class VulkanExample : public VulkanRaytracingSample {
     // Update descriptors
     VkDescriptorImageInfo storageImageDescriptor{
         VK_NULL_HANDLE, storageImage.view, VK_IMAGE_LAYOUT_GENERAL};
-    for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VkWriteDescriptorSet resultImageWrite =
           vks::initializers::writeDescriptorSet(
               descriptorSets_[i], VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1,
@@ -583,6 +585,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projInverse = glm::inverse(camera_.matrices_.perspective);
     uniformData_.viewInverse = glm::inverse(camera_.matrices_.view);
     uniformData_.lightPos =
@@ -632,6 +635,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     if (resized_) {
       handleResize();
     }
@@ -44,12 +44,14 @@ class VulkanExample : public VulkanRaytracingSample {
     glm::mat4 viewInverse;
     glm::mat4 projInverse;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VulkanExample() : VulkanRaytracingSample() {
     title = "Ray tracing textures";
@@ -105,8 +107,9 @@ class VulkanExample : public VulkanRaytracingSample {
     memoryAllocateInfo.allocationSize = memoryRequirements.size;
     memoryAllocateInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memoryAllocateInfo, nullptr,
-                                     &accelerationStructure.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memoryAllocateInfo, &accelerationStructure.memory,
+        vks::MemoryTag::Geometry));
     VK_CHECK_RESULT(vkBindBufferMemory(device_, accelerationStructure.buffer,
                                        accelerationStructure.memory, 0));
   }
@@ -475,13 +478,13 @@ class VulkanExample : public VulkanRaytracingSample {
   */
   void createDescriptorSets() {
     std::vector<VkDescriptorPoolSize> poolSizes = {
-        {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES},
-        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES}};
+        {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_}};
     VkDescriptorPoolCreateInfo descriptorPoolCreateInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCreateInfo,
                                            nullptr, &descriptorPool_));
 
@@ -491,7 +494,7 @@ class VulkanExample : public VulkanRaytracingSample {
     VkDescriptorSetAllocateInfo allocInfo =
         vks::initializers::descriptorSetAllocateInfo(descriptorPool_,
                                                      &descriptorSetLayout, 1);
-    for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VK_CHECK_RESULT(
           vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSets_[i]));
 
@@ -696,7 +699,7 @@ class VulkanExample : public VulkanRaytracingSample {
     // Update descriptors
     VkDescriptorImageInfo storageImageDescriptor{
         VK_NULL_HANDLE, storageImage.view, VK_IMAGE_LAYOUT_GENERAL};
-    for (auto i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VkWriteDescriptorSet resultImageWrite =
           vks::initializers::writeDescriptorSet(
               descriptorSets_[i], VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1,
@@ -707,6 +710,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projInverse = glm::inverse(camera_.matrices_.perspective);
     uniformData_.viewInverse = glm::inverse(camera_.matrices_.view);
     memcpy(uniformBuffers_[currentBuffer_].mapped, &uniformData_,
@@ -735,6 +739,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     texture_.loadFromFile(getAssetPath() + "textures/gratefloor_rgba.ktx",
                           VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
   }
@@ -757,6 +762,7 @@ class VulkanExample : public VulkanRaytracingSample {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     if (resized_) {
       handleResize();
     }
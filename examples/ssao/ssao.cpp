@@ -67,14 +67,14 @@ public:
 		VkDescriptorSet ssaoBlur{ VK_NULL_HANDLE };
 		VkDescriptorSet composition{ VK_NULL_HANDLE };
 	};
-	std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_;
+	std::vector<DescriptorSets> descriptorSets_ = std::vector<DescriptorSets>(framesInFlight_);
 
 	struct UniformBuffers {
 		vks::Buffer sceneParams;
 		vks::Buffer ssaoKernel;
 		vks::Buffer ssaoParams;
 	};
-	std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffers> uniformBuffers_ = std::vector<UniformBuffers>(framesInFlight_);
 
 	// Framebuffer for offscreen rendering
 	struct FrameBufferAttachment {
@@ -82,11 +82,11 @@ public:
 		VkDeviceMemory mem;
 		VkImageView view;
 		VkFormat format;
-		void destroy(VkDevice device)
+		void destroy(vks::VulkanDevice* device)
 		{
-			vkDestroyImage(device, image, nullptr);
-			vkDestroyImageView(device, view, nullptr);
-			vkFreeMemory(device, mem, nullptr);
+			vkDestroyImage(device->logicalDevice, image, nullptr);
+			vkDestroyImageView(device->logicalDevice, view, nullptr);
+			device->freeMemory(mem);
 		}
 	};
 	struct FrameBuffer {
@@ -133,12 +133,12 @@ public:
 	{
 		if (device_) {
 			vkDestroySampler(device_, colorSampler, nullptr);
-			frameBuffers.offscreen.position.destroy(device_);
-			frameBuffers.offscreen.normal.destroy(device_);
-			frameBuffers.offscreen.albedo.destroy(device_);
-			frameBuffers.offscreen.depth.destroy(device_);
-			frameBuffers.ssao.color.destroy(device_);
-			frameBuffers.ssaoBlur.color.destroy(device_);
+			frameBuffers.offscreen.position.destroy(vulkanDevice_);
+			frameBuffers.offscreen.normal.destroy(vulkanDevice_);
+			frameBuffers.offscreen.albedo.destroy(vulkanDevice_);
+			frameBuffers.offscreen.depth.destroy(vulkanDevice_);
+			frameBuffers.ssao.color.destroy(vulkanDevice_);
+			frameBuffers.ssaoBlur.color.destroy(vulkanDevice_);
 			frameBuffers.offscreen.destroy(device_);
 			frameBuffers.ssao.destroy(device_);
 			frameBuffers.ssaoBlur.destroy(device_);
@@ -212,7 +212,7 @@ public:
 		vkGetImageMemoryRequirements(device_, attachment->image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &attachment->mem));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &attachment->mem, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, attachment->image, attachment->mem, 0));
 
 		VkImageViewCreateInfo imageView = vks::initializers::imageViewCreateInfo();
@@ -483,6 +483,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		vkglTF::descriptorBindingFlags  = vkglTF::DescriptorBindingFlags::ImageBaseColor;
 		const uint32_t gltfLoadingFlags = vkglTF::FileLoadingFlags::FlipY | vkglTF::FileLoadingFlags::PreTransformVertices;
 		scene.loadFromFile(getAssetPath() + "models/sponza/sponza.gltf", vulkanDevice_, queue_, gltfLoadingFlags);
@@ -492,10 +493,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 4),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 10)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 4),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 10)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 4);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 4);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		VkDescriptorSetAllocateInfo descriptorAllocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool_, nullptr, 1);
@@ -595,6 +596,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layouts
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = vks::initializers::pipelineLayoutCreateInfo();
 
@@ -701,7 +703,7 @@ public:
 	void prepareBuffers()
 	{
 		// Set up SSAO sample kernel
-		std::default_random_engine rndEngine(benchmark.active ? 0 : (unsigned)time(nullptr));
+		std::default_random_engine rndEngine(randomSeed());
 		std::uniform_real_distribution<float> rndDist(0.0f, 1.0f);
 		std::vector<glm::vec4> ssaoKernel(SSAO_KERNEL_SIZE);
 		for (uint32_t i = 0; i < SSAO_KERNEL_SIZE; ++i) {
@@ -734,6 +736,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		// Scene
 		uboSceneParams.projection = camera_.matrices_.perspective;
 		uboSceneParams.view = camera_.matrices_.view;
@@ -758,6 +761,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -15,6 +15,7 @@
 #include <ktxvulkan.h>
 #include "VulkanglTFModel.h"
 #include "frustum.hpp"
+#include "terraintessellation.h"
 #include "vulkanexamplebase.h"
 
 class VulkanExample : public VulkanExampleBase {
@@ -43,7 +44,8 @@ class VulkanExample : public VulkanExampleBase {
     vks::Buffer terrainTessellation;
     vks::Buffer skysphereVertex;
   };
-  std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<UniformBuffers> uniformBuffers_ =
+      std::vector<UniformBuffers>(framesInFlight_);
 
   // Shared values for vertex, tessellation control and evaluation stages
   struct UniformDataTessellation {
@@ -83,7 +85,8 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSet terrain{VK_NULL_HANDLE};
     VkDescriptorSet skysphere{VK_NULL_HANDLE};
   };
-  std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_;
+  std::vector<DescriptorSets> descriptorSets_ =
+      std::vector<DescriptorSets>(framesInFlight_);
 
   // If supported, this sample will gather pipeline statistics to show e.g.
   // tessellation related information
@@ -131,7 +134,7 @@ class VulkanExample : public VulkanExampleBase {
       if (queryPool != VK_NULL_HANDLE) {
         vkDestroyQueryPool(device_, queryPool, nullptr);
         vkDestroyBuffer(device_, queryResult.buffer, nullptr);
-        vkFreeMemory(device_, queryResult.memory, nullptr);
+        vulkanDevice_->freeMemory(queryResult.memory);
       }
     }
   }
@@ -179,8 +182,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &queryResult.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &queryResult.memory, vks::MemoryTag::Other));
     VK_CHECK_RESULT(
         vkBindBufferMemory(device_, queryResult.buffer, queryResult.memory, 0));
 
@@ -199,6 +202,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     const uint32_t glTFLoadingFlags =
         vkglTF::FileLoadingFlags::PreTransformVertices |
         vkglTF::FileLoadingFlags::PreMultiplyVertexColors |
@@ -262,6 +266,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // Generate a terrain quad patch with normals based on heightmap data
   void generateTerrain() {
+    ScopedStartupPhase startupPhase(this, "generateTerrain");
     const uint32_t patchSize{64};
     const float uvScale{1.0f};
 
@@ -329,33 +334,8 @@ class VulkanExample : public VulkanExampleBase {
     // Calculate normals from the height map using a sobel filter
     for (auto x = 0; x < patchSize; x++) {
       for (auto y = 0; y < patchSize; y++) {
-        // We get
-        float heights[3][3];
-        for (auto sx = -1; sx <= 1; sx++) {
-          for (auto sy = -1; sy <= 1; sy++) {
-            // Get height at sampled position from heightmap
-            glm::ivec2 rpos = glm::ivec2(x + sx, y + sy) * glm::ivec2(scale);
-            rpos.x = std::max(0, std::min(rpos.x, (int)dim - 1));
-            rpos.y = std::max(0, std::min(rpos.y, (int)dim - 1));
-            rpos /= glm::ivec2(scale);
-            heights[sx + 1][sy + 1] =
-                *(heightdata + (rpos.x + rpos.y * dim) * scale) / 65535.0f;
-          }
-        }
-        glm::vec3 normal;
-        // Gx sobel filter
-        normal.x = heights[0][0] - heights[2][0] + 2.0f * heights[0][1] -
-                   2.0f * heights[2][1] + heights[0][2] - heights[2][2];
-        // Gy sobel filter
-        normal.z = heights[0][0] + 2.0f * heights[1][0] + heights[2][0] -
-                   heights[0][2] - 2.0f * heights[1][2] - heights[2][2];
-        // Calculate missing up component of the normal using the filtered x and
-        // y axis The first value controls the bump strength
-        normal.y =
-            0.25f * sqrt(1.0f - normal.x * normal.x - normal.z * normal.z);
-
         vertices[x + y * patchSize].normal =
-            glm::normalize(normal * glm::vec3(2.0f, 1.0f, 2.0f));
+            terrainNormal(heightdata, dim, scale, x, y);
       }
     }
 
@@ -380,22 +360,6 @@ class VulkanExample : public VulkanExampleBase {
     uint32_t vertexBufferSize = vertexCount * sizeof(vkglTF::Vertex);
     uint32_t indexBufferSize = terrain.indexCount * sizeof(uint32_t);
 
-    vks::Buffer vertexStaging, indexStaging;
-
-    // Stage the terrain vertex data to the device
-
-    VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        &vertexStaging, vertexBufferSize, vertices));
-
-    VK_CHECK_RESULT(
-        vulkanDevice_->createBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                    &indexStaging, indexBufferSize, indices));
-
     VK_CHECK_RESULT(vulkanDevice_->createBuffer(
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &terrain.vertexBuffer,
@@ -406,26 +370,16 @@ class VulkanExample : public VulkanExampleBase {
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &terrain.indexBuffer,
         indexBufferSize));
 
-    // Copy from staging buffers
-    VkCommandBuffer copyCmd = vulkanDevice_->createCommandBuffer(
-        VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-    VkBufferCopy copyRegion = {};
-
-    copyRegion.size = vertexBufferSize;
-    vkCmdCopyBuffer(copyCmd, vertexStaging.buffer, terrain.vertexBuffer.buffer,
-                    1, &copyRegion);
-
-    copyRegion.size = indexBufferSize;
-    vkCmdCopyBuffer(copyCmd, indexStaging.buffer, terrain.indexBuffer.buffer, 1,
-                    &copyRegion);
-
-    vulkanDevice_->flushCommandBuffer(copyCmd, queue_, true);
-
-    vkDestroyBuffer(device_, vertexStaging.buffer, nullptr);
-    vkFreeMemory(device_, vertexStaging.memory, nullptr);
-    vkDestroyBuffer(device_, indexStaging.buffer, nullptr);
-    vkFreeMemory(device_, indexStaging.memory, nullptr);
+    // Stream the terrain data through the transfer queue, the copies are
+    // submitted with the other uploads before the first frame and don't need
+    // to be waited for on the host
+    vulkanDevice_->uploadManager.uploadBuffer(
+        terrain.vertexBuffer.buffer, vertices, vertexBufferSize, 0,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+    vulkanDevice_->uploadManager.uploadBuffer(
+        terrain.indexBuffer.buffer, indices, indexBufferSize, 0,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT);
 
     delete[] vertices;
     delete[] indices;
@@ -435,13 +389,13 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES * 3),
+                                              framesInFlight_ * 3),
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            MAX_CONCURRENT_FRAMES * 3)};
+            framesInFlight_ * 3)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES * 2);
+                                                    framesInFlight_ * 2);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -544,6 +498,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layouts
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
 
@@ -673,6 +628,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     // Tessellation
     uniformDataTessellation.projection = camera_.matrices_.perspective;
     uniformDataTessellation.modelview =
@@ -722,6 +678,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -0,0 +1,52 @@
+/*
+ * Vulkan Example - Dynamic terrain tessellation
+ *
+ * Terrain generation helpers that don't depend on Vulkan (also used by the CPU
+ * benchmarks)
+ *
+ * Copyright (C) 2016-2025 by Sascha Willems - www.saschawillems.de
+ *
+ * This code is licensed under the MIT license (MIT)
+ * (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Calculates the normal of the terrain patch vertex at x, y from a 16 bit
+// height map with dim * dim texels using a sobel filter. scale is the number
+// of height map texels per patch vertex
+inline glm::vec3 terrainNormal(const uint16_t* heightdata,
+                               uint32_t dim,
+                               uint32_t scale,
+                               int32_t x,
+                               int32_t y) {
+  float heights[3][3];
+  for (auto sx = -1; sx <= 1; sx++) {
+    for (auto sy = -1; sy <= 1; sy++) {
+      // Get height at sampled position from heightmap
+      glm::ivec2 rpos = glm::ivec2(x + sx, y + sy) * glm::ivec2(scale);
+      rpos.x = std::max(0, std::min(rpos.x, (int)dim - 1));
+      rpos.y = std::max(0, std::min(rpos.y, (int)dim - 1));
+      rpos /= glm::ivec2(scale);
+      heights[sx + 1][sy + 1] =
+          *(heightdata + (rpos.x + rpos.y * dim) * scale) / 65535.0f;
+    }
+  }
+  glm::vec3 normal;
+  // Gx sobel filter
+  normal.x = heights[0][0] - heights[2][0] + 2.0f * heights[0][1] -
+             2.0f * heights[2][1] + heights[0][2] - heights[2][2];
+  // Gy sobel filter
+  normal.z = heights[0][0] + 2.0f * heights[1][0] + heights[2][0] -
+             heights[0][2] - 2.0f * heights[1][2] - heights[2][2];
+  // Calculate missing up component of the normal using the filtered x and y
+  // axis The first value controls the bump strength
+  normal.y = 0.25f * sqrt(1.0f - normal.x * normal.x - normal.z * normal.z);
+
+  return glm::normalize(normal * glm::vec3(2.0f, 1.0f, 2.0f));
+}
@@ -43,7 +43,8 @@ class VulkanExample : public VulkanExampleBase {
     vks::Buffer terrain;
     vks::Buffer skybox;
   };
-  std::array<UniformBuffers, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<UniformBuffers> uniformBuffers_ =
+      std::vector<UniformBuffers>(framesInFlight_);
 
   // Holds the buffers for rendering the tessellated terrain
   struct {
@@ -72,10 +73,12 @@ class VulkanExample : public VulkanExampleBase {
     VkDescriptorSet terrain{VK_NULL_HANDLE};
     VkDescriptorSet skyBox{VK_NULL_HANDLE};
   };
-  std::array<DescriptorSets, MAX_CONCURRENT_FRAMES> descriptorSets_;
+  std::vector<DescriptorSets> descriptorSets_ =
+      std::vector<DescriptorSets>(framesInFlight_);
 
   // Generate a terrain quad patch with normals based on heightmap data
   void generateTerrain() {
+    ScopedStartupPhase startupPhase(this, "generateTerrain");
     std::string filename = getAssetPath() + "textures/iceland_heightmap_r8.ktx";
 
     ktxResult result;
@@ -123,19 +126,6 @@ class VulkanExample : public VulkanExampleBase {
     // Allocate buffer space for vertices and indices
     size_t vertexBufferSize = vertices.size() * sizeof(vkglTF::Vertex);
     size_t indexBufferSize = indices.size() * sizeof(uint32_t);
-    vks::Buffer vertexBuffer, indexBuffer;
-
-    // Staging Buffer (Source)
-    VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        &vertexBuffer, vertexBufferSize, vertices.data()));
-    VK_CHECK_RESULT(vulkanDevice_->createBuffer(
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        &indexBuffer, indexBufferSize, indices.data()));
 
     // GPU Device Buffer (Destination)
     VK_CHECK_RESULT(vulkanDevice_->createBuffer(
@@ -147,39 +137,28 @@ class VulkanExample : public VulkanExampleBase {
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &terrain_.indexBuffer,
         indexBufferSize));
 
-    // Copy from staging buffers
-    VkCommandBuffer copyCmd = vulkanDevice_->createCommandBuffer(
-        VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-    VkBufferCopy copyRegion = {};
-
-    copyRegion.size = vertexBufferSize;
-    vkCmdCopyBuffer(copyCmd, vertexBuffer.buffer, terrain_.vertexBuffer.buffer,
-                    1, &copyRegion);
-
-    copyRegion.size = indexBufferSize;
-    vkCmdCopyBuffer(copyCmd, indexBuffer.buffer, terrain_.indexBuffer.buffer, 1,
-                    &copyRegion);
-
-    vulkanDevice_->flushCommandBuffer(copyCmd, queue_, true);
-
-    vkDestroyBuffer(device_, vertexBuffer.buffer, nullptr);
-    vkFreeMemory(device_, vertexBuffer.memory, nullptr);
-    vkDestroyBuffer(device_, indexBuffer.buffer, nullptr);
-    vkFreeMemory(device_, indexBuffer.memory, nullptr);
+    // Stream the terrain data through the transfer queue, the copies are
+    // submitted with the other uploads before the first frame
+    vulkanDevice_->uploadManager.uploadBuffer(
+        terrain_.vertexBuffer.buffer, vertices.data(), vertexBufferSize, 0,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+    vulkanDevice_->uploadManager.uploadBuffer(
+        terrain_.indexBuffer.buffer, indices.data(), indexBufferSize, 0,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT);
   }
 
   void setupDescriptors() {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES * 2),
+                                              framesInFlight_ * 2),
         vks::initializers::descriptorPoolSize(
             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            MAX_CONCURRENT_FRAMES * 2)};
+            framesInFlight_ * 2)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES * 2);
+                                                    framesInFlight_ * 2);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -269,6 +248,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layouts
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
 
@@ -411,6 +391,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     ubos_.terrain.mvp = camera_.matrices_.perspective *
                         glm::mat4(camera_.matrices_.view * glm::mat4(1.0f));
     memcpy(uniformBuffers_[currentBuffer_].terrain.mapped, &ubos_.terrain,
@@ -447,6 +428,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -581,6 +563,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     // Height data is stored in a one-channel texture
     textures_.heightMap.loadFromFile(
         getAssetPath() + "textures/iceland_heightmap_r8.ktx",
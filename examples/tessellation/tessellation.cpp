@@ -28,7 +28,8 @@ class VulkanExample : public VulkanExampleBase {
     float tessAlpha = 1.0f;
     float tessLevel = 3.0f;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   struct Pipelines {
     VkPipeline solid{VK_NULL_HANDLE};
@@ -39,7 +40,8 @@ class VulkanExample : public VulkanExampleBase {
 
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VulkanExample() : VulkanExampleBase() {
     title = "Tessellation shader (PN Triangles)";
@@ -93,6 +95,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     model.loadFromFile(getAssetPath() + "models/deer.gltf", vulkanDevice_,
                        queue_,
                        vkglTF::FileLoadingFlags::PreTransformVertices |
@@ -103,11 +106,11 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     const std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
     };
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -144,6 +147,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout uses set 0 for passing tessellation shader ubos and set 1 for
     // fragment shader images (taken from glTF model)
     const std::vector<VkDescriptorSetLayout> setLayouts = {
@@ -264,6 +268,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     // Adjust camera perspective if split screen is enabled
     camera_.setPerspective(
         45.0f, (float)(width_ * ((splitScreen) ? 0.5f : 1.0f)) / (float)height_,
@@ -284,6 +289,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
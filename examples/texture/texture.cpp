@@ -50,12 +50,14 @@ class VulkanExample : public VulkanExampleBase {
     // fragment shader
     float lodBias = 0.0f;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VulkanExample() : VulkanExampleBase() {
     title = "Texture loading";
@@ -208,8 +210,8 @@ class VulkanExample : public VulkanExampleBase {
       memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
           memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-      VK_CHECK_RESULT(
-          vkAllocateMemory(device_, &memAllocInfo, nullptr, &stagingMemory));
+      VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+          &memAllocInfo, &stagingMemory, vks::MemoryTag::Staging));
       VK_CHECK_RESULT(
           vkBindBufferMemory(device_, stagingBuffer, stagingMemory, 0));
 
@@ -265,8 +267,8 @@ class VulkanExample : public VulkanExampleBase {
       memAllocInfo.allocationSize = memReqs.size;
       memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
           memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-      VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr,
-                                       &texture_.deviceMemory));
+      VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+          &memAllocInfo, &texture_.deviceMemory, vks::MemoryTag::Textures));
       VK_CHECK_RESULT(
           vkBindImageMemory(device_, texture_.image, texture_.deviceMemory, 0));
 
@@ -334,7 +336,7 @@ class VulkanExample : public VulkanExampleBase {
       vulkanDevice_->flushCommandBuffer(copyCmd, queue_, true);
 
       // Clean up staging resources
-      vkFreeMemory(device_, stagingMemory, nullptr);
+      vulkanDevice_->freeMemory(stagingMemory);
       vkDestroyBuffer(device_, stagingBuffer, nullptr);
     } else {
       // Copy data to a linear tiled image
@@ -365,8 +367,8 @@ class VulkanExample : public VulkanExampleBase {
       memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
           memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-      VK_CHECK_RESULT(
-          vkAllocateMemory(device_, &memAllocInfo, nullptr, &mappableMemory));
+      VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+          &memAllocInfo, &mappableMemory, vks::MemoryTag::Textures));
       VK_CHECK_RESULT(
           vkBindImageMemory(device_, mappableImage, mappableMemory, 0));
 
@@ -484,7 +486,7 @@ class VulkanExample : public VulkanExampleBase {
     vkDestroyImageView(device_, texture.view, nullptr);
     vkDestroyImage(device_, texture.image, nullptr);
     vkDestroySampler(device_, texture.sampler, nullptr);
-    vkFreeMemory(device_, texture.deviceMemory, nullptr);
+    vulkanDevice_->freeMemory(texture.deviceMemory);
   }
 
   // Creates a vertex and index buffer for a quad made of two triangles
@@ -544,12 +546,12 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         // The sample uses a combined image + sampler descriptor to sample the
         // texture in the fragment shader We need multiple descriptors (NOT
         // images) due to how we set up the descriptor bindings in this sample
         vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES)};
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes, 2);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
@@ -621,6 +623,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
@@ -711,6 +714,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.modelView = camera_.matrices_.view;
     uniformData_.viewPos = camera_.viewPos_;
@@ -729,6 +733,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -8,6 +8,7 @@
  * (http://opensource.org/licenses/MIT)
  */
 
+#include "noise.hpp"
 #include "vulkanexamplebase.h"
 
 // Vertex layout for this example
@@ -17,111 +18,6 @@ struct Vertex {
   float normal[3];
 };
 
-// Translation of Ken Perlin's JAVA implementation
-// (http://mrl.nyu.edu/~perlin/noise/)
-template <typename T>
-class PerlinNoise {
- private:
-  uint32_t permutations[512];
-  T fade(T t) { return t * t * t * (t * (t * (T)6 - (T)15) + (T)10); }
-  T lerp(T t, T a, T b) { return a + t * (b - a); }
-  T grad(int hash, T x, T y, T z) {
-    // Convert LO 4 bits of hash code into 12 gradient directions
-    int h = hash & 15;
-    T u = h < 8 ? x : y;
-    T v = h < 4 ? y : h == 12 || h == 14 ? x : z;
-    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
-  }
-
- public:
-  PerlinNoise(bool applyRandomSeed) {
-    // Generate random lookup for permutations containing all numbers from
-    // 0..255
-    std::vector<uint8_t> plookup;
-    plookup.resize(256);
-    std::iota(plookup.begin(), plookup.end(), 0);
-    std::default_random_engine rndEngine(
-        applyRandomSeed ? std::random_device{}() : 0);
-    std::shuffle(plookup.begin(), plookup.end(), rndEngine);
-
-    for (uint32_t i = 0; i < 256; i++) {
-      permutations[i] = permutations[256 + i] = plookup[i];
-    }
-  }
-  T noise(T x, T y, T z) {
-    // Find unit cube that contains point
-    int32_t X = (int32_t)floor(x) & 255;
-    int32_t Y = (int32_t)floor(y) & 255;
-    int32_t Z = (int32_t)floor(z) & 255;
-    // Find relative x,y,z of point in cube
-    x -= floor(x);
-    y -= floor(y);
-    z -= floor(z);
-
-    // Compute fade curves for each of x,y,z
-    T u = fade(x);
-    T v = fade(y);
-    T w = fade(z);
-
-    // Hash coordinates of the 8 cube corners
-    uint32_t A = permutations[X] + Y;
-    uint32_t AA = permutations[A] + Z;
-    uint32_t AB = permutations[A + 1] + Z;
-    uint32_t B = permutations[X + 1] + Y;
-    uint32_t BA = permutations[B] + Z;
-    uint32_t BB = permutations[B + 1] + Z;
-
-    // And add blended results for 8 corners of the cube;
-    T res = lerp(w,
-                 lerp(v,
-                      lerp(u, grad(permutations[AA], x, y, z),
-                           grad(permutations[BA], x - 1, y, z)),
-                      lerp(u, grad(permutations[AB], x, y - 1, z),
-                           grad(permutations[BB], x - 1, y - 1, z))),
-                 lerp(v,
-                      lerp(u, grad(permutations[AA + 1], x, y, z - 1),
-                           grad(permutations[BA + 1], x - 1, y, z - 1)),
-                      lerp(u, grad(permutations[AB + 1], x, y - 1, z - 1),
-                           grad(permutations[BB + 1], x - 1, y - 1, z - 1))));
-    return res;
-  }
-};
-
-// Fractal noise generator based on perlin noise above
-template <typename T>
-class FractalNoise {
- private:
-  PerlinNoise<T> perlinNoise;
-  uint32_t octaves;
-  T frequency;
-  T amplitude;
-  T persistence;
-
- public:
-  FractalNoise(const PerlinNoise<T>& perlinNoiseIn)
-      : perlinNoise(perlinNoiseIn) {
-    octaves = 6;
-    persistence = (T)0.5;
-  }
-
-  T noise(T x, T y, T z) {
-    T sum = 0;
-    T frequency = (T)1;
-    T amplitude = (T)1;
-    T max = (T)0;
-    for (uint32_t i = 0; i < octaves; i++) {
-      sum += perlinNoise.noise(x * frequency, y * frequency, z * frequency) *
-             amplitude;
-      max += amplitude;
-      amplitude *= persistence;
-      frequency *= (T)2;
-    }
-
-    sum = sum / max;
-    return (sum + (T)1.0) / (T)2.0;
-  }
-};
-
 class VulkanExample : public VulkanExampleBase {
  public:
   // Contains all Vulkan objects that are required to store and use a 3D texture
@@ -151,12 +47,14 @@ class VulkanExample : public VulkanExampleBase {
     // This is animated
     float depth = 0.0f;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VulkanExample() : VulkanExampleBase() {
     title = "3D textures";
@@ -164,7 +62,6 @@ class VulkanExample : public VulkanExampleBase {
     camera_.setPosition(glm::vec3(0.0f, 0.0f, -2.5f));
     camera_.setRotation(glm::vec3(0.0f, 15.0f, 0.0f));
     camera_.setPerspective(60.0f, (float)width_ / (float)height_, 0.1f, 256.0f);
-    srand(benchmark.active ? 0 : (unsigned int)time(NULL));
   }
 
   ~VulkanExample() {
@@ -242,8 +139,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.allocationSize = memReqs.size;
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr,
-                                     &texture_.deviceMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &texture_.deviceMemory, vks::MemoryTag::Textures));
     VK_CHECK_RESULT(
         vkBindImageMemory(device_, texture_.image, texture_.deviceMemory, 0));
 
@@ -287,6 +184,7 @@ class VulkanExample : public VulkanExampleBase {
 
   // Generate randomized noise and upload it to the 3D texture using staging
   void updateNoiseTexture() {
+    ScopedStartupPhase startupPhase(this, "updateNoiseTexture");
     const uint32_t texMemSize =
         texture_.width * texture_.height * texture_.depth;
 
@@ -299,10 +197,11 @@ class VulkanExample : public VulkanExampleBase {
 
     auto tStart = std::chrono::high_resolution_clock::now();
 
-    PerlinNoise<float> perlinNoise(!benchmark.active);
-    FractalNoise<float> fractalNoise(perlinNoise);
+    vks::PerlinNoise<float> perlinNoise(randomEngine_);
+    vks::FractalNoise<float> fractalNoise(perlinNoise);
 
-    const float noiseScale = static_cast<float>(rand() % 10) + 4.0f;
+    std::uniform_int_distribution<int32_t> rndScale(0, 9);
+    const float noiseScale = static_cast<float>(rndScale(randomEngine_)) + 4.0f;
 
 #pragma omp parallel for
     for (int32_t z = 0; z < static_cast<int32_t>(texture_.depth); z++) {
@@ -346,8 +245,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAllocInfo, nullptr, &stagingMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &stagingMemory, vks::MemoryTag::Staging));
     VK_CHECK_RESULT(
         vkBindBufferMemory(device_, stagingBuffer, stagingMemory, 0));
 
@@ -403,7 +302,7 @@ class VulkanExample : public VulkanExampleBase {
 
     // Clean up staging resources
     delete[] data;
-    vkFreeMemory(device_, stagingMemory, nullptr);
+    vulkanDevice_->freeMemory(stagingMemory);
     vkDestroyBuffer(device_, stagingBuffer, nullptr);
   }
 
@@ -416,7 +315,7 @@ class VulkanExample : public VulkanExampleBase {
     if (texture.sampler != VK_NULL_HANDLE)
       vkDestroySampler(device_, texture.sampler, nullptr);
     if (texture.deviceMemory != VK_NULL_HANDLE)
-      vkFreeMemory(device_, texture.deviceMemory, nullptr);
+      vulkanDevice_->freeMemory(texture.deviceMemory);
   }
 
   // Creates a vertex and index buffer for a quad made of two triangles
@@ -476,12 +375,12 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES)};
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -528,6 +427,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
@@ -620,12 +520,13 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.modelView = camera_.matrices_.view;
     uniformData_.viewPos = camera_.viewPos_;
     if (!paused) {
       // Animate depth
-      uniformData_.depth += frameTimer * 0.15f;
+      uniformData_.depth += animationStep_ * 0.15f;
       if (uniformData_.depth > 1.0f) {
         uniformData_.depth = uniformData_.depth - 1.0f;
       }
@@ -645,6 +546,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
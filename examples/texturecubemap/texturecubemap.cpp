@@ -35,7 +35,8 @@ class VulkanExample : public VulkanExampleBase {
     glm::mat4 inverseModelview;
     float lodBias = 0.0f;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   struct {
     VkPipeline skybox{VK_NULL_HANDLE};
@@ -44,7 +45,8 @@ class VulkanExample : public VulkanExampleBase {
 
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   std::vector<std::string> objectNames;
 
@@ -62,7 +64,7 @@ class VulkanExample : public VulkanExampleBase {
       vkDestroyImageView(device_, cubeMap.view, nullptr);
       vkDestroyImage(device_, cubeMap.image, nullptr);
       vkDestroySampler(device_, cubeMap.sampler, nullptr);
-      vkFreeMemory(device_, cubeMap.deviceMemory, nullptr);
+      vulkanDevice_->freeMemory(cubeMap.deviceMemory);
       vkDestroyPipeline(device_, pipelines_.skybox, nullptr);
       vkDestroyPipeline(device_, pipelines_.reflect, nullptr);
       vkDestroyPipelineLayout(device_, pipelineLayout, nullptr);
@@ -150,8 +152,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAllocInfo, nullptr, &stagingMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &stagingMemory, vks::MemoryTag::Staging));
     VK_CHECK_RESULT(
         vkBindBufferMemory(device_, stagingBuffer, stagingMemory, 0));
 
@@ -188,8 +190,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr,
-                                     &cubeMap.deviceMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &cubeMap.deviceMemory, vks::MemoryTag::Textures));
     VK_CHECK_RESULT(
         vkBindImageMemory(device_, cubeMap.image, cubeMap.deviceMemory, 0));
 
@@ -287,12 +289,13 @@ class VulkanExample : public VulkanExampleBase {
     VK_CHECK_RESULT(vkCreateImageView(device_, &view, nullptr, &cubeMap.view));
 
     // Clean up staging resources
-    vkFreeMemory(device_, stagingMemory, nullptr);
+    vulkanDevice_->freeMemory(stagingMemory);
     vkDestroyBuffer(device_, stagingBuffer, nullptr);
     ktxTexture_Destroy(ktxTexture);
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices |
                                 vkglTF::FileLoadingFlags::FlipY;
     // Skybox
@@ -316,12 +319,12 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         vks::initializers::descriptorPoolSize(
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES)};
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_)};
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -369,6 +372,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     const VkPipelineLayoutCreateInfo pipelineLayoutCI =
         vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
@@ -455,6 +459,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     // Note: Both the object and skybox use the same uniform data, the
     // translation part of the skybox is removed in the shader (see skybox.vert)
@@ -474,6 +479,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -35,7 +35,7 @@ public:
 		// Used by the fragment shader to select the cubemap from the array cubemap
 		int cubeMapIndex = 1;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	struct {
 		VkPipeline skybox{ VK_NULL_HANDLE };
@@ -44,7 +44,7 @@ public:
 
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	std::vector<std::string> objectNames;
 
@@ -63,7 +63,7 @@ public:
 			vkDestroyImageView(device_, cubeMapArray.view, nullptr);
 			vkDestroyImage(device_, cubeMapArray.image, nullptr);
 			vkDestroySampler(device_, cubeMapArray.sampler, nullptr);
-			vkFreeMemory(device_, cubeMapArray.deviceMemory, nullptr);
+			vulkanDevice_->freeMemory(cubeMapArray.deviceMemory);
 			vkDestroyPipeline(device_, pipelines_.skybox, nullptr);
 			vkDestroyPipeline(device_, pipelines_.reflect, nullptr);
 			vkDestroyPipelineLayout(device_, pipelineLayout, nullptr);
@@ -142,7 +142,7 @@ public:
 		memAllocInfo.allocationSize = memReqs.size;
 		// Get memory type index for a host visible buffer
 		memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr, &sourceData.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllocInfo, &sourceData.memory, vks::MemoryTag::Staging));
 		VK_CHECK_RESULT(vkBindBufferMemory(device_, sourceData.buffer, sourceData.memory, 0));
 
 		// Copy the ktx image data into the source buffer
@@ -172,7 +172,7 @@ public:
 		vkGetImageMemoryRequirements(device_, cubeMapArray.image, &memReqs);
 		memAllocInfo.allocationSize = memReqs.size;
 		memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr, &cubeMapArray.deviceMemory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllocInfo, &cubeMapArray.deviceMemory, vks::MemoryTag::Textures));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, cubeMapArray.image, cubeMapArray.deviceMemory, 0));
 
 		/*
@@ -280,13 +280,14 @@ public:
 		VK_CHECK_RESULT(vkCreateImageView(device_, &view, nullptr, &cubeMapArray.view));
 
 		// Clean up staging resources
-		vkFreeMemory(device_, sourceData.memory, nullptr);
+		vulkanDevice_->freeMemory(sourceData.memory);
 		vkDestroyBuffer(device_, sourceData.buffer, nullptr);
 		ktxTexture_Destroy(ktxTexture);
 	}
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		uint32_t glTFLoadingFlags = vkglTF::FileLoadingFlags::PreTransformVertices | vkglTF::FileLoadingFlags::FlipY;
 		// Skybox
 		models_.skybox.loadFromFile(getAssetPath() + "models/cube.gltf", vulkanDevice_, queue_, glTFLoadingFlags);
@@ -305,10 +306,10 @@ public:
 	{
 		// Pool
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 		// Layout
@@ -339,6 +340,7 @@ public:
 
 	void preparePipelines()
 	{
+		ScopedStartupPhase startupPhase(this, "preparePipelines");
 		// Layout
 		const VkPipelineLayoutCreateInfo pipelineLayoutCI = vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 		VK_CHECK_RESULT(vkCreatePipelineLayout(device_, &pipelineLayoutCI, nullptr, &pipelineLayout));
@@ -394,6 +396,7 @@ public:
 
 	void updateUniformBuffers()
 	{
+		vks::ProfilerZone profilerZone("updateUniformBuffers");
 		uniformData_.projection = camera_.matrices_.perspective;
 		uniformData_.modelView = camera_.matrices_.view;
 		uniformData_.inverseModelview = glm::inverse(camera_.matrices_.view);
@@ -412,6 +415,7 @@ public:
 
 	void buildCommandBuffer()
 	{
+		vks::ProfilerZone profilerZone("buildCommandBuffer");
 		VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 		
 		VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -42,12 +42,14 @@ class VulkanExample : public VulkanExampleBase {
     float lodBias = 0.0f;
     int32_t samplerIndex = 2;
   } uniformData_;
-  std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<vks::Buffer> uniformBuffers_ =
+      std::vector<vks::Buffer>(framesInFlight_);
 
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
-  std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+  std::vector<VkDescriptorSet> descriptorSets_ =
+      std::vector<VkDescriptorSet>(framesInFlight_);
 
   VulkanExample() : VulkanExampleBase() {
     title = "Runtime mip map generation";
@@ -160,8 +162,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAllocInfo, nullptr, &stagingMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &stagingMemory, vks::MemoryTag::Staging));
     VK_CHECK_RESULT(
         vkBindBufferMemory(device_, stagingBuffer, stagingMemory, 0));
 
@@ -192,8 +194,8 @@ class VulkanExample : public VulkanExampleBase {
     memAllocInfo.allocationSize = memReqs.size;
     memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr,
-                                     &texture_.deviceMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAllocInfo, &texture_.deviceMemory, vks::MemoryTag::Textures));
     VK_CHECK_RESULT(
         vkBindImageMemory(device_, texture_.image, texture_.deviceMemory, 0));
 
@@ -238,7 +240,7 @@ class VulkanExample : public VulkanExampleBase {
     vulkanDevice_->flushCommandBuffer(copyCmd, queue_, true);
 
     // Clean up staging resources
-    vkFreeMemory(device_, stagingMemory, nullptr);
+    vulkanDevice_->freeMemory(stagingMemory);
     vkDestroyBuffer(device_, stagingBuffer, nullptr);
     ktxTexture_Destroy(ktxTexture);
 
@@ -361,10 +363,11 @@ class VulkanExample : public VulkanExampleBase {
   void destroyTextureImage(Texture texture) {
     vkDestroyImageView(device_, texture.view, nullptr);
     vkDestroyImage(device_, texture.image, nullptr);
-    vkFreeMemory(device_, texture.deviceMemory, nullptr);
+    vulkanDevice_->freeMemory(texture.deviceMemory);
   }
 
   void loadAssets() {
+    ScopedStartupPhase startupPhase(this, "loadAssets");
     model.loadFromFile(getAssetPath() + "models/tunnel_cylinder.gltf",
                        vulkanDevice_, queue_,
                        vkglTF::FileLoadingFlags::PreTransformVertices |
@@ -378,15 +381,15 @@ class VulkanExample : public VulkanExampleBase {
     // Pool
     std::vector<VkDescriptorPoolSize> poolSizes = {
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-                                              MAX_CONCURRENT_FRAMES),
+                                              framesInFlight_),
         vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_SAMPLER,
-                                              MAX_CONCURRENT_FRAMES * 3),
+                                              framesInFlight_ * 3),
     };
     VkDescriptorPoolCreateInfo descriptorPoolInfo =
         vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                    MAX_CONCURRENT_FRAMES);
+                                                    framesInFlight_);
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo,
                                            nullptr, &descriptorPool_));
 
@@ -457,6 +460,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void preparePipelines() {
+    ScopedStartupPhase startupPhase(this, "preparePipelines");
     // Layout
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
@@ -528,6 +532,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void updateUniformBuffers() {
+    vks::ProfilerZone profilerZone("updateUniformBuffers");
     uniformData_.projection = camera_.matrices_.perspective;
     uniformData_.view = camera_.matrices_.view;
     uniformData_.model =
@@ -549,6 +554,7 @@ class VulkanExample : public VulkanExampleBase {
   }
 
   void buildCommandBuffer() {
+    vks::ProfilerZone profilerZone("buildCommandBuffer");
     VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
     VkCommandBufferBeginInfo cmdBufInfo =
@@ -30,7 +30,7 @@ bool VirtualTexturePage::resident() {
 }
 
 // Allocate Vulkan memory for the virtual page
-bool VirtualTexturePage::allocate(VkDevice device, uint32_t memoryTypeIndex) {
+bool VirtualTexturePage::allocate(vks::VulkanDevice* device, uint32_t memoryTypeIndex) {
   if (imageMemoryBind.memory != VK_NULL_HANDLE) {
     return false;
   };
@@ -40,8 +40,8 @@ bool VirtualTexturePage::allocate(VkDevice device, uint32_t memoryTypeIndex) {
   VkMemoryAllocateInfo allocInfo = vks::initializers::memoryAllocateInfo();
   allocInfo.allocationSize = size;
   allocInfo.memoryTypeIndex = memoryTypeIndex;
-  VK_CHECK_RESULT(
-      vkAllocateMemory(device, &allocInfo, nullptr, &imageMemoryBind.memory));
+  VK_CHECK_RESULT(device->allocateMemory(
+      &allocInfo, &imageMemoryBind.memory, vks::MemoryTag::Textures));
 
   VkImageSubresource subResource{};
   subResource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -56,10 +56,10 @@ bool VirtualTexturePage::allocate(VkDevice device, uint32_t memoryTypeIndex) {
 }
 
 // Release Vulkan memory allocated for this page
-bool VirtualTexturePage::release(VkDevice device) {
+bool VirtualTexturePage::release(vks::VulkanDevice* device) {
   del = false;
   if (imageMemoryBind.memory != VK_NULL_HANDLE) {
-    vkFreeMemory(device, imageMemoryBind.memory, nullptr);
+    device->freeMemory(imageMemoryBind.memory);
     imageMemoryBind.memory = VK_NULL_HANDLE;
     return true;
   }
@@ -137,11 +137,11 @@ void VirtualTexture::destroy() {
     page.release(device);
   }
   for (auto bind : opaqueMemoryBinds) {
-    vkFreeMemory(device, bind.memory, nullptr);
+    device->freeMemory(bind.memory);
   }
   // Clean up mip tail
   if (mipTailimageMemoryBind.memory != VK_NULL_HANDLE) {
-    vkFreeMemory(device, mipTailimageMemoryBind.memory, nullptr);
+    device->freeMemory(mipTailimageMemoryBind.memory);
   }
 }
 
@@ -196,7 +196,7 @@ void VulkanExample::prepareSparseTexture(uint32_t width,
                                          uint32_t height,
                                          uint32_t layerCount,
                                          VkFormat format) {
-  texture_.device = vulkanDevice_->logicalDevice;
+  texture_.device = vulkanDevice_;
   texture_.width = width;
   texture_.height = height;
   texture_.mipLevels =
@@ -438,8 +438,8 @@ void VulkanExample::prepareSparseTexture(uint32_t width,
       allocInfo.memoryTypeIndex = texture_.memoryTypeIndex;
 
       VkDeviceMemory deviceMemory;
-      VK_CHECK_RESULT(
-          vkAllocateMemory(device_, &allocInfo, nullptr, &deviceMemory));
+      VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+          &allocInfo, &deviceMemory, vks::MemoryTag::Textures));
 
       // (Opaque) sparse memory binding
       VkSparseMemoryBind sparseMemoryBind{};
@@ -468,8 +468,8 @@ void VulkanExample::prepareSparseTexture(uint32_t width,
     allocInfo.memoryTypeIndex = texture_.memoryTypeIndex;
 
     VkDeviceMemory deviceMemory;
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &allocInfo, nullptr, &deviceMemory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &allocInfo, &deviceMemory, vks::MemoryTag::Textures));
 
     // (Opaque) sparse memory binding
     VkSparseMemoryBind sparseMemoryBind{};
@@ -545,6 +545,7 @@ void VulkanExample::destroyTextureImage(SparseTexture texture) {
 }
 
 void VulkanExample::loadAssets() {
+  ScopedStartupPhase startupPhase(this, "loadAssets");
   const uint32_t glTFLoadingFlags =
       vkglTF::FileLoadingFlags::PreTransformVertices |
       vkglTF::FileLoadingFlags::PreMultiplyVertexColors |
@@ -557,12 +558,12 @@ void VulkanExample::setupDescriptors() {
   // Pool
   std::vector<VkDescriptorPoolSize> poolSizes = {
       vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                            MAX_CONCURRENT_FRAMES),
+                                            framesInFlight_),
       vks::initializers::descriptorPoolSize(
-          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES)};
+          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_)};
   VkDescriptorPoolCreateInfo descriptorPoolInfo =
       vks::initializers::descriptorPoolCreateInfo(poolSizes,
-                                                  MAX_CONCURRENT_FRAMES);
+                                                  framesInFlight_);
   VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr,
                                          &descriptorPool_));
 
@@ -604,6 +605,7 @@ void VulkanExample::setupDescriptors() {
 }
 
 void VulkanExample::preparePipelines() {
+  ScopedStartupPhase startupPhase(this, "preparePipelines");
   // Layout
   VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
       vks::initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
@@ -675,6 +677,7 @@ void VulkanExample::prepareUniformBuffers() {
 }
 
 void VulkanExample::updateUniformBuffers() {
+  vks::ProfilerZone profilerZone("updateUniformBuffers");
   uniformData_.projection = camera_.matrices_.perspective;
   uniformData_.model = camera_.matrices_.view;
   uniformData_.viewPos = camera_.viewPos_;
@@ -701,6 +704,7 @@ void VulkanExample::prepare() {
 }
 
 void VulkanExample::buildCommandBuffer() {
+  vks::ProfilerZone profilerZone("buildCommandBuffer");
   VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 
   VkCommandBufferBeginInfo cmdBufInfo =
@@ -759,8 +763,7 @@ void VulkanExample::render() {
 void VulkanExample::randomPattern(uint8_t* buffer,
                                   uint32_t width,
                                   uint32_t height) {
-  std::random_device rd;
-  std::mt19937 rndEngine(rd());
+  std::mt19937 rndEngine(randomSeed());
   std::uniform_int_distribution<uint32_t> rndDist(0, 255);
   uint8_t rndVal[4] = {0, 0, 0, 0};
   while (rndVal[0] + rndVal[1] + rndVal[2] < 10) {
@@ -819,8 +822,7 @@ void VulkanExample::uploadContent(VirtualTexturePage page, VkImage image) {
 void VulkanExample::fillRandomPages() {
   vkDeviceWaitIdle(device_);
 
-  std::default_random_engine rndEngine(
-      benchmark.active ? 0 : std::random_device{}());
+  std::default_random_engine rndEngine(randomSeed());
   std::uniform_real_distribution<float> rndDist(0.0f, 1.0f);
 
   std::vector<VirtualTexturePage> updatedPages;
@@ -829,7 +831,7 @@ void VulkanExample::fillRandomPages() {
     if (rndDist(rndEngine) < 0.5f) {
       continue;
     }
-    if (page.allocate(device_, texture_.memoryTypeIndex)) {
+    if (page.allocate(vulkanDevice_, texture_.memoryTypeIndex)) {
       bindingChangedPages.push_back(page);
     }
     updatedPages.push_back(page);
@@ -853,7 +855,7 @@ void VulkanExample::fillRandomPages() {
 void VulkanExample::fillMipTail() {
   // Clean up previous mip tail memory allocation
   if (texture_.mipTailimageMemoryBind.memory != VK_NULL_HANDLE) {
-    vkFreeMemory(device_, texture_.mipTailimageMemoryBind.memory, nullptr);
+    vulkanDevice_->freeMemory(texture_.mipTailimageMemoryBind.memory);
   }
 
   //@todo: WIP
@@ -869,8 +871,9 @@ void VulkanExample::fillMipTail() {
   VkMemoryAllocateInfo allocInfo = vks::initializers::memoryAllocateInfo();
   allocInfo.allocationSize = imageMipTailSize;
   allocInfo.memoryTypeIndex = texture_.memoryTypeIndex;
-  VK_CHECK_RESULT(vkAllocateMemory(device_, &allocInfo, nullptr,
-                                   &texture_.mipTailimageMemoryBind.memory));
+  VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+      &allocInfo, &texture_.mipTailimageMemoryBind.memory,
+      vks::MemoryTag::Textures));
 
   uint32_t mipLevel =
       texture_.sparseImageMemoryRequirements.imageMipTailFirstLod;
@@ -900,8 +903,7 @@ void VulkanExample::fillMipTail() {
     imageBuffer.map();
 
     // Fill buffer with random colors
-    std::random_device rd;
-    std::mt19937 rndEngine(rd());
+    std::mt19937 rndEngine(randomSeed());
     std::uniform_int_distribution<uint32_t> rndDist(0, 255);
     uint8_t* data = (uint8_t*)imageBuffer.mapped;
     randomPattern(data, width, height);
@@ -933,8 +935,7 @@ void VulkanExample::fillMipTail() {
 void VulkanExample::flushRandomPages() {
   vkDeviceWaitIdle(device_);
 
-  std::default_random_engine rndEngine(
-      benchmark.active ? 0 : std::random_device{}());
+  std::default_random_engine rndEngine(randomSeed());
   std::uniform_real_distribution<float> rndDist(0.0f, 1.0f);
 
   std::vector<VirtualTexturePage> updatedPages;
@@ -960,7 +961,7 @@ void VulkanExample::flushRandomPages() {
   vkDestroyFence(device_, fence, nullptr);
   for (auto& page : texture_.pages) {
     if (page.del) {
-      page.release(device_);
+      page.release(vulkanDevice_);
     }
   }
 }
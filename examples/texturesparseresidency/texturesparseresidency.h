@@ -28,14 +28,14 @@ struct VirtualTexturePage
 
 	VirtualTexturePage();
 	bool resident();
-	bool allocate(VkDevice device, uint32_t memoryTypeIndex);
-	bool release(VkDevice device);
+	bool allocate(vks::VulkanDevice* device, uint32_t memoryTypeIndex);
+	bool release(vks::VulkanDevice* device);
 };
 
 // Virtual texture object containing all pages
 struct VirtualTexture
 {
-	VkDevice device;
+	vks::VulkanDevice* device;
 	VkImage image;														// Texture image handle
 	VkBindSparseInfo bindSparseInfo;									// Sparse queue binding information
 	std::vector<VirtualTexturePage> pages;								// Contains all virtual pages of the texture
@@ -85,12 +85,12 @@ public:
 		glm::vec4 viewPos;
 		float lodBias = 0.0f;
 	} uniformData_;
-	std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<vks::Buffer> uniformBuffers_ = std::vector<vks::Buffer>(framesInFlight_);
 
 	VkPipeline pipeline{ VK_NULL_HANDLE };
 	VkPipelineLayout pipelineLayout{ VK_NULL_HANDLE };
 	VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
-	std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets_{};
+	std::vector<VkDescriptorSet> descriptorSets_ = std::vector<VkDescriptorSet>(framesInFlight_);
 
 	//todo: comment
 	VkSemaphore bindSparseSemaphore{ VK_NULL_HANDLE };
@@ -37,7 +37,7 @@ public:
 	struct Graphics {
 		uint32_t queueFamilyIndex;
 		VkDescriptorSetLayout descriptorSetLayout;
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets;
+		std::vector<VkDescriptorSet> descriptorSets;
 		VkPipelineLayout pipelineLayout;
 		VkPipeline pipeline;
 		struct UniformData {
@@ -45,7 +45,7 @@ public:
 			glm::mat4 view;
 			glm::vec2 screenDim;
 		} uniformData;
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
+		std::vector<vks::Buffer> uniformBuffers;
 	} graphics{};
 
 	// Resources for the compute part of the example
@@ -53,9 +53,9 @@ public:
 		uint32_t queueFamilyIndex;
 		VkQueue queue;
 		VkCommandPool commandPool;
-		std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers;
+		std::vector<VkCommandBuffer> commandBuffers;
 		VkDescriptorSetLayout descriptorSetLayout;
-		std::array<VkDescriptorSet, MAX_CONCURRENT_FRAMES> descriptorSets;
+		std::vector<VkDescriptorSet> descriptorSets;
 		VkPipelineLayout pipelineLayout;
 		VkPipeline pipelineCalculate;
 		VkPipeline pipelineIntegrate;
@@ -66,7 +66,7 @@ public:
 			float power{ 0.75f };
 			float soften{ 0.05f };
 		} uniformData;
-		std::array<vks::Buffer, MAX_CONCURRENT_FRAMES> uniformBuffers;
+		std::vector<vks::Buffer> uniformBuffers;
 	} compute{};
 
 	// Along with the actual semaphore we also need to track the increasing value of the timeline, 
@@ -129,6 +129,7 @@ public:
 
 	void loadAssets()
 	{
+		ScopedStartupPhase startupPhase(this, "loadAssets");
 		textures_.particle.loadFromFile(getAssetPath() + "textures/particle01_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
 		textures_.gradient.loadFromFile(getAssetPath() + "textures/particle_gradient_rgba.ktx", VK_FORMAT_R8G8B8A8_UNORM, vulkanDevice_, queue_);
 	}
@@ -151,7 +152,7 @@ public:
 		// Initial particle positions
 		std::vector<Particle> particleBuffer(numParticles);
 
-		std::default_random_engine rndEngine(benchmark.active ? 0 : (unsigned)time(nullptr));
+		std::default_random_engine rndEngine(randomSeed());
 		std::normal_distribution<float> rndDist(0.0f, 1.0f);
 
 		for (uint32_t i = 0; i < static_cast<uint32_t>(attractors.size()); i++) {
@@ -231,11 +232,11 @@ public:
 	{
 		// This is shared between graphics and compute
 		std::vector<VkDescriptorPoolSize> poolSizes = {
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES * 2),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_CONCURRENT_FRAMES),
-			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_CONCURRENT_FRAMES * 2)
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_ * 2),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight_),
+			vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight_ * 2)
 		};
-		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES * 2);
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_ * 2);
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 	}
 
@@ -252,6 +253,8 @@ public:
 		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device_, &descriptorLayout, nullptr, &graphics.descriptorSetLayout));
 
 		// Vertex shader uniform buffer block
+		graphics.uniformBuffers.resize(framesInFlight_);
+		graphics.descriptorSets.resize(framesInFlight_);
 		for (auto& buffer : graphics.uniformBuffers) {
 			vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, sizeof(Graphics::UniformData));
 			VK_CHECK_RESULT(buffer.map());
@@ -332,6 +335,9 @@ public:
 	void prepareCompute()
 	{
 		vkGetDeviceQueue(device_, compute.queueFamilyIndex, 0, &compute.queue);
+		compute.uniformBuffers.resize(framesInFlight_);
+		compute.descriptorSets.resize(framesInFlight_);
+		compute.commandBuffers.resize(framesInFlight_);
 		for (auto& buffer : compute.uniformBuffers) {
 			vulkanDevice_->createBuffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, sizeof(Compute::UniformData));
 			VK_CHECK_RESULT(buffer.map());
@@ -376,7 +382,7 @@ public:
 
 	void updateComputeUniformBuffers()
 	{
-		compute.uniformData.deltaT = paused ? 0.0f : frameTimer * 0.05f;
+		compute.uniformData.deltaT = paused ? 0.0f : animationStep_ * 0.05f;
 		memcpy(compute.uniformBuffers[currentBuffer_].mapped, &compute.uniformData, sizeof(Compute::UniformData));
 	}
 
@@ -628,6 +634,7 @@ public:
 		semaphoreWaitInfo.pSemaphores = &timeLineSemaphore.handle;
 		semaphoreWaitInfo.pValues = &timeLineSemaphore.value;
 		vkWaitSemaphoresKHR(device_, &semaphoreWaitInfo, UINT64_MAX);
+		VulkanExampleBase::frameSlotAvailable();
 
 		updateComputeUniformBuffers();
 		buildComputeCommandBuffer();
@@ -30,11 +30,10 @@
 #include "vulkanexamplebase.h"
 
 // We want to keep GPU and CPU busy. To do that we may start building a new
-// command buffer while the previous one is still being executed This number
-// defines how many frames may be worked on simultaneously at once Increasing
-// this number may improve performance but will also introduce additional
-// latency
-// constexpr auto MAX_CONCURRENT_FRAMES = 2;
+// command buffer while the previous one is still being executed. The number of
+// frames that may be worked on simultaneously is selected at startup
+// (framesInFlight_, see --framesinflight). Increasing this number may improve
+// performance but will also introduce additional latency
 
 class VulkanExample : public VulkanExampleBase {
  public:
@@ -73,7 +72,8 @@ class VulkanExample : public VulkanExampleBase {
   };
   // We use one UBO per frame, so we can have a frame overlap and make sure that
   // uniforms aren't updated while still in use
-  std::array<UniformBuffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+  std::vector<UniformBuffer> uniformBuffers_ =
+      std::vector<UniformBuffer>(framesInFlight_);
 
   // For simplicity we use the same uniform block layout as in the shader:
   //
@@ -124,8 +124,9 @@ class VulkanExample : public VulkanExampleBase {
   std::vector<VkSemaphore> renderCompleteSemaphores{};
 
   VkCommandPool commandPool{VK_NULL_HANDLE};
-  std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers{};
-  std::array<VkFence, MAX_CONCURRENT_FRAMES> waitFences{};
+  std::vector<VkCommandBuffer> commandBuffers =
+      std::vector<VkCommandBuffer>(framesInFlight_);
+  std::vector<VkFence> waitFences = std::vector<VkFence>(framesInFlight_);
 
   // To select the correct sync and command objects, we need to keep track of
   // the current frame
@@ -151,9 +152,9 @@ class VulkanExample : public VulkanExampleBase {
       vkDestroyPipelineLayout(device_, pipelineLayout, nullptr);
       vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
       vkDestroyBuffer(device_, vertices.buffer, nullptr);
-      vkFreeMemory(device_, vertices.memory, nullptr);
+      vulkanDevice_->freeMemory(vertices.memory);
       vkDestroyBuffer(device_, indices.buffer, nullptr);
-      vkFreeMemory(device_, indices.memory, nullptr);
+      vulkanDevice_->freeMemory(indices.memory);
       vkDestroyCommandPool(device_, commandPool, nullptr);
       for (size_t i = 0; i < presentCompleteSemaphores.size(); i++) {
         vkDestroySemaphore(device_, presentCompleteSemaphores[i], nullptr);
@@ -161,10 +162,10 @@ class VulkanExample : public VulkanExampleBase {
       for (size_t i = 0; i < renderCompleteSemaphores.size(); i++) {
         vkDestroySemaphore(device_, renderCompleteSemaphores[i], nullptr);
       }
-      for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+      for (uint32_t i = 0; i < framesInFlight_; i++) {
         vkDestroyFence(device_, waitFences[i], nullptr);
         vkDestroyBuffer(device_, uniformBuffers_[i].buffer, nullptr);
-        vkFreeMemory(device_, uniformBuffers_[i].memory, nullptr);
+        vulkanDevice_->freeMemory(uniformBuffers_[i].memory);
       }
     }
   }
@@ -196,7 +197,7 @@ class VulkanExample : public VulkanExampleBase {
   // this example
   void createSynchronizationPrimitives() {
     // Fences are used to check draw command buffer completion on the host
-    for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VkFenceCreateInfo fenceCI{};
       fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
       // Create the fences in signaled state (so we don't wait on first render
@@ -210,7 +211,7 @@ class VulkanExample : public VulkanExampleBase {
     // Semaphores are used for correct command ordering within a queue
     // Used to ensure that image presentation is complete before starting to
     // submit again
-    presentCompleteSemaphores.resize(MAX_CONCURRENT_FRAMES);
+    presentCompleteSemaphores.resize(framesInFlight_);
     for (auto& semaphore : presentCompleteSemaphores) {
       VkSemaphoreCreateInfo semaphoreCI{
           VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
@@ -242,7 +243,7 @@ class VulkanExample : public VulkanExampleBase {
     VkCommandBufferAllocateInfo cmdBufAllocateInfo =
         vks::initializers::commandBufferAllocateInfo(
             commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-            MAX_CONCURRENT_FRAMES);
+            framesInFlight_);
     VK_CHECK_RESULT(vkAllocateCommandBuffers(device_, &cmdBufAllocateInfo,
                                              commandBuffers.data()));
   }
@@ -319,8 +320,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.memoryTypeIndex = getMemoryTypeIndex(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr,
-                                     &stagingBuffers.vertices.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &stagingBuffers.vertices.memory, vks::MemoryTag::Staging));
     // Map and copy
     VK_CHECK_RESULT(vkMapMemory(device_, stagingBuffers.vertices.memory, 0,
                                 memAlloc.allocationSize, 0, &data));
@@ -339,8 +340,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = getMemoryTypeIndex(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &vertices.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &vertices.memory, vks::MemoryTag::Geometry));
     VK_CHECK_RESULT(
         vkBindBufferMemory(device_, vertices.buffer, vertices.memory, 0));
 
@@ -358,8 +359,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.memoryTypeIndex = getMemoryTypeIndex(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr,
-                                     &stagingBuffers.indices.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &stagingBuffers.indices.memory, vks::MemoryTag::Staging));
     VK_CHECK_RESULT(vkMapMemory(device_, stagingBuffers.indices.memory, 0,
                                 indexBufferSize, 0, &data));
     memcpy(data, indexBuffer.data(), indexBufferSize);
@@ -376,8 +377,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = getMemoryTypeIndex(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &indices.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &indices.memory, vks::MemoryTag::Geometry));
     VK_CHECK_RESULT(
         vkBindBufferMemory(device_, indices.buffer, indices.memory, 0));
 
@@ -435,9 +436,9 @@ class VulkanExample : public VulkanExampleBase {
     // Note: Staging buffer must not be deleted before the copies have been
     // submitted and executed
     vkDestroyBuffer(device_, stagingBuffers.vertices.buffer, nullptr);
-    vkFreeMemory(device_, stagingBuffers.vertices.memory, nullptr);
+    vulkanDevice_->freeMemory(stagingBuffers.vertices.memory);
     vkDestroyBuffer(device_, stagingBuffers.indices.buffer, nullptr);
-    vkFreeMemory(device_, stagingBuffers.indices.memory, nullptr);
+    vulkanDevice_->freeMemory(stagingBuffers.indices.memory);
   }
 
   // Descriptors are allocated from a pool, that tells the implementation how
@@ -448,7 +449,7 @@ class VulkanExample : public VulkanExampleBase {
     // This example only one descriptor type (uniform buffer)
     descriptorTypeCounts[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     // We have one buffer (and as such descriptor) per frame
-    descriptorTypeCounts[0].descriptorCount = MAX_CONCURRENT_FRAMES;
+    descriptorTypeCounts[0].descriptorCount = framesInFlight_;
     // For additional types you need to add new entries in the type count list
     // E.g. for two combined image samplers :
     // typeCounts[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -464,7 +465,7 @@ class VulkanExample : public VulkanExampleBase {
     // Set the max. number of descriptor sets that can be requested from this
     // pool (requesting beyond this limit will result in an error) Our sample
     // will create one set per uniform buffer per frame
-    descriptorPoolCI.maxSets = MAX_CONCURRENT_FRAMES;
+    descriptorPoolCI.maxSets = framesInFlight_;
     VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCI, nullptr,
                                            &descriptorPool_));
   }
@@ -496,7 +497,7 @@ class VulkanExample : public VulkanExampleBase {
   // above
   void createDescriptorSets() {
     // Allocate one descriptor set per frame from the global descriptor pool
-    for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VkDescriptorSetAllocateInfo allocInfo{};
       allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
       allocInfo.descriptorPool = descriptorPool_;
@@ -554,8 +555,8 @@ class VulkanExample : public VulkanExampleBase {
     memAlloc.allocationSize = memReqs.size;
     memAlloc.memoryTypeIndex = getMemoryTypeIndex(
         memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK_RESULT(
-        vkAllocateMemory(device_, &memAlloc, nullptr, &depthStencil_.memory));
+    VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+        &memAlloc, &depthStencil_.memory, vks::MemoryTag::Attachments));
     VK_CHECK_RESULT(vkBindImageMemory(device_, depthStencil_.image,
                                       depthStencil_.memory, 0));
 
@@ -1044,7 +1045,7 @@ class VulkanExample : public VulkanExampleBase {
     bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
 
     // Create the buffers
-    for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+    for (uint32_t i = 0; i < framesInFlight_; i++) {
       VK_CHECK_RESULT(vkCreateBuffer(device_, &bufferInfo, nullptr,
                                      &uniformBuffers_[i].buffer));
       // Get memory requirements including size, alignment and memory type
@@ -1061,8 +1062,8 @@ class VulkanExample : public VulkanExampleBase {
           memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
                                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
       // Allocate memory for the uniform buffer
-      VK_CHECK_RESULT(vkAllocateMemory(device_, &allocInfo, nullptr,
-                                       &(uniformBuffers_[i].memory)));
+      VK_CHECK_RESULT(vulkanDevice_->allocateMemory(
+          &allocInfo, &(uniformBuffers_[i].memory), vks::MemoryTag::Uniforms));
       // Bind memory to buffer
       VK_CHECK_RESULT(vkBindBufferMemory(device_, uniformBuffers_[i].buffer,
                                          uniformBuffers_[i].memory, 0));
@@ -1101,9 +1102,15 @@ class VulkanExample : public VulkanExampleBase {
     // so we must use the acquire function and can't just cycle through the
     // images/imageIndex on our own
     uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(
-        device_, swapChain_.swapChain_, UINT64_MAX,
-        presentCompleteSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+    // In offscreen mode there is no swap chain, and the wrapper hands out its
+    // own images instead
+    VkResult result =
+        swapChain_.offscreen_
+            ? swapChain_.acquireNextImage(
+                  presentCompleteSemaphores[currentFrame], imageIndex)
+            : vkAcquireNextImageKHR(device_, swapChain_.swapChain_, UINT64_MAX,
+                                    presentCompleteSemaphores[currentFrame],
+                                    VK_NULL_HANDLE, &imageIndex);
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
       windowResize();
       return;
@@ -1241,7 +1248,12 @@ class VulkanExample : public VulkanExampleBase {
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = &swapChain_.swapChain_;
     presentInfo.pImageIndices = &imageIndex;
-    result = vkQueuePresentKHR(queue_, &presentInfo);
+    if (swapChain_.offscreen_) {
+      result = swapChain_.presentOffscreen(imageIndex,
+                                           renderCompleteSemaphores[imageIndex]);
+    } else {
+      result = vkQueuePresentKHR(queue_, &presentInfo);
+    }
 
     if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) {
       windowResize();
@@ -1251,7 +1263,7 @@ class VulkanExample : public VulkanExampleBase {
 
     // Select the next frame to render to, based on the max. no. of concurrent
     // frames
-    currentFrame = (currentFrame + 1) % MAX_CONCURRENT_FRAMES;
+    currentFrame = (currentFrame + 1) % framesInFlight_;
   }
 };
 
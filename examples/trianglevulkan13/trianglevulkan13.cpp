@@ -27,9 +27,8 @@
 #include "vulkanexamplebase.h"
 
 // We want to keep GPU and CPU busy. To do that we may start building a new command buffer while the previous one is still being executed
-// This number defines how many frames may be worked on simultaneously at once
+// The number of frames that may be worked on simultaneously is selected at startup (framesInFlight_, see --framesinflight)
 // Increasing this number may improve performance but will also introduce additional latency
-constexpr auto MAX_CONCURRENT_FRAMES = 2;
 
 class VulkanExample : public VulkanExampleBase
 {
@@ -58,7 +57,7 @@ public:
 		uint8_t* mapped{ nullptr };
 	};
 	// We use one UBO per frame, so we can have a frame overlap and make sure that uniforms aren't updated while still in use
-	std::array<UniformBuffer, MAX_CONCURRENT_FRAMES> uniformBuffers_;
+	std::vector<UniformBuffer> uniformBuffers_ = std::vector<UniformBuffer>(framesInFlight_);
 
 	// For simplicity we use the same uniform block layout as in the shader
 	// This way we can just memcpy the data to the ubo
@@ -90,10 +89,10 @@ public:
 	std::vector<VkSemaphore> presentCompleteSemaphores{};
 	std::vector<VkSemaphore> renderCompleteSemaphores{};
 	// Fences are used to make sure command buffers aren't rerecorded until they've finished executing
-	std::array<VkFence, MAX_CONCURRENT_FRAMES> waitFences{};
+	std::vector<VkFence> waitFences = std::vector<VkFence>(framesInFlight_);
 
 	VkCommandPool commandPool{ VK_NULL_HANDLE };
-	std::array<VkCommandBuffer, MAX_CONCURRENT_FRAMES> commandBuffers{};
+	std::vector<VkCommandBuffer> commandBuffers = std::vector<VkCommandBuffer>(framesInFlight_);
 
 	// To select the correct sync and command objects, we need to keep track of the current frame
 	uint32_t currentFrame{ 0 };
@@ -126,9 +125,9 @@ public:
 			vkDestroyPipelineLayout(device_, pipelineLayout, nullptr);
 			vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
 			vkDestroyBuffer(device_, vertexBuffer.handle, nullptr);
-			vkFreeMemory(device_, vertexBuffer.memory, nullptr);
+			vulkanDevice_->freeMemory(vertexBuffer.memory);
 			vkDestroyBuffer(device_, indexBuffer.handle, nullptr);
-			vkFreeMemory(device_, indexBuffer.memory, nullptr);
+			vulkanDevice_->freeMemory(indexBuffer.memory);
 			vkDestroyCommandPool(device_, commandPool, nullptr);
 			for (size_t i = 0; i < presentCompleteSemaphores.size(); i++) {
 				vkDestroySemaphore(device_, presentCompleteSemaphores[i], nullptr);
@@ -136,10 +135,10 @@ public:
 			for (size_t i = 0; i < renderCompleteSemaphores.size(); i++) {
 				vkDestroySemaphore(device_, renderCompleteSemaphores[i], nullptr);
 			}
-			for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+			for (uint32_t i = 0; i < framesInFlight_; i++) {
 				vkDestroyFence(device_, waitFences[i], nullptr);
 				vkDestroyBuffer(device_, uniformBuffers_[i].handle, nullptr);
-				vkFreeMemory(device_, uniformBuffers_[i].memory, nullptr);
+				vulkanDevice_->freeMemory(uniformBuffers_[i].memory);
 			}
 		}
 	}
@@ -174,7 +173,7 @@ public:
 	void createSynchronizationPrimitives()
 	{
 		// Fences are per frame in flight
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {		
+		for (uint32_t i = 0; i < framesInFlight_; i++) {		
 			// Fence used to ensure that command buffer has completed exection before using it again
 			VkFenceCreateInfo fenceCI{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
 			// Create the fences in signaled state (so we don't wait on first render of each command buffer)
@@ -183,7 +182,7 @@ public:
 		}
 		// Semaphores are used for correct command ordering within a queue
 		// Used to ensure that image presentation is complete before starting to submit again
-		presentCompleteSemaphores.resize(MAX_CONCURRENT_FRAMES);
+		presentCompleteSemaphores.resize(framesInFlight_);
 		for (auto& semaphore : presentCompleteSemaphores) {
 			VkSemaphoreCreateInfo semaphoreCI{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
 			VK_CHECK_RESULT(vkCreateSemaphore(device_, &semaphoreCI, nullptr, &semaphore));
@@ -206,7 +205,7 @@ public:
 		commandPoolCI.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 		VK_CHECK_RESULT(vkCreateCommandPool(device_, &commandPoolCI, nullptr, &commandPool));
 		// Allocate one command buffer per max. concurrent frame from above pool
-		VkCommandBufferAllocateInfo cmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, MAX_CONCURRENT_FRAMES);
+		VkCommandBufferAllocateInfo cmdBufAllocateInfo = vks::initializers::commandBufferAllocateInfo(commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, framesInFlight_);
 		VK_CHECK_RESULT(vkAllocateCommandBuffers(device_, &cmdBufAllocateInfo, commandBuffers.data()));
 	}
 
@@ -261,7 +260,7 @@ public:
 		// Request a host visible memory type that can be used to copy our data to
 		// Also request it to be coherent, so that writes are visible to the GPU right after unmapping the buffer
 		memAlloc.memoryTypeIndex = getMemoryTypeIndex(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &stagingBuffer.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &stagingBuffer.memory, vks::MemoryTag::Staging));
 		VK_CHECK_RESULT(vkBindBufferMemory(device_, stagingBuffer.handle, stagingBuffer.memory, 0));
 		// Map the buffer and copy vertices and indices into it, this way we can use a single buffer as the source for both vertex and index GPU buffers
 		uint8_t* data{ nullptr };
@@ -277,7 +276,7 @@ public:
 		vkGetBufferMemoryRequirements(device_, vertexBuffer.handle, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = getMemoryTypeIndex(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &vertexBuffer.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &vertexBuffer.memory, vks::MemoryTag::Geometry));
 		VK_CHECK_RESULT(vkBindBufferMemory(device_, vertexBuffer.handle, vertexBuffer.memory, 0));
 
 		// Create a device local buffer to which the (host local) index data will be copied and which will be used for rendering
@@ -288,7 +287,7 @@ public:
 		vkGetBufferMemoryRequirements(device_, indexBuffer.handle, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = getMemoryTypeIndex(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &indexBuffer.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &indexBuffer.memory, vks::MemoryTag::Geometry));
 		VK_CHECK_RESULT(vkBindBufferMemory(device_, indexBuffer.handle, indexBuffer.memory, 0));
 
 		// Buffer copies have to be submitted to a queue, so we need a command buffer for them
@@ -330,7 +329,7 @@ public:
 
 		// The fence made sure copies are finished, so we can safely delete the staging buffer
 		vkDestroyBuffer(device_, stagingBuffer.handle, nullptr);
-		vkFreeMemory(device_, stagingBuffer.memory, nullptr);
+		vulkanDevice_->freeMemory(stagingBuffer.memory);
 	}
 
 	// Decriptors are used to pass data to shaders, for our sample we use a descriptor to pass parameters like matrices to the shader
@@ -341,7 +340,7 @@ public:
 		// This example only one descriptor type (uniform buffer)
 		descriptorTypeCounts[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 		// We have one buffer (and as such descriptor) per frame
-		descriptorTypeCounts[0].descriptorCount = MAX_CONCURRENT_FRAMES;
+		descriptorTypeCounts[0].descriptorCount = framesInFlight_;
 		// For additional types you need to add new entries in the type count list
 		// E.g. for two combined image samplers :
 		// typeCounts[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -354,7 +353,7 @@ public:
 		descriptorPoolCI.pPoolSizes = descriptorTypeCounts;
 		// Set the max. number of descriptor sets that can be requested from this pool (requesting beyond this limit will result in an error)
 		// Our sample will create one set per uniform buffer per frame
-		descriptorPoolCI.maxSets = MAX_CONCURRENT_FRAMES;
+		descriptorPoolCI.maxSets = framesInFlight_;
 		VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolCI, nullptr, &descriptorPool_));
 
 		// Descriptor set layouts define the interface between our application and the shader
@@ -373,7 +372,7 @@ public:
 
 		// Where the descriptor set layout is the interface, the descriptor set points to actual data
 		// Descriptors that are changed per frame need to be multiplied, so we can update descriptor n+1 while n is still used by the GPU, so we create one per max frame in flight
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			VkDescriptorSetAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
 			allocInfo.descriptorPool = descriptorPool_;
 			allocInfo.descriptorSetCount = 1;
@@ -423,7 +422,7 @@ public:
 		vkGetImageMemoryRequirements(device_, depthStencil_.image, &memReqs);
 		memAlloc.allocationSize = memReqs.size;
 		memAlloc.memoryTypeIndex = getMemoryTypeIndex(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-		VK_CHECK_RESULT(vkAllocateMemory(device_, &memAlloc, nullptr, &depthStencil_.memory));
+		VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAlloc, &depthStencil_.memory, vks::MemoryTag::Attachments));
 		VK_CHECK_RESULT(vkBindImageMemory(device_, depthStencil_.image, depthStencil_.memory, 0));
 
 		// Create a view for the depth stencil image
@@ -660,7 +659,7 @@ public:
 		bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
 
 		// Create the buffers
-		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++) {
+		for (uint32_t i = 0; i < framesInFlight_; i++) {
 			VK_CHECK_RESULT(vkCreateBuffer(device_, &bufferInfo, nullptr, &uniformBuffers_[i].handle));
 			// Get memory requirements including size, alignment and memory type based on the buffer type we request (uniform buffer)
 			VkMemoryRequirements memReqs;
@@ -673,7 +672,7 @@ public:
 			// We also want the buffer to be host coherent so we don't have to flush (or sync after every update).
 			allocInfo.memoryTypeIndex = getMemoryTypeIndex(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 			// Allocate memory for the uniform buffer
-			VK_CHECK_RESULT(vkAllocateMemory(device_, &allocInfo, nullptr, &(uniformBuffers_[i].memory)));
+			VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&allocInfo, &(uniformBuffers_[i].memory), vks::MemoryTag::Uniforms));
 			// Bind memory to buffer
 			VK_CHECK_RESULT(vkBindBufferMemory(device_, uniformBuffers_[i].handle, uniformBuffers_[i].memory, 0));
 			// We map the buffer once, so we can update it without having to map it again
@@ -703,7 +702,10 @@ public:
 		// Get the next swap chain image from the implementation
 		// Note that the implementation is free to return the images in any order, so we must use the acquire function and can't just cycle through the images/imageIndex on our own
 		uint32_t imageIndex{ 0 };
-		VkResult result = vkAcquireNextImageKHR(device_, swapChain_.swapChain_, UINT64_MAX, presentCompleteSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		// In offscreen mode there is no swap chain, and the wrapper hands out its own images instead
+		VkResult result = swapChain_.offscreen_ ?
+			swapChain_.acquireNextImage(presentCompleteSemaphores[currentFrame], imageIndex) :
+			vkAcquireNextImageKHR(device_, swapChain_.swapChain_, UINT64_MAX, presentCompleteSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
 		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
 			windowResize();
 			return;
@@ -808,7 +810,11 @@ public:
 		presentInfo.swapchainCount = 1;
 		presentInfo.pSwapchains = &swapChain_.swapChain_;
 		presentInfo.pImageIndices = &imageIndex;
-		result = vkQueuePresentKHR(queue_, &presentInfo);
+		if (swapChain_.offscreen_) {
+			result = swapChain_.presentOffscreen(imageIndex, renderCompleteSemaphores[imageIndex]);
+		} else {
+			result = vkQueuePresentKHR(queue_, &presentInfo);
+		}
 		if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) {
 			windowResize();
 		} else if (result != VK_SUCCESS) {
@@ -816,7 +822,7 @@ public:
 		}
 
 		// Select the next frame to render to, based on the max. no. of concurrent frames
-		currentFrame = (currentFrame + 1) % MAX_CONCURRENT_FRAMES;
+		currentFrame = (currentFrame + 1) % framesInFlight_;
 	}
 
 	// Override these as otherwise the base class would generate frame buffers and render passes
@@ -31,7 +31,7 @@ VulkanExample::~VulkanExample()
 	vkDestroyDescriptorSetLayout(device_, descriptorSetLayout, nullptr);
 	vkDestroyImageView(device_, shadingRateImage.view, nullptr);
 	vkDestroyImage(device_, shadingRateImage.image, nullptr);
-	vkFreeMemory(device_, shadingRateImage.memory, nullptr);
+	vulkanDevice_->freeMemory(shadingRateImage.memory);
 	for (auto& buffer : uniformBuffers_) {
 		buffer.destroy();
 	}
@@ -58,7 +58,7 @@ void VulkanExample::handleResize()
 	// Invalidate the shading rate image, will be recreated in the renderpass setup
 	vkDestroyImageView(device_, shadingRateImage.view, nullptr);
 	vkDestroyImage(device_, shadingRateImage.image, nullptr);
-	vkFreeMemory(device_, shadingRateImage.memory, nullptr);
+	vulkanDevice_->freeMemory(shadingRateImage.memory);
 	prepareShadingRateImage();
 	// Recreate the render pass and update it with the new fragment shading rate image resolution
 	vkDestroyRenderPass(device_, renderPass_, nullptr);
@@ -216,6 +216,7 @@ void VulkanExample::setupRenderPass()
 
 void VulkanExample::loadAssets()
 {
+	ScopedStartupPhase startupPhase(this, "loadAssets");
 	vkglTF::descriptorBindingFlags = vkglTF::DescriptorBindingFlags::ImageBaseColor | vkglTF::DescriptorBindingFlags::ImageNormalMap;
 	scene.loadFromFile(getAssetPath() + "models/sponza/sponza.gltf", vulkanDevice_, queue_, vkglTF::FileLoadingFlags::PreTransformVertices);
 }
@@ -224,9 +225,9 @@ void VulkanExample::setupDescriptors()
 {
 	// Pool
 	const std::vector<VkDescriptorPoolSize> poolSizes = {
-		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
+		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
 	};
-	VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, MAX_CONCURRENT_FRAMES);
+	VkDescriptorPoolCreateInfo descriptorPoolInfo = vks::initializers::descriptorPoolCreateInfo(poolSizes, framesInFlight_);
 	VK_CHECK_RESULT(vkCreateDescriptorPool(device_, &descriptorPoolInfo, nullptr, &descriptorPool_));
 
 	// Descriptor set layout
@@ -306,7 +307,7 @@ void VulkanExample::prepareShadingRateImage()
 	memAllloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
 	memAllloc.allocationSize = memReqs.size;
 	memAllloc.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllloc, nullptr, &shadingRateImage.memory));
+	VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllloc, &shadingRateImage.memory, vks::MemoryTag::Textures));
 	VK_CHECK_RESULT(vkBindImageMemory(device_, shadingRateImage.image, shadingRateImage.memory, 0));
 
 	VkImageViewCreateInfo imageViewCI{};
@@ -390,7 +391,7 @@ void VulkanExample::prepareShadingRateImage()
 	vkGetBufferMemoryRequirements(device_, stagingBuffer, &memReqs);
 	memAllocInfo.allocationSize = memReqs.size;
 	memAllocInfo.memoryTypeIndex = vulkanDevice_->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(device_, &memAllocInfo, nullptr, &stagingMemory));
+	VK_CHECK_RESULT(vulkanDevice_->allocateMemory(&memAllocInfo, &stagingMemory, vks::MemoryTag::Staging));
 	VK_CHECK_RESULT(vkBindBufferMemory(device_, stagingBuffer, stagingMemory, 0));
 
 	uint8_t* mapped;
@@ -437,12 +438,13 @@ void VulkanExample::prepareShadingRateImage()
 	}
 	vulkanDevice_->flushCommandBuffer(copyCmd, queue_, true);
 
-	vkFreeMemory(device_, stagingMemory, nullptr);
+	vulkanDevice_->freeMemory(stagingMemory);
 	vkDestroyBuffer(device_, stagingBuffer, nullptr);
 }
 
 void VulkanExample::preparePipelines()
 {
+	ScopedStartupPhase startupPhase(this, "preparePipelines");
 	VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCI = vks::initializers::pipelineInputAssemblyStateCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 0, VK_FALSE);
 	VkPipelineRasterizationStateCreateInfo rasterizationStateCI = vks::initializers::pipelineRasterizationStateCreateInfo(VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, VK_FRONT_FACE_COUNTER_CLOCKWISE, 0);
 	VkPipelineColorBlendAttachmentState blendAttachmentStateCI = vks::initializers::pipelineColorBlendAttachmentState(0xf, VK_FALSE);
@@ -499,6 +501,7 @@ void VulkanExample::prepareUniformBuffers()
 
 void VulkanExample::updateUniformBuffers()
 {
+	vks::ProfilerZone profilerZone("updateUniformBuffers");
 	uniformData_.projection = camera_.matrices_.perspective;
 	uniformData_.view = camera_.matrices_.view;
 	uniformData_.viewPos = camera_.viewPos_;
@@ -522,6 +525,7 @@ void VulkanExample::prepare()
 
 void VulkanExample::buildCommandBuffer()
 {
+	vks::ProfilerZone profilerZone("buildCommandBuffer");
 	VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 	
 	VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
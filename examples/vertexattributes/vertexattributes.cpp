@@ -169,10 +169,7 @@ VulkanExample::~VulkanExample()
 		separateVertexBuffers.uv.destroy();
 		interleavedVertexBuffer.destroy();
 		for (Image image : scene.images) {
-			vkDestroyImageView(vulkanDevice_->logicalDevice, image.texture.view, nullptr);
-			vkDestroyImage(vulkanDevice_->logicalDevice, image.texture.image, nullptr);
-			vkDestroySampler(vulkanDevice_->logicalDevice, image.texture.sampler, nullptr);
-			vkFreeMemory(vulkanDevice_->logicalDevice, image.texture.deviceMemory, nullptr);
+			image.texture.destroy();
 		}
 	}
 }
@@ -361,6 +358,7 @@ void VulkanExample::uploadVertexData()
 
 void VulkanExample::loadAssets()
 {
+	ScopedStartupPhase startupPhase(this, "loadAssets");
 	loadglTFFile(getAssetPath() + "models/sponza/sponza.gltf");
 }
 
@@ -369,7 +367,7 @@ void VulkanExample::setupDescriptors()
 	// One ubo to pass dynamic data to the shader
 	// Two combined image samplers per material as each material uses color and normal maps
 	std::vector<VkDescriptorPoolSize> poolSizes = {
-		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_CONCURRENT_FRAMES),
+		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight_),
 		vks::initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(scene.materials.size()) * 2),
 	};
 	// One set for matrices and one per model image/texture
@@ -429,6 +427,7 @@ void VulkanExample::setupDescriptors()
 
 void VulkanExample::preparePipelines()
 {
+	ScopedStartupPhase startupPhase(this, "preparePipelines");
 	VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCI = vks::initializers::pipelineInputAssemblyStateCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 0, VK_FALSE);
 	VkPipelineRasterizationStateCreateInfo rasterizationStateCI = vks::initializers::pipelineRasterizationStateCreateInfo(VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, VK_FRONT_FACE_COUNTER_CLOCKWISE, 0);
 	VkPipelineColorBlendAttachmentState blendAttachmentStateCI = vks::initializers::pipelineColorBlendAttachmentState(0xf, VK_FALSE);
@@ -500,6 +499,7 @@ void VulkanExample::prepareUniformBuffers()
 
 void VulkanExample::updateUniformBuffers()
 {
+	vks::ProfilerZone profilerZone("updateUniformBuffers");
 	uniformData_.projection = camera_.matrices_.perspective;
 	uniformData_.view = camera_.matrices_.view;
 	uniformData_.viewPos = camera_.viewPos_;
@@ -518,6 +518,7 @@ void VulkanExample::prepare()
 
 void VulkanExample::buildCommandBuffer()
 {
+	vks::ProfilerZone profilerZone("buildCommandBuffer");
 	VkCommandBuffer cmdBuffer = drawCmdBuffers_[currentBuffer_];
 	
 	VkCommandBufferBeginInfo cmdBufInfo = vks::initializers::commandBufferBeginInfo();
@@ -0,0 +1,111 @@
+# Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+# This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+
+# Packs the SPIR-V files of a shading language folder into a single archive that the examples memory map at runtime
+# Layout (little endian):
+#   header:  char[4] magic "VKSP", uint32 version, uint32 entry count, uint32 blob count, uint64 string table offset, uint64 string table size
+#   entries: uint32 path offset, uint32 path length, uint32 blob index, uint32 source file size, int64 source file modification time in seconds (sorted by path)
+#   blobs:   uint64 data offset, uint64 size, uint64 FNV-1a hash of the SPIR-V code
+#   string table with the paths relative to the language folder, followed by the SPIR-V code of all blobs (16 byte aligned)
+# Files with identical code (e.g. full screen vertex shaders shared by several examples) are stored once
+# The size and modification time of each source file let the examples detect .spv files that were changed after packing
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"VKSP"
+VERSION = 2
+HEADER_FORMAT = "<4sIIIQQ"
+ENTRY_FORMAT = "<IIIIq"
+BLOB_FORMAT = "<QQQ"
+BLOB_ALIGNMENT = 16
+
+def fnv1a64(data):
+    hash = 0xcbf29ce484222325
+    for byte in data:
+        hash ^= byte
+        hash = (hash * 0x100000001b3) & 0xffffffffffffffff
+    return hash
+
+def align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+def collect(language_dir, examples):
+    files = []
+    for root, dirs, names in os.walk(language_dir):
+        for name in names:
+            if not name.endswith(".spv"):
+                continue
+            path = os.path.relpath(os.path.join(root, name), language_dir).replace("\\", "/")
+            if examples and path.split("/")[0] not in examples:
+                continue
+            files.append(path)
+    return sorted(files)
+
+def pack(language_dir, output, examples):
+    paths = collect(language_dir, examples)
+    if not paths:
+        print("No SPIR-V files found in %s" % language_dir)
+        return False
+
+    blobs = []
+    blob_indices = {}
+    entries = []
+    string_table = bytearray()
+    for path in paths:
+        source = os.path.join(language_dir, path)
+        with open(source, "rb") as f:
+            code = f.read()
+        source_time = int(os.stat(source).st_mtime)
+        hash = fnv1a64(code)
+        key = (hash, code)
+        if key not in blob_indices:
+            blob_indices[key] = len(blobs)
+            blobs.append((hash, code))
+        encoded = path.encode("utf-8")
+        entries.append((len(string_table), len(encoded), blob_indices[key], len(code), source_time))
+        string_table += encoded
+
+    string_table_offset = struct.calcsize(HEADER_FORMAT) + len(entries) * struct.calcsize(ENTRY_FORMAT) + len(blobs) * struct.calcsize(BLOB_FORMAT)
+    data_offset = align(string_table_offset + len(string_table), BLOB_ALIGNMENT)
+
+    blob_table = bytearray()
+    blob_data = bytearray()
+    for hash, code in blobs:
+        offset = data_offset + len(blob_data)
+        blob_table += struct.pack(BLOB_FORMAT, offset, len(code), hash)
+        blob_data += code
+        blob_data += bytes(align(len(blob_data), BLOB_ALIGNMENT) - len(blob_data))
+
+    archive = bytearray(struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(entries), len(blobs), string_table_offset, len(string_table)))
+    for entry in entries:
+        archive += struct.pack(ENTRY_FORMAT, *entry)
+    archive += blob_table
+    archive += string_table
+    archive += bytes(data_offset - len(archive))
+    archive += blob_data
+
+    # Write to a temporary file first, so examples never map a partially written archive
+    temp_output = output + ".tmp"
+    with open(temp_output, "wb") as f:
+        f.write(archive)
+    os.replace(temp_output, output)
+    print("Packed %d shaders (%d unique) into %s (%d bytes)" % (len(entries), len(blobs), output, len(archive)))
+    return True
+
+parser = argparse.ArgumentParser(description='Pack SPIR-V shaders into a memory mapped archive')
+parser.add_argument('--languages', nargs='+', default=["glsl", "hlsl", "slang"], help='shading language folders to pack, each into <language>.shaderpack')
+parser.add_argument('--examples', nargs='+', help='only pack the shaders of these examples (shaders shared by the base are always included)')
+parser.add_argument('--outdir', type=str, help='folder to write the archives to, defaults to the shaders folder')
+args = parser.parse_args()
+
+dir_path = os.path.dirname(os.path.realpath(__file__))
+out_dir = args.outdir if args.outdir else dir_path
+examples = set(args.examples + ["base"]) if args.examples else None
+for language in args.languages:
+    language_dir = os.path.join(dir_path, language)
+    if not os.path.isdir(language_dir):
+        sys.exit("Shader folder %s does not exist" % language_dir)
+    pack(language_dir, os.path.join(out_dir, language + ".shaderpack"), examples)
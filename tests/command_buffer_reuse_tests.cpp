@@ -0,0 +1,138 @@
+/*
+* Unit tests for command buffer reuse tracking
+*
+* Replays sequences of frames and checks that the number of recorded and reused command buffers matches what the frame slots, swap chain images and invalidations require
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "VulkanCommandBufferReuse.h"
+
+namespace
+{
+	constexpr uint32_t framesInFlight = 2;
+	constexpr uint32_t imageCount = 3;
+	// Time each simulated recording takes in ms
+	constexpr double recordTime = 2.0;
+
+	uint32_t failures = 0;
+
+	void check(bool condition, const char* expression, int line)
+	{
+		if (!condition)
+		{
+			std::cout << "  line " << line << ": " << expression << " failed\n";
+			failures++;
+		}
+	}
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+	// Mirrors VulkanExampleBase: frame slots are used round robin, swap chain images are acquired round robin, and frames that can't reuse their command buffer record it
+	uint32_t render(vks::CommandBufferReuse& reuse, uint32_t frames, uint32_t images)
+	{
+		uint32_t recorded = 0;
+		for (uint32_t frame = 0; frame < frames; frame++)
+		{
+			if (!reuse.reusable(frame % framesInFlight, frame % images, 0))
+			{
+				reuse.recorded(recordTime);
+				recorded++;
+			}
+		}
+		return recorded;
+	}
+
+	void reusesUnchangedFrames()
+	{
+		// With as many images as frame slots, each slot always renders to the same image
+		vks::CommandBufferReuse reuse;
+		reuse.prepare(framesInFlight, true);
+		const uint32_t frames = 100;
+		const uint32_t recorded = render(reuse, frames, framesInFlight);
+		CHECK(recorded == framesInFlight);
+		CHECK(reuse.recordCount == recorded);
+		CHECK(reuse.reuseCount == frames - framesInFlight);
+		CHECK(reuse.recordTime == framesInFlight * recordTime);
+		CHECK(reuse.savedTime == (frames - framesInFlight) * recordTime);
+		CHECK(reuse.reuseRate() == 98.0f);
+	}
+
+	void recordsForOtherImages()
+	{
+		// With more images than frame slots, a slot renders to a different image than last time, so its recording can't be reused
+		vks::CommandBufferReuse reuse;
+		reuse.prepare(framesInFlight, true);
+		const uint32_t frames = 12;
+		const uint32_t recorded = render(reuse, frames, imageCount);
+		CHECK(recorded == frames);
+		CHECK(reuse.recordCount == frames);
+		CHECK(reuse.reuseCount == 0);
+	}
+
+	void recordsAfterInvalidation()
+	{
+		vks::CommandBufferReuse reuse;
+		reuse.prepare(framesInFlight, true);
+		for (uint32_t slot = 0; slot < framesInFlight; slot++)
+		{
+			CHECK(!reuse.reusable(slot, slot, 0));
+			reuse.recorded(recordTime);
+		}
+		CHECK(reuse.reusable(0, 0, 0));
+		// Invalidation affects all slots, each records exactly once again
+		reuse.invalidate();
+		for (uint32_t slot = 0; slot < framesInFlight; slot++)
+		{
+			CHECK(!reuse.reusable(slot, slot, 0));
+			reuse.recorded(recordTime);
+			CHECK(reuse.reusable(slot, slot, 0));
+		}
+		// A different key (e.g. changed UI draw commands) or image also requires recording
+		CHECK(!reuse.reusable(0, 0, 1));
+		reuse.recorded(recordTime);
+		CHECK(reuse.reusable(0, 0, 1));
+		CHECK(!reuse.reusable(0, 1, 1));
+		reuse.recorded(recordTime);
+		CHECK(reuse.recordCount == 3 * framesInFlight);
+		CHECK(reuse.reuseCount == framesInFlight + 2);
+	}
+
+	void recordsEveryFrameWhenDisabled()
+	{
+		vks::CommandBufferReuse reuse;
+		reuse.prepare(framesInFlight, false);
+		const uint32_t frames = 10;
+		const uint32_t recorded = render(reuse, frames, framesInFlight);
+		CHECK(recorded == frames);
+		CHECK(reuse.recordCount == frames);
+		CHECK(reuse.reuseCount == 0);
+		CHECK(reuse.savedTime == 0.0);
+		CHECK(reuse.reuseRate() == 0.0f);
+	}
+}
+
+int main()
+{
+	const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+		{ "reusesUnchangedFrames", reusesUnchangedFrames },
+		{ "recordsForOtherImages", recordsForOtherImages },
+		{ "recordsAfterInvalidation", recordsAfterInvalidation },
+		{ "recordsEveryFrameWhenDisabled", recordsEveryFrameWhenDisabled },
+	};
+	for (const auto& [name, test] : tests)
+	{
+		const uint32_t previousFailures = failures;
+		test();
+		std::cout << ((failures == previousFailures) ? "[ OK ] " : "[FAIL] ") << name << "\n";
+	}
+	return (failures == 0) ? 0 : 1;
+}
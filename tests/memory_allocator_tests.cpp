@@ -0,0 +1,286 @@
+/*
+* Unit tests for the device memory sub-allocator
+*
+* Checks buddy splitting, merging and behaviour under fragmentation against a mocked device, so no GPU is required
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "VulkanMemoryAllocator.h"
+
+// Mocked device: device memory is backed by host memory, and all calls are counted
+namespace mock
+{
+	uint32_t allocateCount = 0;
+	uint32_t freeCount = 0;
+	uint64_t nextHandle = 1;
+	VkMemoryAllocateFlags lastAllocateFlags = 0;
+	std::map<VkDeviceMemory, std::vector<uint8_t>> memories;
+
+	void reset()
+	{
+		allocateCount = 0;
+		freeCount = 0;
+		lastAllocateFlags = 0;
+		memories.clear();
+	}
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateMemory(VkDevice, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks*, VkDeviceMemory* pMemory)
+{
+	mock::allocateCount++;
+	mock::lastAllocateFlags = 0;
+	if (pAllocateInfo->pNext)
+	{
+		mock::lastAllocateFlags = static_cast<const VkMemoryAllocateFlagsInfo*>(pAllocateInfo->pNext)->flags;
+	}
+	*pMemory = reinterpret_cast<VkDeviceMemory>(static_cast<uintptr_t>(mock::nextHandle++));
+	mock::memories[*pMemory].resize(static_cast<size_t>(pAllocateInfo->allocationSize));
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkFreeMemory(VkDevice, VkDeviceMemory memory, const VkAllocationCallbacks*)
+{
+	mock::freeCount++;
+	mock::memories.erase(memory);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkMapMemory(VkDevice, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize, VkMemoryMapFlags, void** ppData)
+{
+	*ppData = mock::memories[memory].data() + offset;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkUnmapMemory(VkDevice, VkDeviceMemory)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkFlushMappedMemoryRanges(VkDevice, uint32_t, const VkMappedMemoryRange*)
+{
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkInvalidateMappedMemoryRanges(VkDevice, uint32_t, const VkMappedMemoryRange*)
+{
+	return VK_SUCCESS;
+}
+
+namespace
+{
+	// An 8 MiB heap results in 1 MiB blocks with 13 buddy levels (1 MiB down to 256 bytes)
+	constexpr VkDeviceSize heapSize = 8ull * 1024 * 1024;
+	constexpr VkDeviceSize blockSize = 1024ull * 1024;
+	constexpr uint32_t deviceLocalType = 0;
+	constexpr uint32_t hostVisibleType = 1;
+
+	uint32_t failures = 0;
+
+	void check(bool condition, const char* expression, int line)
+	{
+		if (!condition)
+		{
+			std::cout << "  line " << line << ": " << expression << " failed\n";
+			failures++;
+		}
+	}
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+	void initAllocator(vks::MemoryAllocator& allocator)
+	{
+		mock::reset();
+		VkPhysicalDeviceProperties properties{};
+		properties.limits.nonCoherentAtomSize = 64;
+		VkPhysicalDeviceMemoryProperties memoryProperties{};
+		memoryProperties.memoryHeapCount = 1;
+		memoryProperties.memoryHeaps[0] = { heapSize, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT };
+		memoryProperties.memoryTypeCount = 2;
+		memoryProperties.memoryTypes[deviceLocalType] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0 };
+		memoryProperties.memoryTypes[hostVisibleType] = { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0 };
+		allocator.init(reinterpret_cast<VkDevice>(static_cast<uintptr_t>(1)), properties, memoryProperties, nullptr);
+	}
+
+	vks::MemoryAllocation allocate(vks::MemoryAllocator& allocator, VkDeviceSize size, VkDeviceSize alignment = 1, uint32_t memoryTypeIndex = deviceLocalType, bool linear = true, bool deviceAddress = false)
+	{
+		const VkMemoryRequirements requirements{ size, alignment, 1u << memoryTypeIndex };
+		vks::MemoryAllocation allocation;
+		const VkResult result = allocator.allocate(requirements, memoryTypeIndex, linear, deviceAddress, vks::MemoryTag::Other, allocation);
+		CHECK(result == VK_SUCCESS);
+		return allocation;
+	}
+
+	void splitsLargerRanges()
+	{
+		vks::MemoryAllocator allocator;
+		initAllocator(allocator);
+		// The first allocation splits the block down to the smallest level, leaving one free range per level
+		vks::MemoryAllocation a = allocate(allocator, 256);
+		vks::MemoryAllocation b = allocate(allocator, 256);
+		vks::MemoryAllocation c = allocate(allocator, 1024);
+		vks::MemoryAllocation d = allocate(allocator, 512);
+		CHECK(mock::allocateCount == 1);
+		CHECK((a.memory == b.memory) && (b.memory == c.memory) && (c.memory == d.memory));
+		CHECK(a.offset == 0);
+		CHECK(b.offset == 256);
+		CHECK(d.offset == 512);
+		CHECK(c.offset == 1024);
+		// Power of two ranges are aligned to their size, so larger alignments are satisfied by rounding up
+		vks::MemoryAllocation aligned = allocate(allocator, 100, 4096);
+		CHECK(aligned.offset == 4096);
+		CHECK(allocator.getStatistics().padding == (4096 - 100));
+		for (vks::MemoryAllocation* allocation : { &a, &b, &c, &d, &aligned })
+		{
+			allocator.free(*allocation);
+			CHECK(!allocation->valid());
+		}
+		allocator.destroy();
+		CHECK(mock::freeCount == 1);
+	}
+
+	void mergesBuddies()
+	{
+		vks::MemoryAllocator allocator;
+		initAllocator(allocator);
+		std::vector<vks::MemoryAllocation> allocations;
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			allocations.push_back(allocate(allocator, 256));
+		}
+		// Free out of order, buddies must only merge once both halves are free
+		for (uint32_t i : { 5, 0, 7, 2, 1, 6, 3, 4 })
+		{
+			allocator.free(allocations[i]);
+		}
+		// Two halves only fit if the block has been merged back into a single free range
+		vks::MemoryAllocation first = allocate(allocator, blockSize / 2);
+		vks::MemoryAllocation second = allocate(allocator, blockSize / 2);
+		CHECK(mock::allocateCount == 1);
+		CHECK(first.memory == second.memory);
+		CHECK(first.offset == 0);
+		CHECK(second.offset == blockSize / 2);
+		allocator.free(first);
+		allocator.free(second);
+		const vks::MemoryAllocator::Statistics stats = allocator.getStatistics();
+		CHECK(stats.allocationCount == 0);
+		CHECK(stats.used == 0);
+		CHECK(stats.padding == 0);
+		// The last block of a pool is kept for reuse
+		CHECK(stats.blockCount == 1);
+		CHECK(mock::freeCount == 0);
+		allocator.destroy();
+	}
+
+	void handlesFragmentation()
+	{
+		vks::MemoryAllocator allocator;
+		initAllocator(allocator);
+		const uint32_t count = static_cast<uint32_t>(blockSize / 256);
+		std::vector<vks::MemoryAllocation> allocations;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			allocations.push_back(allocate(allocator, 256));
+		}
+		CHECK(mock::allocateCount == 1);
+		// Freeing every other range leaves half of the block free, but without two neighbouring buddies
+		for (uint32_t i = 0; i < count; i += 2)
+		{
+			allocator.free(allocations[i]);
+		}
+		CHECK(allocator.getStatistics().used == blockSize / 2);
+		vks::MemoryAllocation small = allocate(allocator, 256);
+		CHECK(small.memory == allocations[1].memory);
+		CHECK(mock::allocateCount == 1);
+		// No free range is large enough, so a second block is required
+		vks::MemoryAllocation large = allocate(allocator, 512);
+		CHECK(mock::allocateCount == 2);
+		CHECK(large.memory != allocations[1].memory);
+		CHECK(allocator.getStatistics().blockCount == 2);
+		// Empty blocks are released as long as another block is left
+		allocator.free(large);
+		CHECK(mock::freeCount == 1);
+		CHECK(allocator.getStatistics().blockCount == 1);
+		allocator.free(small);
+		for (uint32_t i = 1; i < count; i += 2)
+		{
+			allocator.free(allocations[i]);
+		}
+		// Once all ranges are free again the block merges back and can hold a half block allocation
+		vks::MemoryAllocation half = allocate(allocator, blockSize / 2);
+		CHECK(mock::allocateCount == 2);
+		CHECK(half.offset == 0);
+		allocator.free(half);
+		allocator.destroy();
+		CHECK(mock::freeCount == 2);
+		CHECK(mock::memories.empty());
+	}
+
+	void separatesPools()
+	{
+		vks::MemoryAllocator allocator;
+		initAllocator(allocator);
+		// Linear and optimal resources never share a block, to respect bufferImageGranularity
+		vks::MemoryAllocation buffer = allocate(allocator, 256, 1, deviceLocalType, true);
+		vks::MemoryAllocation image = allocate(allocator, 256, 1, deviceLocalType, false);
+		CHECK(buffer.memory != image.memory);
+		CHECK(mock::lastAllocateFlags == 0);
+		vks::MemoryAllocation addressable = allocate(allocator, 256, 1, deviceLocalType, true, true);
+		CHECK(addressable.memory != buffer.memory);
+		CHECK(mock::lastAllocateFlags == VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT);
+		// Host visible blocks stay mapped, allocations point into the mapping
+		vks::MemoryAllocation first = allocate(allocator, 256, 1, hostVisibleType);
+		vks::MemoryAllocation second = allocate(allocator, 256, 1, hostVisibleType);
+		CHECK(first.mapped == mock::memories[first.memory].data());
+		CHECK(second.mapped == mock::memories[second.memory].data() + second.offset);
+		CHECK(buffer.mapped == nullptr);
+		for (vks::MemoryAllocation* allocation : { &buffer, &image, &addressable, &first, &second })
+		{
+			allocator.free(*allocation);
+		}
+		allocator.destroy();
+		CHECK(mock::memories.empty());
+	}
+
+	void dedicatesLargeResources()
+	{
+		vks::MemoryAllocator allocator;
+		initAllocator(allocator);
+		vks::MemoryAllocation large = allocate(allocator, blockSize / 2 + 1);
+		CHECK(large.pool == UINT32_MAX);
+		CHECK(large.offset == 0);
+		CHECK(mock::memories[large.memory].size() == blockSize / 2 + 1);
+		CHECK(allocator.getStatistics().dedicatedCount == 1);
+		CHECK(allocator.getStatistics().blockCount == 0);
+		// Dedicated memory is released right away
+		allocator.free(large);
+		CHECK(mock::freeCount == 1);
+		CHECK(allocator.getStatistics().reserved == 0);
+		allocator.destroy();
+	}
+}
+
+int main()
+{
+	const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+		{ "splitsLargerRanges", splitsLargerRanges },
+		{ "mergesBuddies", mergesBuddies },
+		{ "handlesFragmentation", handlesFragmentation },
+		{ "separatesPools", separatesPools },
+		{ "dedicatesLargeResources", dedicatesLargeResources },
+	};
+	for (const auto& [name, test] : tests)
+	{
+		const uint32_t previousFailures = failures;
+		test();
+		std::cout << ((failures == previousFailures) ? "[ OK ] " : "[FAIL] ") << name << "\n";
+	}
+	return (failures == 0) ? 0 : 1;
+}
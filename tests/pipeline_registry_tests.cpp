@@ -0,0 +1,227 @@
+/*
+* Unit tests for the pipeline registry
+*
+* Checks deduplication of pipelines and their eviction when layouts or render passes go away against a mocked device, so no GPU is required
+*
+* Copyright (C) 2025 by Sascha Willems - www.saschawillems.de
+*
+* This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
+*/
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "VulkanPipelineRegistry.h"
+#include "VulkanTools.h"
+
+// Mocked device: pipelines are counters, live ones are tracked to catch leaks and double destruction
+namespace mock
+{
+	uint64_t nextHandle = 1;
+	uint32_t createCount = 0;
+	uint32_t destroyCount = 0;
+	std::set<VkPipeline> pipelines;
+
+	VkPipeline create()
+	{
+		createCount++;
+		VkPipeline pipeline = reinterpret_cast<VkPipeline>(static_cast<uintptr_t>(nextHandle++));
+		pipelines.insert(pipeline);
+		return pipeline;
+	}
+
+	void reset()
+	{
+		createCount = 0;
+		destroyCount = 0;
+		pipelines.clear();
+	}
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateGraphicsPipelines(VkDevice, VkPipelineCache, uint32_t, const VkGraphicsPipelineCreateInfo*, const VkAllocationCallbacks*, VkPipeline* pPipelines)
+{
+	*pPipelines = mock::create();
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateComputePipelines(VkDevice, VkPipelineCache, uint32_t, const VkComputePipelineCreateInfo*, const VkAllocationCallbacks*, VkPipeline* pPipelines)
+{
+	*pPipelines = mock::create();
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyPipeline(VkDevice, VkPipeline pipeline, const VkAllocationCallbacks*)
+{
+	mock::destroyCount++;
+	if (mock::pipelines.erase(pipeline) == 0)
+	{
+		std::cout << "  destroyed a pipeline that is not alive\n";
+	}
+}
+
+// Used by VK_CHECK_RESULT, the tools translation unit pulls in the rest of the base
+std::string vks::tools::errorString(VkResult)
+{
+	return "mock";
+}
+
+namespace
+{
+	uint32_t failures = 0;
+
+	void check(bool condition, const char* expression, int line)
+	{
+		if (!condition)
+		{
+			std::cout << "  line " << line << ": " << expression << " failed\n";
+			failures++;
+		}
+	}
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+	template <typename T>
+	T handle(uint64_t value)
+	{
+		return reinterpret_cast<T>(static_cast<uintptr_t>(value));
+	}
+
+	const VkDevice device = handle<VkDevice>(1);
+	const VkShaderModule vertexShader = handle<VkShaderModule>(10);
+	const VkShaderModule fragmentShader = handle<VkShaderModule>(11);
+
+	// Minimal create info, the state structures live as long as the fixture
+	struct GraphicsPipeline
+	{
+		std::vector<VkPipelineShaderStageCreateInfo> stages;
+		VkPipelineInputAssemblyStateCreateInfo inputAssemblyState = vks::initializers::pipelineInputAssemblyStateCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 0, VK_FALSE);
+		VkPipelineRasterizationStateCreateInfo rasterizationState = vks::initializers::pipelineRasterizationStateCreateInfo(VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, VK_FRONT_FACE_COUNTER_CLOCKWISE, 0);
+		VkGraphicsPipelineCreateInfo pipelineCI{};
+
+		GraphicsPipeline(VkPipelineLayout layout, VkRenderPass renderPass)
+		{
+			stages = {
+				{ .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_VERTEX_BIT, .module = vertexShader, .pName = "main" },
+				{ .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_FRAGMENT_BIT, .module = fragmentShader, .pName = "main" },
+			};
+			pipelineCI = vks::initializers::pipelineCreateInfo(layout, renderPass);
+			pipelineCI.stageCount = static_cast<uint32_t>(stages.size());
+			pipelineCI.pStages = stages.data();
+			pipelineCI.pInputAssemblyState = &inputAssemblyState;
+			pipelineCI.pRasterizationState = &rasterizationState;
+		}
+	};
+
+	void deduplicatesPipelines()
+	{
+		mock::reset();
+		vks::PipelineRegistry registry;
+		registry.prepare(device);
+		GraphicsPipeline solid(handle<VkPipelineLayout>(100), handle<VkRenderPass>(200));
+		const VkPipeline first = registry.getGraphicsPipeline(solid.pipelineCI, VK_NULL_HANDLE);
+		CHECK(registry.getGraphicsPipeline(solid.pipelineCI, VK_NULL_HANDLE) == first);
+		// Any change of state results in a different pipeline
+		solid.rasterizationState.polygonMode = VK_POLYGON_MODE_LINE;
+		const VkPipeline wireframe = registry.getGraphicsPipeline(solid.pipelineCI, VK_NULL_HANDLE);
+		CHECK(wireframe != first);
+		solid.rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+		CHECK(registry.getGraphicsPipeline(solid.pipelineCI, VK_NULL_HANDLE) == first);
+		CHECK(mock::createCount == 2);
+		CHECK(registry.hits == 2);
+		CHECK(registry.misses == 2);
+		CHECK(registry.pipelineCount() == 2);
+		registry.destroy();
+		CHECK(mock::pipelines.empty());
+	}
+
+	void matchesShadersByHash()
+	{
+		mock::reset();
+		vks::PipelineRegistry registry;
+		registry.prepare(device);
+		GraphicsPipeline pipeline(handle<VkPipelineLayout>(100), handle<VkRenderPass>(200));
+		registry.registerShader(vertexShader, 1);
+		registry.registerShader(fragmentShader, 2);
+		const VkPipeline first = registry.getGraphicsPipeline(pipeline.pipelineCI, VK_NULL_HANDLE);
+		// A module loaded again from the same code has a different handle, but the same hash
+		const VkShaderModule reloadedShader = handle<VkShaderModule>(12);
+		registry.registerShader(reloadedShader, 2);
+		pipeline.stages[1].module = reloadedShader;
+		CHECK(registry.getGraphicsPipeline(pipeline.pipelineCI, VK_NULL_HANDLE) == first);
+		CHECK(mock::createCount == 1);
+		registry.destroy();
+	}
+
+	void forgetsLayouts()
+	{
+		mock::reset();
+		vks::PipelineRegistry registry;
+		registry.prepare(device);
+		const VkPipelineLayout layout = handle<VkPipelineLayout>(100);
+		const VkPipelineLayout otherLayout = handle<VkPipelineLayout>(101);
+		GraphicsPipeline graphics(layout, handle<VkRenderPass>(200));
+		GraphicsPipeline other(otherLayout, handle<VkRenderPass>(200));
+		VkComputePipelineCreateInfo computeCI = vks::initializers::computePipelineCreateInfo(layout, 0);
+		computeCI.stage = graphics.stages[0];
+		computeCI.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		const VkPipeline oldGraphics = registry.getGraphicsPipeline(graphics.pipelineCI, VK_NULL_HANDLE);
+		const VkPipeline kept = registry.getGraphicsPipeline(other.pipelineCI, VK_NULL_HANDLE);
+		registry.getComputePipeline(computeCI, VK_NULL_HANDLE);
+		registry.forget(layout);
+		CHECK(mock::destroyCount == 2);
+		CHECK(mock::pipelines.count(oldGraphics) == 0);
+		CHECK(registry.pipelineCount() == 1);
+		// A new layout that gets the handle of the destroyed one must not match the old pipelines
+		CHECK(registry.getGraphicsPipeline(graphics.pipelineCI, VK_NULL_HANDLE) != oldGraphics);
+		CHECK(registry.getGraphicsPipeline(other.pipelineCI, VK_NULL_HANDLE) == kept);
+		CHECK(mock::createCount == 4);
+		registry.destroy();
+		CHECK(mock::pipelines.empty());
+	}
+
+	void forgetsRenderPasses()
+	{
+		mock::reset();
+		vks::PipelineRegistry registry;
+		registry.prepare(device);
+		const VkRenderPass renderPass = handle<VkRenderPass>(200);
+		GraphicsPipeline cached(handle<VkPipelineLayout>(100), renderPass);
+		GraphicsPipeline other(handle<VkPipelineLayout>(100), handle<VkRenderPass>(201));
+		// Pipelines with unknown pNext structures aren't deduplicated, but are evicted the same way
+		GraphicsPipeline uncached(handle<VkPipelineLayout>(100), renderPass);
+		VkPipelineRasterizationStateRasterizationOrderAMD rasterizationOrder{ .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_RASTERIZATION_ORDER_AMD };
+		uncached.rasterizationState.pNext = &rasterizationOrder;
+		registry.getGraphicsPipeline(cached.pipelineCI, VK_NULL_HANDLE);
+		registry.getGraphicsPipeline(uncached.pipelineCI, VK_NULL_HANDLE);
+		registry.getGraphicsPipeline(uncached.pipelineCI, VK_NULL_HANDLE);
+		const VkPipeline kept = registry.getGraphicsPipeline(other.pipelineCI, VK_NULL_HANDLE);
+		CHECK(registry.pipelineCount() == 4);
+		registry.forget(renderPass);
+		CHECK(mock::destroyCount == 3);
+		CHECK(registry.pipelineCount() == 1);
+		CHECK(mock::pipelines.count(kept) == 1);
+		registry.destroy();
+		CHECK(mock::pipelines.empty());
+	}
+}
+
+int main()
+{
+	const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+		{ "deduplicatesPipelines", deduplicatesPipelines },
+		{ "matchesShadersByHash", matchesShadersByHash },
+		{ "forgetsLayouts", forgetsLayouts },
+		{ "forgetsRenderPasses", forgetsRenderPasses },
+	};
+	for (const auto& [name, test] : tests)
+	{
+		const uint32_t previousFailures = failures;
+		test();
+		std::cout << ((failures == previousFailures) ? "[ OK ] " : "[FAIL] ") << name << "\n";
+	}
+	return (failures == 0) ? 0 : 1;
+}